@@ -0,0 +1,54 @@
+#include <chrono>
+#include <iostream>
+#include <string>
+
+#include "libslic3r/GCode/GCodeProcessor.hpp"
+
+using namespace Slic3r;
+
+// Processes a G-code file and compares the memory used by the columnar store of the moves
+// with the memory a std::vector<MoveVertex> owning the arc interpolation points would use,
+// then times a pass over the moves through the iterator and through operator[].
+int main(int argc, char **argv)
+{
+    if (argc < 2) {
+        std::cerr << "Usage: gcode_processor file.gcode" << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    GCodeProcessor processor;
+    auto           start_time = std::chrono::high_resolution_clock::now();
+    processor.process_file(argv[1]);
+    auto           end_time   = std::chrono::high_resolution_clock::now();
+
+    const GCodeProcessorResult::MoveVertexStore &moves = processor.get_result().moves;
+
+    size_t arc_points = 0;
+    size_t arc_moves  = 0;
+    auto   iterator_start  = std::chrono::high_resolution_clock::now();
+    for (const GCodeProcessorResult::MoveVertex &move : moves)
+        if (move.is_arc_move()) {
+            ++arc_moves;
+            arc_points += move.interpolation_points.size();
+        }
+    auto   index_start     = std::chrono::high_resolution_clock::now();
+    size_t index_arc_moves = 0;
+    for (size_t i = 0; i < moves.size(); ++i)
+        if (moves[i].is_arc_move())
+            ++index_arc_moves;
+    auto   index_end       = std::chrono::high_resolution_clock::now();
+    const size_t vertex_size = sizeof(GCodeProcessorResult::MoveVertex) - sizeof(GCodeProcessorResult::InterpolationPoints) + sizeof(std::vector<Vec3f>);
+    const size_t vector_size = moves.size() * vertex_size + arc_points * sizeof(Vec3f);
+    const size_t store_size  = moves.memsize();
+
+    std::cout << "Moves:            " << moves.size() << " (" << arc_moves << " arcs, " << arc_points << " interpolation points)" << std::endl;
+    std::cout << "Processing time:  " << std::chrono::duration_cast<std::chrono::milliseconds>(end_time - start_time).count() << " ms" << std::endl;
+    std::cout << "Iterator pass:    " << std::chrono::duration_cast<std::chrono::microseconds>(index_start - iterator_start).count() << " us" << std::endl;
+    std::cout << "operator[] pass:  " << std::chrono::duration_cast<std::chrono::microseconds>(index_end - index_start).count() << " us" << std::endl;
+    std::cout << "std::vector size: " << vector_size << " bytes" << std::endl;
+    std::cout << "Store size:       " << store_size << " bytes" << std::endl;
+    if (store_size > 0)
+        std::cout << "Ratio:            " << double(vector_size) / double(store_size) << std::endl;
+
+    return index_arc_moves == arc_moves ? EXIT_SUCCESS : EXIT_FAILURE;
+}
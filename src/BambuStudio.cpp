@@ -22,10 +22,20 @@
 #include <cstring>
 #include <iostream>
 #include <math.h>
+#include <atomic>
+#include <chrono>
+#include <mutex>
 
 #if defined(__linux__) || defined(__LINUX__)
 #include <condition_variable>
+#include <deque>
 #include <mutex>
+#include <cerrno>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/time.h>
+#include <sys/un.h>
+#include <unistd.h>
 #include <boost/thread.hpp>
 //add json logic
 #include "nlohmann/json.hpp"
@@ -41,6 +51,12 @@ using namespace nlohmann;
 #include <boost/nowide/integration/filesystem.hpp>
 #include <boost/dll/runtime_symbol_info.hpp>
 #include <boost/log/trivial.hpp>
+#include <boost/nowide/fstream.hpp>
+
+#include <tbb/parallel_for.h>
+#include <tbb/task_arena.h>
+
+#include "nlohmann/json.hpp"
 
 #include "unix/fhs.hpp"  // Generated by CMake from ../platform/unix/fhs.hpp.in
 
@@ -312,6 +328,118 @@ static PrinterTechnology get_printer_technology(const DynamicConfig &config)
     return (opt == nullptr) ? ptUnknown : opt->value;
 }
 
+//BBS: process wide caches shared by the jobs of a batch run (--batch).
+// Setting files and plain meshes are loaded once and copied into every job referring to them,
+// the cache entries are keyed by the file path and the load options and invalidated when the file is modified.
+static std::atomic<bool> g_cli_batch_caches_enabled { false };
+static std::mutex        g_cli_cache_mutex;
+// glfw and the OpenGL context used for the thumbnails may only be driven by one job at a time.
+static std::mutex        g_cli_gl_mutex;
+
+struct CLIConfigCacheEntry
+{
+    std::time_t                         mtime { 0 };
+    DynamicPrintConfig                  config;
+    std::map<std::string, std::string>  key_values;
+    std::string                         reason;
+    ConfigSubstitutions                 substitutions;
+};
+static std::map<std::string, CLIConfigCacheEntry> g_cli_config_cache;
+
+struct CLIModelCacheEntry
+{
+    std::time_t                         mtime { 0 };
+    Model                               model;
+};
+// Keyed by the file path and the load strategy of the job.
+static std::map<std::pair<std::string, std::underlying_type_t<LoadStrategy>>, CLIModelCacheEntry> g_cli_model_cache;
+
+// Modification time of an input file, false if the file does not exist (anymore).
+static bool cli_file_mtime(const std::string &file, std::time_t &mtime)
+{
+    boost::system::error_code ec;
+    if (! boost::filesystem::exists(file, ec) || ec)
+        return false;
+    mtime = boost::filesystem::last_write_time(file, ec);
+    return ! ec;
+}
+
+static ConfigSubstitutions copy_config_substitutions(const ConfigSubstitutions &substitutions)
+{
+    ConfigSubstitutions out;
+    out.reserve(substitutions.size());
+    for (const ConfigSubstitution &subst : substitutions)
+        out.push_back({ subst.opt_def, subst.old_value, ConfigOptionUniquePtr(subst.new_value ? subst.new_value->clone() : nullptr) });
+    return out;
+}
+
+// Same as DynamicPrintConfig::load_from_json(), served from the batch cache when enabled.
+static ConfigSubstitutions cli_load_config_from_json(const std::string &file, ForwardCompatibilitySubstitutionRule rule, DynamicPrintConfig &config,
+                                                     std::map<std::string, std::string> &key_values, std::string &reason)
+{
+    std::time_t mtime;
+    if (! g_cli_batch_caches_enabled || ! config.empty() || ! cli_file_mtime(file, mtime))
+        return config.load_from_json(file, rule, key_values, reason);
+
+    {
+        std::lock_guard<std::mutex> lock(g_cli_cache_mutex);
+        auto it = g_cli_config_cache.find(file);
+        if (it != g_cli_config_cache.end() && it->second.mtime == mtime) {
+            BOOST_LOG_TRIVIAL(info) << __FUNCTION__ << ": reuse cached setting file " << file;
+            config     = it->second.config;
+            key_values = it->second.key_values;
+            reason     = it->second.reason;
+            return copy_config_substitutions(it->second.substitutions);
+        }
+    }
+
+    ConfigSubstitutions substitutions = config.load_from_json(file, rule, key_values, reason);
+    if (reason.empty()) {
+        CLIConfigCacheEntry entry { mtime, config, key_values, reason, copy_config_substitutions(substitutions) };
+        std::lock_guard<std::mutex> lock(g_cli_cache_mutex);
+        g_cli_config_cache[file] = std::move(entry);
+    }
+    return substitutions;
+}
+
+// Only plain meshes are cached, project files carry configs and plate data which are job specific.
+static bool cli_is_cacheable_model_file(const std::string &file)
+{
+    return boost::algorithm::iends_with(file, ".stl") || boost::algorithm::iends_with(file, ".obj");
+}
+
+// Returns CLI_FILE_NOTFOUND if the file does not exist, the read errors are thrown as by Model::read_from_file().
+static int cli_read_mesh_model(const std::string &file, LoadStrategy strategy, Model &model)
+{
+    std::time_t mtime;
+    if (! cli_file_mtime(file, mtime))
+        return CLI_FILE_NOTFOUND;
+    if (! g_cli_batch_caches_enabled) {
+        model = Model::read_from_file(file, nullptr, nullptr, strategy);
+        return CLI_SUCCESS;
+    }
+
+    const auto key = std::make_pair(file, static_cast<std::underlying_type_t<LoadStrategy>>(strategy));
+    {
+        std::lock_guard<std::mutex> lock(g_cli_cache_mutex);
+        auto it = g_cli_model_cache.find(key);
+        if (it != g_cli_model_cache.end() && it->second.mtime == mtime) {
+            BOOST_LOG_TRIVIAL(info) << __FUNCTION__ << ": reuse cached model file " << file;
+            // The copy shares the immutable triangle meshes with the cached model. It gets its own IDs, the backup path
+            // used by the 3MF export is derived from the model ID and would be shared by the concurrent jobs otherwise.
+            model.assign_clone(it->second.model);
+            return CLI_SUCCESS;
+        }
+    }
+
+    model = Model::read_from_file(file, nullptr, nullptr, strategy);
+    std::lock_guard<std::mutex> lock(g_cli_cache_mutex);
+    CLIModelCacheEntry &entry = g_cli_model_cache[key];
+    entry.mtime = mtime;
+    entry.model = model;
+    return CLI_SUCCESS;
+}
+
 //BBS: add flush and exit
 #if defined(__linux__) || defined(__LINUX__)
 #define flush_and_exit(ret)     { boost::nowide::cout << __FUNCTION__ << " found error, return "<<ret<<", exit..." << std::endl;\
@@ -345,22 +473,26 @@ const float bed3d_ax3s_default_tip_length = 5.0f;
 int CLI::run(int argc, char **argv)
 {
     // Mark the main thread for the debugger and for runtime checks.
-    set_current_thread_name("bambustu_main");
+    if (! m_batch_job)
+        set_current_thread_name("bambustu_main");
 
 #ifdef __WXGTK__
-    // On Linux, wxGTK has no support for Wayland, and the app crashes on
-    // startup if gtk3 is used. This env var has to be set explicitly to
-    // instruct the window manager to fall back to X server mode.
-    ::setenv("GDK_BACKEND", "x11", /* replace */ true);
-
-    // Also on Linux, we need to tell Xlib that we will be using threads,
-    // lest we crash when we fire up GStreamer.
-    XInitThreads();
+    if (! m_batch_job) {
+        // On Linux, wxGTK has no support for Wayland, and the app crashes on
+        // startup if gtk3 is used. This env var has to be set explicitly to
+        // instruct the window manager to fall back to X server mode.
+        ::setenv("GDK_BACKEND", "x11", /* replace */ true);
+
+        // Also on Linux, we need to tell Xlib that we will be using threads,
+        // lest we crash when we fire up GStreamer.
+        XInitThreads();
+    }
 #endif
 
 	// Switch boost::filesystem to utf8.
     try {
-        boost::nowide::nowide_filesystem();
+        if (! m_batch_job)
+            boost::nowide::nowide_filesystem();
     } catch (const std::runtime_error& ex) {
         std::string caption = std::string(SLIC3R_APP_FULL_NAME) + " Error";
         std::string text = std::string("boost::nowide::nowide_filesystem Failed!\n") + (
@@ -398,8 +530,10 @@ int CLI::run(int argc, char **argv)
         return CLI_INVALID_PARAMS;
     }
     BOOST_LOG_TRIVIAL(info) << "finished setup params, argc="<< argc << std::endl;
-    std::string temp_path = wxFileName::GetTempDir().utf8_str().data();
-    set_temporary_dir(temp_path);
+    if (! m_batch_job) {
+        std::string temp_path = wxFileName::GetTempDir().utf8_str().data();
+        set_temporary_dir(temp_path);
+    }
 
     m_extra_config.apply(m_config, true);
     m_extra_config.normalize_fdm();
@@ -407,6 +541,10 @@ int CLI::run(int argc, char **argv)
     PrinterTechnology printer_technology = get_printer_technology(m_config);
 
     bool							start_gui			= m_actions.empty();
+    if (start_gui && m_batch_job) {
+        boost::nowide::cerr << "batch job without any action" << std::endl;
+        return CLI_INVALID_PARAMS;
+    }
 
     //BBS: remove GCodeViewer as seperate APP logic
     /*bool 							start_as_gcodeviewer =
@@ -482,7 +620,7 @@ int CLI::run(int argc, char **argv)
         return (argc == 0) ? 0 : 1;
 #endif // SLIC3R_GUI
     }
-    else {
+    else if (! m_batch_job) {
         const ConfigOptionInt *opt_loglevel = m_config.opt<ConfigOptionInt>("debug");
         if (opt_loglevel) {
             set_logging_level(opt_loglevel->value);
@@ -492,6 +630,17 @@ int CLI::run(int argc, char **argv)
         }
     }
 
+    //BBS: batch and daemon modes, run the jobs with the process level setup done above
+    const std::string &batch_manifest = m_config.opt_string("batch");
+    const std::string &daemon_socket  = m_config.opt_string("daemon");
+    if (! batch_manifest.empty() || ! daemon_socket.empty()) {
+        if (m_batch_job) {
+            boost::nowide::cerr << "--batch and --daemon can not be used inside a job" << std::endl;
+            return CLI_INVALID_PARAMS;
+        }
+        return batch_manifest.empty() ? this->run_daemon(daemon_socket) : this->run_batch(batch_manifest);
+    }
+
     BOOST_LOG_TRIVIAL(info) << "start_gui="<< start_gui << std::endl;
 
     //BBS: add plate data related logic
@@ -523,6 +672,11 @@ int CLI::run(int argc, char **argv)
         up_config_to_date = uptodate_option->value;
 
     ConfigOptionString* pipe_option = m_config.option<ConfigOptionString>("pipe");
+    if (pipe_option && m_batch_job && !pipe_option->value.empty()) {
+        // The progress pipe is process wide, the batch report is used instead.
+        BOOST_LOG_TRIVIAL(warning) << boost::format("batch job ignores pipe %1%")%pipe_option->value;
+        pipe_option->value.clear();
+    }
     if (pipe_option) {
         pipe_name = pipe_option->value;
         if (!pipe_name.empty()) {
@@ -569,7 +723,14 @@ int CLI::run(int argc, char **argv)
                 // BBS: adjust whebackup
                 //LoadStrategy strategy = LoadStrategy::LoadModel | LoadStrategy::LoadConfig|LoadStrategy::AddDefaultInstances;
                 //if (load_aux) strategy = strategy | LoadStrategy::LoadAuxiliary;
-                model = Model::read_from_file(file, &config, &config_substitutions, strategy, &plate_data_src, &project_presets, &is_bbl_3mf, &file_version, nullptr, nullptr, nullptr, nullptr, nullptr, plate_to_slice);
+                if (cli_is_cacheable_model_file(file)) {
+                    if (cli_read_mesh_model(file, strategy, model) == CLI_FILE_NOTFOUND) {
+                        boost::nowide::cerr << "No such file: " << file << std::endl;
+                        flush_and_exit(CLI_FILE_NOTFOUND);
+                    }
+                }
+                else
+                    model = Model::read_from_file(file, &config, &config_substitutions, strategy, &plate_data_src, &project_presets, &is_bbl_3mf, &file_version, nullptr, nullptr, nullptr, nullptr, nullptr, plate_to_slice);
                 if (is_bbl_3mf)
                 {
                     if (!first_file)
@@ -701,7 +862,11 @@ int CLI::run(int argc, char **argv)
             std::map<std::string, std::string> key_values;
             std::string reason, config_from;
 
-            config_substitutions = config.load_from_json(file, config_substitution_rule, key_values, reason);
+            config_substitutions = cli_load_config_from_json(file, config_substitution_rule, config, key_values, reason);
+            if (!reason.empty() && ! boost::filesystem::exists(file)) {
+                boost::nowide::cerr << __FUNCTION__<< ": can not find setting file: " << file << std::endl;
+                return CLI_FILE_NOTFOUND;
+            }
             if (!reason.empty()) {
                 BOOST_LOG_TRIVIAL(error) <<__FUNCTION__<<  ":Can not load config from file "<<file<<"\n";
                 return CLI_CONFIG_FILE_ERROR;
@@ -1924,6 +2089,9 @@ int CLI::run(int argc, char **argv)
     bool no_check = false;
     std::string export_3mf_file, load_slice_data_dir, export_slice_data_dir;
     std::string outfile_dir = m_config.opt_string("outputdir");
+    // Objects sliced by any previous run are loaded from the slicing cache, newly sliced ones are added to it.
+    std::string slice_cache_dir = m_config.opt_string("slice_cache_dir");
+    size_t slice_cache_size = size_t(std::max(0, m_config.opt_int("slice_cache_size"))) << 20;
     std::vector<ThumbnailData*> calibration_thumbnails;
     int max_slicing_time_per_plate = 0, max_triangle_count_per_plate = 0;
     std::vector<bool> plate_has_skips(partplate_list.get_plate_count(), false);
@@ -2193,6 +2361,12 @@ int CLI::run(int argc, char **argv)
                                     }
                                 }
 #endif
+                                //BBS: daemon job, report the progress to the requester and allow it to cancel this print
+                                if (m_job_hooks) {
+                                    print->set_status_callback(m_job_hooks->status);
+                                    m_job_hooks->attach_print(print);
+                                }
+                                ScopeGuard detach_print_guard(m_job_hooks ? ScopeGuard::Closure([this]() { m_job_hooks->attach_print(nullptr); }) : ScopeGuard::Closure());
                                 //check whether it is bbl printer
                                 std::string& printer_model_string = new_print_config.opt_string("printer_model", true);
                                 bool is_bbl_vendor_preset = false;
@@ -2229,6 +2403,16 @@ int CLI::run(int argc, char **argv)
                                         BOOST_LOG_TRIVIAL(info) << "plate "<< index+1<< ": finished print::process.";
                                     }
                                 }
+                                else if (!slice_cache_dir.empty() && printer_technology == ptFFF) {
+                                    int ret = print->load_cached_data(slice_cache_dir, true);
+                                    if (ret) {
+                                        BOOST_LOG_TRIVIAL(warning) << "plate "<< index+1<< ": load slicing cache error, ret=" << ret << ", switch normal slicing";
+                                        print->process();
+                                    }
+                                    else
+                                        // Objects not found in the cache are sliced.
+                                        print->process(true);
+                                }
                                 else {
                                     print->process();
                                 }
@@ -2267,6 +2451,8 @@ int CLI::run(int argc, char **argv)
                                 // Run the post-processing scripts if defined.
                                 //run_post_process_scripts(outfile, print->full_print_config());
                                 BOOST_LOG_TRIVIAL(info) << "Slicing result exported to " << outfile << std::endl;
+                                if (m_job_hooks)
+                                    m_job_hooks->output(outfile);
                                 part_plate->update_slice_result_valid_state(true);
 #if defined(__linux__) || defined(__LINUX__)
                                 if (g_cli_callback_mgr.is_started()) {
@@ -2286,6 +2472,12 @@ int CLI::run(int argc, char **argv)
                                             fs::remove_all(plate_dir);
                                     }
                                 }
+                                if (!slice_cache_dir.empty() && printer_technology == ptFFF) {
+                                    int ret = print->export_cached_data(slice_cache_dir, false, true);
+                                    if (ret)
+                                        BOOST_LOG_TRIVIAL(warning) << "plate "<< index+1<< ": update slicing cache error, ret=" << ret;
+                                    Print::evict_cached_data(slice_cache_dir, slice_cache_size);
+                                }
                                 if (max_slicing_time_per_plate != 0) {
                                     end_time = (long long)Slic3r::Utils::get_current_time_utc();
                                     long long time_cost = end_time - start_time;
@@ -2447,6 +2639,7 @@ int CLI::run(int argc, char **argv)
         }
 
         if (need_regenerate_thumbnail || need_regenerate_top_thumbnail) {
+            std::lock_guard<std::mutex> gl_lock(g_cli_gl_mutex);
             std::vector<std::string> colors;
             if (filament_color) {
                 colors= filament_color->vserialize();
@@ -2870,6 +3063,8 @@ int CLI::run(int argc, char **argv)
             flush_and_exit(CLI_EXPORT_3MF_ERROR);
         }
         release_PlateData_list(plate_data_list);
+        if (m_job_hooks)
+            m_job_hooks->output(export_3mf_file);
         for (unsigned int i = 0; i < thumbnails.size(); i++)
             thumbnails[i]->reset();
         for (unsigned int i = 0; i < top_thumbnails.size(); i++)
@@ -2909,8 +3104,543 @@ int CLI::run(int argc, char **argv)
     return 0;
 }
 
+int CLI::run_job(const std::vector<std::string> &job_args, std::string &error_string)
+{
+    // argv[0] is skipped by the command line parser.
+    std::vector<std::string> args { SLIC3R_APP_KEY };
+    args.insert(args.end(), job_args.begin(), job_args.end());
+    std::vector<char*> argv;
+    for (std::string &arg : args)
+        argv.push_back(arg.data());
+    m_batch_job = true;
+    try {
+        return this->run(int(argv.size()), argv.data());
+    } catch (std::bad_alloc &) {
+        return CLI_OUT_OF_MEMORY;
+    } catch (std::exception &ex) {
+        error_string = ex.what();
+        return CLI_SLICING_ERROR;
+    }
+}
+
+//BBS: batch mode
+// The manifest lists the jobs to run, each job is a regular command line without the executable:
+// {
+//     "threads": 8,                       (optional, cores shared by all the jobs, default all the cores)
+//     "report": "report.json",            (optional, default <manifest>.report.json)
+//     "jobs": [
+//         { "name": "boat", "args": ["--slice", "2", "--load-settings", "machine.json;process.json", "--export-3mf", "boat_2.3mf"], "inputs": ["boat.3mf"] },
+//         ...
+//     ]
+// }
+// The jobs run concurrently inside one task arena, so the slicing of all the jobs together never uses more than the requested cores.
+// Setting files and meshes are loaded once for all the jobs referring to them.
+int CLI::run_batch(const std::string &manifest_path)
+{
+    struct BatchJob
+    {
+        std::string                 name;
+        std::vector<std::string>    args;
+        int                         return_code { CLI_SUCCESS };
+        std::string                 error_string;
+        double                      seconds { 0. };
+    };
+
+    nlohmann::json manifest;
+    std::vector<BatchJob> jobs;
+    try {
+        boost::nowide::ifstream ifs(manifest_path);
+        if (! ifs) {
+            boost::nowide::cerr << "can not open batch manifest " << manifest_path << std::endl;
+            return CLI_FILE_NOTFOUND;
+        }
+        ifs >> manifest;
+
+        for (const nlohmann::json &job_json : manifest.at("jobs")) {
+            BatchJob job;
+            job.name = job_json.value("name", "job_" + std::to_string(jobs.size() + 1));
+            if (job_json.contains("args"))
+                job.args = job_json["args"].get<std::vector<std::string>>();
+            if (job_json.contains("inputs"))
+                for (const std::string &input : job_json["inputs"].get<std::vector<std::string>>())
+                    job.args.push_back(input);
+            jobs.push_back(std::move(job));
+        }
+    } catch (std::exception &ex) {
+        boost::nowide::cerr << "invalid batch manifest " << manifest_path << ": " << ex.what() << std::endl;
+        return CLI_INVALID_PARAMS;
+    }
+
+    int threads = manifest.value("threads", 0);
+    if (threads <= 0)
+        threads = tbb::this_task_arena::max_concurrency();
+    std::string report_path = manifest.value("report", std::string());
+    if (report_path.empty())
+        report_path = boost::filesystem::path(manifest_path).replace_extension(".report.json").string();
+    BOOST_LOG_TRIVIAL(info) << boost::format("batch %1%: %2% jobs on %3% threads, report to %4%") % manifest_path % jobs.size() % threads % report_path;
+
+    g_cli_batch_caches_enabled = true;
+    auto batch_start = std::chrono::steady_clock::now();
+    tbb::task_arena arena(threads);
+    arena.execute([&jobs]() {
+        tbb::parallel_for(tbb::blocked_range<size_t>(0, jobs.size(), 1), [&jobs](const tbb::blocked_range<size_t> &range) {
+            for (size_t job_idx = range.begin(); job_idx < range.end(); ++ job_idx) {
+                BatchJob &job = jobs[job_idx];
+                BOOST_LOG_TRIVIAL(info) << boost::format("batch job %1% started") % job.name;
+                auto job_start = std::chrono::steady_clock::now();
+                CLI  cli;
+                // A job waiting for its nested parallel loops, for example while holding g_cli_gl_mutex, shall not pick up another job.
+                tbb::this_task_arena::isolate([&cli, &job]() { job.return_code = cli.run_job(job.args, job.error_string); });
+                job.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - job_start).count();
+                if (job.error_string.empty()) {
+                    auto error_it = cli_errors.find(job.return_code);
+                    job.error_string = (error_it != cli_errors.end()) ? error_it->second : "Unknown error";
+                }
+                BOOST_LOG_TRIVIAL(info) << boost::format("batch job %1% finished in %2%s, return %3%") % job.name % job.seconds % job.return_code;
+            }
+        });
+    });
+    g_cli_batch_caches_enabled = false;
+    {
+        std::lock_guard<std::mutex> lock(g_cli_cache_mutex);
+        g_cli_config_cache.clear();
+        g_cli_model_cache.clear();
+    }
+
+    nlohmann::json report;
+    size_t failed_count = 0;
+    report["manifest"] = manifest_path;
+    report["threads"]  = threads;
+    report["seconds"]  = std::chrono::duration<double>(std::chrono::steady_clock::now() - batch_start).count();
+    report["jobs"]     = nlohmann::json::array();
+    for (const BatchJob &job : jobs) {
+        nlohmann::json job_json;
+        job_json["name"]         = job.name;
+        job_json["args"]         = job.args;
+        job_json["return_code"]  = job.return_code;
+        job_json["error_string"] = job.error_string;
+        job_json["seconds"]      = job.seconds;
+        report["jobs"].push_back(std::move(job_json));
+        if (job.return_code != CLI_SUCCESS)
+            ++ failed_count;
+    }
+    report["failed"] = failed_count;
+
+    boost::nowide::ofstream ofs(report_path);
+    ofs << report.dump(4);
+    ofs.close();
+    if (! ofs) {
+        boost::nowide::cerr << "can not write batch report " << report_path << std::endl;
+        return CLI_ENVIRONMENT_ERROR;
+    }
+    BOOST_LOG_TRIVIAL(info) << boost::format("batch finished, %1% of %2% jobs failed") % failed_count % jobs.size();
+    boost::nowide::cout.flush();
+    boost::nowide::cerr.flush();
+
+    // The batch itself succeeded, the per job results are in the report.
+    return CLI_SUCCESS;
+}
+
+#if defined(__linux__) || defined(__LINUX__)
+//BBS: slicing daemon
+// Requests and replies are json messages, one per line, exchanged on a unix domain socket:
+//   {"type": "slice", "id": "job1", "inputs": ["boat.3mf"], "plate": 1, "args": ["--export-3mf", "boat_1.3mf"], "overrides": {"layer_height": "0.16"}}
+//       is answered by {"type": "queued"}, then by {"type": "progress", "percent", "message" or "warning"} while slicing,
+//       and finally by {"type": "result", "return_code", "error_string", "canceled", "outputs", "seconds"}, all of them carrying the job id.
+//       The progress messages without a warning are coalesced or dropped if the client does not read them fast enough.
+//   {"type": "cancel", "id": "job1"} cancels a queued or running job, which then replies its result as usual.
+//   {"type": "shutdown"} stops accepting requests, the daemon exits once the queued jobs are done.
+// The jobs are run one by one in the order they were received, each of them using all the cores.
+// The setting files and meshes loaded by the jobs stay cached for the following ones.
+namespace {
+
+struct DaemonConnection
+{
+    int                         fd { -1 };
+
+    explicit DaemonConnection(int fd) : fd(fd)
+    {
+        // A client not reading its replies must not stall the daemon forever.
+        timeval timeout { send_timeout_seconds, 0 };
+        ::setsockopt(fd, SOL_SOCKET, SO_SNDTIMEO, &timeout, sizeof(timeout));
+        m_writer = create_thread([this]() { this->write_messages(); });
+    }
+    // Writes the messages queued before closing the socket.
+    ~DaemonConnection()
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_closing = true;
+        }
+        m_condition.notify_one();
+        m_writer.join();
+        ::close(fd);
+    }
+
+    // Queues a reply, which is never dropped.
+    void send(const nlohmann::json &message) { this->enqueue(message.dump() + "\n", std::string()); }
+
+    // Queues a progress message of a job. A progress of the same job not written yet is replaced,
+    // and the message is dropped if the client does not keep up with reading, so the slicing never waits for the client.
+    void send_progress(const std::string &job_id, const nlohmann::json &message)
+    {
+        std::string line = message.dump() + "\n";
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_broken)
+            return;
+        for (Message &queued : m_messages)
+            if (queued.progress_of_job == job_id) {
+                queued.line = std::move(line);
+                return;
+            }
+        if (m_messages.size() < max_queued_progress) {
+            m_messages.push_back({ std::move(line), job_id });
+            m_condition.notify_one();
+        }
+    }
+
+private:
+    static constexpr int    send_timeout_seconds = 30;
+    static constexpr size_t max_queued_progress  = 64;
+
+    struct Message
+    {
+        std::string line;
+        // Id of the job for a progress message, which may be replaced or dropped.
+        std::string progress_of_job;
+    };
+
+    void enqueue(std::string &&line, std::string &&progress_of_job)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (! m_broken) {
+            m_messages.push_back({ std::move(line), std::move(progress_of_job) });
+            m_condition.notify_one();
+        }
+    }
+
+    void write_messages()
+    {
+        for (;;) {
+            std::string line;
+            {
+                std::unique_lock<std::mutex> lock(m_mutex);
+                m_condition.wait(lock, [this]() { return m_closing || ! m_messages.empty(); });
+                if (m_messages.empty())
+                    return;
+                line = std::move(m_messages.front().line);
+                m_messages.pop_front();
+            }
+            for (size_t written = 0; written < line.size();) {
+                ssize_t ret = ::send(fd, line.data() + written, line.size() - written, MSG_NOSIGNAL);
+                if (ret < 0 && errno == EINTR)
+                    continue;
+                if (ret <= 0) {
+                    BOOST_LOG_TRIVIAL(warning) << "daemon: can not write to client " << fd << ", dropping its messages";
+                    std::lock_guard<std::mutex> lock(m_mutex);
+                    m_broken = true;
+                    m_messages.clear();
+                    break;
+                }
+                written += size_t(ret);
+            }
+        }
+    }
+
+    std::mutex                  m_mutex;
+    std::condition_variable     m_condition;
+    std::deque<Message>         m_messages;
+    bool                        m_closing { false };
+    // Set once a write failed or timed out, the following messages are discarded.
+    bool                        m_broken { false };
+    boost::thread               m_writer;
+};
+
+struct DaemonJob
+{
+    std::string                         id;
+    std::vector<std::string>            args;
+    std::map<std::string, std::string>  overrides;
+    std::shared_ptr<DaemonConnection>   connection;
+
+    // Guards print and canceled, print is only set while the job is slicing a plate.
+    std::mutex                          mutex;
+    PrintBase                          *print { nullptr };
+    bool                                canceled { false };
+
+    void cancel()
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        canceled = true;
+        if (print)
+            print->cancel();
+    }
+    void attach_print(PrintBase *new_print)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        print = new_print;
+        if (print && canceled)
+            print->cancel();
+    }
+    bool is_canceled()
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        return canceled;
+    }
+};
+
+struct DaemonQueue
+{
+    std::mutex                                          mutex;
+    std::condition_variable                             condition;
+    std::deque<std::shared_ptr<DaemonJob>>              pending;
+    // Queued and running jobs by their id, for the cancellation.
+    std::map<std::string, std::shared_ptr<DaemonJob>>   active;
+    bool                                                exit { false };
+};
+
+} // namespace
+
+int CLI::run_daemon(const std::string &socket_path)
+{
+    sockaddr_un address {};
+    if (socket_path.size() >= sizeof(address.sun_path)) {
+        boost::nowide::cerr << "daemon socket path too long: " << socket_path << std::endl;
+        return CLI_INVALID_PARAMS;
+    }
+    address.sun_family = AF_UNIX;
+    std::strncpy(address.sun_path, socket_path.c_str(), sizeof(address.sun_path) - 1);
+
+    int listen_fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    ::unlink(socket_path.c_str());
+    // Only the user running the daemon may connect, the socket is made private before listening on it.
+    if (listen_fd < 0 || ::bind(listen_fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0 ||
+        ::chmod(socket_path.c_str(), S_IRUSR | S_IWUSR) != 0 || ::listen(listen_fd, 16) != 0) {
+        boost::nowide::cerr << "daemon can not listen on " << socket_path << ": " << std::strerror(errno) << std::endl;
+        if (listen_fd >= 0)
+            ::close(listen_fd);
+        return CLI_ENVIRONMENT_ERROR;
+    }
+    BOOST_LOG_TRIVIAL(info) << "daemon listening on " << socket_path;
+    g_cli_batch_caches_enabled = true;
+
+    DaemonQueue queue;
+
+    auto run_job = [](DaemonJob &job) {
+        nlohmann::json result { { "type", "result" }, { "id", job.id } };
+        std::vector<std::string> outputs;
+        int return_code = CLI_SUCCESS;
+        std::string error_string;
+        auto job_start = std::chrono::steady_clock::now();
+
+        JobHooks hooks;
+        hooks.status = [&job](const PrintBase::SlicingStatus &status) {
+            if (status.text.empty())
+                return;
+            nlohmann::json progress { { "type", "progress" }, { "id", job.id }, { "percent", status.percent } };
+            // The warnings are delivered, the other progress messages may be coalesced or dropped for a slow client.
+            if (status.warning_step >= 0) {
+                progress["warning"] = status.text;
+                job.connection->send(progress);
+            } else {
+                progress["message"] = status.text;
+                job.connection->send_progress(job.id, progress);
+            }
+        };
+        hooks.attach_print = [&job](PrintBase *print) { job.attach_print(print); };
+        hooks.output = [&outputs](const std::string &path) { outputs.push_back(path); };
+
+        if (! job.is_canceled()) {
+            CLI cli;
+            cli.m_job_hooks = &hooks;
+            try {
+                for (const auto &[opt_key, value] : job.overrides)
+                    cli.m_extra_config.set_deserialize_strict(opt_key, value);
+            } catch (std::exception &ex) {
+                return_code  = CLI_INVALID_PARAMS;
+                error_string = ex.what();
+            }
+            if (return_code == CLI_SUCCESS)
+                return_code = cli.run_job(job.args, error_string);
+        }
+        else
+            return_code = CLI_SLICING_ERROR;
+
+        if (error_string.empty()) {
+            auto error_it = cli_errors.find(return_code);
+            error_string = (error_it != cli_errors.end()) ? error_it->second : "Unknown error";
+        }
+        result["return_code"]  = return_code;
+        result["error_string"] = error_string;
+        result["canceled"]     = job.is_canceled();
+        result["outputs"]      = outputs;
+        result["seconds"]      = std::chrono::duration<double>(std::chrono::steady_clock::now() - job_start).count();
+        job.connection->send(result);
+    };
+
+    boost::thread worker = create_thread([&queue, &run_job]() {
+        for (;;) {
+            std::shared_ptr<DaemonJob> job;
+            {
+                std::unique_lock<std::mutex> lock(queue.mutex);
+                queue.condition.wait(lock, [&queue]() { return queue.exit || ! queue.pending.empty(); });
+                if (queue.pending.empty())
+                    return;
+                job = std::move(queue.pending.front());
+                queue.pending.pop_front();
+            }
+            BOOST_LOG_TRIVIAL(info) << "daemon: job " << job->id << " started";
+            run_job(*job);
+            BOOST_LOG_TRIVIAL(info) << "daemon: job " << job->id << " finished";
+            std::lock_guard<std::mutex> lock(queue.mutex);
+            queue.active.erase(job->id);
+        }
+    });
+
+    auto handle_request = [&queue, listen_fd](const std::shared_ptr<DaemonConnection> &connection, const std::string &line) {
+        nlohmann::json request;
+        try {
+            request = nlohmann::json::parse(line);
+            const std::string type = request.at("type").get<std::string>();
+            if (type == "slice") {
+                auto job = std::make_shared<DaemonJob>();
+                job->id         = request.at("id").get<std::string>();
+                job->connection = connection;
+                if (request.contains("args"))
+                    job->args = request["args"].get<std::vector<std::string>>();
+                if (request.contains("plate")) {
+                    job->args.emplace_back("--slice");
+                    job->args.emplace_back(std::to_string(request["plate"].get<int>()));
+                }
+                if (request.contains("overrides"))
+                    for (const auto &item : request["overrides"].items())
+                        job->overrides[item.key()] = item.value().is_string() ? item.value().get<std::string>() : item.value().dump();
+                if (request.contains("inputs"))
+                    for (const std::string &input : request["inputs"].get<std::vector<std::string>>())
+                        job->args.push_back(input);
+
+                std::lock_guard<std::mutex> lock(queue.mutex);
+                if (queue.exit)
+                    throw Slic3r::RuntimeError("daemon is shutting down");
+                if (! queue.active.emplace(job->id, job).second)
+                    throw Slic3r::RuntimeError("duplicate job id " + job->id);
+                queue.pending.push_back(job);
+                queue.condition.notify_one();
+                connection->send({ { "type", "queued" }, { "id", job->id }, { "position", queue.pending.size() } });
+            } else if (type == "cancel") {
+                const std::string id = request.at("id").get<std::string>();
+                std::shared_ptr<DaemonJob> job;
+                {
+                    std::lock_guard<std::mutex> lock(queue.mutex);
+                    auto it = queue.active.find(id);
+                    if (it != queue.active.end())
+                        job = it->second;
+                }
+                if (job)
+                    job->cancel();
+                connection->send({ { "type", "cancel" }, { "id", id }, { "found", job != nullptr } });
+            } else if (type == "shutdown") {
+                {
+                    std::lock_guard<std::mutex> lock(queue.mutex);
+                    queue.exit = true;
+                }
+                queue.condition.notify_one();
+                // Wakes up accept() in the main thread.
+                ::shutdown(listen_fd, SHUT_RDWR);
+                connection->send({ { "type", "shutdown" } });
+            } else
+                throw Slic3r::RuntimeError("unknown request type " + type);
+        } catch (std::exception &ex) {
+            nlohmann::json error { { "type", "error" }, { "message", ex.what() } };
+            if (request.is_object() && request.contains("id"))
+                error["id"] = request["id"];
+            connection->send(error);
+        }
+    };
+
+    struct ClientThread
+    {
+        boost::thread                       thread;
+        // Expires once the client disconnected and its jobs replied.
+        std::weak_ptr<DaemonConnection>     connection;
+    };
+    std::vector<ClientThread> clients;
+    for (;;) {
+        int client_fd = ::accept(listen_fd, nullptr, nullptr);
+        if (client_fd < 0) {
+            if (errno == EINTR)
+                continue;
+            break;
+        }
+        // Reap the threads of the clients gone.
+        clients.erase(std::remove_if(clients.begin(), clients.end(), [](ClientThread &client) {
+            if (! client.connection.expired())
+                return false;
+            client.thread.join();
+            return true;
+        }), clients.end());
+
+        auto connection = std::make_shared<DaemonConnection>(client_fd);
+        std::weak_ptr<DaemonConnection> client_connection = connection;
+        // The thread functor lives until the thread is joined, the connection is moved out of it to be released once the client disconnects.
+        boost::thread thread = create_thread([captured_connection = std::move(connection), &handle_request]() mutable {
+            std::shared_ptr<DaemonConnection> connection = std::move(captured_connection);
+            std::string buffer;
+            char chunk[4096];
+            for (;;) {
+                ssize_t len = ::recv(connection->fd, chunk, sizeof(chunk), 0);
+                if (len <= 0)
+                    break;
+                buffer.append(chunk, size_t(len));
+                for (size_t eol = buffer.find('\n'); eol != std::string::npos; eol = buffer.find('\n')) {
+                    std::string line = buffer.substr(0, eol);
+                    buffer.erase(0, eol + 1);
+                    if (! line.empty())
+                        handle_request(connection, line);
+                }
+            }
+        });
+        clients.push_back({ std::move(thread), std::move(client_connection) });
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        queue.exit = true;
+    }
+    queue.condition.notify_one();
+    worker.join();
+    // All the jobs replied their results, disconnect the clients.
+    for (ClientThread &client : clients) {
+        if (std::shared_ptr<DaemonConnection> connection = client.connection.lock())
+            ::shutdown(connection->fd, SHUT_RDWR);
+        client.thread.join();
+    }
+    ::close(listen_fd);
+    ::unlink(socket_path.c_str());
+
+    g_cli_batch_caches_enabled = false;
+    {
+        std::lock_guard<std::mutex> lock(g_cli_cache_mutex);
+        g_cli_config_cache.clear();
+        g_cli_model_cache.clear();
+    }
+    BOOST_LOG_TRIVIAL(info) << "daemon on " << socket_path << " stopped";
+    return CLI_SUCCESS;
+}
+#else
+int CLI::run_daemon(const std::string &socket_path)
+{
+    boost::nowide::cerr << "--daemon is only supported on linux" << std::endl;
+    return CLI_UNSUPPORTED_OPERATION;
+}
+#endif
+
 bool CLI::setup(int argc, char **argv)
 {
+    // Batch jobs only parse their command line, the process has been set up by the batch run already.
+    if (m_batch_job)
+        return this->parse_cli(argc, argv);
+
     // Detect the operating system flavor after SLIC3R_LOGLEVEL is set.
     detect_platform();
 
@@ -2961,6 +3691,11 @@ bool CLI::setup(int argc, char **argv)
     set_local_dir((path_resources / "i18n").string());
     set_sys_shapes_dir((path_resources / "shapes").string());
 
+    return this->parse_cli(argc, argv);
+}
+
+bool CLI::parse_cli(int argc, char **argv)
+{
     // Parse all command line options into a DynamicConfig.
     // If any option is unsupported, print usage and abort immediately.
     t_config_option_keys opt_order;
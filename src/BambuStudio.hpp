@@ -3,6 +3,9 @@
 
 #include "libslic3r/Config.hpp"
 #include "libslic3r/Model.hpp"
+#include "libslic3r/PrintBase.hpp"
+
+#include <functional>
 
 namespace Slic3r {
 
@@ -20,8 +23,29 @@ namespace IO {
 class CLI {
 public:
     int run(int argc, char **argv);
+    //BBS: run all the jobs of a batch manifest inside this process, see --batch
+    int run_batch(const std::string &manifest_path);
+    //BBS: serve slicing requests on a unix domain socket until asked to shut down, see --daemon
+    int run_daemon(const std::string &socket_path);
+
+    // Hooks of a job run on behalf of the slicing daemon.
+    struct JobHooks
+    {
+        // Receives the slicing progress of the job.
+        PrintBase::status_callback_type             status;
+        // Called with the print about to be processed and with nullptr once it is done, so that the job may be canceled.
+        std::function<void(PrintBase*)>             attach_print;
+        // Receives the path of every file exported by the job.
+        std::function<void(const std::string&)>     output;
+    };
 
 private:
+    // Runs a job of run_batch() or run_daemon() with this CLI. Both modes map the exceptions escaping the job to the same return codes.
+    int run_job(const std::vector<std::string> &job_args, std::string &error_string);
+
+    // Set for the CLI instances created by run_batch() and run_daemon(), the process level setup has been done already.
+    bool                        m_batch_job { false };
+    JobHooks                   *m_job_hooks { nullptr };
     DynamicPrintAndCLIConfig    m_config;
     DynamicPrintConfig			m_print_config;
     DynamicPrintConfig          m_extra_config;
@@ -31,6 +55,8 @@ private:
     std::vector<Model>          m_models;
 
     bool setup(int argc, char **argv);
+    // Parses the command line into m_config, m_input_files, m_actions and m_transforms.
+    bool parse_cli(int argc, char **argv);
 
     /// Prints usage of the CLI.
     void print_help(bool include_print_options = false, PrinterTechnology printer_technology = ptAny) const;
@@ -7,6 +7,7 @@
 #define slic3r_AABBTreeIndirect_hpp_
 
 #include <algorithm>
+#include <array>
 #include <limits>
 #include <type_traits>
 #include <vector>
@@ -746,6 +747,119 @@ inline bool intersect_ray_first_hit(
         ray_intersector, size_t(0), std::numeric_limits<Scalar>::infinity(), hit);
 }
 
+// Find first intersections of a packet of up to PacketSize rays sharing a single origin with indexed triangle set.
+// The packet traverses the AABB tree at once: The tree nodes are fetched once per packet and the ray-box tests of all rays
+// of the packet are evaluated over arrays of floats, which the compiler vectorizes into 4 or 8 wide SSE / AVX lanes.
+// The ray-triangle test is calculated in double precision for the rays hitting the leaf box, as intersect_ray_first_hit() does.
+// Returns a bit mask of the rays hitting the triangle set, hits[i] is valid for the rays with the i-th bit set.
+template<size_t PacketSize, typename VertexType, typename IndexedFaceType, typename TreeType>
+inline uint32_t intersect_ray_packet_first_hits(
+	// Indexed triangle set - 3D vertices.
+	const std::vector<VertexType> 		&vertices,
+	// Indexed triangle set - triangular faces, references to vertices.
+	const std::vector<IndexedFaceType> 	&faces,
+	// AABBTreeIndirect::Tree over vertices & faces, bounding boxes built with the accuracy of vertices.
+	const TreeType 						&tree,
+	// Common origin of the rays.
+	const Vec3d 						&origin,
+	// Directions of the rays, num_rays <= PacketSize.
+	const Vec3d 						*dirs,
+	size_t 								 num_rays,
+	// First intersections of the rays with the indexed triangle set.
+	std::array<igl::Hit, PacketSize> 	&hits,
+	// Epsilon for the ray-triangle intersection, it should be proportional to an average triangle edge length.
+	const double 						 eps = 0.000001)
+{
+	static_assert(PacketSize <= 32, "The hit mask holds 32 rays at most");
+	assert(num_rays <= PacketSize);
+	if (tree.empty() || num_rays == 0)
+		return 0;
+
+	// Ray packet in the structure of arrays layout. Unused lanes get an empty ray interval, thus they never hit a box.
+	// The rays parallel to an axis get a zero inverse direction along that axis and are tested against the slab explicitly,
+	// multiplying the infinite inverse direction by a box side touching the origin would produce NaN.
+	const Vec3f origin_f = origin.cast<float>();
+	alignas(32) float invdir[3][PacketSize];
+	alignas(32) int   parallel[3][PacketSize];
+	alignas(32) float max_t[PacketSize];
+	Vec3f 			  mean_dir = Vec3f::Zero();
+	for (size_t i = 0; i < num_rays; ++ i)
+		mean_dir += dirs[i].cast<float>();
+	for (size_t i = 0; i < PacketSize; ++ i) {
+		const bool active = i < num_rays;
+		for (int axis = 0; axis < 3; ++ axis) {
+			parallel[axis][i] = active && dirs[i][axis] == 0.;
+			invdir[axis][i]   = ! active ? 1.f : parallel[axis][i] ? 0.f : float(1. / dirs[i][axis]);
+		}
+		max_t[i] = active ? std::numeric_limits<float>::infinity() : -std::numeric_limits<float>::infinity();
+	}
+
+	// Depth first traversal. The depth of a balanced tree over 2^62 entities fits the stack.
+	static constexpr size_t stack_capacity = 64;
+	size_t   stack[stack_capacity];
+	size_t   stack_size = 0;
+	uint32_t hit_mask   = 0;
+	stack[stack_size ++] = 0;
+	while (stack_size > 0) {
+		const size_t node_idx = stack[-- stack_size];
+		const auto  &node     = tree.node(node_idx);
+		assert(node.is_valid());
+		const float  bmin[3]  = { float(node.bbox.min().x()) - origin_f.x(), float(node.bbox.min().y()) - origin_f.y(), float(node.bbox.min().z()) - origin_f.z() };
+		const float  bmax[3]  = { float(node.bbox.max().x()) - origin_f.x(), float(node.bbox.max().y()) - origin_f.y(), float(node.bbox.max().z()) - origin_f.z() };
+		// Ray interval inside a slab of the box. A ray parallel to the slab is either inside the slab for any t or outside for any t.
+		const bool   inside[3] = { bmin[0] <= 0.f && bmax[0] >= 0.f, bmin[1] <= 0.f && bmax[1] >= 0.f, bmin[2] <= 0.f && bmax[2] >= 0.f };
+		const float  inf       = std::numeric_limits<float>::infinity();
+		// Branchless slab test of all lanes, kept free of bit manipulation so that it is vectorized.
+		alignas(32) int lane_hit[PacketSize];
+		for (size_t i = 0; i < PacketSize; ++ i) {
+			float tmin = 0.f;
+			float tmax = max_t[i];
+			for (int axis = 0; axis < 3; ++ axis) {
+				const float t1 = bmin[axis] * invdir[axis][i];
+				const float t2 = bmax[axis] * invdir[axis][i];
+				tmin = std::max(tmin, parallel[axis][i] ? (inside[axis] ? -inf : inf) : std::min(t1, t2));
+				tmax = std::min(tmax, parallel[axis][i] ? (inside[axis] ? inf : -inf) : std::max(t1, t2));
+			}
+			lane_hit[i] = tmin <= tmax;
+		}
+		uint32_t mask = 0;
+		for (size_t i = 0; i < PacketSize; ++ i)
+			mask |= uint32_t(lane_hit[i]) << i;
+		if (mask == 0)
+			continue;
+		if (node.is_leaf()) {
+			const auto face = faces[node.idx];
+			for (size_t i = 0; i < num_rays; ++ i)
+				if (mask & (uint32_t(1) << i)) {
+					double t, u, v;
+					if (detail::intersect_triangle(origin, dirs[i], vertices[face(0)], vertices[face(1)], vertices[face(2)], t, u, v, eps) &&
+						t > 0. && float(t) < max_t[i]) {
+						hits[i]   = igl::Hit { int(node.idx), -1, float(u), float(v), float(t) };
+						max_t[i]  = float(t);
+						hit_mask |= uint32_t(1) << i;
+					}
+				}
+		} else if (stack_size + 2 > stack_capacity) {
+			// The tree is deeper than the stack, which a tree built by build_aabb_tree_over_indexed_triangle_set() never is.
+			// Trace the rays one by one by the recursive traversal instead of failing.
+			hit_mask = 0;
+			for (size_t i = 0; i < num_rays; ++ i)
+				if (intersect_ray_first_hit(vertices, faces, tree, origin, dirs[i], hits[i], eps))
+					hit_mask |= uint32_t(1) << i;
+			return hit_mask;
+		} else {
+			// Visit the child closer along the mean direction of the packet first to shorten the rays early.
+			size_t left  = TreeType::left_child_idx(node_idx);
+			size_t right = TreeType::right_child_idx(node_idx);
+			if ((tree.node(left).bbox.center() - tree.node(right).bbox.center()).template cast<float>().dot(mean_dir) > 0.f)
+				std::swap(left, right);
+			stack[stack_size ++] = right;
+			stack[stack_size ++] = left;
+		}
+	}
+	return hit_mask;
+}
+
 // Find all intersections of a ray with indexed triangle set.
 // Intersection test is calculated with the accuracy of VectorType::Scalar
 // even if the triangle mesh and the AABB Tree are built with floats.
@@ -314,6 +314,10 @@ void AppConfig::set_defaults()
         set("backup_interval", "10");
     }
 
+    if (get("fast_save_3mf").empty()) {
+        set_bool("fast_save_3mf", false);
+    }
+
     if (get("curr_bed_type").empty()) {
         set("curr_bed_type", "1");
     }
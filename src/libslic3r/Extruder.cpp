@@ -92,6 +92,29 @@ double Extruder::unretract()
     }
 }
 
+Extruder::State Extruder::state() const
+{
+    // BBS
+    if (m_share_extruder)
+        return { m_share_E, m_absolute_E, m_share_retracted, 0. };
+    else
+        return { m_E, m_absolute_E, m_retracted, m_restart_extra };
+}
+
+void Extruder::set_state(const State &state)
+{
+    // BBS
+    if (m_share_extruder) {
+        m_share_E         = state.E;
+        m_share_retracted = state.retracted;
+    } else {
+        m_E             = state.E;
+        m_retracted     = state.retracted;
+        m_restart_extra = state.restart_extra;
+    }
+    m_absolute_E = state.absolute_E;
+}
+
 // Used filament volume in mm^3.
 double Extruder::extruded_volume() const
 {
@@ -37,6 +37,17 @@ public:
     void   reset_E() { m_E = 0.; m_share_E = 0.; }
     double e_per_mm(double mm3_per_mm) const { return mm3_per_mm * m_e_per_mm3; }
     double e_per_mm3() const { return m_e_per_mm3; }
+
+    // BBS: State of the extruder axis, saved and restored by GCodeWriter::state() and GCodeWriter::set_state().
+    struct State
+    {
+        double E;
+        double absolute_E;
+        double retracted;
+        double restart_extra;
+    };
+    State  state() const;
+    void   set_state(const State &state);
     // Used filament volume in mm^3.
     double extruded_volume() const;
     // Used filament length in mm.
@@ -292,12 +292,16 @@ void ExtrusionLoop::split_at(const Point &point, bool prefer_non_overhang, const
 void ExtrusionLoop::clip_end(double distance, ExtrusionPaths* paths) const
 {
     *paths = this->paths;
-    
-    while (distance > 0 && !paths->empty()) {
-        ExtrusionPath &last = paths->back();
+    Slic3r::clip_end(*paths, distance);
+}
+
+void clip_end(ExtrusionPaths &paths, double distance)
+{
+    while (distance > 0 && !paths.empty()) {
+        ExtrusionPath &last = paths.back();
         double len = last.length();
         if (len <= distance) {
-            paths->pop_back();
+            paths.pop_back();
             distance -= len;
         } else {
             last.polyline.clip_end(distance);
@@ -2,6 +2,7 @@
 #define slic3r_ExtrusionEntity_hpp_
 
 #include "libslic3r.h"
+#include "ExtrusionEntityArena.hpp"
 #include "Polygon.hpp"
 #include "Polyline.hpp"
 
@@ -98,6 +99,9 @@ public:
     // Create a new object, initialize it with this object using the move semantics.
     virtual ExtrusionEntity* clone_move() = 0;
     virtual ~ExtrusionEntity() {}
+    // BBS: entities created while generating a layer live in the arena of the layer, see ExtrusionEntityArena.
+    static void* operator new(size_t size) { return ExtrusionEntityArena::allocate_entity(size); }
+    static void  operator delete(void *ptr) { ExtrusionEntityArena::free_entity(ptr); }
     virtual void reverse() = 0;
     virtual const Point& first_point() const = 0;
     virtual const Point& last_point() const = 0;
@@ -432,6 +436,9 @@ private:
     ExtrusionLoopRole m_loop_role;
 };
 
+// Remove the distance from the end of the chained paths.
+void clip_end(ExtrusionPaths &paths, double distance);
+
 inline void extrusion_paths_append(ExtrusionPaths &dst, Polylines &polylines, ExtrusionRole role, double mm3_per_mm, float width, float height)
 {
     dst.reserve(dst.size() + polylines.size());
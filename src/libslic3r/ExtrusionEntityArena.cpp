@@ -0,0 +1,138 @@
+#include "ExtrusionEntityArena.hpp"
+
+#include <cassert>
+#include <cstdint>
+#include <new>
+
+#include <boost/log/trivial.hpp>
+
+namespace Slic3r {
+
+// Every entity is preceded by a header pointing to its chunk, nullptr for the entities allocated on the heap.
+// The header is padded to keep the entities aligned the same way as ::operator new() aligns them.
+static constexpr size_t entity_alignment = alignof(std::max_align_t);
+static constexpr size_t header_size      = (sizeof(void*) + entity_alignment - 1) / entity_alignment * entity_alignment;
+// Size of a chunk including its bookkeeping, big enough for hundreds of paths.
+static constexpr size_t chunk_size       = 64 * 1024;
+
+static inline size_t align_up(size_t size) { return (size + entity_alignment - 1) / entity_alignment * entity_alignment; }
+
+struct ExtrusionEntityArena::Chunk
+{
+    // nullptr once the arena was destroyed while the chunk still held live entities.
+    ExtrusionEntityArena *arena;
+    Chunk                *prev;
+    Chunk                *next;
+    // Bytes of data() handed out.
+    size_t                used;
+    // Number of entities not deleted yet.
+    size_t                live;
+
+    static constexpr size_t data_offset() { return (sizeof(Chunk) + entity_alignment - 1) / entity_alignment * entity_alignment; }
+    static constexpr size_t capacity()    { return chunk_size - data_offset(); }
+    char*                   data()        { return reinterpret_cast<char*>(this) + data_offset(); }
+};
+
+static thread_local ExtrusionEntityArena *s_current_arena = nullptr;
+
+ExtrusionEntityArena::Scope::Scope(ExtrusionEntityArena &arena) : m_previous(s_current_arena)
+{
+    s_current_arena = &arena;
+}
+
+ExtrusionEntityArena::Scope::~Scope()
+{
+    s_current_arena = m_previous;
+}
+
+ExtrusionEntityArena::~ExtrusionEntityArena()
+{
+    // The owner of the arena shall delete its entities first. If it did not, the chunks holding live entities are detached
+    // from the arena and kept until their last entity is deleted, see free_entity().
+    size_t num_live = 0;
+    for (Chunk *chunk = m_current; chunk != nullptr;) {
+        Chunk *prev = chunk->prev;
+        if (chunk->live == 0)
+            ::operator delete(chunk);
+        else {
+            num_live += chunk->live;
+            chunk->arena = nullptr;
+            chunk->prev  = nullptr;
+            chunk->next  = nullptr;
+        }
+        chunk = prev;
+    }
+    if (num_live > 0)
+        BOOST_LOG_TRIVIAL(error) << "ExtrusionEntityArena destroyed with " << num_live << " live extrusion entities, their chunks are kept until the entities are deleted";
+}
+
+void* ExtrusionEntityArena::allocate(size_t size)
+{
+    if (size > Chunk::capacity())
+        return nullptr;
+    if (m_current == nullptr || m_current->used + size > Chunk::capacity()) {
+        Chunk *chunk = static_cast<Chunk*>(::operator new(chunk_size));
+        chunk->arena = this;
+        chunk->prev  = m_current;
+        chunk->next  = nullptr;
+        chunk->used  = 0;
+        chunk->live  = 0;
+        if (m_current != nullptr)
+            m_current->next = chunk;
+        m_current = chunk;
+        ++ m_num_chunks;
+        ++ m_num_chunks_allocated;
+    }
+    char *block = m_current->data() + m_current->used;
+    *reinterpret_cast<Chunk**>(block) = m_current;
+    m_current->used += size;
+    ++ m_current->live;
+    ++ m_num_entities;
+    return block;
+}
+
+void ExtrusionEntityArena::release(Chunk *chunk)
+{
+    assert(chunk->arena == this && chunk->live == 0);
+    if (chunk == m_current) {
+        // Rewind, the chunk is being filled.
+        chunk->used = 0;
+        return;
+    }
+    if (chunk->prev != nullptr)
+        chunk->prev->next = chunk->next;
+    // Not the last chunk, thus next is valid.
+    chunk->next->prev = chunk->prev;
+    ::operator delete(chunk);
+    -- m_num_chunks;
+}
+
+void* ExtrusionEntityArena::allocate_entity(size_t size)
+{
+    size = header_size + align_up(size);
+    char *block = s_current_arena ? static_cast<char*>(s_current_arena->allocate(size)) : nullptr;
+    if (block == nullptr) {
+        block = static_cast<char*>(::operator new(size));
+        *reinterpret_cast<Chunk**>(block) = nullptr;
+    }
+    return block + header_size;
+}
+
+void ExtrusionEntityArena::free_entity(void *ptr)
+{
+    if (ptr == nullptr)
+        return;
+    char  *block = static_cast<char*>(ptr) - header_size;
+    Chunk *chunk = *reinterpret_cast<Chunk**>(block);
+    if (chunk == nullptr)
+        ::operator delete(block);
+    else if (-- chunk->live == 0) {
+        if (chunk->arena != nullptr)
+            chunk->arena->release(chunk);
+        else
+            // The last entity of a chunk which outlived its arena.
+            ::operator delete(chunk);
+    }
+}
+
+} // namespace Slic3r
@@ -0,0 +1,64 @@
+#ifndef slic3r_ExtrusionEntityArena_hpp_
+#define slic3r_ExtrusionEntityArena_hpp_
+
+#include <cstddef>
+
+namespace Slic3r {
+
+// BBS: Monotonic arena backing the ExtrusionEntity objects of a single Layer.
+// Perimeter and infill generation allocate tens of millions of small polymorphic extrusion entities,
+// each of them used to be a separate heap allocation released one by one when the layer was invalidated.
+// While an ExtrusionEntityArena::Scope is active on a thread, ExtrusionEntity::operator new bumps a pointer
+// in the chunks of the arena instead and operator delete only decrements the live count of the chunk.
+// A chunk is returned to the heap once all its entities are deleted, all chunks are returned when the arena
+// is destroyed together with its layer. The chunks of entities outliving the arena are kept until the entities are deleted.
+// The arena is not thread safe, a layer is expected to be generated by a single thread at a time.
+// Entities allocated outside of any scope (G-code export, support generation...) are allocated on the heap.
+class ExtrusionEntityArena
+{
+public:
+    ExtrusionEntityArena() = default;
+    ~ExtrusionEntityArena();
+    ExtrusionEntityArena(const ExtrusionEntityArena &) = delete;
+    ExtrusionEntityArena& operator=(const ExtrusionEntityArena &) = delete;
+
+    // Install the arena as the target of ExtrusionEntity allocations of the current thread,
+    // the previous arena is restored when the scope ends.
+    class Scope
+    {
+    public:
+        explicit Scope(ExtrusionEntityArena &arena);
+        ~Scope();
+        Scope(const Scope &) = delete;
+        Scope& operator=(const Scope &) = delete;
+    private:
+        ExtrusionEntityArena *m_previous;
+    };
+
+    // Number of entities allocated from the arena over its lifetime.
+    size_t entities_allocated() const { return m_num_entities; }
+    // Number of chunks allocated on the heap over the lifetime of the arena.
+    size_t chunks_allocated() const { return m_num_chunks_allocated; }
+    // Number of chunks held by the arena now.
+    size_t chunks() const { return m_num_chunks; }
+
+    // Entry points of ExtrusionEntity::operator new / operator delete.
+    static void* allocate_entity(size_t size);
+    static void  free_entity(void *ptr);
+
+private:
+    struct Chunk;
+
+    void* allocate(size_t size);
+    void  release(Chunk *chunk);
+
+    // Chunks in a double linked list, m_current is the last one, which is being filled.
+    Chunk  *m_current              { nullptr };
+    size_t  m_num_chunks           { 0 };
+    size_t  m_num_chunks_allocated { 0 };
+    size_t  m_num_entities         { 0 };
+};
+
+} // namespace Slic3r
+
+#endif // slic3r_ExtrusionEntityArena_hpp_
@@ -0,0 +1,46 @@
+#include "ExtrusionTable.hpp"
+#include "ExtrusionEntityCollection.hpp"
+
+namespace Slic3r {
+
+void ExtrusionTable::clear()
+{
+    roles.clear();
+    mm3_per_mm.clear();
+    widths.clear();
+    heights.clear();
+    no_extrusion.clear();
+    point_offsets.assign(1, 0);
+    points.clear();
+}
+
+void ExtrusionTable::append(const ExtrusionPath &path)
+{
+    roles.emplace_back(path.role());
+    mm3_per_mm.emplace_back(float(path.mm3_per_mm));
+    widths.emplace_back(path.width);
+    heights.emplace_back(path.height);
+    no_extrusion.emplace_back(path.is_force_no_extrusion());
+    points.insert(points.end(), path.polyline.points.begin(), path.polyline.points.end());
+    point_offsets.emplace_back(uint32_t(points.size()));
+}
+
+void ExtrusionTable::append(const ExtrusionEntity &entity)
+{
+    if (entity.is_collection())
+        this->append(static_cast<const ExtrusionEntityCollection&>(entity));
+    else if (const ExtrusionPath *path = dynamic_cast<const ExtrusionPath*>(&entity))
+        this->append(*path);
+    else if (const ExtrusionMultiPath *multipath = dynamic_cast<const ExtrusionMultiPath*>(&entity))
+        this->append(multipath->paths);
+    else if (const ExtrusionLoop *loop = dynamic_cast<const ExtrusionLoop*>(&entity))
+        this->append(loop->paths);
+}
+
+void ExtrusionTable::append(const ExtrusionEntityCollection &collection)
+{
+    for (const ExtrusionEntity *entity : collection.entities)
+        this->append(*entity);
+}
+
+} // namespace Slic3r
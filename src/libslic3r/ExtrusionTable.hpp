@@ -0,0 +1,49 @@
+#ifndef slic3r_ExtrusionTable_hpp_
+#define slic3r_ExtrusionTable_hpp_
+
+#include "libslic3r.h"
+#include "ExtrusionEntity.hpp"
+
+#include <cstdint>
+#include <vector>
+
+namespace Slic3r {
+
+class ExtrusionEntityCollection;
+
+// BBS: Flattened, contiguous copy of the extrusion paths of a layer, structure of arrays.
+// The conflict checker flattens the ExtrusionEntity trees of all the layers in parallel for the duration of the check
+// and reads plain arrays instead of chasing the pointers of the nested collections and copying the paths out of them.
+// The tables are not kept with the layers, G-code generation walks the entity trees.
+// Row i is a single ExtrusionPath, its points are points[point_offsets[i], point_offsets[i + 1]).
+class ExtrusionTable
+{
+public:
+    std::vector<ExtrusionRole> roles;
+    std::vector<float>         mm3_per_mm;
+    std::vector<float>         widths;
+    std::vector<float>         heights;
+    // Paths not extruding (ExtrusionPath::is_force_no_extrusion()).
+    std::vector<uint8_t>       no_extrusion;
+    // size() + 1 offsets into points.
+    std::vector<uint32_t>      point_offsets { 0 };
+    Points                     points;
+
+    size_t size()  const { return roles.size(); }
+    bool   empty() const { return roles.empty(); }
+    void   clear();
+
+    const Point* points_begin(size_t idx) const { return points.data() + point_offsets[idx]; }
+    const Point* points_end(size_t idx)   const { return points.data() + point_offsets[idx + 1]; }
+    size_t       num_points(size_t idx)   const { return point_offsets[idx + 1] - point_offsets[idx]; }
+
+    void append(const ExtrusionPath &path);
+    void append(const ExtrusionPaths &paths) { for (const ExtrusionPath &path : paths) this->append(path); }
+    // Flattens collections, loops and multi-paths into their paths.
+    void append(const ExtrusionEntity &entity);
+    void append(const ExtrusionEntityCollection &collection);
+};
+
+} // namespace Slic3r
+
+#endif // slic3r_ExtrusionTable_hpp_
@@ -405,6 +405,7 @@ void export_group_fills_to_svg(const char *path, const std::vector<SurfaceFill>
 // friend to Layer
 void Layer::make_fills(FillAdaptive::Octree* adaptive_fill_octree, FillAdaptive::Octree* support_fill_octree, FillLightning::Generator* lightning_generator)
 {
+	ExtrusionEntityArena::Scope arena_scope(m_extrusion_arena);
 	for (LayerRegion *layerm : m_regions)
 		layerm->fills.clear();
 
@@ -516,6 +517,7 @@ void Layer::make_fills(FillAdaptive::Octree* adaptive_fill_octree, FillAdaptive:
 // Create ironing extrusions over top surfaces.
 void Layer::make_ironing()
 {
+	ExtrusionEntityArena::Scope arena_scope(m_extrusion_arena);
 	// LayerRegion::slices contains surfaces marked with SurfaceType.
 	// Here we want to collect top surfaces extruded with the same extruder.
 	// A surface will be ironed with the same extruder to not contaminate the print with another material leaking from the nozzle.
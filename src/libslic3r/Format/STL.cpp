@@ -6,6 +6,15 @@
 
 #include <string>
 
+#include <boost/filesystem/path.hpp>
+#include <boost/iostreams/device/mapped_file.hpp>
+#include <boost/log/trivial.hpp>
+#include <boost/nowide/convert.hpp>
+#include <boost/predef/other/endian.h>
+
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_reduce.h>
+
 #ifdef _WIN32
 #define DIR_SEPARATOR '\\'
 #else
@@ -14,6 +23,89 @@
 
 namespace Slic3r {
 
+std::optional<bool> stl_open_binary_mapped(stl_file *stl, const char *path, ImportstlProgressFn stlFn)
+{
+#if BOOST_ENDIAN_BIG_BYTE
+    // The facets are copied from the file as they are, which only works on little endian machines.
+    return std::nullopt;
+#else
+    boost::iostreams::mapped_file_source file;
+    try {
+#ifdef _WIN32
+        file.open(boost::filesystem::path(boost::nowide::widen(path)));
+#else
+        file.open(boost::filesystem::path(path));
+#endif
+    } catch (const std::exception &ex) {
+        BOOST_LOG_TRIVIAL(info) << "stl_open_binary_mapped: Couldn't map " << path << " into memory: " << ex.what();
+        return std::nullopt;
+    }
+    const char  *data      = file.data();
+    const size_t file_size = file.size();
+    if (file_size < HEADER_SIZE + 128)
+        return std::nullopt;
+    // Same test for a binary file as stl_open() does.
+    bool is_binary = false;
+    for (size_t i = HEADER_SIZE; i < HEADER_SIZE + 128 && ! is_binary; ++ i)
+        is_binary = (unsigned char)data[i] > 127;
+    if (! is_binary)
+        return std::nullopt;
+    if ((file_size - HEADER_SIZE) % SIZEOF_STL_FACET != 0 || file_size < STL_MIN_FILE_SIZE) {
+        BOOST_LOG_TRIVIAL(error) << "stl_open_binary_mapped: The file " << path << " has the wrong size.";
+        return false;
+    }
+
+    stl->clear();
+    stl->stats.type = binary;
+    memcpy(stl->stats.header, data, LABEL_SIZE);
+    stl->stats.header[LABEL_SIZE] = '\0';
+    const uint32_t num_facets = uint32_t((file_size - HEADER_SIZE) / SIZEOF_STL_FACET);
+    uint32_t       header_num_facets;
+    memcpy(&header_num_facets, data + LABEL_SIZE, sizeof(uint32_t));
+    if (num_facets != header_num_facets)
+        BOOST_LOG_TRIVIAL(info) << "stl_open_binary_mapped: Warning: File size doesn't match number of facets in the header: " << path;
+    stl->stats.number_of_facets    = num_facets;
+    stl->stats.original_num_facets = num_facets;
+    stl_allocate(stl);
+
+    // Decode the facets in parallel, report progress the same number of times stl_open() does.
+    static constexpr const uint32_t num_steps = 5;
+    const char *facets = data + HEADER_SIZE;
+    using BBox = std::pair<stl_vertex, stl_vertex>;
+    BBox bbox { stl_vertex::Constant(std::numeric_limits<float>::max()), stl_vertex::Constant(- std::numeric_limits<float>::max()) };
+    for (uint32_t step = 0; step < num_steps; ++ step) {
+        if (stlFn) {
+            bool cancel = false;
+            stlFn(step * (num_facets / num_steps + 1), num_facets, cancel);
+            if (cancel)
+                return false;
+        }
+        bbox = tbb::parallel_reduce(
+            tbb::blocked_range<uint32_t>(uint64_t(num_facets) * step / num_steps, uint64_t(num_facets) * (step + 1) / num_steps), bbox,
+            [stl, facets](const tbb::blocked_range<uint32_t> &range, BBox range_bbox) {
+                for (uint32_t i = range.begin(); i < range.end(); ++ i) {
+                    stl_facet &facet = stl->facet_start[i];
+                    memcpy(&facet, facets + size_t(i) * SIZEOF_STL_FACET, SIZEOF_STL_FACET);
+                    for (const stl_vertex &v : facet.vertex) {
+                        range_bbox.first  = range_bbox.first.cwiseMin(v);
+                        range_bbox.second = range_bbox.second.cwiseMax(v);
+                    }
+                }
+                return range_bbox;
+            },
+            [](const BBox &l, const BBox &r) { return BBox(l.first.cwiseMin(r.first), l.second.cwiseMax(r.second)); });
+    }
+
+    const stl_facet &first = stl->facet_start.front();
+    stl->stats.min               = bbox.first;
+    stl->stats.max               = bbox.second;
+    stl->stats.shortest_edge     = (first.vertex[1] - first.vertex[0]).cwiseAbs().maxCoeff();
+    stl->stats.size              = stl->stats.max - stl->stats.min;
+    stl->stats.bounding_diameter = stl->stats.size.norm();
+    return true;
+#endif
+}
+
 bool load_stl(const char *path, Model *model, const char *object_name_in, ImportstlProgressFn stlFn)
 {
     TriangleMesh mesh;
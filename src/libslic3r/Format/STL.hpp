@@ -3,12 +3,18 @@
 
 #include <admesh/stl.h>
 
+#include <optional>
+
 namespace Slic3r {
 
 class Model;
 class TriangleMesh;
 class ModelObject;
 
+// Read a binary STL file mapped into memory, decoding the facets in parallel.
+// Returns std::nullopt if the file is not a binary STL file or if it could not be mapped, in that case the caller shall fall back to stl_open().
+extern std::optional<bool> stl_open_binary_mapped(stl_file *stl, const char *path, ImportstlProgressFn stlFn = nullptr);
+
 // Load an STL file into a provided model.
 extern bool load_stl(const char *path, Model *model, const char *object_name = nullptr, ImportstlProgressFn stlFn = nullptr);
 
@@ -14,6 +14,8 @@
 
 #include "bbs_3mf.hpp"
 
+#include <atomic>
+#include <chrono>
 #include <limits>
 #include <stdexcept>
 #include <iomanip>
@@ -37,6 +39,7 @@
 
 namespace pt = boost::property_tree;
 
+#include <tbb/parallel_for.h>
 #include <tbb/parallel_reduce.h>
 
 #include <expat.h>
@@ -503,6 +506,315 @@ bool bbs_is_valid_object_type(const std::string& type)
     return false;
 }
 
+// Fast path for parsing the <mesh> elements of a model file, which make up most of a large 3MF file.
+// Only the subset of XML produced by 3MF writers for meshes is accepted: <vertices> and <triangles> elements containing
+// <vertex> and <triangle> elements with attributes only, without character references. If anything else is encountered,
+// parsing fails and the caller shall parse the model file with expat.
+struct BBS3MFTriangle
+{
+    Slic3r::Vec3i indices { 0, 0, 0 };
+    std::string   custom_supports;
+    std::string   custom_seam;
+    std::string   mmu_segmentation;
+    std::string   face_property;
+};
+using BBS3MFMeshes = std::vector<std::pair<std::vector<Slic3r::Vec3f>, std::vector<BBS3MFTriangle>>>;
+
+static inline const char* bbs_skip_whitespaces(const char *p, const char *end)
+{
+    while (p != end && (*p == ' ' || *p == '\t' || *p == '\r' || *p == '\n'))
+        ++ p;
+    return p;
+}
+
+// Does the text at p start with an element tag of the given name?
+static inline bool bbs_starts_with_tag(const char *p, const char *end, const char *tag, size_t tag_len)
+{
+    if (size_t(end - p) < tag_len + 2 || *p != '<' || ::strncmp(p + 1, tag, tag_len) != 0)
+        return false;
+    char c = p[tag_len + 1];
+    return c == ' ' || c == '\t' || c == '\r' || c == '\n' || c == '/' || c == '>';
+}
+
+// Parse the attributes of an element, p points just after the element name.
+// Returns pointer after the closing "/>" or after the closing "></tag>", nullptr on error.
+template<typename AttributeFn>
+static const char* bbs_parse_element_attributes(const char *p, const char *end, const char *tag, size_t tag_len, AttributeFn attribute_fn)
+{
+    for (;;) {
+        p = bbs_skip_whitespaces(p, end);
+        if (p == end)
+            return nullptr;
+        if (*p == '/')
+            return (end - p >= 2 && p[1] == '>') ? p + 2 : nullptr;
+        if (*p == '>') {
+            p = bbs_skip_whitespaces(p + 1, end);
+            if (size_t(end - p) < tag_len + 3 || p[0] != '<' || p[1] != '/' || ::strncmp(p + 2, tag, tag_len) != 0)
+                return nullptr;
+            p = bbs_skip_whitespaces(p + 2 + tag_len, end);
+            return (p != end && *p == '>') ? p + 1 : nullptr;
+        }
+        const char *name = p;
+        while (p != end && *p != '=' && *p != ' ' && *p != '\t' && *p != '\r' && *p != '\n' && *p != '>' && *p != '/')
+            ++ p;
+        const char *name_end = p;
+        p = bbs_skip_whitespaces(p, end);
+        if (p == end || *p != '=' || name == name_end)
+            return nullptr;
+        p = bbs_skip_whitespaces(p + 1, end);
+        if (p == end || (*p != '"' && *p != '\''))
+            return nullptr;
+        const char  quote = *p ++;
+        const char *value = p;
+        for (; p != end && *p != quote; ++ p)
+            if (*p == '&' || *p == '<')
+                return nullptr;
+        if (p == end)
+            return nullptr;
+        attribute_fn(name, name_end, value, p);
+        ++ p;
+    }
+}
+
+static inline bool bbs_attribute_name_equals(const char *name, const char *name_end, const char *key)
+{
+    size_t len = ::strlen(key);
+    return size_t(name_end - name) == len && ::strncmp(name, key, len) == 0;
+}
+
+// Parse a sequence of elements named tag, splitting the text into chunks parsed in parallel.
+// Each element starts as a copy of empty before its attributes are parsed.
+template<typename Element, typename AttributeFn>
+static bool bbs_parse_elements_parallel(const char *begin, const char *end, const char *tag, const Element &empty, std::vector<Element> &out, AttributeFn attribute_fn)
+{
+    static constexpr const size_t chunk_size = 1024 * 1024;
+    const size_t tag_len = ::strlen(tag);
+    // Chunk boundaries are aligned to the start of an element. As character references and '<' inside attribute values are rejected,
+    // any '<' not followed by '/' starts an element.
+    std::vector<const char*> boundaries { begin };
+    while (size_t(end - boundaries.back()) > chunk_size) {
+        const char *p = boundaries.back() + chunk_size;
+        while ((p = std::find(p, end, '<')) != end && p + 1 != end && p[1] == '/')
+            ++ p;
+        if (p == end || p + 1 == end)
+            break;
+        boundaries.emplace_back(p);
+    }
+    boundaries.emplace_back(end);
+
+    std::vector<std::vector<Element>> chunks(boundaries.size() - 1);
+    std::atomic<bool>                 failed { false };
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, chunks.size(), 1), [&boundaries, &chunks, &failed, tag, tag_len, &empty, &attribute_fn](const tbb::blocked_range<size_t> &range) {
+        for (size_t i = range.begin(); i < range.end() && ! failed; ++ i) {
+            std::vector<Element> &elements = chunks[i];
+            const char           *chunk_end = boundaries[i + 1];
+            elements.reserve((chunk_end - boundaries[i]) / 48);
+            for (const char *p = bbs_skip_whitespaces(boundaries[i], chunk_end); p != chunk_end; p = bbs_skip_whitespaces(p, chunk_end)) {
+                if (! bbs_starts_with_tag(p, chunk_end, tag, tag_len)) {
+                    failed = true;
+                    break;
+                }
+                Element &element = elements.emplace_back(empty);
+                p = bbs_parse_element_attributes(p + 1 + tag_len, chunk_end, tag, tag_len,
+                    [&element, &attribute_fn](const char *name, const char *name_end, const char *value, const char *value_end) { attribute_fn(element, name, name_end, value, value_end); });
+                if (p == nullptr) {
+                    failed = true;
+                    break;
+                }
+            }
+        }
+    });
+    if (failed)
+        return false;
+    size_t num_elements = 0;
+    for (const std::vector<Element> &chunk : chunks)
+        num_elements += chunk.size();
+    out.reserve(out.size() + num_elements);
+    for (std::vector<Element> &chunk : chunks)
+        out.insert(out.end(), std::make_move_iterator(chunk.begin()), std::make_move_iterator(chunk.end()));
+    return true;
+}
+
+// Find the content of a container element (<vertices> or <triangles>) starting at p, possibly preceded by whitespaces.
+// Returns pointer after the closing tag, nullptr if not found.
+static const char* bbs_find_container_element(const char *p, const char *end, const char *tag, const char *&content_begin, const char *&content_end)
+{
+    const size_t tag_len = ::strlen(tag);
+    p = bbs_skip_whitespaces(p, end);
+    if (! bbs_starts_with_tag(p, end, tag, tag_len))
+        return nullptr;
+    p = std::find(p, end, '>');
+    if (p == end || p[-1] == '/')
+        return nullptr;
+    content_begin = ++ p;
+    std::string closing_tag = std::string("</") + tag;
+    const char *closing = std::search(p, end, closing_tag.begin(), closing_tag.end());
+    if (closing == end)
+        return nullptr;
+    content_end = closing;
+    p = bbs_skip_whitespaces(closing + closing_tag.size(), end);
+    return (p != end && *p == '>') ? p + 1 : nullptr;
+}
+
+// Parse the content of all <mesh> elements of the model file xml. The vertex coordinates are not scaled by the unit factor.
+// The segments of the model file around the content of the <mesh> elements are returned to be parsed by expat.
+static bool bbs_parse_mesh_elements(const char *xml, const char *xml_end, std::vector<std::pair<const char*, const char*>> &segments, BBS3MFMeshes &meshes)
+{
+    static const std::string comment_tag = "<!--";
+    static const std::string cdata_tag   = "<![CDATA[";
+    static const std::string mesh_tag    = std::string("<") + MESH_TAG;
+    static const std::string mesh_end    = std::string("</") + MESH_TAG + ">";
+    // A <mesh> text inside a comment or a CDATA section would confuse the search for the mesh elements.
+    if (std::search(xml, xml_end, comment_tag.begin(), comment_tag.end()) != xml_end ||
+        std::search(xml, xml_end, cdata_tag.begin(), cdata_tag.end()) != xml_end)
+        return false;
+
+    segments.clear();
+    meshes.clear();
+    const char *p             = xml;
+    const char *segment_begin = xml;
+    for (;;) {
+        const char *mesh = std::search(p, xml_end, mesh_tag.begin(), mesh_tag.end());
+        if (mesh == xml_end)
+            break;
+        if (! bbs_starts_with_tag(mesh, xml_end, MESH_TAG, mesh_tag.size() - 1)) {
+            // Another element starting with "<mesh", for example <mesh_stat>.
+            p = mesh + 1;
+            continue;
+        }
+        const char *mesh_content = std::find(mesh, xml_end, '>');
+        if (mesh_content == xml_end)
+            return false;
+        ++ mesh_content;
+        if (mesh_content[-2] == '/') {
+            // Empty <mesh/> element, expat reports its end as well.
+            meshes.emplace_back();
+            p = mesh_content;
+            continue;
+        }
+        segments.emplace_back(segment_begin, mesh_content);
+        auto &[vertices, triangles] = meshes.emplace_back();
+        const char *vertices_begin  = nullptr, *vertices_end  = nullptr;
+        const char *triangles_begin = nullptr, *triangles_end = nullptr;
+        p = mesh_content;
+        for (;;) {
+            p = bbs_skip_whitespaces(p, xml_end);
+            if (std::string_view(p, std::min<size_t>(xml_end - p, mesh_end.size())) == mesh_end)
+                break;
+            const char *next = nullptr;
+            if (vertices_begin == nullptr)
+                next = bbs_find_container_element(p, xml_end, VERTICES_TAG, vertices_begin, vertices_end);
+            if (next == nullptr && triangles_begin == nullptr)
+                next = bbs_find_container_element(p, xml_end, TRIANGLES_TAG, triangles_begin, triangles_end);
+            if (next == nullptr)
+                // Unexpected element inside <mesh>.
+                return false;
+            p = next;
+        }
+        // The next segment starts with the closing tag of the mesh.
+        segment_begin = p;
+        p += mesh_end.size();
+        if (vertices_begin != nullptr &&
+            ! bbs_parse_elements_parallel(vertices_begin, vertices_end, VERTEX_TAG, Slic3r::Vec3f(Slic3r::Vec3f::Zero()), vertices,
+                [](Slic3r::Vec3f &v, const char *name, const char *name_end, const char *value, const char *value_end) {
+                    // Missing values are set equal to ZERO, same as bbs_get_attribute_value_float().
+                    int axis = name_end - name != 1 ? -1 : *name == 'x' ? 0 : *name == 'y' ? 1 : *name == 'z' ? 2 : -1;
+                    if (axis != -1)
+                        fast_float::from_chars(value, value_end, v(axis));
+                }))
+            return false;
+        if (triangles_begin != nullptr &&
+            ! bbs_parse_elements_parallel(triangles_begin, triangles_end, TRIANGLE_TAG, BBS3MFTriangle(), triangles,
+                [](BBS3MFTriangle &t, const char *name, const char *name_end, const char *value, const char *value_end) {
+                    if (bbs_attribute_name_equals(name, name_end, V1_ATTR))
+                        boost::spirit::qi::parse(value, value_end, boost::spirit::qi::int_, t.indices(0));
+                    else if (bbs_attribute_name_equals(name, name_end, V2_ATTR))
+                        boost::spirit::qi::parse(value, value_end, boost::spirit::qi::int_, t.indices(1));
+                    else if (bbs_attribute_name_equals(name, name_end, V3_ATTR))
+                        boost::spirit::qi::parse(value, value_end, boost::spirit::qi::int_, t.indices(2));
+                    else if (bbs_attribute_name_equals(name, name_end, CUSTOM_SUPPORTS_ATTR))
+                        t.custom_supports.assign(value, value_end);
+                    else if (bbs_attribute_name_equals(name, name_end, CUSTOM_SEAM_ATTR))
+                        t.custom_seam.assign(value, value_end);
+                    else if (bbs_attribute_name_equals(name, name_end, MMU_SEGMENTATION_ATTR))
+                        t.mmu_segmentation.assign(value, value_end);
+                    else if (bbs_attribute_name_equals(name, name_end, FACE_PROPERTY_ATTR))
+                        t.face_property.assign(value, value_end);
+                }))
+            return false;
+    }
+    segments.emplace_back(segment_begin, xml_end);
+    return true;
+}
+
+// Memory reserved by the model files parsed in memory, shared by the object files loaded in parallel.
+static std::atomic<size_t> s_model_in_memory_reserved{ 0 };
+
+// Reserves memory for parsing a model file in memory: its buffer plus the meshes parsed out of it, about twice its size.
+// All the model files parsed in memory at once shall not take more than half of the available memory.
+class BBSModelMemoryReservation
+{
+public:
+    explicit BBSModelMemoryReservation(size_t uncompressed_size) {
+        const size_t available_memory = Slic3r::available_physical_memory();
+        const size_t memory_limit     = available_memory == 0 ? size_t(512 * 1024 * 1024) : available_memory / 2;
+        const size_t size             = 2 * uncompressed_size;
+        size_t       reserved         = s_model_in_memory_reserved.load();
+        do {
+            if (size > memory_limit || reserved > memory_limit - size)
+                return;
+        } while (! s_model_in_memory_reserved.compare_exchange_weak(reserved, reserved + size));
+        m_size = size;
+    }
+    ~BBSModelMemoryReservation() { s_model_in_memory_reserved -= m_size; }
+    BBSModelMemoryReservation(const BBSModelMemoryReservation&) = delete;
+    BBSModelMemoryReservation& operator=(const BBSModelMemoryReservation&) = delete;
+
+    bool reserved() const { return m_size > 0; }
+
+private:
+    size_t m_size{ 0 };
+};
+
+// Parse a model file by expat. If the model file fits into memory, its mesh elements are parsed by the fast path into meshes,
+// and the rest of the model file is parsed by expat, otherwise the model file is streamed to expat as a whole.
+// Returns false if the model file could not be extracted into memory, then the caller shall stream it to expat.
+// Throws Slic3r::FileIOError on parsing error.
+static bool bbs_parse_model_in_memory(mz_zip_archive &archive, const mz_zip_archive_file_stat &stat, XML_Parser parser, BBS3MFMeshes &meshes,
+    const std::function<bool()> &parse_error, const std::function<const char*()> &parse_error_message)
+{
+    meshes.clear();
+    // Released with the buffer, when the meshes are parsed.
+    BBSModelMemoryReservation reservation(size_t(stat.m_uncomp_size));
+    if (! reservation.reserved())
+        return false;
+    std::string xml(size_t(stat.m_uncomp_size), 0);
+    if (mz_zip_reader_extract_to_mem(&archive, stat.m_file_index, xml.data(), xml.size(), 0) == 0)
+        return false;
+    // Expat parses the model file without the mesh content segment by segment, out of the same buffer.
+    std::vector<std::pair<const char*, const char*>> segments;
+    if (! bbs_parse_mesh_elements(xml.data(), xml.data() + xml.size(), segments, meshes)) {
+        BOOST_LOG_TRIVIAL(info) << "Fast path for parsing meshes of " << stat.m_filename << " not applicable, parsing the model file with expat";
+        meshes.clear();
+        segments.assign(1, { xml.data(), xml.data() + xml.size() });
+    }
+    static constexpr const size_t max_chunk = 64 * 1024 * 1024;
+    for (size_t i = 0; i < segments.size(); ++ i) {
+        const char *p = segments[i].first;
+        do {
+            size_t n          = std::min(max_chunk, size_t(segments[i].second - p));
+            bool   last_chunk = i + 1 == segments.size() && p + n == segments[i].second;
+            if (! XML_Parse(parser, p, int(n), last_chunk ? 1 : 0) || parse_error()) {
+                char error_buf[1024];
+                ::sprintf(error_buf, "Error (%s) while parsing '%s' at line %d", parse_error_message(), stat.m_filename, (int)XML_GetCurrentLineNumber(parser));
+                throw Slic3r::FileIOError(error_buf);
+            }
+            p += n;
+        } while (p != segments[i].second);
+    }
+    return true;
+}
+
 namespace Slic3r {
 
 void PlateData::parse_filament_info(GCodeProcessorResult *result)
@@ -773,6 +1085,9 @@ void PlateData::parse_filament_info(GCodeProcessorResult *result)
             std::string obj_curr_metadata_name;
             std::string obj_curr_characters;
             float object_unit_factor;
+            // Meshes parsed by the fast path, assigned to the objects in the order of the <mesh> elements.
+            BBS3MFMeshes parsed_meshes;
+            size_t       next_parsed_mesh { 0 };
             int object_current_color_group{-1};
             std::map<int, std::string> object_group_id_to_color;
             bool is_bbl_3mf { false };
@@ -905,6 +1220,7 @@ void PlateData::parse_filament_info(GCodeProcessorResult *result)
         bool m_load_model = false;
         bool m_load_aux = false;
         bool m_load_config = false;
+        bool m_load_lazy = false;
         // backup & restore
         bool m_load_restore = false;
         std::string m_backup_path;
@@ -934,6 +1250,9 @@ void PlateData::parse_filament_info(GCodeProcessorResult *result)
         std::string m_parse_error_message;
         Model* m_model;
         float m_unit_factor;
+        // Meshes parsed by the fast path, assigned to the objects in the order of the <mesh> elements.
+        BBS3MFMeshes m_parsed_meshes;
+        size_t       m_next_parsed_mesh { 0 };
         CurrentObject* m_curr_object{nullptr};
         IdToCurrentObjectMap m_current_objects;
         IndexToPathMap       m_index_paths;
@@ -1047,6 +1366,8 @@ void PlateData::parse_filament_info(GCodeProcessorResult *result)
         bool _handle_start_color(const char **attributes, unsigned int num_attributes);
         bool _handle_end_color();
 
+        // Move a mesh parsed by the fast path into geometry, scaling the vertices by unit_factor.
+        static void _assign_parsed_mesh(Geometry &geometry, float unit_factor, std::vector<Vec3f> &vertices, std::vector<BBS3MFTriangle> &triangles);
         bool _handle_start_mesh(const char** attributes, unsigned int num_attributes);
         bool _handle_end_mesh();
 
@@ -1194,6 +1515,7 @@ void PlateData::parse_filament_info(GCodeProcessorResult *result)
         m_load_aux = strategy & LoadStrategy::LoadAuxiliary;
         m_load_restore = strategy & LoadStrategy::Restore;
         m_load_config = strategy & LoadStrategy::LoadConfig;
+        m_load_lazy = (strategy & LoadStrategy::LazyPlateData) && !m_load_restore;
         m_model = &model;
         m_unit_factor = 1.0f;
         m_curr_object = nullptr;
@@ -1751,8 +2073,9 @@ void PlateData::parse_filament_info(GCodeProcessorResult *result)
                         _extract_auxiliary_file_from_archive(archive, stat, model);
                 }
                 else if (!dont_load_config && boost::algorithm::istarts_with(name, METADATA_DIR) && boost::algorithm::iends_with(name, GCODE_EXTENSION)) {
-                    //load gcode files
-                    _extract_file_from_archive(archive, stat);
+                    //load gcode files, left in the archive until a plate needs them when loading lazily
+                    if (!m_load_lazy)
+                        _extract_file_from_archive(archive, stat);
                 }
                 else if (!dont_load_config && boost::algorithm::istarts_with(name, METADATA_DIR) && boost::algorithm::iends_with(name, THUMBNAIL_EXTENSION)) {
                     //BBS parsing pattern thumbnail and plate thumbnails
@@ -2048,6 +2371,10 @@ void PlateData::parse_filament_info(GCodeProcessorResult *result)
             plate_data_list[it->first-1]->plate_name  = it->second->plate_name;
             plate_data_list[it->first-1]->obj_inst_map = it->second->obj_inst_map;
             plate_data_list[it->first-1]->gcode_file = (m_load_restore || it->second->gcode_file.empty()) ? it->second->gcode_file : m_backup_path + "/" + it->second->gcode_file;
+            if (m_load_lazy && !dont_load_config && !it->second->gcode_file.empty()) {
+                plate_data_list[it->first-1]->gcode_file_in_3mf = it->second->gcode_file;
+                plate_data_list[it->first-1]->source_3mf = filename;
+            }
             plate_data_list[it->first-1]->gcode_prediction = it->second->gcode_prediction;
             plate_data_list[it->first-1]->gcode_weight = it->second->gcode_weight;
             plate_data_list[it->first-1]->toolpath_outside = it->second->toolpath_outside;
@@ -2275,6 +2602,11 @@ void PlateData::parse_filament_info(GCodeProcessorResult *result)
 
         try
         {
+            m_next_parsed_mesh = 0;
+            if (bbs_parse_model_in_memory(archive, stat, m_xml_parser, m_parsed_meshes,
+                    [this]() { return this->parse_error(); }, [this]() { return this->parse_error_message(); }))
+                return true;
+
             mz_file_write_func callback = [](void* pOpaque, mz_uint64 file_ofs, const void* pBuf, size_t n)->size_t {
                 CallbackData* data = (CallbackData*)pOpaque;
                 if (!XML_Parse(data->parser, (const char*)pBuf, (int)n, (file_ofs + n == data->stat.m_uncomp_size) ? 1 : 0) || data->importer.parse_error()) {
@@ -3322,9 +3654,37 @@ void PlateData::parse_filament_info(GCodeProcessorResult *result)
         return true;
     }
 
+    void _BBS_3MF_Importer::_assign_parsed_mesh(Geometry &geometry, float unit_factor, std::vector<Vec3f> &vertices, std::vector<BBS3MFTriangle> &triangles)
+    {
+        geometry.reset();
+        geometry.face_properties.clear();
+        geometry.vertices = std::move(vertices);
+        for (Vec3f &v : geometry.vertices)
+            v = unit_factor * v;
+        geometry.triangles.reserve(triangles.size());
+        geometry.custom_supports.reserve(triangles.size());
+        geometry.custom_seam.reserve(triangles.size());
+        geometry.mmu_segmentation.reserve(triangles.size());
+        geometry.face_properties.reserve(triangles.size());
+        for (BBS3MFTriangle &t : triangles) {
+            geometry.triangles.emplace_back(t.indices);
+            geometry.custom_supports.emplace_back(std::move(t.custom_supports));
+            geometry.custom_seam.emplace_back(std::move(t.custom_seam));
+            geometry.mmu_segmentation.emplace_back(std::move(t.mmu_segmentation));
+            geometry.face_properties.emplace_back(std::move(t.face_property));
+        }
+        triangles.clear();
+        triangles.shrink_to_fit();
+    }
+
     bool _BBS_3MF_Importer::_handle_end_mesh()
     {
-        // do nothing
+        // assign the geometry parsed by the fast path
+        if (m_next_parsed_mesh < m_parsed_meshes.size()) {
+            auto &[vertices, triangles] = m_parsed_meshes[m_next_parsed_mesh ++];
+            if (m_curr_object)
+                _assign_parsed_mesh(m_curr_object->geometry, m_unit_factor, vertices, triangles);
+        }
         return true;
     }
 
@@ -4794,7 +5154,12 @@ void PlateData::parse_filament_info(GCodeProcessorResult *result)
 
     bool _BBS_3MF_Importer::ObjectImporter::_handle_object_end_mesh()
     {
-        // do nothing
+        // assign the geometry parsed by the fast path
+        if (next_parsed_mesh < parsed_meshes.size()) {
+            auto &[vertices, triangles] = parsed_meshes[next_parsed_mesh ++];
+            if (current_object)
+                _assign_parsed_mesh(current_object->geometry, object_unit_factor, vertices, triangles);
+        }
         return true;
     }
 
@@ -5073,6 +5438,11 @@ void PlateData::parse_filament_info(GCodeProcessorResult *result)
 
         try
         {
+            next_parsed_mesh = 0;
+            if (bbs_parse_model_in_memory(archive, stat, object_xml_parser, parsed_meshes,
+                    [this]() { return this->object_parse_error(); }, [this]() { return this->object_parse_error_message(); }))
+                return true;
+
             mz_file_write_func callback = [](void* pOpaque, mz_uint64 file_ofs, const void* pBuf, size_t n)->size_t {
                 CallbackData* data = (CallbackData*)pOpaque;
                 if (!XML_Parse(data->parser, (const char*)pBuf, (int)n, (file_ofs + n == data->stat.m_uncomp_size) ? 1 : 0) || data->importer.object_parse_error()) {
@@ -5167,6 +5537,7 @@ void PlateData::parse_filament_info(GCodeProcessorResult *result)
         bool m_skip_auxiliary { false };    // skip normal axuiliary files
         bool m_use_loaded_id { false };        // whether to use loaded id for identify_id
         bool m_share_mesh { false };        // whether to share mesh between objects
+        int  m_compression_level { MZ_DEFAULT_COMPRESSION }; // deflate level of the archive entries
         std::string m_thumbnail_middle = PRINTER_THUMBNAIL_MIDDLE_FILE;
         std::string m_thumbnail_small  = PRINTER_THUMBNAIL_SMALL_FILE;
         std::map<void const *, std::pair<ObjectData*, ModelVolume const *>> m_shared_meshes;
@@ -5197,6 +5568,8 @@ void PlateData::parse_filament_info(GCodeProcessorResult *result)
             int export_plate_idx = -1);
 
         bool _add_file_to_archive(mz_zip_archive& archive, const std::string & path_in_zip, const std::string & file_path);
+        // Add an in-memory entry compressed with m_compression_level, log the time spent compressing it.
+        bool _add_entry_to_archive(mz_zip_archive& archive, const char* path_in_zip, const void* data, size_t size) const;
 
         bool _add_content_types_file_to_archive(mz_zip_archive& archive);
 
@@ -5260,6 +5633,7 @@ void PlateData::parse_filament_info(GCodeProcessorResult *result)
         m_skip_auxiliary = store_params.strategy & SaveStrategy::SkipAuxiliary;
         m_share_mesh       = store_params.strategy & SaveStrategy::ShareMesh;
         m_from_backup_save = store_params.strategy & SaveStrategy::Backup;
+        m_compression_level = (store_params.strategy & SaveStrategy::FastSave) ? MZ_BEST_SPEED : MZ_DEFAULT_COMPRESSION;
 
         m_use_loaded_id = store_params.strategy & SaveStrategy::UseLoadedId;
 
@@ -5685,8 +6059,7 @@ void PlateData::parse_filament_info(GCodeProcessorResult *result)
                     for (int j = 0; j < 16; j++) { sprintf(&md5_str[j * 2], "%02X", (unsigned int) digest[j]); }
                     plate_data->gcode_file_md5 = std::string(md5_str);
                     std::string target_file    = (boost::format("Metadata/plate_%1%.gcode.md5") % (plate_data->plate_index + 1)).str();
-                    if (!mz_zip_writer_add_mem(&archive, target_file.c_str(), (const void *) plate_data->gcode_file_md5.c_str(), plate_data->gcode_file_md5.length(),
-                                               MZ_DEFAULT_COMPRESSION)) {
+                    if (!_add_entry_to_archive(archive, target_file.c_str(), (const void *) plate_data->gcode_file_md5.c_str(), plate_data->gcode_file_md5.length())) {
                         BOOST_LOG_TRIVIAL(error) << __FUNCTION__ << ":" << __LINE__
                                                  << boost::format(", store  gcode md5 to 3mf's %1%,  length %2%, failed\n") %target_file %plate_data->gcode_file_md5.length();
                         return false;
@@ -5786,11 +6159,11 @@ void PlateData::parse_filament_info(GCodeProcessorResult *result)
         auto end = nocomp_exts + sizeof(nocomp_exts) / sizeof(nocomp_exts[0]);
         bool nocomp = std::find_if(nocomp_exts, end, [&path_in_zip](auto & ext) { return boost::algorithm::ends_with(path_in_zip, ext); }) != end;
 #if WRITE_ZIP_LANGUAGE_ENCODING
-        bool result = mz_zip_writer_add_file(&archive, path_in_zip.c_str(), encode_path(src_file_path.c_str()).c_str(), NULL, 0, nocomp ? MZ_NO_COMPRESSION : MZ_DEFAULT_LEVEL);
+        bool result = mz_zip_writer_add_file(&archive, path_in_zip.c_str(), encode_path(src_file_path.c_str()).c_str(), NULL, 0, nocomp ? MZ_NO_COMPRESSION : m_compression_level);
 #else
         std::string native_path = encode_path(path_in_zip.c_str());
         std::string extra = ZipUnicodePathExtraField::encode(path_in_zip, native_path);
-        bool result = mz_zip_writer_add_file_ex(&archive, native_path.c_str(), encode_path(src_file_path.c_str()).c_str(), NULL, 0, nocomp ? MZ_ZIP_FLAG_ASCII_FILENAME : MZ_DEFAULT_COMPRESSION,
+        bool result = mz_zip_writer_add_file_ex(&archive, native_path.c_str(), encode_path(src_file_path.c_str()).c_str(), NULL, 0, nocomp ? MZ_ZIP_FLAG_ASCII_FILENAME : m_compression_level,
                 extra.c_str(), extra.length(), extra.c_str(), extra.length());
 #endif
         if (!result) {
@@ -5802,6 +6175,15 @@ void PlateData::parse_filament_info(GCodeProcessorResult *result)
         return result;
     }
 
+    bool _BBS_3MF_Exporter::_add_entry_to_archive(mz_zip_archive& archive, const char* path_in_zip, const void* data, size_t size) const
+    {
+        auto start  = std::chrono::steady_clock::now();
+        bool result = mz_zip_writer_add_mem(&archive, path_in_zip, data, size, m_compression_level);
+        BOOST_LOG_TRIVIAL(debug) << __FUNCTION__ << ":" << __LINE__ << boost::format(", add %1% to archive, %2% bytes, level %3%, %4% ms") % path_in_zip % size % m_compression_level %
+            std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count();
+        return result;
+    }
+
     bool _BBS_3MF_Exporter::_add_content_types_file_to_archive(mz_zip_archive& archive)
     {
         std::stringstream stream;
@@ -5815,7 +6197,7 @@ void PlateData::parse_filament_info(GCodeProcessorResult *result)
 
         std::string out = stream.str();
 
-        if (!mz_zip_writer_add_mem(&archive, CONTENT_TYPES_FILE.c_str(), (const void*)out.data(), out.length(), MZ_DEFAULT_COMPRESSION)) {
+        if (!_add_entry_to_archive(archive, CONTENT_TYPES_FILE.c_str(), (const void*)out.data(), out.length())) {
             add_error("Unable to add content types file to archive");
             BOOST_LOG_TRIVIAL(error) << __FUNCTION__ << ":" << __LINE__ << boost::format(", Unable to add content types file to archive\n");
             return false;
@@ -5872,7 +6254,7 @@ void PlateData::parse_filament_info(GCodeProcessorResult *result)
         std::string out = j.dump();
 
         std::string json_file_name = (boost::format(PATTERN_CONFIG_FILE_FORMAT) % (index + 1)).str();
-        if (!mz_zip_writer_add_mem(&archive, json_file_name.c_str(), (const void*)out.data(), out.length(), MZ_DEFAULT_COMPRESSION)) {
+        if (!_add_entry_to_archive(archive, json_file_name.c_str(), (const void*)out.data(), out.length())) {
             add_error("Unable to add json file to archive");
             BOOST_LOG_TRIVIAL(error) << __FUNCTION__ << ":" << __LINE__ << boost::format(", Unable to add json file to archive\n");
             return false;
@@ -5926,7 +6308,7 @@ void PlateData::parse_filament_info(GCodeProcessorResult *result)
 
         std::string out = stream.str();
 
-        if (!mz_zip_writer_add_mem(&archive, from.empty() ? RELATIONSHIPS_FILE.c_str() : from.c_str(), (const void*)out.data(), out.length(), MZ_DEFAULT_COMPRESSION)) {
+        if (!_add_entry_to_archive(archive, from.empty() ? RELATIONSHIPS_FILE.c_str() : from.c_str(), (const void*)out.data(), out.length())) {
             add_error("Unable to add relationships file to archive");
             BOOST_LOG_TRIVIAL(error) << __FUNCTION__ << ":" << __LINE__ << boost::format(", Unable to add relationships file to archive\n");
             return false;
@@ -5975,9 +6357,9 @@ void PlateData::parse_filament_info(GCodeProcessorResult *result)
                 // GH issue #6193.
                 (uint64_t(1) << 32) - 1,
 #if WRITE_ZIP_LANGUAGE_ENCODING
-            nullptr, nullptr, 0, MZ_DEFAULT_LEVEL, nullptr, 0, nullptr, 0)) {
+            nullptr, nullptr, 0, m_compression_level, nullptr, 0, nullptr, 0)) {
 #else
-            nullptr, nullptr, 0, MZ_DEFAULT_COMPRESSION, extra.c_str(), extra.length(), extra.c_str(), extra.length())) {
+            nullptr, nullptr, 0, m_compression_level, extra.c_str(), extra.length(), extra.c_str(), extra.length())) {
 #endif
             add_error("Unable to add model file to archive");
             BOOST_LOG_TRIVIAL(error) << __FUNCTION__ << ":" << __LINE__ << boost::format(", Unable to add model file to archive\n");
@@ -6221,6 +6603,7 @@ void PlateData::parse_filament_info(GCodeProcessorResult *result)
                     ObjectToObjectDataMap objects_data2;
                     objects_data2.insert(*iter);
                     auto & object = *iter->second.object;
+                    auto start = std::chrono::steady_clock::now();
                     mz_zip_archive archive;
                     mz_zip_zero_struct(&archive);
                     mz_zip_writer_init_heap(&archive, 0, 1024 * 1024);
@@ -6237,6 +6620,8 @@ void PlateData::parse_filament_info(GCodeProcessorResult *result)
                         mz_zip_writer_add_from_zip_reader(main, &archive, 0);
                     }
                     mz_zip_reader_end(&archive);
+                    BOOST_LOG_TRIVIAL(debug) << __FUNCTION__ << ":" << __LINE__ << boost::format(", add %1% to archive, %2% compressed bytes, level %3%, %4% ms") % object_paths[i] % pSize % m_compression_level %
+                        std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count();
                 }
             });
         }
@@ -6615,7 +7000,7 @@ void PlateData::parse_filament_info(GCodeProcessorResult *result)
         }
 
         if (!out.empty()) {
-            if (!mz_zip_writer_add_mem(&archive, BBS_LAYER_HEIGHTS_PROFILE_FILE.c_str(), (const void*)out.data(), out.length(), MZ_DEFAULT_COMPRESSION)) {
+            if (!_add_entry_to_archive(archive, BBS_LAYER_HEIGHTS_PROFILE_FILE.c_str(), (const void*)out.data(), out.length())) {
                 add_error("Unable to add layer heights profile file to archive");
                 BOOST_LOG_TRIVIAL(error) << __FUNCTION__ << ":" << __LINE__ << boost::format("Unable to add layer heights profile file to archive\n");
                 return false;
@@ -6674,7 +7059,7 @@ void PlateData::parse_filament_info(GCodeProcessorResult *result)
         }
 
         if (!out.empty()) {
-            if (!mz_zip_writer_add_mem(&archive, LAYER_CONFIG_RANGES_FILE.c_str(), (const void*)out.data(), out.length(), MZ_DEFAULT_COMPRESSION)) {
+            if (!_add_entry_to_archive(archive, LAYER_CONFIG_RANGES_FILE.c_str(), (const void*)out.data(), out.length())) {
                 add_error("Unable to add layer heights profile file to archive");
                 BOOST_LOG_TRIVIAL(error) << __FUNCTION__ << ":" << __LINE__ << boost::format("Unable to add layer heights profile file to archive\n");
                 return false;
@@ -6712,7 +7097,7 @@ void PlateData::parse_filament_info(GCodeProcessorResult *result)
             // Adds version header at the beginning:
             //out = std::string("support_points_format_version=") + std::to_string(support_points_format_version) + std::string("\n") + out;
 
-            if (!mz_zip_writer_add_mem(&archive, SLA_SUPPORT_POINTS_FILE.c_str(), (const void*)out.data(), out.length(), MZ_DEFAULT_COMPRESSION)) {
+            if (!_add_entry_to_archive(archive, SLA_SUPPORT_POINTS_FILE.c_str(), (const void*)out.data(), out.length())) {
                 add_error("Unable to add sla support points file to archive");
                 BOOST_LOG_TRIVIAL(error) << __FUNCTION__ << ":" << __LINE__ << boost::format("Unable to add sla support points file to archive\n");
                 return false;
@@ -6764,7 +7149,7 @@ void PlateData::parse_filament_info(GCodeProcessorResult *result)
             // Adds version header at the beginning:
             //out = std::string("drain_holes_format_version=") + std::to_string(drain_holes_format_version) + std::string("\n") + out;
 
-            if (!mz_zip_writer_add_mem(&archive, SLA_DRAIN_HOLES_FILE.c_str(), static_cast<const void*>(out.data()), out.length(), mz_uint(MZ_DEFAULT_COMPRESSION))) {
+            if (!_add_entry_to_archive(archive, SLA_DRAIN_HOLES_FILE.c_str(), static_cast<const void*>(out.data()), out.length())) {
                 add_error("Unable to add sla support points file to archive");
                 BOOST_LOG_TRIVIAL(error) << __FUNCTION__ << ":" << __LINE__ << boost::format("Unable to add sla support points file to archive\n");
                 return false;
@@ -6785,7 +7170,7 @@ void PlateData::parse_filament_info(GCodeProcessorResult *result)
                 out += "; " + key + " = " + config.opt_serialize(key) + "\n";
 
         if (!out.empty()) {
-            if (!mz_zip_writer_add_mem(&archive, BBS_PRINT_CONFIG_FILE.c_str(), (const void*)out.data(), out.length(), MZ_DEFAULT_COMPRESSION)) {
+            if (!_add_entry_to_archive(archive, BBS_PRINT_CONFIG_FILE.c_str(), (const void*)out.data(), out.length())) {
                 add_error("Unable to add print config file to archive");
                 BOOST_LOG_TRIVIAL(error) << __FUNCTION__ << ":" << __LINE__ << boost::format("Unable to add print config file to archive\n");
                 return false;
@@ -7131,7 +7516,7 @@ void PlateData::parse_filament_info(GCodeProcessorResult *result)
         stream << "</" << CONFIG_TAG << ">\n";
 
         std::string out = stream.str();
-        if (!mz_zip_writer_add_mem(&archive, BBS_MODEL_CONFIG_FILE.c_str(), (const void*)out.data(), out.length(), MZ_DEFAULT_COMPRESSION)) {
+        if (!_add_entry_to_archive(archive, BBS_MODEL_CONFIG_FILE.c_str(), (const void*)out.data(), out.length())) {
             BOOST_LOG_TRIVIAL(error) << __FUNCTION__ << ":" << __LINE__ << boost::format("Unable to add model config file to archive\n");
             add_error("Unable to add model config file to archive");
             return false;
@@ -7194,7 +7579,7 @@ void PlateData::parse_filament_info(GCodeProcessorResult *result)
         }
 
         if (!out.empty()) {
-            if (!mz_zip_writer_add_mem(&archive, CUT_INFORMATION_FILE.c_str(), (const void *) out.data(), out.length(), MZ_DEFAULT_COMPRESSION)) {
+            if (!_add_entry_to_archive(archive, CUT_INFORMATION_FILE.c_str(), (const void *) out.data(), out.length())) {
                 add_error("Unable to add cut information file to archive");
                 return false;
             }
@@ -7282,7 +7667,7 @@ void PlateData::parse_filament_info(GCodeProcessorResult *result)
 
         std::string out = stream.str();
 
-        if (!mz_zip_writer_add_mem(&archive, SLICE_INFO_CONFIG_FILE.c_str(), (const void*)out.data(), out.length(), MZ_DEFAULT_COMPRESSION)) {
+        if (!_add_entry_to_archive(archive, SLICE_INFO_CONFIG_FILE.c_str(), (const void*)out.data(), out.length())) {
             add_error("Unable to add model config file to archive");
             BOOST_LOG_TRIVIAL(error) << __FUNCTION__ << ":" << __LINE__ << boost::format(", store  slice-info to 3mf,  length %1%, failed\n") % out.length();
             return false;
@@ -7313,6 +7698,7 @@ bool _BBS_3MF_Exporter::_add_gcode_file_to_archive(mz_zip_archive& archive, cons
     boost::mutex mutex;
     tbb::parallel_for(tbb::blocked_range<size_t>(0, plate_data_list2.size(), 1), [this, &plate_data_list2, &root_archive = archive, &mutex, &result](const tbb::blocked_range<size_t>& range) {
         for (int i = range.begin(); i < range.end(); ++i) {
+            auto start = std::chrono::steady_clock::now();
             PlateData* plate_data = plate_data_list2[i];
             auto src_gcode_file = plate_data->gcode_file;
             std::string gcode_in_3mf = (boost::format(GCODE_FILE_FORMAT) % (plate_data->plate_index + 1)).str();
@@ -7324,7 +7710,7 @@ bool _BBS_3MF_Exporter::_add_gcode_file_to_archive(mz_zip_archive& archive, cons
             mz_zip_writer_init_heap(&archive, 0, 1024 * 1024);
             {
                 mz_zip_writer_add_staged_open(&archive, &context, gcode_in_3mf.c_str(), m_zip64 ? (uint64_t(1) << 30) * 16 : (uint64_t(1) << 32) - 1, nullptr, nullptr, 0,
-                    MZ_DEFAULT_COMPRESSION, nullptr, 0, nullptr, 0);
+                    m_compression_level, nullptr, 0, nullptr, 0);
                 boost::filesystem::path src_gcode_path(src_gcode_file);
                 if (!boost::filesystem::exists(src_gcode_path)) {
                     BOOST_LOG_TRIVIAL(error) << "Gcode is missing, filename = " << src_gcode_file;
@@ -7348,7 +7734,8 @@ bool _BBS_3MF_Exporter::_add_gcode_file_to_archive(mz_zip_archive& archive, cons
                 mz_zip_writer_add_from_zip_reader(&root_archive, &archive, 0);
             }
             mz_zip_reader_end(&archive);
-            BOOST_LOG_TRIVIAL(info) << __FUNCTION__ << ":" <<__LINE__ << boost::format(", store  %1% to 3mf %2%\n") % src_gcode_file % gcode_in_3mf;
+            BOOST_LOG_TRIVIAL(info) << __FUNCTION__ << ":" <<__LINE__ << boost::format(", store  %1% to 3mf %2%, %3% compressed bytes, level %4%, %5% ms\n") % src_gcode_file % gcode_in_3mf % pSize % m_compression_level %
+                std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count();
         }
     });
     return result;
@@ -7401,7 +7788,7 @@ bool _BBS_3MF_Exporter::_add_custom_gcode_per_print_z_file_to_archive(mz_zip_arc
     }
 
     if (!out.empty()) {
-        if (!mz_zip_writer_add_mem(&archive, CUSTOM_GCODE_PER_PRINT_Z_FILE.c_str(), (const void*)out.data(), out.length(), MZ_DEFAULT_COMPRESSION)) {
+        if (!_add_entry_to_archive(archive, CUSTOM_GCODE_PER_PRINT_Z_FILE.c_str(), (const void*)out.data(), out.length())) {
             add_error("Unable to add custom Gcodes per print_z file to archive");
             BOOST_LOG_TRIVIAL(error) << __FUNCTION__ << ":" << __LINE__ << boost::format(", Unable to add custom Gcodes per print_z file to archive\n");
             return false;
@@ -7860,6 +8247,26 @@ std::string bbs_3mf_get_thumbnail(const char *path)
     return data;
 }
 
+bool extract_file_from_3mf(const std::string& path, const std::string& path_in_3mf, const std::string& dest_path)
+{
+    mz_zip_archive archive;
+    mz_zip_zero_struct(&archive);
+    if (!open_zip_reader(&archive, path)) {
+        BOOST_LOG_TRIVIAL(error) << __FUNCTION__ << boost::format(", can not open %1%") % path;
+        return false;
+    }
+
+    bool res = false;
+    int index = mz_zip_reader_locate_file(&archive, path_in_3mf.c_str(), nullptr, 0);
+    if (index >= 0) {
+        std::string dest_zip_file = encode_path(dest_path.c_str());
+        res = mz_zip_reader_extract_to_file(&archive, (mz_uint)index, dest_zip_file.c_str(), 0);
+    }
+    BOOST_LOG_TRIVIAL(info) << __FUNCTION__ << boost::format(", extract %1% from 3mf %2% to %3%, ret %4%") % path_in_3mf % path % dest_path % res;
+    close_zip_reader(&archive);
+    return res;
+}
+
 bool load_gcode_3mf_from_stream(std::istream &data, DynamicPrintConfig *config, Model *model, PlateDataPtrs *plate_data_list, Semver *file_version)
 {
     CNumericLocalesSetter locales_setter;
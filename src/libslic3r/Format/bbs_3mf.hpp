@@ -67,6 +67,9 @@ struct PlateData
     std::map<int, std::pair<int, int>> obj_inst_map;
     std::string     gcode_file;
     std::string     gcode_file_md5;
+    // Set by LoadStrategy::LazyPlateData when gcode_file was not extracted yet, see extract_file_from_3mf().
+    std::string     gcode_file_in_3mf;
+    std::string     source_3mf;
     std::string     thumbnail_file;
     ThumbnailData   plate_thumbnail;
     std::string     top_file;
@@ -113,6 +116,8 @@ enum class SaveStrategy
     SkipAuxiliary       = 1 << 9,
     UseLoadedId         = 1 << 10,
     ShareMesh           = 1 << 11,
+    // Deflate the archive entries at the fastest compression level, trading file size for saving time.
+    FastSave            = 1 << 13,
 
     SplitModel = 0x1000 | ProductionExt,
     Encrypted  = SecureContentExt | SplitModel,
@@ -141,6 +146,10 @@ enum class LoadStrategy
     LoadAuxiliary = 16,
     Silence = 32,
     ImperialUnits = 64,
+    // Leave the per plate G-code in the archive, see PlateData::gcode_file_in_3mf.
+    // Only the G-code is deferred: the meshes, the thumbnails and the slice info are still loaded eagerly, and
+    // PartPlateList::load_gcode_files() extracts the G-code of all the plates of a G-code only project when it is opened.
+    LazyPlateData = 128,
 
     Restore = 0x10000 | LoadModel | LoadConfig | LoadAuxiliary | Silence,
 };
@@ -226,6 +235,9 @@ extern bool load_bbs_3mf(const char* path, DynamicPrintConfig* config, ConfigSub
 
 extern std::string bbs_3mf_get_thumbnail(const char * path);
 
+// Extract a single entry of a 3mf archive to dest_path, used to materialize the data skipped by LoadStrategy::LazyPlateData.
+extern bool extract_file_from_3mf(const std::string& path, const std::string& path_in_3mf, const std::string& dest_path);
+
 extern bool load_gcode_3mf_from_stream(std::istream & data, DynamicPrintConfig* config, Model* model, PlateDataPtrs* plate_data_list, 
        Semver* file_version);
 
@@ -33,6 +33,7 @@
 #include <boost/nowide/cstdio.hpp>
 #include <boost/nowide/cstdlib.hpp>
 
+
 #include "SVG.hpp"
 
 #include <tbb/parallel_for.h>
@@ -1133,6 +1134,7 @@ void GCode::do_export(Print* print, const char* path, GCodeProcessorResult* resu
     BOOST_LOG_TRIVIAL(debug) << "Start processing gcode, " << log_memory_info();
     // Post-process the G-code to update time stamps.
     m_processor.finalize(true);
+    BOOST_LOG_TRIVIAL(info) << "Finished processing gcode" << log_memory_info();
 //    DoExport::update_print_estimated_times_stats(m_processor, print->m_print_statistics);
     DoExport::update_print_estimated_stats(m_processor, m_writer.extruders(), print->m_print_statistics);
     if (result != nullptr) {
@@ -2137,6 +2139,54 @@ void GCode::check_placeholder_parser_failed()
     }
 }
 
+// Maximum number of layers in flight in the G-code export pipeline. Each token keeps the G-code of a whole layer alive
+// until the output filter writes it into the file and releases it. Large production plates produce huge layers,
+// therefore the pipeline is throttled down if the system is short of free memory.
+static size_t gcode_pipeline_max_tokens()
+{
+    static constexpr size_t max_tokens = 12;
+    static constexpr size_t min_tokens = 2;
+    // Pessimistic estimate of memory held by a single token: G-code of the layer and its copies in the filters.
+    static constexpr size_t token_memory_estimate = size_t(256) << 20;
+    const size_t available = available_physical_memory();
+    // Unknown amount of free memory, don't throttle.
+    size_t tokens = available == 0 ? max_tokens : std::clamp(available / token_memory_estimate, min_tokens, max_tokens);
+    BOOST_LOG_TRIVIAL(debug) << "G-code export pipeline: " << tokens << " layers in flight, available memory: " << format_memsize_MB(available);
+    return tokens;
+}
+
+// Cooling buffer stages of the G-code export pipeline. Only collecting the layers until a flush and carrying over
+// the position, extruder and fan state between the batches are serial, parsing the G-code and applying the slow down
+// run in parallel for multiple batches.
+template<typename LayerResult>
+static auto make_cooling_buffer_filters(CoolingBuffer &cooling_buffer)
+{
+    const auto collect = tbb::make_filter<LayerResult, CoolingBuffer::Batch>(slic3r_tbb_filtermode::serial_in_order,
+        [&cooling_buffer](LayerResult in) -> CoolingBuffer::Batch {
+            return cooling_buffer.collect_layer(std::move(in.gcode), in.layer_id, in.cooling_buffer_flush);
+        });
+    const auto parse = tbb::make_filter<CoolingBuffer::Batch, CoolingBuffer::Batch>(slic3r_tbb_filtermode::parallel,
+        [&cooling_buffer](CoolingBuffer::Batch in) -> CoolingBuffer::Batch {
+            cooling_buffer.parse_batch(in);
+            return in;
+        });
+    const auto carry_over = tbb::make_filter<CoolingBuffer::Batch, CoolingBuffer::Batch>(slic3r_tbb_filtermode::serial_in_order,
+        [&cooling_buffer](CoolingBuffer::Batch in) -> CoolingBuffer::Batch {
+            cooling_buffer.carry_over(in);
+            return in;
+        });
+    const auto slow_down = tbb::make_filter<CoolingBuffer::Batch, CoolingBuffer::Batch>(slic3r_tbb_filtermode::parallel,
+        [&cooling_buffer](CoolingBuffer::Batch in) -> CoolingBuffer::Batch {
+            cooling_buffer.slow_down_batch(in);
+            return in;
+        });
+    const auto fan = tbb::make_filter<CoolingBuffer::Batch, std::string>(slic3r_tbb_filtermode::serial_in_order,
+        [&cooling_buffer](CoolingBuffer::Batch in) -> std::string {
+            return cooling_buffer.apply_fan_speeds(std::move(in));
+        });
+    return collect & parse & carry_over & slow_down & fan;
+}
+
 // Process all layers of all objects (non-sequential mode) with a parallel pipeline:
 // Generate G-code, run the filters (vase mode, cooling buffer), run the G-code analyser
 // and export G-code into file.
@@ -2171,19 +2221,20 @@ void GCode::process_layers(
             spiral_mode.enable(in.spiral_vase_enable);
             return { spiral_mode.process_layer(std::move(in.gcode)), in.layer_id, in.spiral_vase_enable, in.cooling_buffer_flush };
         });
-    const auto cooling = tbb::make_filter<GCode::LayerResult, std::string>(slic3r_tbb_filtermode::serial_in_order,
-        [&cooling_buffer = *this->m_cooling_buffer.get()](GCode::LayerResult in) -> std::string {
-            return cooling_buffer.process_layer(std::move(in.gcode), in.layer_id, in.cooling_buffer_flush);
-        });
+    const auto cooling = make_cooling_buffer_filters<GCode::LayerResult>(*this->m_cooling_buffer.get());
+    // The layer G-code is released as soon as it is written into the file and passed to the G-code processor.
     const auto output = tbb::make_filter<std::string, void>(slic3r_tbb_filtermode::serial_in_order,
         [&output_stream](std::string s) { output_stream.write(s); }
     );
 
     // The pipeline elements are joined using const references, thus no copying is performed.
+    const size_t max_tokens = gcode_pipeline_max_tokens();
     if (m_spiral_vase)
-        tbb::parallel_pipeline(12, generator & spiral_mode & cooling & output);
+        tbb::parallel_pipeline(max_tokens, generator & spiral_mode & cooling & output);
     else
-        tbb::parallel_pipeline(12, generator & cooling & output);
+        tbb::parallel_pipeline(max_tokens, generator & cooling & output);
+
+    BOOST_LOG_TRIVIAL(info) << "Generating G-code layers finished" << log_memory_info();
 }
 
 // Process all layers of a single object instance (sequential mode) with a parallel pipeline:
@@ -2219,19 +2270,20 @@ void GCode::process_layers(
             spiral_mode.enable(in.spiral_vase_enable);
             return { spiral_mode.process_layer(std::move(in.gcode)), in.layer_id, in.spiral_vase_enable, in.cooling_buffer_flush };
         });
-    const auto cooling = tbb::make_filter<GCode::LayerResult, std::string>(slic3r_tbb_filtermode::serial_in_order,
-        [&cooling_buffer = *this->m_cooling_buffer.get()](GCode::LayerResult in)->std::string {
-            return cooling_buffer.process_layer(std::move(in.gcode), in.layer_id, in.cooling_buffer_flush);
-        });
+    const auto cooling = make_cooling_buffer_filters<GCode::LayerResult>(*this->m_cooling_buffer.get());
+    // The layer G-code is released as soon as it is written into the file and passed to the G-code processor.
     const auto output = tbb::make_filter<std::string, void>(slic3r_tbb_filtermode::serial_in_order,
         [&output_stream](std::string s) { output_stream.write(s); }
     );
 
     // The pipeline elements are joined using const references, thus no copying is performed.
+    const size_t max_tokens = gcode_pipeline_max_tokens();
     if (m_spiral_vase)
-        tbb::parallel_pipeline(12, generator & spiral_mode & cooling & output);
+        tbb::parallel_pipeline(max_tokens, generator & spiral_mode & cooling & output);
     else
-        tbb::parallel_pipeline(12, generator & cooling & output);
+        tbb::parallel_pipeline(max_tokens, generator & cooling & output);
+
+    BOOST_LOG_TRIVIAL(info) << "Generating G-code layers finished" << log_memory_info();
 }
 
 std::string GCode::placeholder_parser_process(const std::string &name, const std::string &templ, unsigned int current_extruder_id, const DynamicConfig *config_override)
@@ -3091,6 +3143,13 @@ GCode::LayerResult GCode::process_layer(
     if (m_wipe_tower)
         m_wipe_tower->set_is_first_print(true);
 
+    // BBS: The islands of an object printed by an extruder are generated for the first instance only and replayed translated for the other instances.
+    // The absolute E values would differ between the instances, the wiping into the objects is done per instance.
+    const bool use_instance_templates = m_replay_instance_templates && single_object_instance_idx == size_t(-1) && m_config.use_relative_e_distances &&
+                                        !is_anything_overridden && !m_spiral_vase;
+    std::vector<InstanceTemplate> instance_templates;
+    m_instance_template_recording = nullptr;
+
     // Extrude the skirt, brim, support, perimeters, infill ordered by the extruders.
     for (unsigned int extruder_id : layer_tools.extruders)
     {
@@ -3256,43 +3315,73 @@ GCode::LayerResult GCode::process_layer(
                     m_layer = layer_to_print.layer();
                     m_object_layer_over_raft = object_layer_over_raft;
                 }
-                //FIXME order islands?
-                // Sequential tool path ordering of multiple parts within the same object, aka. perimeter tracking (#5511)
-                for (ObjectByExtruder::Island &island : instance_to_print.object_by_extruder.islands) {
-                    const auto& by_region_specific = is_anything_overridden ? island.by_region_per_copy(by_region_per_copy_cache, static_cast<unsigned int>(instance_to_print.instance_id), extruder_id, print_wipe_extrusions != 0) : island.by_region;
-                    //BBS: add brim by obj by extruder
-                    if (this->m_objsWithBrim.find(instance_to_print.print_object.id()) != this->m_objsWithBrim.end() && !print_wipe_extrusions) {
-                        this->set_origin(0., 0.);
-                        m_avoid_crossing_perimeters.use_external_mp();
-                        for (const ExtrusionEntity* ee : print.m_brimMap.at(instance_to_print.print_object.id()).entities) {
-                            gcode += this->extrude_entity(*ee, "brim", m_config.support_speed.value);
-                        }
-                        m_avoid_crossing_perimeters.use_external_mp(false);
-                        // Allow a straight travel move to the first object point.
-                        m_avoid_crossing_perimeters.disable_once();
-                        this->m_objsWithBrim.erase(instance_to_print.print_object.id());
-                    }
+                // BBS: replay the islands generated for another instance of the same object, the last one recorded was entered
+                // the same way as the following instances.
+                auto instance_template = std::find_if(instance_templates.rbegin(), instance_templates.rend(),
+                    [&instance_to_print](const InstanceTemplate &t) { return t.object_by_extruder == &instance_to_print.object_by_extruder; });
+                bool replayed = false;
+                if (instance_template != instance_templates.rend() && instance_template->started) {
                     // When starting a new object, use the external motion planner for the first travel move.
-                    const Point& offset = instance_to_print.print_object.instances()[instance_to_print.instance_id].shift;
                     std::pair<const PrintObject*, Point> this_object_copy(&instance_to_print.print_object, offset);
                     if (m_last_obj_copy != this_object_copy)
                         m_avoid_crossing_perimeters.use_external_mp_once();
                     m_last_obj_copy = this_object_copy;
                     this->set_origin(unscale(offset));
-                    //FIXME the following code prints regions in the order they are defined, the path is not optimized in any way.
-                    bool is_infill_first = print.config().wall_infill_order == WallInfillOrder::InfillInnerOuter ||
-                                           print.config().wall_infill_order == WallInfillOrder::InfillOuterInner;
-                    //BBS: for first layer, we always print wall firstly to get better bed adhesive force
-                    //This behaviour is same with cura
-                    if (is_infill_first && !first_layer) {
-                        gcode += this->extrude_infill(print, by_region_specific, false);
-                        gcode += this->extrude_perimeters(print, by_region_specific);
-                    } else {
-                        gcode += this->extrude_perimeters(print, by_region_specific);
-                        gcode += this->extrude_infill(print,by_region_specific, false);
+                    replayed = this->replay_instance_template(*instance_template, offset, gcode);
+                }
+                if (! replayed) {
+                    size_t islands_begin = gcode.size();
+                    // The instances which could not be replayed are recorded again, the following instances are entered the same way.
+                    // The seams or the order of the extrusions of an object depending on the entry are generated for each instance.
+                    if (use_instance_templates &&
+                        (instance_template == instance_templates.rend() || ! instance_template->entry_dependent) &&
+                        this->m_objsWithBrim.find(instance_to_print.print_object.id()) == this->m_objsWithBrim.end() &&
+                        std::count_if(instances_to_print.begin(), instances_to_print.end(), [&instance_to_print](const InstanceToPrint &other) {
+                            return &other.object_by_extruder == &instance_to_print.object_by_extruder; }) > 1) {
+                        m_instance_template_recording                     = &instance_templates.emplace_back();
+                        m_instance_template_recording->object_by_extruder = &instance_to_print.object_by_extruder;
+                        m_instance_template_recording->shift              = offset;
                     }
-                    // ironing
-                    gcode += this->extrude_infill(print,by_region_specific, true);
+                    //FIXME order islands?
+                    // Sequential tool path ordering of multiple parts within the same object, aka. perimeter tracking (#5511)
+                    for (ObjectByExtruder::Island &island : instance_to_print.object_by_extruder.islands) {
+                        const auto& by_region_specific = is_anything_overridden ? island.by_region_per_copy(by_region_per_copy_cache, static_cast<unsigned int>(instance_to_print.instance_id), extruder_id, print_wipe_extrusions != 0) : island.by_region;
+                        //BBS: add brim by obj by extruder
+                        if (this->m_objsWithBrim.find(instance_to_print.print_object.id()) != this->m_objsWithBrim.end() && !print_wipe_extrusions) {
+                            this->set_origin(0., 0.);
+                            m_avoid_crossing_perimeters.use_external_mp();
+                            for (const ExtrusionEntity* ee : print.m_brimMap.at(instance_to_print.print_object.id()).entities) {
+                                gcode += this->extrude_entity(*ee, "brim", m_config.support_speed.value);
+                            }
+                            m_avoid_crossing_perimeters.use_external_mp(false);
+                            // Allow a straight travel move to the first object point.
+                            m_avoid_crossing_perimeters.disable_once();
+                            this->m_objsWithBrim.erase(instance_to_print.print_object.id());
+                        }
+                        // When starting a new object, use the external motion planner for the first travel move.
+                        const Point& offset = instance_to_print.print_object.instances()[instance_to_print.instance_id].shift;
+                        std::pair<const PrintObject*, Point> this_object_copy(&instance_to_print.print_object, offset);
+                        if (m_last_obj_copy != this_object_copy)
+                            m_avoid_crossing_perimeters.use_external_mp_once();
+                        m_last_obj_copy = this_object_copy;
+                        this->set_origin(unscale(offset));
+                        //FIXME the following code prints regions in the order they are defined, the path is not optimized in any way.
+                        bool is_infill_first = print.config().wall_infill_order == WallInfillOrder::InfillInnerOuter ||
+                                               print.config().wall_infill_order == WallInfillOrder::InfillOuterInner;
+                        //BBS: for first layer, we always print wall firstly to get better bed adhesive force
+                        //This behaviour is same with cura
+                        if (is_infill_first && !first_layer) {
+                            gcode += this->extrude_infill(print, by_region_specific, false);
+                            gcode += this->extrude_perimeters(print, by_region_specific);
+                        } else {
+                            gcode += this->extrude_perimeters(print, by_region_specific);
+                            gcode += this->extrude_infill(print,by_region_specific, false);
+                        }
+                        // ironing
+                        gcode += this->extrude_infill(print,by_region_specific, true);
+                    }
+                    if (m_instance_template_recording != nullptr)
+                        this->finish_instance_template(gcode, islands_begin);
                 }
                 // Don't set m_gcode_label_objects_end if you don't had to write the m_gcode_label_objects_start.
                 if (!m_writer.empty_object_start_str()) {
@@ -3490,9 +3579,13 @@ std::string GCode::extrude_loop(ExtrusionLoop loop, std::string description, dou
         assert(m_layer != nullptr);
         bool is_outer_wall_first = m_config.wall_infill_order == WallInfillOrder::OuterInnerInfill
                                 || m_config.wall_infill_order == WallInfillOrder::InfillOuterInner;
+        if (m_layer->object()->config().seam_position == spNearest)
+            this->instance_template_depends_on_entry();
         m_seam_placer.place_seam(m_layer, loop, is_outer_wall_first, this->last_pos());
-    } else
+    } else {
+        this->instance_template_depends_on_entry();
         loop.split_at(last_pos, false);
+    }
 
     // clip the path to avoid the extruder to get exactly on the first point of the loop;
     // if polyline was shorter than the clipping distance we'd get a null polyline, so
@@ -3501,9 +3594,9 @@ std::string GCode::extrude_loop(ExtrusionLoop loop, std::string description, dou
         scale_(EXTRUDER_CONFIG(nozzle_diameter)) * ( m_config.seam_gap.value / 100 ) :
         0;
 
-    // get paths
-    ExtrusionPaths paths;
-    loop.clip_end(clip_length, &paths);
+    // get paths, moved out of the local copy of the loop instead of copying them again
+    ExtrusionPaths paths = std::move(loop.paths);
+    clip_end(paths, clip_length);
     if (paths.empty()) return "";
 
     // BBS: remove small small_perimeter_speed config, and will absolutely
@@ -3585,17 +3678,17 @@ std::string GCode::extrude_loop(ExtrusionLoop loop, std::string description, dou
     return gcode;
 }
 
-std::string GCode::extrude_multi_path(ExtrusionMultiPath multipath, std::string description, double speed)
+std::string GCode::extrude_multi_path(const ExtrusionMultiPath &multipath, std::string description, double speed)
 {
     // extrude along the path
     std::string gcode;
-    for (ExtrusionPath path : multipath.paths)
+    for (const ExtrusionPath &path : multipath.paths)
         gcode += this->_extrude(path, description, speed);
 
     // BBS
     if (m_wipe.enable) {
         m_wipe.path = Polyline();
-        for (ExtrusionPath &path : multipath.paths) {
+        for (const ExtrusionPath &path : multipath.paths) {
             //BBS: Don't need to save duplicated point into wipe path
             if (!m_wipe.path.empty() && !path.empty() &&
                 m_wipe.path.last_point() == path.first_point())
@@ -3628,12 +3721,12 @@ std::string GCode::extrude_entity(const ExtrusionEntity &entity, std::string des
     return "";
 }
 
-std::string GCode::extrude_path(ExtrusionPath path, std::string description, double speed)
+std::string GCode::extrude_path(const ExtrusionPath &path, std::string description, double speed)
 {
 //    description += ExtrusionEntity::role_to_string(path.role());
     std::string gcode = this->_extrude(path, description, speed);
     if (m_wipe.enable) {
-        m_wipe.path = std::move(path.polyline);
+        m_wipe.path = path.polyline;
         m_wipe.path.reverse();
     }
     //BBS: don't reset acceleration when printing first layer. During first layer, acceleration is always same value.
@@ -3652,7 +3745,10 @@ std::string GCode::extrude_perimeters(const Print &print, const std::vector<Obje
     std::string gcode;
     for (const ObjectByExtruder::Island::Region &region : by_region)
         if (! region.perimeters.empty()) {
-            m_config.apply(print.get_print_region(&region - &by_region.front()).config());
+            const PrintRegionConfig &region_config = print.get_print_region(&region - &by_region.front()).config();
+            m_config.apply(region_config);
+            if (m_instance_template_recording != nullptr)
+                m_instance_template_recording->last_region_config = &region_config;
 
             for (const ExtrusionEntity* ee : region.perimeters)
                 gcode += this->extrude_entity(*ee, "perimeter", -1.);
@@ -3674,7 +3770,11 @@ std::string GCode::extrude_infill(const Print &print, const std::vector<ObjectBy
                 if ((ee->role() == erIroning) == ironing)
                     extrusions.emplace_back(ee);
             if (! extrusions.empty()) {
-                m_config.apply(print.get_print_region(&region - &by_region.front()).config());
+                const PrintRegionConfig &region_config = print.get_print_region(&region - &by_region.front()).config();
+                m_config.apply(region_config);
+                if (m_instance_template_recording != nullptr)
+                    m_instance_template_recording->last_region_config = &region_config;
+                this->instance_template_depends_on_entry();
                 chain_and_reorder_extrusion_entities(extrusions, &m_last_pos);
                 for (const ExtrusionEntity *fill : extrusions) {
                     auto *eec = dynamic_cast<const ExtrusionEntityCollection*>(fill);
@@ -3730,6 +3830,180 @@ std::string GCode::extrude_support(const ExtrusionEntityCollection &support_fill
     return gcode;
 }
 
+// BBS: Marks the start of the G-code of an instance template, removed by finish_instance_template().
+static const std::string instance_template_marker = ";_INSTANCE_TEMPLATE_START\n";
+
+// BBS: Translate the X and Y axes of the G0 to G3 moves by offset, the other axes and the arc centers are relative or do not depend on the instance.
+// The axes are emitted from the values recorded before rounding, xy, thus they are rounded once as if the moves were generated translated.
+// Returns false if the G-code does not match the recorded values or if a translated value is too close to the midpoint
+// between two rounded values, where the rounding of a value generated for the instance may differ due to the numerical error.
+static bool translate_gcode_xy(const std::string &gcode, const std::vector<Vec2d> &xy, const Vec2d &offset, std::string &out)
+{
+    static constexpr const double scale = 1000.;
+    static_assert(GCodeFormatter::XYZF_EXPORT_DIGITS == 3, "scale shall match the XY digits");
+    out.reserve(out.size() + gcode.size() + gcode.size() / 16);
+    size_t      xy_idx = 0;
+    const char *ptr    = gcode.data();
+    const char *end    = ptr + gcode.size();
+    while (ptr != end) {
+        const char *eol = std::find(ptr, end, '\n');
+        if (eol != end)
+            ++ eol;
+        if (eol - ptr < 4 || ptr[0] != 'G' || ptr[1] < '0' || ptr[1] > '3' || ptr[2] != ' ') {
+            out.append(ptr, eol);
+            ptr = eol;
+            continue;
+        }
+        const char *comment = std::find(ptr, eol, ';');
+        const char *copied  = ptr;
+        for (const char *c = ptr + 2; c + 1 < comment; ++ c)
+            if (*c == ' ' && (c[1] == 'X' || c[1] == 'Y')) {
+                // Each recorded point was emitted as an X axis followed by an Y axis.
+                if (xy_idx == xy.size())
+                    return false;
+                const int axis      = c[1] == 'X' ? 0 : 1;
+                const char *num_end = std::find_if(c + 2, comment, [](char ch) { return ch == ' ' || ch == '\n' || ch == '\r'; });
+                GCodeFormatter w;
+                w.emit_axis(c[1], xy[xy_idx](axis), GCodeFormatter::XYZF_EXPORT_DIGITS);
+                std::string recorded = w.string();
+                if (recorded.compare(1, recorded.size() - 2, c + 1, num_end - c - 1) != 0)
+                    return false;
+                const double v        = xy[xy_idx](axis) + offset(axis);
+                const double fraction = v * scale - std::floor(v * scale);
+                if (std::abs(fraction - 0.5) < 1e-6)
+                    return false;
+                GCodeFormatter w_translated;
+                w_translated.emit_axis(c[1], v, GCodeFormatter::XYZF_EXPORT_DIGITS);
+                std::string translated = w_translated.string();
+                out.append(copied, c);
+                out.append(translated, 0, translated.size() - 1);
+                copied = num_end;
+                c      = num_end - 1;
+                if (axis == 1)
+                    ++ xy_idx;
+            }
+        out.append(copied, eol);
+        ptr = eol;
+    }
+    return xy_idx == xy.size();
+}
+
+void GCode::start_instance_template(const ExtrusionPath &path, const std::string &description)
+{
+    InstanceTemplate &instance_template               = *m_instance_template_recording;
+    instance_template.started                         = true;
+    instance_template.first_point                     = path.first_point();
+    instance_template.first_role                      = path.role();
+    instance_template.first_description               = description;
+    instance_template.first_region_config             = instance_template.last_region_config;
+    instance_template.start_extrusion_role            = m_last_extrusion_role;
+    instance_template.start_processor_extrusion_role  = m_last_processor_extrusion_role;
+    instance_template.start_width                     = m_last_width;
+    instance_template.start_height                    = m_last_height;
+#if ENABLE_GCODE_VIEWER_DATA_CHECKING
+    instance_template.start_mm3_per_mm                = m_last_mm3_per_mm;
+#endif // ENABLE_GCODE_VIEWER_DATA_CHECKING
+    instance_template.writer_start                    = m_writer.state();
+    m_writer.record_xy(&instance_template.xy);
+}
+
+void GCode::instance_template_depends_on_entry()
+{
+    if (m_instance_template_recording != nullptr && !m_instance_template_recording->started)
+        m_instance_template_recording->entry_dependent = true;
+}
+
+void GCode::finish_instance_template(std::string &gcode, size_t gcode_begin)
+{
+    InstanceTemplate &instance_template = *m_instance_template_recording;
+    m_instance_template_recording = nullptr;
+    m_writer.record_xy(nullptr);
+    size_t marker_pos = instance_template.started ? gcode.find(instance_template_marker, gcode_begin) : std::string::npos;
+    if (marker_pos != std::string::npos)
+        gcode.erase(marker_pos, instance_template_marker.size());
+    if (marker_pos == std::string::npos || instance_template.entry_dependent) {
+        instance_template.started = false;
+        return;
+    }
+    instance_template.gcode.assign(gcode, marker_pos, std::string::npos);
+    instance_template.writer_end                    = m_writer.state();
+    instance_template.last_pos                      = m_last_pos;
+    instance_template.wipe_path                     = m_wipe.path;
+    instance_template.last_extrusion_role           = m_last_extrusion_role;
+    instance_template.last_processor_extrusion_role = m_last_processor_extrusion_role;
+    instance_template.last_width                    = m_last_width;
+    instance_template.last_height                   = m_last_height;
+#if ENABLE_GCODE_VIEWER_DATA_CHECKING
+    instance_template.last_mm3_per_mm               = m_last_mm3_per_mm;
+#endif // ENABLE_GCODE_VIEWER_DATA_CHECKING
+}
+
+bool GCode::replay_instance_template(const InstanceTemplate &instance_template, const Point &shift, std::string &gcode)
+{
+    const Point delta  = shift - instance_template.shift;
+    const Vec2d offset = unscale(shift) - unscale(instance_template.shift);
+    for (const std::pair<Polyline, bool> &check : instance_template.overhang_checks) {
+        Polyline travel = check.first;
+        travel.translate(delta);
+        if (this->travel_through_overhang(travel) != check.second)
+            return false;
+    }
+    std::string translated;
+    if (! translate_gcode_xy(instance_template.gcode, instance_template.xy, offset, translated))
+        return false;
+
+    // The same steps as extrude_perimeters() / extrude_infill() and _extrude() do before the first extrusion of the template.
+    if (instance_template.first_region_config != nullptr)
+        m_config.apply(*instance_template.first_region_config);
+    if (!m_last_pos_defined || m_last_pos != instance_template.first_point || m_need_change_layer_lift_z) {
+        gcode += this->travel_to(instance_template.first_point, instance_template.first_role, "move to first " + instance_template.first_description + " point");
+        m_need_change_layer_lift_z = false;
+    }
+    m_writer.add_object_change_labels(gcode);
+    gcode += this->unretract();
+    m_config.apply(m_calib_config);
+
+    // The template continues from the state it was recorded in. Otherwise the instance is generated from here,
+    // _extrude() skips the travel and the unretraction done already.
+    const GCodeWriter::State writer_state_start = m_writer.state();
+    const GCodeWriter::State &template_start    = instance_template.writer_start;
+    if (m_last_extrusion_role != instance_template.start_extrusion_role ||
+        m_last_processor_extrusion_role != instance_template.start_processor_extrusion_role ||
+        m_last_width != instance_template.start_width || m_last_height != instance_template.start_height ||
+#if ENABLE_GCODE_VIEWER_DATA_CHECKING
+        m_last_mm3_per_mm != instance_template.start_mm3_per_mm ||
+#endif // ENABLE_GCODE_VIEWER_DATA_CHECKING
+        writer_state_start.last_acceleration != template_start.last_acceleration || writer_state_start.last_jerk != template_start.last_jerk ||
+        writer_state_start.lifted != template_start.lifted || writer_state_start.to_lift != template_start.to_lift ||
+        writer_state_start.to_lift_type != template_start.to_lift_type || writer_state_start.pos.z() != template_start.pos.z() ||
+        writer_state_start.is_current_pos_clear != template_start.is_current_pos_clear ||
+        writer_state_start.extruder.retracted != template_start.extruder.retracted ||
+        writer_state_start.extruder.restart_extra != template_start.extruder.restart_extra)
+        return false;
+
+    gcode += translated;
+
+    GCodeWriter::State writer_state = instance_template.writer_end;
+    writer_state.pos.x() += offset.x();
+    writer_state.pos.y() += offset.y();
+    writer_state.extruder.absolute_E = writer_state_start.extruder.absolute_E +
+        instance_template.writer_end.extruder.absolute_E - template_start.extruder.absolute_E;
+    m_writer.set_state(writer_state);
+    if (instance_template.last_region_config != nullptr)
+        m_config.apply(*instance_template.last_region_config);
+    m_config.apply(m_calib_config);
+    this->set_last_pos(instance_template.last_pos);
+    m_wipe.path                     = instance_template.wipe_path;
+    m_last_extrusion_role           = instance_template.last_extrusion_role;
+    m_last_processor_extrusion_role = instance_template.last_processor_extrusion_role;
+    m_last_width                    = instance_template.last_width;
+    m_last_height                   = instance_template.last_height;
+#if ENABLE_GCODE_VIEWER_DATA_CHECKING
+    m_last_mm3_per_mm               = instance_template.last_mm3_per_mm;
+#endif // ENABLE_GCODE_VIEWER_DATA_CHECKING
+    return true;
+}
+
 bool GCode::GCodeOutputStream::is_error() const
 {
     return ::ferror(this->f);
@@ -3752,10 +4026,11 @@ void GCode::GCodeOutputStream::write(const char *what)
 {
     if (what != nullptr) {
         const char* gcode = what;
+        const size_t len = ::strlen(gcode);
         // writes string to file
-        fwrite(gcode, 1, ::strlen(gcode), this->f);
-        //FIXME don't allocate a string, maybe process a batch of lines?
-        m_processor.process_buffer(std::string(gcode));
+        fwrite(gcode, 1, len, this->f);
+        // Let the G-code processor consume the lines in place, while they are being produced.
+        m_processor.process_buffer(gcode, gcode + len);
     }
 }
 
@@ -3833,6 +4108,12 @@ std::string GCode::_extrude(const ExtrusionPath &path, std::string description,
     gcode += this->unretract();
     m_config.apply(m_calib_config);
 
+    // BBS: the G-code of an instance template starts after the travel to its first extrusion
+    if (m_instance_template_recording != nullptr && !m_instance_template_recording->started) {
+        this->start_instance_template(path, description);
+        gcode += instance_template_marker;
+    }
+
     // adjust acceleration
     if (m_config.default_acceleration.value > 0) {
         double acceleration;
@@ -4042,17 +4323,21 @@ std::string GCode::_extrude(const ExtrusionPath &path, std::string description,
         if (!m_config.enable_arc_fitting ||
             path.polyline.fitting_result.empty() ||
             m_config.spiral_mode) {
-            for (const Line& line : path.polyline.lines()) {
-                const double line_length = line.length() * SCALING_FACTOR;
+            const Points &points = path.polyline.points;
+            // Reserve the output once for the whole path, the moves are then formatted directly into it.
+            gcode.reserve(gcode.size() + points.size() * 32 + comment.size() * points.size() + 32);
+            for (size_t point_index = 1; point_index < points.size(); ++ point_index) {
+                const double line_length = (points[point_index] - points[point_index - 1]).cast<double>().norm() * SCALING_FACTOR;
                 path_length += line_length;
-                gcode += m_writer.extrude_to_xy(
-                    this->point_to_gcode(line.b),
+                m_writer.extrude_to_xy(gcode,
+                    this->point_to_gcode(points[point_index]),
                     e_per_mm * line_length,
                     comment);
             }
         } else {
             // BBS: start to generate gcode from arc fitting data which includes line and arc
             const std::vector<PathFittingData>& fitting_result = path.polyline.fitting_result;
+            gcode.reserve(gcode.size() + (path.polyline.points.size() + fitting_result.size()) * (48 + comment.size()) + 32);
             for (size_t fitting_index = 0; fitting_index < fitting_result.size(); fitting_index++) {
                 switch (fitting_result[fitting_index].path_type) {
                 case EMovePathType::Linear_move: {
@@ -4062,7 +4347,7 @@ std::string GCode::_extrude(const ExtrusionPath &path, std::string description,
                         const Line line = Line(path.polyline.points[point_index - 1], path.polyline.points[point_index]);
                         const double line_length = line.length() * SCALING_FACTOR;
                         path_length += line_length;
-                        gcode += m_writer.extrude_to_xy(
+                        m_writer.extrude_to_xy(gcode,
                             this->point_to_gcode(line.b),
                             e_per_mm * line_length,
                             comment, path.is_force_no_extrusion());
@@ -4075,7 +4360,7 @@ std::string GCode::_extrude(const ExtrusionPath &path, std::string description,
                     const double arc_length = fitting_result[fitting_index].arc_data.length * SCALING_FACTOR;
                     const Vec2d center_offset = this->point_to_gcode(arc.center) - this->point_to_gcode(arc.start_point);
                     path_length += arc_length;
-                    gcode += m_writer.extrude_arc_to_xy(
+                    m_writer.extrude_arc_to_xy(gcode,
                             this->point_to_gcode(arc.end_point),
                             center_offset,
                             e_per_mm * arc_length,
@@ -4247,68 +4532,76 @@ LiftType GCode::to_lift_type(ZHopType z_hop_types) {
     }
 };
 
-bool GCode::needs_retraction(const Polyline &travel, ExtrusionRole role, LiftType& lift_type)
+//BBS: input travel polyline must be in current plate coordinate system
+bool GCode::travel_through_overhang(const Polyline &travel)
 {
-    if (travel.length() < scale_(EXTRUDER_CONFIG(retraction_minimum_travel))) {
-        // skip retraction if the move is shorter than the configured threshold
-        return false;
-    }
-
-    //BBS: input travel polyline must be in current plate coordinate system
-    auto is_through_overhang = [this](const Polyline& travel) {
-        BoundingBox travel_bbox = get_extents(travel);
-        travel_bbox.inflated(1);
-        travel_bbox.defined = true;
-
-        const float protect_z_scaled = scale_(0.4);
-        std::pair<float, float> z_range;
-        z_range.second = m_layer ? m_layer->print_z : 0.f;
-        z_range.first = std::max(0.f, z_range.second - protect_z_scaled);
-        std::vector<LayerPtrs> layers_of_objects;
-        std::vector<BoundingBox> boundingBox_for_objects;
-        std::vector<Points> objects_instances_shift;
-        std::vector<size_t> idx_of_object_sorted = m_curr_print->layers_sorted_for_object(z_range.first, z_range.second, layers_of_objects, boundingBox_for_objects, objects_instances_shift);
-
-        std::vector<bool> is_layers_of_objects_sorted(layers_of_objects.size(), false);
-
-        for (size_t idx : idx_of_object_sorted) {
-            for (const Point & instance_shift : objects_instances_shift[idx]) {
-                BoundingBox instance_bbox = boundingBox_for_objects[idx];
-                if (!instance_bbox.defined)  //BBS: Don't need to check when bounding box of overhang area is empty(undefined)
-                    continue;
+    BoundingBox travel_bbox = get_extents(travel);
+    travel_bbox.inflated(1);
+    travel_bbox.defined = true;
+
+    const float protect_z_scaled = scale_(0.4);
+    std::pair<float, float> z_range;
+    z_range.second = m_layer ? m_layer->print_z : 0.f;
+    z_range.first = std::max(0.f, z_range.second - protect_z_scaled);
+    std::vector<LayerPtrs> layers_of_objects;
+    std::vector<BoundingBox> boundingBox_for_objects;
+    std::vector<Points> objects_instances_shift;
+    std::vector<size_t> idx_of_object_sorted = m_curr_print->layers_sorted_for_object(z_range.first, z_range.second, layers_of_objects, boundingBox_for_objects, objects_instances_shift);
+
+    std::vector<bool> is_layers_of_objects_sorted(layers_of_objects.size(), false);
+
+    for (size_t idx : idx_of_object_sorted) {
+        for (const Point & instance_shift : objects_instances_shift[idx]) {
+            BoundingBox instance_bbox = boundingBox_for_objects[idx];
+            if (!instance_bbox.defined)  //BBS: Don't need to check when bounding box of overhang area is empty(undefined)
+                continue;
 
-                instance_bbox.offset(scale_(EPSILON));
-                instance_bbox.translate(instance_shift.x(), instance_shift.y());
-                if (!instance_bbox.overlap(travel_bbox))
-                    continue;
+            instance_bbox.offset(scale_(EPSILON));
+            instance_bbox.translate(instance_shift.x(), instance_shift.y());
+            if (!instance_bbox.overlap(travel_bbox))
+                continue;
 
-                Polygons temp;
-                temp.emplace_back(std::move(instance_bbox.polygon()));
-                if (intersection_pl(travel, temp).empty())
-                    continue;
+            Polygons temp;
+            temp.emplace_back(std::move(instance_bbox.polygon()));
+            if (intersection_pl(travel, temp).empty())
+                continue;
 
-                if (!is_layers_of_objects_sorted[idx]) {
-                    std::sort(layers_of_objects[idx].begin(), layers_of_objects[idx].end(), [](auto left, auto right) { return left->loverhangs_bbox.area() > right->loverhangs_bbox.area();});
-                    is_layers_of_objects_sorted[idx] = true;
-                }
+            if (!is_layers_of_objects_sorted[idx]) {
+                std::sort(layers_of_objects[idx].begin(), layers_of_objects[idx].end(), [](auto left, auto right) { return left->loverhangs_bbox.area() > right->loverhangs_bbox.area();});
+                is_layers_of_objects_sorted[idx] = true;
+            }
 
-                for (const auto& layer : layers_of_objects[idx]) {
-                    for (ExPolygon overhang : layer->loverhangs) {
-                        overhang.translate(instance_shift);
-                        BoundingBox bbox1 = get_extents(overhang);
+            for (const auto& layer : layers_of_objects[idx]) {
+                for (ExPolygon overhang : layer->loverhangs) {
+                    overhang.translate(instance_shift);
+                    BoundingBox bbox1 = get_extents(overhang);
 
-                        if (!bbox1.overlap(travel_bbox))
-                            continue;
+                    if (!bbox1.overlap(travel_bbox))
+                        continue;
 
-                        if (intersection_pl(travel, overhang).empty())
-                            continue;
+                    if (intersection_pl(travel, overhang).empty())
+                        continue;
 
-                        return true;
-                    }
+                    return true;
                 }
             }
         }
+    }
+    return false;
+}
+
+bool GCode::needs_retraction(const Polyline &travel, ExtrusionRole role, LiftType& lift_type)
+{
+    if (travel.length() < scale_(EXTRUDER_CONFIG(retraction_minimum_travel))) {
+        // skip retraction if the move is shorter than the configured threshold
         return false;
+    }
+
+    auto is_through_overhang = [this](const Polyline& travel) {
+        bool through = this->travel_through_overhang(travel);
+        if (m_instance_template_recording != nullptr && m_instance_template_recording->started)
+            m_instance_template_recording->overhang_checks.emplace_back(travel, through);
+        return through;
     };
 
     float max_z_hop = 0.f;
@@ -171,6 +171,8 @@ public:
 
     //BBS: set offset for gcode writer
     void set_gcode_offset(double x, double y) { m_writer.set_xy_offset(x, y); m_processor.set_xy_offset(x, y);}
+    //BBS: generate the instances of an object one by one without recording and replaying the G-code of the first one, used to test the replay
+    void set_replay_instance_templates(bool replay) { m_replay_instance_templates = replay; }
 
     // Exported for the helper classes (OozePrevention, Wipe) and for the Perl binding for unit tests.
     const Vec2d&    origin() const { return m_origin; }
@@ -335,8 +337,8 @@ private:
     std::string     change_layer(coordf_t print_z);
     std::string     extrude_entity(const ExtrusionEntity &entity, std::string description = "", double speed = -1.);
     std::string     extrude_loop(ExtrusionLoop loop, std::string description, double speed = -1.);
-    std::string     extrude_multi_path(ExtrusionMultiPath multipath, std::string description = "", double speed = -1.);
-    std::string     extrude_path(ExtrusionPath path, std::string description = "", double speed = -1.);
+    std::string     extrude_multi_path(const ExtrusionMultiPath &multipath, std::string description = "", double speed = -1.);
+    std::string     extrude_path(const ExtrusionPath &path, std::string description = "", double speed = -1.);
 
     // Extruding multiple objects with soluble / non-soluble / combined supports
     // on a multi-material printer, trying to minimize tool switches.
@@ -403,11 +405,67 @@ private:
 		// For sequential print, the instance of the object to be printing has to be defined.
 		const size_t                     				 single_object_instance_idx);
 
+    // BBS: G-code of the islands of an object layer, generated for the first instance printed and replayed
+    // translated for the other instances of the same object printed with the same extruder.
+    struct InstanceTemplate
+    {
+        // Extrusions of a single object by a single extruder at the current layer.
+        const ObjectByExtruder    *object_by_extruder { nullptr };
+        // Shift of the instance the G-code was generated for.
+        Point                      shift;
+        // Set once the first extrusion was reached, the G-code is only valid then.
+        bool                       started { false };
+        // Set if a seam or the order of the extrusions was chosen before the first extrusion, thus it depends on where
+        // the nozzle entered the instance from. Such a template is not replayed.
+        bool                       entry_dependent { false };
+        // The travel to the first extrusion is generated for each instance.
+        Point                      first_point;
+        ExtrusionRole              first_role { erNone };
+        std::string                first_description;
+        // G-code following the travel to the first extrusion and the unretraction.
+        std::string                gcode;
+        // X and Y of the moves of the G-code before rounding, see GCodeWriter::record_xy().
+        std::vector<Vec2d>         xy;
+        // The travels inside the template are planned in the object coordinates and do not depend on the instance,
+        // except for the lift over the overhangs of all the objects, see travel_through_overhang().
+        // These travels are checked again for each replayed instance.
+        std::vector<std::pair<Polyline, bool>> overhang_checks;
+        // State at the start and at the end of the G-code. The template is only replayed where the extrusion role, width, height,
+        // acceleration and jerk emitted last are the same as at its start, so that it emits the same of them.
+        ExtrusionRole              start_extrusion_role { erNone };
+        ExtrusionRole              start_processor_extrusion_role { erNone };
+        float                      start_width { 0.f };
+        float                      start_height { 0.f };
+        double                     start_mm3_per_mm { 0. };
+        GCodeWriter::State         writer_start;
+        GCodeWriter::State         writer_end;
+        // Region configs active at the travel to the first extrusion and at the end of the G-code.
+        const PrintRegionConfig   *first_region_config { nullptr };
+        const PrintRegionConfig   *last_region_config { nullptr };
+        Point                      last_pos;
+        Polyline                   wipe_path;
+        ExtrusionRole              last_extrusion_role { erNone };
+        ExtrusionRole              last_processor_extrusion_role { erNone };
+        float                      last_width { 0.f };
+        float                      last_height { 0.f };
+        double                     last_mm3_per_mm { 0. };
+    };
+    void            start_instance_template(const ExtrusionPath &path, const std::string &description);
+    // Called before a seam or an order of the extrusions is chosen from the last position.
+    void            instance_template_depends_on_entry();
+    // Cut the template G-code out of the G-code generated for the first instance since gcode_begin.
+    void            finish_instance_template(std::string &gcode, size_t gcode_begin);
+    // Append the template translated to the instance at shift. Returns false if the G-code of the instance would differ
+    // from the translated template, then the instance has to be generated. The travel to the first extrusion may already be appended then.
+    bool            replay_instance_template(const InstanceTemplate &instance_template, const Point &shift, std::string &gcode);
+
     std::string     extrude_perimeters(const Print &print, const std::vector<ObjectByExtruder::Island::Region> &by_region);
     std::string     extrude_infill(const Print &print, const std::vector<ObjectByExtruder::Island::Region> &by_region, bool ironing);
     std::string     extrude_support(const ExtrusionEntityCollection &support_fills);
 
     std::string     travel_to(const Point &point, ExtrusionRole role, std::string comment);
+    // BBS: travel in the plate coordinates crosses an overhang of some object below
+    bool            travel_through_overhang(const Polyline &travel);
     // BBS
     LiftType to_lift_type(ZHopType z_hop_types);
 
@@ -500,6 +558,9 @@ private:
     unsigned int m_toolchange_count;
     coordf_t m_nominal_z;
     bool m_need_change_layer_lift_z = false;
+    // Instance template being generated by process_layer(), if any.
+    InstanceTemplate* m_instance_template_recording = nullptr;
+    bool              m_replay_instance_templates = true;
     int m_start_gcode_filament = -1;
 
     // BBS
@@ -1,10 +1,9 @@
 #include "ConflictChecker.hpp"
 
 #include <tbb/parallel_for.h>
-#include <tbb/concurrent_vector.h>
 
 #include <map>
-#include <functional>
+#include <unordered_map>
 #include <atomic>
 
 namespace Slic3r {
@@ -135,60 +134,55 @@ LineWithIDs LinesBucketQueue::getCurLines() const
     return lines;
 }
 
-void getExtrusionPathsFromEntity(const ExtrusionEntityCollection *entity, ExtrusionPaths &paths)
+std::vector<LinesBucketRange> LinesBucketQueue::getCurRanges() const
 {
-    std::function<void(const ExtrusionEntityCollection *, ExtrusionPaths &)> getExtrusionPathImpl = [&](const ExtrusionEntityCollection *entity, ExtrusionPaths &paths) {
-        for (auto entityPtr : entity->entities) {
-            if (const ExtrusionEntityCollection *collection = dynamic_cast<ExtrusionEntityCollection *>(entityPtr)) {
-                getExtrusionPathImpl(collection, paths);
-            } else if (const ExtrusionPath *path = dynamic_cast<ExtrusionPath *>(entityPtr)) {
-                paths.push_back(*path);
-            } else if (const ExtrusionMultiPath *multipath = dynamic_cast<ExtrusionMultiPath *>(entityPtr)) {
-                for (const ExtrusionPath &path : multipath->paths) { paths.push_back(path); }
-            } else if (const ExtrusionLoop *loop = dynamic_cast<ExtrusionLoop *>(entityPtr)) {
-                for (const ExtrusionPath &path : loop->paths) { paths.push_back(path); }
-            }
+    std::vector<LinesBucketRange> ranges;
+    for (const LinesBucket &bucket : _buckets) {
+        if (bucket.valid()) {
+            auto [b, e] = bucket.curRange();
+            ranges.push_back({&bucket, b, e});
         }
-    };
-    getExtrusionPathImpl(entity, paths);
+    }
+    return ranges;
 }
 
-ExtrusionLayers getExtrusionPathsFromLayer(const LayerRegionPtrs layerRegionPtrs)
+// perimeters and infills of a layer, or the support of a support layer
+static void appendExtrusionsOfLayer(ExtrusionTable &table, const Layer *layer)
 {
-    ExtrusionLayers perimeters; // periments and infills
-    perimeters.resize(layerRegionPtrs.size());
-    int i = 0;
-    for (LayerRegion *regionPtr : layerRegionPtrs) {
-        perimeters[i].layer    = regionPtr->layer();
-        perimeters[i].bottom_z = regionPtr->layer()->bottom_z();
-        perimeters[i].height   = regionPtr->layer()->height;
-        getExtrusionPathsFromEntity(&regionPtr->perimeters, perimeters[i].paths);
-        getExtrusionPathsFromEntity(&regionPtr->fills, perimeters[i].paths);
-        ++i;
+    for (const LayerRegion *layerm : layer->regions()) {
+        table.append(layerm->perimeters);
+        table.append(layerm->fills);
     }
-    return perimeters;
+    if (const SupportLayer *supportLayer = dynamic_cast<const SupportLayer *>(layer)) { table.append(supportLayer->support_fills); }
 }
 
-ExtrusionLayer getExtrusionPathsFromSupportLayer(SupportLayer *supportLayer)
+ExtrusionLayer getExtrusionPathsFromLayer(const Layer *layer, const ExtrusionTable &table)
 {
     ExtrusionLayer el;
-    getExtrusionPathsFromEntity(&supportLayer->support_fills, el.paths);
-    el.layer    = supportLayer;
-    el.bottom_z = supportLayer->bottom_z();
-    el.height   = supportLayer->height;
+    el.table    = &table;
+    el.layer    = layer;
+    el.bottom_z = layer->bottom_z();
+    el.height   = layer->height;
     return el;
 }
 
-ObjectExtrusions getAllLayersExtrusionPathsFromObject(PrintObject *obj)
+ObjectExtrusions getAllLayersExtrusionPathsFromObject(PrintObject *obj, std::vector<ExtrusionTable> &tables)
 {
+    // the tables of the layers followed by the tables of the support layers, flattened in parallel
+    const size_t numLayers = obj->layers().size();
+    tables.assign(numLayers + obj->support_layers().size(), ExtrusionTable());
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, tables.size()), [obj, numLayers, &tables](const tbb::blocked_range<size_t> &range) {
+        for (size_t i = range.begin(); i < range.end(); ++i) {
+            const Layer *layer = i < numLayers ? static_cast<const Layer *>(obj->layers()[i]) : obj->support_layers()[i - numLayers];
+            appendExtrusionsOfLayer(tables[i], layer);
+        }
+    });
+
     ObjectExtrusions oe;
 
-    for (auto layerPtr : obj->layers()) {
-        auto perimeters = getExtrusionPathsFromLayer(layerPtr->regions());
-        oe.perimeters.insert(oe.perimeters.end(), perimeters.begin(), perimeters.end());
-    }
+    for (size_t i = 0; i < numLayers; ++i) { oe.perimeters.push_back(getExtrusionPathsFromLayer(obj->layers()[i], tables[i])); }
 
-    for (auto supportLayerPtr : obj->support_layers()) { oe.support.push_back(getExtrusionPathsFromSupportLayer(supportLayerPtr)); }
+    for (size_t i = 0; i < obj->support_layers().size(); ++i) { oe.support.push_back(getExtrusionPathsFromLayer(obj->support_layers()[i], tables[numLayers + i])); }
 
     return oe;
 }
@@ -213,56 +207,113 @@ ConflictComputeOpt ConflictChecker::find_inter_of_lines(const LineWithIDs &lines
     return {};
 }
 
+ConflictComputeOpt ConflictChecker::find_inter_of_lines_in_overlapping_objs(const LineWithIDs &lines)
+{
+    struct ObjectLines
+    {
+        BoundingBox                     bbox;
+        std::vector<const LineWithID *> lines;
+    };
+    std::vector<ObjectLines>                objs;
+    std::unordered_map<const void *, size_t> idToObj;
+    for (const LineWithID &l : lines) {
+        auto [it, inserted] = idToObj.emplace(l._id, objs.size());
+        if (inserted) { objs.emplace_back(); }
+        ObjectLines &obj = objs[it->second];
+        obj.bbox.merge(l._line.a);
+        obj.bbox.merge(l._line.b);
+        obj.lines.push_back(&l);
+    }
+    if (objs.size() <= 1) { return {}; }
+
+    // broad phase: sweep the object bounding boxes sorted by their min x
+    std::sort(objs.begin(), objs.end(), [](const ObjectLines &l, const ObjectLines &r) { return l.bbox.min.x() < r.bbox.min.x(); });
+    for (size_t i = 0; i < objs.size(); ++i) {
+        for (size_t j = i + 1; j < objs.size() && objs[j].bbox.min.x() <= objs[i].bbox.max.x(); ++j) {
+            if (!objs[i].bbox.overlap(objs[j].bbox)) { continue; }
+            // narrow phase: lines crossing each other lie in the overlap of the object bounding boxes
+            BoundingBox overlap(Point(std::max(objs[i].bbox.min.x(), objs[j].bbox.min.x()), std::max(objs[i].bbox.min.y(), objs[j].bbox.min.y())),
+                                Point(std::min(objs[i].bbox.max.x(), objs[j].bbox.max.x()), std::min(objs[i].bbox.max.y(), objs[j].bbox.max.y())));
+            overlap.offset(SCALED_EPSILON);
+            LineWithIDs pairLines;
+            for (const ObjectLines *obj : {&objs[i], &objs[j]}) {
+                for (const LineWithID *l : obj->lines) {
+                    const Line &line = l->_line;
+                    if (std::max(line.a.x(), line.b.x()) >= overlap.min.x() && std::min(line.a.x(), line.b.x()) <= overlap.max.x() &&
+                        std::max(line.a.y(), line.b.y()) >= overlap.min.y() && std::min(line.a.y(), line.b.y()) <= overlap.max.y()) {
+                        pairLines.push_back(*l);
+                    }
+                }
+            }
+            if (auto interRes = find_inter_of_lines(pairLines); interRes.has_value()) { return interRes; }
+        }
+    }
+    return {};
+}
+
 ConflictResultOpt ConflictChecker::find_inter_of_lines_in_diff_objs(PrintObjectPtrs                      objs,
                                                                     std::optional<const FakeWipeTower *> wtdptr) // find the first intersection point of lines in different objects
 {
     if (objs.size() <= 1 && !wtdptr) { return {}; }
+    // the extrusions are flattened into tables for the duration of the check only, they are not kept with the layers
+    std::vector<ExtrusionTable>              wtTables;
+    std::vector<std::vector<ExtrusionTable>> objTables(objs.size());
     LinesBucketQueue conflictQueue;
     if (wtdptr.has_value()) { // wipe tower at 0 by default
         auto            wtpaths = wtdptr.value()->getFakeExtrusionPathsFromWipeTower();
         ExtrusionLayers wtels;
         wtels.type = ExtrusionLayersType::WIPE_TOWER;
+        wtTables.resize(wtpaths.size());
         for (int i = 0; i < wtpaths.size(); ++i) { // assume that wipe tower always has same height
+            wtTables[i].append(wtpaths[i]);
             ExtrusionLayer el;
-            el.paths    = wtpaths[i];
+            el.table    = &wtTables[i];
             el.bottom_z = wtpaths[i].front().height * (float) i;
             el.layer    = nullptr;
             wtels.push_back(el);
         }
         conflictQueue.emplace_back_bucket(std::move(wtels), wtdptr.value(), {wtdptr.value()->plate_origin.x(), wtdptr.value()->plate_origin.y()});
     }
-    for (PrintObject *obj : objs) {
-        auto layers = getAllLayersExtrusionPathsFromObject(obj);
+    for (size_t objIdx = 0; objIdx < objs.size(); ++objIdx) {
+        PrintObject *obj    = objs[objIdx];
+        auto         layers = getAllLayersExtrusionPathsFromObject(obj, objTables[objIdx]);
         conflictQueue.emplace_back_bucket(std::move(layers.perimeters), obj, obj->instances().front().shift);
         conflictQueue.emplace_back_bucket(std::move(layers.support), obj, obj->instances().front().shift);
     }
 
-    std::vector<LineWithIDs> layersLines;
-    std::vector<float>       bottomZs;
+    // only the pile ranges are collected in z order, the lines of the layers are extracted in parallel
+    std::vector<std::vector<LinesBucketRange>> layersRanges;
+    std::vector<float>                         bottomZs;
     while (conflictQueue.valid()) {
-        LineWithIDs lines = conflictQueue.getCurLines();
-        float curBottomZ = conflictQueue.getCurrBottomZ();
-        bottomZs.push_back(curBottomZ);
-        layersLines.push_back(std::move(lines));
+        layersRanges.push_back(conflictQueue.getCurRanges());
+        bottomZs.push_back(conflictQueue.getCurrBottomZ());
     }
 
-    bool                                                          find = false;
-    tbb::concurrent_vector<std::pair<ConflictComputeResult, float>> conflict;
-    tbb::parallel_for(tbb::blocked_range<size_t>(0, layersLines.size()), [&](tbb::blocked_range<size_t> range) {
-        for (size_t i = range.begin(); i < range.end(); i++) {
-            auto interRes = find_inter_of_lines(layersLines[i]);
-            if (interRes.has_value()) {
-                find = true;
-                conflict.emplace_back(interRes.value(), bottomZs[i]);
+    // index of the lowest layer with a conflict found so far, the layers above it are skipped
+    std::atomic<size_t>             firstConflictLayer(layersRanges.size());
+    std::vector<ConflictComputeOpt> layersConflicts(layersRanges.size());
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, layersRanges.size()), [&](tbb::blocked_range<size_t> range) {
+        for (size_t i = range.begin(); i < range.end() && i < firstConflictLayer.load(std::memory_order_relaxed); i++) {
+            LineWithIDs lines;
+            for (const LinesBucketRange &r : layersRanges[i]) {
+                LineWithIDs tmpLines = r.bucket->lines(r.begin, r.end);
+                lines.insert(lines.end(), tmpLines.begin(), tmpLines.end());
+            }
+            layersConflicts[i] = find_inter_of_lines_in_overlapping_objs(lines);
+            if (layersConflicts[i].has_value()) {
+                size_t first = firstConflictLayer.load();
+                while (i < first && !firstConflictLayer.compare_exchange_weak(first, i)) {}
                 break;
             }
         }
     });
 
+    size_t conflictLayer = firstConflictLayer.load();
+    bool   find          = conflictLayer < layersRanges.size();
     if (find) {
-        const void *ptr1           = conflict[0].first._obj1;
-        const void *ptr2           = conflict[0].first._obj2;
-        float       conflictPrintZ = conflict[0].second;
+        const void *ptr1           = layersConflicts[conflictLayer]->_obj1;
+        const void *ptr2           = layersConflicts[conflictLayer]->_obj2;
+        float       conflictPrintZ = bottomZs[conflictLayer];
         if (wtdptr.has_value()) {
             const FakeWipeTower *wtdp = wtdptr.value();
             if (ptr1 == wtdp || ptr2 == wtdp) {
@@ -5,6 +5,7 @@
 #include "../Model.hpp"
 #include "../Print.hpp"
 #include "../Layer.hpp"
+#include "../ExtrusionTable.hpp"
 
 #include <queue>
 #include <vector>
@@ -25,7 +26,8 @@ using LineWithIDs = std::vector<LineWithID>;
 
 struct ExtrusionLayer
 {
-    ExtrusionPaths paths;
+    // Flattened extrusions of the layer, owned by the caller for the duration of the check.
+    const ExtrusionTable *table;
     const Layer *  layer;
     float          bottom_z;
     float          height;
@@ -61,7 +63,7 @@ public:
     Point           _offset;
 
 public:
-    LinesBucket(ExtrusionLayers &&paths, const void* id, Point offset) : _piles(paths), _id(id), _offset(offset) {}
+    LinesBucket(ExtrusionLayers &&paths, const void* id, Point offset) : _piles(std::move(paths)), _id(id), _offset(offset) {}
     LinesBucket(LinesBucket &&) = default;
 
     std::pair<int, int> curRange() const
@@ -82,15 +84,17 @@ public:
     LineWithIDs curLines() const
     {
         auto [b, e] = curRange();
+        return lines(b, e);
+    }
+    LineWithIDs lines(int b, int e) const
+    {
         LineWithIDs lines;
         for (int i = b; i < e; ++i) {
-            for (const ExtrusionPath &path : _piles[i].paths) {
-                if (path.is_force_no_extrusion() == false) {
-                    Polyline check_polyline = path.polyline;
-                    check_polyline.translate(_offset);
-                    Lines tmpLines = check_polyline.lines();
-                    for (const Line &line : tmpLines) { lines.emplace_back(line, _id, path.role()); }
-                }
+            const ExtrusionTable &table = *_piles[i].table;
+            for (size_t path = 0; path < table.size(); ++path) {
+                if (table.no_extrusion[path] || table.num_points(path) < 2) { continue; }
+                const Point *end = table.points_end(path);
+                for (const Point *pt = table.points_begin(path); pt + 1 != end; ++pt) { lines.emplace_back(Line(pt[0] + _offset, pt[1] + _offset), _id, table.roles[path]); }
             }
         }
         return lines;
@@ -106,6 +110,14 @@ struct LinesBucketPtrComp
     bool operator()(const LinesBucket *left, const LinesBucket *right) { return *left > *right; }
 };
 
+// Piles [begin, end) of a bucket, their lines are extracted later by LinesBucket::lines().
+struct LinesBucketRange
+{
+    const LinesBucket *bucket;
+    int                begin;
+    int                end;
+};
+
 class LinesBucketQueue
 {
 public:
@@ -117,15 +129,13 @@ public:
     bool        valid() const { return _pq.empty() == false; }
     float       getCurrBottomZ();
     LineWithIDs getCurLines() const;
+    std::vector<LinesBucketRange> getCurRanges() const;
 };
 
-void getExtrusionPathsFromEntity(const ExtrusionEntityCollection *entity, ExtrusionPaths &paths);
-
-ExtrusionLayers getExtrusionPathsFromLayer(const LayerRegionPtrs layerRegionPtrs);
-
-ExtrusionLayer getExtrusionPathsFromSupportLayer(SupportLayer *supportLayer);
+ExtrusionLayer getExtrusionPathsFromLayer(const Layer *layer, const ExtrusionTable &table);
 
-ObjectExtrusions getAllLayersExtrusionPathsFromObject(PrintObject *obj);
+// Flattens the extrusions of the layers and of the support layers of the object into tables.
+ObjectExtrusions getAllLayersExtrusionPathsFromObject(PrintObject *obj, std::vector<ExtrusionTable> &tables);
 
 struct ConflictComputeResult
 {
@@ -144,6 +154,8 @@ struct ConflictChecker
 {
     static ConflictResultOpt  find_inter_of_lines_in_diff_objs(PrintObjectPtrs objs, std::optional<const FakeWipeTower *> wtdptr);
     static ConflictComputeOpt find_inter_of_lines(const LineWithIDs &lines);
+    // Only tests the lines of the object pairs with overlapping XY bounding boxes, inside the overlap of the boxes.
+    static ConflictComputeOpt find_inter_of_lines_in_overlapping_objs(const LineWithIDs &lines);
     static ConflictComputeOpt line_intersect(const LineWithID &l1, const LineWithID &l2);
 };
 
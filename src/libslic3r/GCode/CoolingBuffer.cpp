@@ -3,7 +3,9 @@
 #include <boost/algorithm/string/predicate.hpp>
 #include <boost/algorithm/string/replace.hpp>
 #include <boost/log/trivial.hpp>
+#include <cmath>
 #include <iostream>
+#include <limits>
 #include <float.h>
 
 #if 0
@@ -31,7 +33,7 @@ CoolingBuffer::CoolingBuffer(GCode &gcodegen) : m_config(gcodegen.config()), m_t
 void CoolingBuffer::reset(const Vec3d &position)
 {
     // BBS: add I and J axis to store center of arc
-    m_current_pos.assign(7, 0.f);
+    m_current_pos.fill(0.f);
     m_current_pos[0] = float(position.x());
     m_current_pos[1] = float(position.y());
     m_current_pos[2] = float(position.z());
@@ -295,6 +297,15 @@ finished:
 }
 
 std::string CoolingBuffer::process_layer(std::string &&gcode, size_t layer_id, bool flush)
+{
+    Batch batch = this->collect_layer(std::move(gcode), layer_id, flush);
+    this->parse_batch(batch);
+    this->carry_over(batch);
+    this->slow_down_batch(batch);
+    return this->apply_fan_speeds(std::move(batch));
+}
+
+CoolingBuffer::Batch CoolingBuffer::collect_layer(std::string &&gcode, size_t layer_id, bool flush)
 {
     // Cache the input G-code.
     if (m_gcode.empty())
@@ -302,41 +313,43 @@ std::string CoolingBuffer::process_layer(std::string &&gcode, size_t layer_id, b
     else
         m_gcode += gcode;
 
-    std::string out;
+    Batch batch;
     if (flush) {
         // This is either an object layer or the very last print layer. Calculate cool down over the collected support layers
         // and one object layer.
-        std::vector<PerExtruderAdjustments> per_extruder_adjustments = this->parse_layer_gcode(m_gcode, m_current_pos);
-        float layer_time_stretched = this->calculate_layer_slowdown(per_extruder_adjustments);
-        out = this->apply_layer_cooldown(m_gcode, layer_id, layer_time_stretched, per_extruder_adjustments);
+        batch.gcode    = std::move(m_gcode);
+        batch.layer_id = layer_id;
+        batch.empty    = false;
         m_gcode.clear();
     }
-    return out;
+    return batch;
 }
 
-// Parse the layer G-code for the moves, which could be adjusted.
-// Return the list of parsed lines, bucketed by an extruder.
-std::vector<PerExtruderAdjustments> CoolingBuffer::parse_layer_gcode(const std::string &gcode, std::vector<float> &current_pos) const
+// Position after a G0 / G1 / G2 / G3 / G92 line starting at current_pos.
+static inline std::array<float, 7> parsed_line_new_pos(const CoolingBuffer::ParsedLine &line, const std::array<float, 7> &current_pos)
 {
-    std::vector<PerExtruderAdjustments> per_extruder_adjustments(m_extruder_ids.size());
-    std::vector<size_t>                 map_extruder_to_per_extruder_adjustment(m_num_extruders, 0);
-    for (size_t i = 0; i < m_extruder_ids.size(); ++ i) {
-        PerExtruderAdjustments &adj         = per_extruder_adjustments[i];
-        unsigned int            extruder_id = m_extruder_ids[i];
-        adj.extruder_id               = extruder_id;
-        adj.cooling_slow_down_enabled = m_config.slow_down_for_layer_cooling.get_at(extruder_id);
-        adj.slow_down_layer_time = float(m_config.slow_down_layer_time.get_at(extruder_id));
-        adj.slow_down_min_speed           = float(m_config.slow_down_min_speed.get_at(extruder_id));
-        map_extruder_to_per_extruder_adjustment[extruder_id] = i;
-    }
+    std::array<float, 7> new_pos = current_pos;
+    for (size_t axis = 0; axis < 7; ++ axis)
+        if (line.axes & (1 << axis))
+            // BBS: get position of arc center
+            new_pos[axis] = (axis == 5 || axis == 6) ? line.pos[axis] + current_pos[axis - 5] : line.pos[axis];
+    return new_pos;
+}
 
-    unsigned int      current_extruder  = m_current_extruder;
-    PerExtruderAdjustments *adjustment  = &per_extruder_adjustments[map_extruder_to_per_extruder_adjustment[current_extruder]];
-    const char       *line_start = gcode.c_str();
-    const char       *line_end   = line_start;
-    // Index of an existing CoolingLine of the current adjustment, which holds the feedrate setting command
-    // for a sequence of extrusion moves.
-    size_t            active_speed_modifier = size_t(-1);
+// Parse the layer G-code for the lines, which could be adjusted or which control the fan.
+// The result does not depend on the preceding layers, thus the batches are parsed in parallel.
+void CoolingBuffer::parse_batch(Batch &batch) const
+{
+    if (batch.empty)
+        return;
+
+    const std::string &gcode      = batch.gcode;
+    const char        *line_start = gcode.c_str();
+    const char        *line_end   = line_start;
+    // Simulate the moves starting from unknown position to find out the axes set by this batch.
+    std::array<float, 7> current_pos;
+    current_pos.fill(std::numeric_limits<float>::quiet_NaN());
+    batch.end_extruder = -1;
 
     for (; *line_start != 0; line_start = line_end) 
     {
@@ -344,10 +357,12 @@ std::vector<PerExtruderAdjustments> CoolingBuffer::parse_layer_gcode(const std::
             ++ line_end;
         // sline will not contain the trailing '\n'.
         std::string sline(line_start, line_end);
-        // CoolingLine will contain the trailing '\n'.
+        // ParsedLine will contain the trailing '\n'.
         if (*line_end == '\n')
             ++ line_end;
-        CoolingLine line(0, line_start - gcode.c_str(), line_end - gcode.c_str());
+        ParsedLine line;
+        line.line_start = line_start - gcode.c_str();
+        line.line_end   = line_end - gcode.c_str();
         if (boost::starts_with(sline, "G0 "))
             line.type = CoolingLine::TYPE_G0;
         else if (boost::starts_with(sline, "G1 "))
@@ -361,7 +376,6 @@ std::vector<PerExtruderAdjustments> CoolingBuffer::parse_layer_gcode(const std::
         if (line.type) {
             // G0, G1 or G92
             // Parse the G-code line.
-            std::vector<float> new_pos(current_pos);
             const char *c = sline.data() + 3;
             for (;;) {
                 // Skip whitespaces.
@@ -375,16 +389,14 @@ std::vector<PerExtruderAdjustments> CoolingBuffer::parse_layer_gcode(const std::
                               (*c == 'E') ? 3 : (*c == 'F') ? 4 :
                               (*c == 'I') ? 5 : (*c == 'J') ? 6 : size_t(-1);
                 if (axis != size_t(-1)) {
-                    new_pos[axis] = float(atof(++c));
+                    line.pos[axis] = float(atof(++c));
+                    line.axes |= 1 << axis;
                     if (axis == 4) {
                         // Convert mm/min to mm/sec.
-                        new_pos[4] /= 60.f;
+                        line.pos[4] /= 60.f;
                         if ((line.type & CoolingLine::TYPE_G92) == 0)
                             // This is G0 or G1 line and it sets the feedrate. This mark is used for reducing the duplicate F calls.
                             line.type |= CoolingLine::TYPE_HAS_F;
-                    } else if (axis == 5 || axis == 6) {
-                        // BBS: get position of arc center
-                        new_pos[axis] += current_pos[axis - 5];
                     }
                 }
                 // Skip this word.
@@ -396,10 +408,104 @@ std::vector<PerExtruderAdjustments> CoolingBuffer::parse_layer_gcode(const std::
                 line.type |= CoolingLine::TYPE_EXTERNAL_PERIMETER;
             if (wipe)
                 line.type |= CoolingLine::TYPE_WIPE;
-            if (boost::contains(sline, ";_EXTRUDE_SET_SPEED") && ! wipe) {
+            if (boost::contains(sline, ";_EXTRUDE_SET_SPEED") && ! wipe)
                 line.type |= CoolingLine::TYPE_ADJUSTABLE;
-                active_speed_modifier = adjustment->lines.size();
+            current_pos = parsed_line_new_pos(line, current_pos);
+        } else if (boost::starts_with(sline, ";_EXTRUDE_END")) {
+            line.type = CoolingLine::TYPE_EXTRUDE_END;
+        } else if (boost::starts_with(sline, m_toolchange_prefix)) {
+            unsigned int new_extruder = (unsigned int)atoi(sline.c_str() + m_toolchange_prefix.size());
+            // Only change extruder in case the number is meaningful. User could provide an out-of-range index through custom gcodes - those shall be ignored.
+            if (new_extruder < m_num_extruders) {
+                // Whether the tool really changes is decided by resolve_batch_lines() once the starting extruder is known.
+                line.type          = CoolingLine::TYPE_SET_TOOL;
+                line.extruder_id   = new_extruder;
+                batch.end_extruder = int(new_extruder);
+            }
+            else {
+                // Only log the error in case of MM printer. Single extruder printers likely ignore any T anyway.
+                if (m_num_extruders > 1)
+                    BOOST_LOG_TRIVIAL(error) << "CoolingBuffer encountered an invalid toolchange, maybe from a custom gcode: " << sline;
             }
+
+        } else if (boost::starts_with(sline, ";_OVERHANG_FAN_START")) {
+            line.type = CoolingLine::TYPE_OVERHANG_FAN_START;
+        } else if (boost::starts_with(sline, ";_OVERHANG_FAN_END")) {
+            line.type = CoolingLine::TYPE_OVERHANG_FAN_END;
+        } else if (boost::starts_with(sline, "G4 ")) {
+            // Parse the wait time.
+            line.type = CoolingLine::TYPE_G4;
+            size_t pos_S = sline.find('S', 3);
+            size_t pos_P = sline.find('P', 3);
+            assert(is_decimal_separator_point()); // for atof
+            line.time = float(
+                (pos_S > 0) ? atof(sline.c_str() + pos_S + 1) :
+                (pos_P > 0) ? atof(sline.c_str() + pos_P + 1) * 0.001 : 0.);
+        } else if (boost::starts_with(sline, ";_FORCE_RESUME_FAN_SPEED")) {
+            line.type = CoolingLine::TYPE_FORCE_RESUME_FAN;
+        } else if (boost::starts_with(sline, ";_SET_FAN_SPEED_CHANGING_LAYER")) {
+            line.type = CoolingLine::TYPE_SET_FAN_CHANGING_LAYER;
+        }
+        if (line.type != 0)
+            batch.lines.emplace_back(line);
+    }
+    batch.end_pos = current_pos;
+}
+
+void CoolingBuffer::carry_over(Batch &batch)
+{
+    if (batch.empty)
+        return;
+    batch.start_pos      = m_current_pos;
+    batch.start_extruder = m_batch_extruder;
+    // The axes not set by the batch keep their values.
+    for (size_t axis = 0; axis < 7; ++ axis)
+        if (! std::isnan(batch.end_pos[axis]))
+            m_current_pos[axis] = batch.end_pos[axis];
+    if (batch.end_extruder != -1)
+        m_batch_extruder = (unsigned int)batch.end_extruder;
+}
+
+void CoolingBuffer::slow_down_batch(Batch &batch) const
+{
+    if (batch.empty)
+        return;
+    std::vector<PerExtruderAdjustments> per_extruder_adjustments = this->resolve_batch_lines(batch);
+    batch.layer_time = this->calculate_layer_slowdown(per_extruder_adjustments);
+    batch.gcode      = this->apply_layer_cooldown(batch.gcode, batch.start_extruder, per_extruder_adjustments, batch.fan_events);
+    // The parsed lines are not needed anymore, release the memory before the batch reaches the serial stages.
+    batch.lines      = std::vector<ParsedLine>();
+}
+
+// Calculate the durations of the parsed lines starting from the position and extruder carried over from the preceding batch.
+// Return the list of lines, bucketed by an extruder.
+std::vector<PerExtruderAdjustments> CoolingBuffer::resolve_batch_lines(const Batch &batch) const
+{
+    std::vector<PerExtruderAdjustments> per_extruder_adjustments(m_extruder_ids.size());
+    std::vector<size_t>                 map_extruder_to_per_extruder_adjustment(m_num_extruders, 0);
+    for (size_t i = 0; i < m_extruder_ids.size(); ++ i) {
+        PerExtruderAdjustments &adj         = per_extruder_adjustments[i];
+        unsigned int            extruder_id = m_extruder_ids[i];
+        adj.extruder_id               = extruder_id;
+        adj.cooling_slow_down_enabled = m_config.slow_down_for_layer_cooling.get_at(extruder_id);
+        adj.slow_down_layer_time = float(m_config.slow_down_layer_time.get_at(extruder_id));
+        adj.slow_down_min_speed           = float(m_config.slow_down_min_speed.get_at(extruder_id));
+        map_extruder_to_per_extruder_adjustment[extruder_id] = i;
+    }
+
+    unsigned int            current_extruder = batch.start_extruder;
+    PerExtruderAdjustments *adjustment       = &per_extruder_adjustments[map_extruder_to_per_extruder_adjustment[current_extruder]];
+    std::array<float, 7>    current_pos      = batch.start_pos;
+    // Index of an existing CoolingLine of the current adjustment, which holds the feedrate setting command
+    // for a sequence of extrusion moves.
+    size_t                  active_speed_modifier = size_t(-1);
+
+    for (const ParsedLine &parsed : batch.lines) {
+        CoolingLine line(parsed.type, parsed.line_start, parsed.line_end);
+        if (line.type & (CoolingLine::TYPE_G0 | CoolingLine::TYPE_G1 | CoolingLine::TYPE_G2 | CoolingLine::TYPE_G3 | CoolingLine::TYPE_G92)) {
+            std::array<float, 7> new_pos = parsed_line_new_pos(parsed, current_pos);
+            if (line.type & CoolingLine::TYPE_ADJUSTABLE)
+                active_speed_modifier = adjustment->lines.size();
             if ((line.type & CoolingLine::TYPE_G92) == 0) {
                 //BBS: G0, G1, G2, G3. Calculate the duration.
                 if (m_config.use_relative_e_distances.value)
@@ -455,44 +561,18 @@ std::vector<PerExtruderAdjustments> CoolingBuffer::parse_layer_gcode(const std::
                     line.type = 0;
                 }
             }
-            current_pos = std::move(new_pos);
-        } else if (boost::starts_with(sline, ";_EXTRUDE_END")) {
-            line.type = CoolingLine::TYPE_EXTRUDE_END;
+            current_pos = new_pos;
+        } else if (line.type & CoolingLine::TYPE_EXTRUDE_END) {
             active_speed_modifier = size_t(-1);
-        } else if (boost::starts_with(sline, m_toolchange_prefix)) {
-            unsigned int new_extruder = (unsigned int)atoi(sline.c_str() + m_toolchange_prefix.size());
-            // Only change extruder in case the number is meaningful. User could provide an out-of-range index through custom gcodes - those shall be ignored.
-            if (new_extruder < map_extruder_to_per_extruder_adjustment.size()) {
-                if (new_extruder != current_extruder) {
-                    // Switch the tool.
-                    line.type = CoolingLine::TYPE_SET_TOOL;
-                    current_extruder = new_extruder;
-                    adjustment         = &per_extruder_adjustments[map_extruder_to_per_extruder_adjustment[current_extruder]];
-                }
-            }
-            else {
-                // Only log the error in case of MM printer. Single extruder printers likely ignore any T anyway.
-                if (map_extruder_to_per_extruder_adjustment.size() > 1)
-                    BOOST_LOG_TRIVIAL(error) << "CoolingBuffer encountered an invalid toolchange, maybe from a custom gcode: " << sline;
-            }
-
-        } else if (boost::starts_with(sline, ";_OVERHANG_FAN_START")) {
-            line.type = CoolingLine::TYPE_OVERHANG_FAN_START;
-        } else if (boost::starts_with(sline, ";_OVERHANG_FAN_END")) {
-            line.type = CoolingLine::TYPE_OVERHANG_FAN_END;
-        } else if (boost::starts_with(sline, "G4 ")) {
-            // Parse the wait time.
-            line.type = CoolingLine::TYPE_G4;
-            size_t pos_S = sline.find('S', 3);
-            size_t pos_P = sline.find('P', 3);
-            assert(is_decimal_separator_point()); // for atof
-            line.time = line.time_max = float(
-                (pos_S > 0) ? atof(sline.c_str() + pos_S + 1) :
-                (pos_P > 0) ? atof(sline.c_str() + pos_P + 1) * 0.001 : 0.);
-        } else if (boost::starts_with(sline, ";_FORCE_RESUME_FAN_SPEED")) {
-            line.type = CoolingLine::TYPE_FORCE_RESUME_FAN;
-        } else if (boost::starts_with(sline, ";_SET_FAN_SPEED_CHANGING_LAYER")) {
-            line.type = CoolingLine::TYPE_SET_FAN_CHANGING_LAYER;
+        } else if (line.type & CoolingLine::TYPE_SET_TOOL) {
+            if (parsed.extruder_id != current_extruder) {
+                // Switch the tool.
+                current_extruder = parsed.extruder_id;
+                adjustment       = &per_extruder_adjustments[map_extruder_to_per_extruder_adjustment[current_extruder]];
+            } else
+                line.type = 0;
+        } else if (line.type & CoolingLine::TYPE_G4) {
+            line.time = line.time_max = parsed.time;
         }
         if (line.type != 0)
             adjustment->lines.emplace_back(std::move(line));
@@ -637,7 +717,7 @@ static inline void extruder_range_slow_down_non_proportional(
 }
 
 // Calculate slow down for all the extruders.
-float CoolingBuffer::calculate_layer_slowdown(std::vector<PerExtruderAdjustments> &per_extruder_adjustments)
+float CoolingBuffer::calculate_layer_slowdown(std::vector<PerExtruderAdjustments> &per_extruder_adjustments) const
 {
     // Sort the extruders by an increasing slow_down_layer_time.
     // The layers with a lower slow_down_layer_time are slowed down
@@ -696,17 +776,17 @@ float CoolingBuffer::calculate_layer_slowdown(std::vector<PerExtruderAdjustments
     return elapsed_time_total0;
 }
 
-// Apply slow down over G-code lines stored in per_extruder_adjustments, enable fan if needed.
+// Apply slow down over G-code lines stored in per_extruder_adjustments, collect the lines controlling the fan.
 // Returns the adjusted G-code.
 std::string CoolingBuffer::apply_layer_cooldown(
     // Source G-code for the current layer.
     const std::string                      &gcode,
-    // ID of the current layer, used to disable fan for the first n layers.
-    size_t                                  layer_id, 
-    // Total time of this layer after slow down, used to control the fan.
-    float                                   layer_time,
+    // Extruder active at the start of the G-code.
+    unsigned int                            start_extruder,
     // Per extruder list of G-code lines and their cool down attributes.
-    std::vector<PerExtruderAdjustments>    &per_extruder_adjustments)
+    std::vector<PerExtruderAdjustments>    &per_extruder_adjustments,
+    // Fan commands to be resolved by apply_fan_speeds() at positions of the returned G-code.
+    std::vector<FanEvent>                  &fan_events) const
 {
     // First sort the adjustment lines by of multiple extruders by their position in the source G-code.
     std::vector<const CoolingLine*> lines;
@@ -723,87 +803,10 @@ std::string CoolingBuffer::apply_layer_cooldown(
     // Second generate the adjusted G-code.
     std::string new_gcode;
     new_gcode.reserve(gcode.size() * 2);
-    bool overhang_fan_control= false;
-    int  overhang_fan_speed   = 0;
-
-    enum class SetFanType {
-        sfChangingLayer = 0,
-        sfChangingFilament,
-        sfImmediatelyApply
-    };
-
-    auto change_extruder_set_fan = [ this, layer_id, layer_time, &new_gcode, &overhang_fan_control, &overhang_fan_speed](SetFanType type) {
-#define EXTRUDER_CONFIG(OPT) m_config.OPT.get_at(m_current_extruder)
-        int fan_min_speed = EXTRUDER_CONFIG(fan_min_speed);
-        int fan_speed_new = EXTRUDER_CONFIG(reduce_fan_stop_start_freq) ? fan_min_speed : 0;
-        //BBS
-        int additional_fan_speed_new = EXTRUDER_CONFIG(additional_cooling_fan_speed);
-        int close_fan_the_first_x_layers = EXTRUDER_CONFIG(close_fan_the_first_x_layers);
-        // Is the fan speed ramp enabled?
-        int full_fan_speed_layer = EXTRUDER_CONFIG(full_fan_speed_layer);
-        if (close_fan_the_first_x_layers <= 0 && full_fan_speed_layer > 0) {
-            // When ramping up fan speed from close_fan_the_first_x_layers to full_fan_speed_layer, force close_fan_the_first_x_layers above zero,
-            // so there will be a zero fan speed at least at the 1st layer.
-            close_fan_the_first_x_layers = 1;
-        }
-        if (int(layer_id) >= close_fan_the_first_x_layers) {
-            int   fan_max_speed             = EXTRUDER_CONFIG(fan_max_speed);
-            float slow_down_layer_time = float(EXTRUDER_CONFIG(slow_down_layer_time));
-            float fan_cooling_layer_time      = float(EXTRUDER_CONFIG(fan_cooling_layer_time));
-            //BBS: always enable the fan speed interpolation according to layer time
-            //if (EXTRUDER_CONFIG(cooling)) {
-                if (layer_time < slow_down_layer_time) {
-                    // Layer time very short. Enable the fan to a full throttle.
-                    fan_speed_new = fan_max_speed;
-                } else if (layer_time < fan_cooling_layer_time) {
-                    // Layer time quite short. Enable the fan proportionally according to the current layer time.
-                    assert(layer_time >= slow_down_layer_time);
-                    double t = (layer_time - slow_down_layer_time) / (fan_cooling_layer_time - slow_down_layer_time);
-                    fan_speed_new = int(floor(t * fan_min_speed + (1. - t) * fan_max_speed) + 0.5);
-                }
-            //}
-            overhang_fan_speed   = EXTRUDER_CONFIG(overhang_fan_speed);
-            if (int(layer_id) >= close_fan_the_first_x_layers && int(layer_id) + 1 < full_fan_speed_layer) {
-                // Ramp up the fan speed from close_fan_the_first_x_layers to full_fan_speed_layer.
-                float factor = float(int(layer_id + 1) - close_fan_the_first_x_layers) / float(full_fan_speed_layer - close_fan_the_first_x_layers);
-                fan_speed_new    = std::clamp(int(float(fan_speed_new) * factor + 0.5f), 0, 255);
-                overhang_fan_speed = std::clamp(int(float(overhang_fan_speed) * factor + 0.5f), 0, 255);
-            }
-#undef EXTRUDER_CONFIG
-            overhang_fan_control= overhang_fan_speed > fan_speed_new;
-        } else {
-            overhang_fan_control= false;
-            overhang_fan_speed   = 0;
-            fan_speed_new      = 0;
-            additional_fan_speed_new = 0;
-        }
-        if (fan_speed_new != m_fan_speed) {
-            m_fan_speed = fan_speed_new;
-            //BBS
-            m_current_fan_speed = fan_speed_new;
-            if (type == SetFanType::sfImmediatelyApply)
-                new_gcode  += GCodeWriter::set_fan(m_config.gcode_flavor, m_fan_speed);
-            else if (type == SetFanType::sfChangingLayer)
-                this->m_set_fan_changing_layer = true;
-            //BBS: don't need to handle change filament, because we are always force to resume fan speed when filament change is finished
-        }
-        //BBS
-        if (additional_fan_speed_new != m_additional_fan_speed) {
-            m_additional_fan_speed = additional_fan_speed_new;
-            if (type == SetFanType::sfImmediatelyApply)
-                new_gcode += GCodeWriter::set_additional_fan(m_additional_fan_speed);
-            else if (type == SetFanType::sfChangingLayer)
-                this->m_set_addition_fan_changing_layer = true;
-            //BBS: don't need to handle change filament, because we are always force to resume fan speed when filament change is finished
-        }
-    };
+    unsigned int current_extruder = start_extruder;
 
     const char         *pos               = gcode.c_str();
     int                 current_feedrate  = 0;
-    //BBS
-    m_set_fan_changing_layer = false;
-    m_set_addition_fan_changing_layer = false;
-    change_extruder_set_fan(SetFanType::sfChangingLayer);
     for (const CoolingLine *line : lines) {
         const char *line_start  = gcode.c_str() + line->line_start;
         const char *line_end    = gcode.c_str() + line->line_end;
@@ -811,39 +814,14 @@ std::string CoolingBuffer::apply_layer_cooldown(
             new_gcode.append(pos, line_start - pos);
         if (line->type & CoolingLine::TYPE_SET_TOOL) {
             unsigned int new_extruder = (unsigned int)atoi(line_start + m_toolchange_prefix.size());
-            if (new_extruder != m_current_extruder) {
-                m_current_extruder = new_extruder;
-                change_extruder_set_fan(SetFanType::sfChangingFilament); //BBS: will force to resume fan speed when filament change is finished
+            if (new_extruder != current_extruder) {
+                current_extruder = new_extruder;
+                fan_events.push_back({ new_gcode.size(), CoolingLine::TYPE_SET_TOOL, new_extruder });
             }
             new_gcode.append(line_start, line_end - line_start);
-        } else if (line->type & CoolingLine::TYPE_OVERHANG_FAN_START) {
-            if (overhang_fan_control) {
-                //BBS
-                m_current_fan_speed = overhang_fan_speed;
-                new_gcode += GCodeWriter::set_fan(m_config.gcode_flavor, overhang_fan_speed);
-            }
-        } else if (line->type & CoolingLine::TYPE_OVERHANG_FAN_END) {
-            if (overhang_fan_control) {
-                //BBS
-                m_current_fan_speed = m_fan_speed;
-                new_gcode += GCodeWriter::set_fan(m_config.gcode_flavor, m_fan_speed);
-            }
-        } else if (line->type & CoolingLine::TYPE_FORCE_RESUME_FAN) {
-            //BBS: force to write a fan speed command again
-            if (m_current_fan_speed != -1)
-                new_gcode += GCodeWriter::set_fan(m_config.gcode_flavor, m_current_fan_speed);
-            if (m_additional_fan_speed != -1)
-                new_gcode += GCodeWriter::set_additional_fan(m_additional_fan_speed);
-        } else if (line->type & CoolingLine::TYPE_SET_FAN_CHANGING_LAYER) {
-            //BBS: check whether fan speed need to changed when change layer
-            if (m_current_fan_speed != -1 && m_set_fan_changing_layer) {
-                new_gcode += GCodeWriter::set_fan(m_config.gcode_flavor, m_current_fan_speed);
-                m_set_fan_changing_layer = false;
-            }
-            if (m_additional_fan_speed != -1 && m_set_addition_fan_changing_layer) {
-                new_gcode += GCodeWriter::set_additional_fan(m_additional_fan_speed);
-                m_set_addition_fan_changing_layer = false;
-            }
+        } else if (line->type & (CoolingLine::TYPE_OVERHANG_FAN_START | CoolingLine::TYPE_OVERHANG_FAN_END | CoolingLine::TYPE_FORCE_RESUME_FAN | CoolingLine::TYPE_SET_FAN_CHANGING_LAYER)) {
+            // The fan G-code depends on the fan state at the end of the preceding layers, it is emitted by apply_fan_speeds().
+            fan_events.push_back({ new_gcode.size(), unsigned(line->type), current_extruder });
         }
         else if (line->type & CoolingLine::TYPE_EXTRUDE_END) {
             // Just remove this comment.
@@ -938,4 +916,149 @@ std::string CoolingBuffer::apply_layer_cooldown(
     return new_gcode;
 }
 
+// Resolve the fan events of a batch with the fan state carried over from the preceding batches.
+// Returns the final G-code of the batch.
+std::string CoolingBuffer::apply_fan_speeds(Batch &&batch)
+{
+    if (batch.empty)
+        return std::string();
+
+    const size_t layer_id   = batch.layer_id;
+    const float  layer_time = batch.layer_time;
+    bool overhang_fan_control= false;
+    int  overhang_fan_speed   = 0;
+    // Fan G-code to be inserted at the current fan event.
+    std::string fan_gcode;
+
+    enum class SetFanType {
+        sfChangingLayer = 0,
+        sfChangingFilament,
+        sfImmediatelyApply
+    };
+
+    auto change_extruder_set_fan = [ this, layer_id, layer_time, &fan_gcode, &overhang_fan_control, &overhang_fan_speed](SetFanType type) {
+#define EXTRUDER_CONFIG(OPT) m_config.OPT.get_at(m_current_extruder)
+        int fan_min_speed = EXTRUDER_CONFIG(fan_min_speed);
+        int fan_speed_new = EXTRUDER_CONFIG(reduce_fan_stop_start_freq) ? fan_min_speed : 0;
+        //BBS
+        int additional_fan_speed_new = EXTRUDER_CONFIG(additional_cooling_fan_speed);
+        int close_fan_the_first_x_layers = EXTRUDER_CONFIG(close_fan_the_first_x_layers);
+        // Is the fan speed ramp enabled?
+        int full_fan_speed_layer = EXTRUDER_CONFIG(full_fan_speed_layer);
+        if (close_fan_the_first_x_layers <= 0 && full_fan_speed_layer > 0) {
+            // When ramping up fan speed from close_fan_the_first_x_layers to full_fan_speed_layer, force close_fan_the_first_x_layers above zero,
+            // so there will be a zero fan speed at least at the 1st layer.
+            close_fan_the_first_x_layers = 1;
+        }
+        if (int(layer_id) >= close_fan_the_first_x_layers) {
+            int   fan_max_speed             = EXTRUDER_CONFIG(fan_max_speed);
+            float slow_down_layer_time = float(EXTRUDER_CONFIG(slow_down_layer_time));
+            float fan_cooling_layer_time      = float(EXTRUDER_CONFIG(fan_cooling_layer_time));
+            //BBS: always enable the fan speed interpolation according to layer time
+            //if (EXTRUDER_CONFIG(cooling)) {
+                if (layer_time < slow_down_layer_time) {
+                    // Layer time very short. Enable the fan to a full throttle.
+                    fan_speed_new = fan_max_speed;
+                } else if (layer_time < fan_cooling_layer_time) {
+                    // Layer time quite short. Enable the fan proportionally according to the current layer time.
+                    assert(layer_time >= slow_down_layer_time);
+                    double t = (layer_time - slow_down_layer_time) / (fan_cooling_layer_time - slow_down_layer_time);
+                    fan_speed_new = int(floor(t * fan_min_speed + (1. - t) * fan_max_speed) + 0.5);
+                }
+            //}
+            overhang_fan_speed   = EXTRUDER_CONFIG(overhang_fan_speed);
+            if (int(layer_id) >= close_fan_the_first_x_layers && int(layer_id) + 1 < full_fan_speed_layer) {
+                // Ramp up the fan speed from close_fan_the_first_x_layers to full_fan_speed_layer.
+                float factor = float(int(layer_id + 1) - close_fan_the_first_x_layers) / float(full_fan_speed_layer - close_fan_the_first_x_layers);
+                fan_speed_new    = std::clamp(int(float(fan_speed_new) * factor + 0.5f), 0, 255);
+                overhang_fan_speed = std::clamp(int(float(overhang_fan_speed) * factor + 0.5f), 0, 255);
+            }
+#undef EXTRUDER_CONFIG
+            overhang_fan_control= overhang_fan_speed > fan_speed_new;
+        } else {
+            overhang_fan_control= false;
+            overhang_fan_speed   = 0;
+            fan_speed_new      = 0;
+            additional_fan_speed_new = 0;
+        }
+        if (fan_speed_new != m_fan_speed) {
+            m_fan_speed = fan_speed_new;
+            //BBS
+            m_current_fan_speed = fan_speed_new;
+            if (type == SetFanType::sfImmediatelyApply)
+                fan_gcode  += GCodeWriter::set_fan(m_config.gcode_flavor, m_fan_speed);
+            else if (type == SetFanType::sfChangingLayer)
+                this->m_set_fan_changing_layer = true;
+            //BBS: don't need to handle change filament, because we are always force to resume fan speed when filament change is finished
+        }
+        //BBS
+        if (additional_fan_speed_new != m_additional_fan_speed) {
+            m_additional_fan_speed = additional_fan_speed_new;
+            if (type == SetFanType::sfImmediatelyApply)
+                fan_gcode += GCodeWriter::set_additional_fan(m_additional_fan_speed);
+            else if (type == SetFanType::sfChangingLayer)
+                this->m_set_addition_fan_changing_layer = true;
+            //BBS: don't need to handle change filament, because we are always force to resume fan speed when filament change is finished
+        }
+    };
+
+    //BBS
+    m_set_fan_changing_layer = false;
+    m_set_addition_fan_changing_layer = false;
+    change_extruder_set_fan(SetFanType::sfChangingLayer);
+
+    // Most of the fan events don't emit any G-code, the batch G-code is only spliced if needed.
+    const std::string &gcode = batch.gcode;
+    std::string        new_gcode;
+    size_t             pos = 0;
+    for (const FanEvent &event : batch.fan_events) {
+        fan_gcode.clear();
+        if (event.type & CoolingLine::TYPE_SET_TOOL) {
+            if (event.extruder_id != m_current_extruder) {
+                m_current_extruder = event.extruder_id;
+                change_extruder_set_fan(SetFanType::sfChangingFilament); //BBS: will force to resume fan speed when filament change is finished
+            }
+        } else if (event.type & CoolingLine::TYPE_OVERHANG_FAN_START) {
+            if (overhang_fan_control) {
+                //BBS
+                m_current_fan_speed = overhang_fan_speed;
+                fan_gcode += GCodeWriter::set_fan(m_config.gcode_flavor, overhang_fan_speed);
+            }
+        } else if (event.type & CoolingLine::TYPE_OVERHANG_FAN_END) {
+            if (overhang_fan_control) {
+                //BBS
+                m_current_fan_speed = m_fan_speed;
+                fan_gcode += GCodeWriter::set_fan(m_config.gcode_flavor, m_fan_speed);
+            }
+        } else if (event.type & CoolingLine::TYPE_FORCE_RESUME_FAN) {
+            //BBS: force to write a fan speed command again
+            if (m_current_fan_speed != -1)
+                fan_gcode += GCodeWriter::set_fan(m_config.gcode_flavor, m_current_fan_speed);
+            if (m_additional_fan_speed != -1)
+                fan_gcode += GCodeWriter::set_additional_fan(m_additional_fan_speed);
+        } else if (event.type & CoolingLine::TYPE_SET_FAN_CHANGING_LAYER) {
+            //BBS: check whether fan speed need to changed when change layer
+            if (m_current_fan_speed != -1 && m_set_fan_changing_layer) {
+                fan_gcode += GCodeWriter::set_fan(m_config.gcode_flavor, m_current_fan_speed);
+                m_set_fan_changing_layer = false;
+            }
+            if (m_additional_fan_speed != -1 && m_set_addition_fan_changing_layer) {
+                fan_gcode += GCodeWriter::set_additional_fan(m_additional_fan_speed);
+                m_set_addition_fan_changing_layer = false;
+            }
+        }
+        if (! fan_gcode.empty()) {
+            if (new_gcode.empty())
+                new_gcode.reserve(gcode.size() + 256);
+            new_gcode.append(gcode, pos, event.position - pos);
+            new_gcode += fan_gcode;
+            pos = event.position;
+        }
+    }
+    if (new_gcode.empty())
+        return std::move(batch.gcode);
+    new_gcode.append(gcode, pos, std::string::npos);
+    return new_gcode;
+}
+
 } // namespace Slic3r
@@ -2,8 +2,10 @@
 #define slic3r_CoolingBuffer_hpp_
 
 #include "../libslic3r.h"
+#include <array>
 #include <map>
 #include <string>
+#include <vector>
 
 namespace Slic3r {
 
@@ -20,27 +22,92 @@ struct PerExtruderAdjustments;
 // For example, some materials may not like to print too slowly, while with some materials 
 // we may slow down significantly.
 //
+// In the G-code export pipeline the cooling buffer runs as a sequence of stages, see GCode::process_layers():
+// collect_layer() and carry_over() and apply_fan_speeds() are serial in order and they only carry over the collected G-code,
+// the position / extruder at the start of the next batch and the fan state.
+// parse_batch() and slow_down_batch(), which scan and rewrite the G-code text, run in parallel over multiple batches.
 class CoolingBuffer {
 public:
+    // A G-code line of interest to the cooling buffer, parsed independently of the preceding layers.
+    struct ParsedLine {
+        // CoolingLine::Type flags derived from the G-code text.
+        unsigned int    type { 0 };
+        // Bit mask of the axes (X,Y,Z,E,F,I,J) set by a G0/G1/G2/G3/G92 line.
+        unsigned int    axes { 0 };
+        size_t          line_start { 0 };
+        size_t          line_end { 0 };
+        // Axis values set by the line, F already converted to mm/sec.
+        float           pos[7] {};
+        // Tool of a tool change line.
+        unsigned int    extruder_id { 0 };
+        // Duration of a G4 line.
+        float           time { 0.f };
+    };
+
+    // Fan related line of a batch, to be resolved by apply_fan_speeds() with the fan state carried over from the preceding batches.
+    struct FanEvent {
+        // Position in the slowed down G-code, where the fan G-code will be inserted.
+        size_t          position;
+        // CoolingLine::Type of the source line.
+        unsigned int    type;
+        // New tool of a tool change.
+        unsigned int    extruder_id;
+    };
+
+    // G-code collected until a flush (support layers followed by an object layer) passing through the stages of the pipeline.
+    struct Batch {
+        std::string                 gcode;
+        size_t                      layer_id { 0 };
+        // Nothing to process, the G-code of this layer was kept by the cooling buffer until the next flush.
+        bool                        empty { true };
+        // Filled in by parse_batch().
+        std::vector<ParsedLine>     lines;
+        // Last values of the axes set by this batch, NaN for axes not set.
+        std::array<float, 7>        end_pos;
+        // Tool active at the end of this batch or -1 if there is no tool change.
+        int                         end_extruder { -1 };
+        // Filled in by carry_over().
+        std::array<float, 7>        start_pos;
+        unsigned int                start_extruder { 0 };
+        // Filled in by slow_down_batch().
+        float                       layer_time { 0.f };
+        std::vector<FanEvent>       fan_events;
+    };
+
     CoolingBuffer(GCode &gcodegen);
     void        reset(const Vec3d &position);
-    void        set_current_extruder(unsigned int extruder_id) { m_current_extruder = extruder_id; }
+    void        set_current_extruder(unsigned int extruder_id) { m_current_extruder = extruder_id; m_batch_extruder = extruder_id; }
+    // Run all the stages sequentially.
     std::string process_layer(std::string &&gcode, size_t layer_id, bool flush);
 
+    // Serial: Collect the layer G-code, return a non-empty batch on flush.
+    Batch       collect_layer(std::string &&gcode, size_t layer_id, bool flush);
+    // Parallel: Scan the G-code for the lines to be adjusted.
+    void        parse_batch(Batch &batch) const;
+    // Serial: Assign the starting position and extruder of the batch, remember them at the end of the batch for the next one.
+    void        carry_over(Batch &batch);
+    // Parallel: Calculate the slow down and rewrite the feed rates of the batch.
+    void        slow_down_batch(Batch &batch) const;
+    // Serial: Insert the fan G-code, return the final G-code of the batch.
+    std::string apply_fan_speeds(Batch &&batch);
+
 private:
 	CoolingBuffer& operator=(const CoolingBuffer&) = delete;
-    std::vector<PerExtruderAdjustments> parse_layer_gcode(const std::string &gcode, std::vector<float> &current_pos) const;
-    float       calculate_layer_slowdown(std::vector<PerExtruderAdjustments> &per_extruder_adjustments);
-    // Apply slow down over G-code lines stored in per_extruder_adjustments, enable fan if needed.
+    std::vector<PerExtruderAdjustments> resolve_batch_lines(const Batch &batch) const;
+    float       calculate_layer_slowdown(std::vector<PerExtruderAdjustments> &per_extruder_adjustments) const;
+    // Apply slow down over G-code lines stored in per_extruder_adjustments, collect the fan events.
     // Returns the adjusted G-code.
-    std::string apply_layer_cooldown(const std::string &gcode, size_t layer_id, float layer_time, std::vector<PerExtruderAdjustments> &per_extruder_adjustments);
+    std::string apply_layer_cooldown(const std::string &gcode, unsigned int start_extruder, std::vector<PerExtruderAdjustments> &per_extruder_adjustments, std::vector<FanEvent> &fan_events) const;
 
     // G-code snippet cached for the support layers preceding an object layer.
     std::string                 m_gcode;
     // Internal data.
     // BBS: X,Y,Z,E,F,I,J
     std::vector<char>           m_axis;
-    std::vector<float>          m_current_pos;
+    // Position at the start of the next batch.
+    std::array<float, 7>        m_current_pos;
+    // Extruder at the start of the next batch.
+    unsigned int                m_batch_extruder { 0 };
     // Current known fan speed or -1 if not known yet.
     int                         m_fan_speed;
     int                         m_additional_fan_speed;
@@ -53,6 +120,7 @@ private:
     // Referencs GCode::m_config, which is FullPrintConfig. While the PrintObjectConfig slice of FullPrintConfig is being modified,
     // the PrintConfig slice of FullPrintConfig is constant, thus no thread synchronization is required.
     const PrintConfig          &m_config;
+    // Extruder controlling the fan, updated by apply_fan_speeds().
     unsigned int                m_current_extruder;
 
     // Old logic: proportional.
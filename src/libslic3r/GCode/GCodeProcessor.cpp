@@ -361,7 +361,7 @@ void GCodeProcessor::TimeProcessor::reset()
     machines[static_cast<size_t>(PrintEstimatedStatistics::ETimeMode::Normal)].enabled = true;
 }
 
-void GCodeProcessor::TimeProcessor::post_process(const std::string& filename, std::vector<GCodeProcessorResult::MoveVertex>& moves, std::vector<size_t>& lines_ends, size_t total_layer_num)
+void GCodeProcessor::TimeProcessor::post_process(const std::string& filename, GCodeProcessorResult::MoveVertexStore& moves, std::vector<size_t>& lines_ends, size_t total_layer_num)
 {
     FilePtr in{ boost::nowide::fopen(filename.c_str(), "rb") };
     if (in.f == nullptr)
@@ -665,12 +665,13 @@ void GCodeProcessor::TimeProcessor::post_process(const std::string& filename, st
     // updates moves' gcode ids which have been modified by the insertion of the M73 lines
     unsigned int curr_offset_id = 0;
     unsigned int total_offset = 0;
-    for (GCodeProcessorResult::MoveVertex& move : moves) {
-        while (curr_offset_id < static_cast<unsigned int>(offsets.size()) && offsets[curr_offset_id].first <= move.gcode_id) {
+    for (size_t i = 0; i < moves.size(); ++i) {
+        const unsigned int gcode_id = moves.gcode_id(i);
+        while (curr_offset_id < static_cast<unsigned int>(offsets.size()) && offsets[curr_offset_id].first <= gcode_id) {
             total_offset += offsets[curr_offset_id].second;
             ++curr_offset_id;
         }
-        move.gcode_id += total_offset;
+        moves.set_gcode_id(i, gcode_id + total_offset);
     }
 
     if (rename_file(out_path, filename)) {
@@ -761,7 +762,7 @@ void GCodeProcessorResult::reset() {
     //BBS: add mutex for protection of gcode result
     lock();
 
-    moves = std::vector<GCodeProcessorResult::MoveVertex>();
+    moves = GCodeProcessorResult::MoveVertexStore();
     printable_area = Pointfs();
     //BBS: add bed exclude area
     bed_exclude_area = Pointfs();
@@ -814,6 +815,226 @@ void GCodeProcessorResult::reset() {
 }
 #endif // ENABLE_GCODE_VIEWER_STATISTICS
 
+void GCodeProcessorResult::MoveVertexStore::reserve(size_t n)
+{
+    m_gcode_ids.reserve(n);
+    m_types.reserve(n);
+    m_roles.reserve(n);
+    m_path_types.reserve(n);
+    m_positions.reserve(n);
+    m_delta_extruders.reserve(n);
+    m_feedrates.reserve(n);
+    m_widths.reserve(n);
+    m_heights.reserve(n);
+    m_mm3_per_mms.reserve(n);
+}
+
+void GCodeProcessorResult::MoveVertexStore::clear()
+{
+    this->truncate(0);
+    m_layer_durations.clear();
+    m_has_layer_durations = false;
+}
+
+void GCodeProcessorResult::MoveVertexStore::shrink_to_fit()
+{
+    m_gcode_ids.shrink_to_fit();
+    m_types.shrink_to_fit();
+    m_roles.shrink_to_fit();
+    m_path_types.shrink_to_fit();
+    m_positions.shrink_to_fit();
+    m_delta_extruders.shrink_to_fit();
+    m_feedrates.shrink_to_fit();
+    m_widths.shrink_to_fit();
+    m_heights.shrink_to_fit();
+    m_mm3_per_mms.shrink_to_fit();
+    m_extruder_ids.shrink_to_fit();
+    m_cp_color_ids.shrink_to_fit();
+    m_fan_speeds.shrink_to_fit();
+    m_temperatures.shrink_to_fit();
+    m_layer_ids.shrink_to_fit();
+    m_arcs.shrink_to_fit();
+    m_points.shrink_to_fit();
+    m_layer_durations.shrink_to_fit();
+}
+
+size_t GCodeProcessorResult::MoveVertexStore::memsize() const
+{
+    return SLIC3R_STDVEC_MEMSIZE(m_gcode_ids, uint32_t) + SLIC3R_STDVEC_MEMSIZE(m_types, EMoveType) + SLIC3R_STDVEC_MEMSIZE(m_roles, ExtrusionRole) +
+        SLIC3R_STDVEC_MEMSIZE(m_path_types, EMovePathType) + SLIC3R_STDVEC_MEMSIZE(m_positions, Vec3f) + SLIC3R_STDVEC_MEMSIZE(m_delta_extruders, float) +
+        m_feedrates.memsize() + m_widths.memsize() + m_heights.memsize() + m_mm3_per_mms.memsize() + m_extruder_ids.memsize() + m_cp_color_ids.memsize() + m_fan_speeds.memsize() +
+        m_temperatures.memsize() + m_layer_ids.memsize() + SLIC3R_STDVEC_MEMSIZE(m_arcs, Arc) + SLIC3R_STDVEC_MEMSIZE(m_points, Vec3f) +
+        SLIC3R_STDVEC_MEMSIZE(m_layer_durations, float);
+}
+
+void GCodeProcessorResult::MoveVertexStore::push_back(const MoveVertex& move)
+{
+    const size_t id = this->size();
+    m_gcode_ids.push_back(move.gcode_id);
+    m_types.push_back(move.type);
+    m_roles.push_back(move.extrusion_role);
+    m_path_types.push_back(move.move_path_type);
+    m_positions.push_back(move.position);
+    m_delta_extruders.push_back(move.delta_extruder);
+    m_feedrates.push(move.feedrate);
+    m_widths.push(move.width);
+    m_heights.push(move.height);
+    m_mm3_per_mms.push(move.mm3_per_mm);
+    m_extruder_ids.push(id, move.extruder_id);
+    m_cp_color_ids.push(id, move.cp_color_id);
+    m_fan_speeds.push(id, move.fan_speed);
+    m_temperatures.push(id, move.temperature);
+    m_layer_ids.push(id, uint32_t(move.layer_duration));
+    if (move.is_arc_move()) {
+        const InterpolationPoints &points = move.interpolation_points;
+        Arc arc { uint32_t(id), move.arc_center_position, uint32_t(m_points.size()), uint32_t(m_points.size() + points.size()) };
+        if (!points.empty() && points.begin() >= m_points.data() && points.begin() < m_points.data() + m_points.size()) {
+            // The points of a move read from this store, copy them before the pool reallocates.
+            std::vector<Vec3f> copy(points.begin(), points.end());
+            m_points.insert(m_points.end(), copy.begin(), copy.end());
+        } else
+            m_points.insert(m_points.end(), points.begin(), points.end());
+        m_arcs.push_back(arc);
+    }
+}
+
+void GCodeProcessorResult::MoveVertexStore::erase(size_t id)
+{
+    assert(id < this->size());
+    // Moves are only erased while processing, before the layer durations replace the layer ids.
+    assert(!m_has_layer_durations);
+    const size_t size = this->size();
+    m_gcode_ids.erase(m_gcode_ids.begin() + id);
+    m_types.erase(m_types.begin() + id);
+    m_roles.erase(m_roles.begin() + id);
+    m_path_types.erase(m_path_types.begin() + id);
+    m_positions.erase(m_positions.begin() + id);
+    m_delta_extruders.erase(m_delta_extruders.begin() + id);
+    m_feedrates.erase(id);
+    m_widths.erase(id);
+    m_heights.erase(id);
+    m_mm3_per_mms.erase(id);
+    m_extruder_ids.erase(id, size);
+    m_cp_color_ids.erase(id, size);
+    m_fan_speeds.erase(id, size);
+    m_temperatures.erase(id, size);
+    m_layer_ids.erase(id, size);
+    auto     arc           = std::lower_bound(m_arcs.begin(), m_arcs.end(), uint32_t(id), [](const Arc &arc, uint32_t id) { return arc.move_id < id; });
+    uint32_t points_erased = 0;
+    if (arc != m_arcs.end() && arc->move_id == id) {
+        points_erased = arc->points_end - arc->points_begin;
+        m_points.erase(m_points.begin() + arc->points_begin, m_points.begin() + arc->points_end);
+        arc = m_arcs.erase(arc);
+    }
+    for (; arc != m_arcs.end(); ++arc) {
+        --arc->move_id;
+        arc->points_begin -= points_erased;
+        arc->points_end   -= points_erased;
+    }
+}
+
+GCodeProcessorResult::InterpolationPoints GCodeProcessorResult::MoveVertexStore::interpolation_points(size_t id) const
+{
+    if (!this->is_arc_move(id))
+        return {};
+    auto arc = std::lower_bound(m_arcs.begin(), m_arcs.end(), uint32_t(id), [](const Arc &arc, uint32_t id) { return arc.move_id < id; });
+    assert(arc != m_arcs.end() && arc->move_id == id);
+    return InterpolationPoints(m_points.data() + arc->points_begin, arc->points_end - arc->points_begin);
+}
+
+void GCodeProcessorResult::MoveVertexStore::seek(Cursor &cursor, size_t id) const
+{
+    cursor.id          = id;
+    cursor.extruder_id = m_extruder_ids.find(id);
+    cursor.cp_color_id = m_cp_color_ids.find(id);
+    cursor.fan_speed   = m_fan_speeds.find(id);
+    cursor.temperature = m_temperatures.find(id);
+    cursor.layer_id    = m_layer_ids.find(id);
+    cursor.arc         = uint32_t(std::lower_bound(m_arcs.begin(), m_arcs.end(), uint32_t(id), [](const Arc &arc, uint32_t id) { return arc.move_id < id; }) - m_arcs.begin());
+}
+
+void GCodeProcessorResult::MoveVertexStore::step(Cursor &cursor, size_t id) const
+{
+    cursor.id = id;
+    m_extruder_ids.step(cursor.extruder_id, id);
+    m_cp_color_ids.step(cursor.cp_color_id, id);
+    m_fan_speeds.step(cursor.fan_speed, id);
+    m_temperatures.step(cursor.temperature, id);
+    m_layer_ids.step(cursor.layer_id, id);
+    while (cursor.arc < m_arcs.size() && m_arcs[cursor.arc].move_id < id)
+        ++cursor.arc;
+    while (cursor.arc > 0 && m_arcs[cursor.arc - 1].move_id >= id)
+        --cursor.arc;
+}
+
+GCodeProcessorResult::MoveVertex GCodeProcessorResult::MoveVertexStore::get(const Cursor &cursor) const
+{
+    const size_t id = cursor.id;
+    assert(id < this->size());
+    MoveVertex move;
+    move.gcode_id       = m_gcode_ids[id];
+    move.type           = m_types[id];
+    move.extrusion_role = m_roles[id];
+    move.extruder_id    = m_extruder_ids.values[cursor.extruder_id];
+    move.cp_color_id    = m_cp_color_ids.values[cursor.cp_color_id];
+    move.position       = m_positions[id];
+    move.delta_extruder = m_delta_extruders[id];
+    move.feedrate       = m_feedrates.get(id);
+    move.width          = m_widths.get(id);
+    move.height         = m_heights.get(id);
+    move.mm3_per_mm     = m_mm3_per_mms.get(id);
+    move.fan_speed      = m_fan_speeds.values[cursor.fan_speed];
+    move.temperature    = m_temperatures.values[cursor.temperature];
+    move.time           = float(id);
+    const uint32_t layer_id = m_layer_ids.values[cursor.layer_id];
+    if (! m_has_layer_durations)
+        move.layer_duration = float(layer_id);
+    else if (layer_id > 0 && layer_id <= m_layer_durations.size())
+        move.layer_duration = m_layer_durations[layer_id - 1];
+    move.move_path_type = m_path_types[id];
+    if (move.is_arc_move()) {
+        const Arc &arc = m_arcs[cursor.arc];
+        assert(cursor.arc < m_arcs.size() && arc.move_id == id);
+        move.arc_center_position  = arc.center;
+        move.interpolation_points = InterpolationPoints(m_points.data() + arc.points_begin, arc.points_end - arc.points_begin);
+    }
+    return move;
+}
+
+void GCodeProcessorResult::MoveVertexStore::set_width_height(size_t id, float width, float height)
+{
+    m_widths.set(id, width);
+    m_heights.set(id, height);
+}
+
+void GCodeProcessorResult::MoveVertexStore::set_layer_durations(std::vector<float> layer_durations)
+{
+    m_layer_durations     = std::move(layer_durations);
+    m_has_layer_durations = true;
+}
+
+void GCodeProcessorResult::MoveVertexStore::truncate(size_t n)
+{
+    m_gcode_ids.resize(std::min(n, m_gcode_ids.size()));
+    m_types.resize(m_gcode_ids.size());
+    m_roles.resize(m_gcode_ids.size());
+    m_path_types.resize(m_gcode_ids.size());
+    m_positions.resize(m_gcode_ids.size());
+    m_delta_extruders.resize(m_gcode_ids.size());
+    m_feedrates.truncate(m_gcode_ids.size());
+    m_widths.truncate(m_gcode_ids.size());
+    m_heights.truncate(m_gcode_ids.size());
+    m_mm3_per_mms.truncate(m_gcode_ids.size());
+    m_extruder_ids.truncate(n);
+    m_cp_color_ids.truncate(n);
+    m_fan_speeds.truncate(n);
+    m_temperatures.truncate(n);
+    m_layer_ids.truncate(n);
+    auto arc = std::lower_bound(m_arcs.begin(), m_arcs.end(), uint32_t(n), [](const Arc &arc, uint32_t id) { return arc.move_id < id; });
+    m_points.resize(arc == m_arcs.end() ? m_points.size() : arc->points_begin);
+    m_arcs.erase(arc, m_arcs.end());
+}
+
 const std::vector<std::pair<GCodeProcessor::EProducer, std::string>> GCodeProcessor::Producers = {
     //BBS: BambuStudio is also "bambu". Otherwise the time estimation didn't work.
     //FIXME: Workaround and should be handled when do removing-bambu
@@ -1371,7 +1592,8 @@ void GCodeProcessor::process_file(const std::string& filename, std::function<voi
     // 1st move must be a dummy move
     m_result.moves.emplace_back(GCodeProcessorResult::MoveVertex());
     size_t parse_line_callback_cntr = 10000;
-    m_parser.parse_file(filename, [this, cancel_callback, &parse_line_callback_cntr](GCodeReader& reader, const GCodeReader::GCodeLine& line) {
+    // The file is tokenized in parallel in chunks cut at the layer changes, the lines are processed sequentially in the file order.
+    m_parser.parse_file_parallel(filename, [this, cancel_callback, &parse_line_callback_cntr](GCodeReader& reader, const GCodeReader::GCodeLine& line) {
         if (-- parse_line_callback_cntr == 0) {
             // Don't call the cancel_callback() too often, do it every at every 10000'th line.
             parse_line_callback_cntr = 10000;
@@ -1379,7 +1601,7 @@ void GCodeProcessor::process_file(const std::string& filename, std::function<voi
                 cancel_callback();
         }
         this->process_gcode_line(line, true);
-    }, m_result.lines_ends);
+    }, m_result.lines_ends, ";" + reserved_tag(ETags::Layer_Change));
 
     // Don't post-process the G-code to update time stamps.
     this->finalize(false);
@@ -1400,10 +1622,10 @@ void GCodeProcessor::initialize(const std::string& filename)
     m_result.moves.emplace_back(GCodeProcessorResult::MoveVertex());
 }
 
-void GCodeProcessor::process_buffer(const std::string &buffer)
+void GCodeProcessor::process_buffer(const char *begin, const char *end)
 {
     //FIXME maybe cache GCodeLine gline to be over multiple parse_buffer() invocations.
-    m_parser.parse_buffer(buffer, [this](GCodeReader&, const GCodeReader::GCodeLine& line) {
+    m_parser.parse_buffer(begin, end, [this](GCodeReader&, const GCodeReader::GCodeLine& line) {
         this->process_gcode_line(line, false);
     });
 }
@@ -1411,11 +1633,9 @@ void GCodeProcessor::process_buffer(const std::string &buffer)
 void GCodeProcessor::finalize(bool post_process)
 {
     // update width/height of wipe moves
-    for (GCodeProcessorResult::MoveVertex& move : m_result.moves) {
-        if (move.type == EMoveType::Wipe) {
-            move.width = Wipe_Width;
-            move.height = Wipe_Height;
-        }
+    for (size_t i = 0; i < m_result.moves.size(); ++i) {
+        if (m_result.moves.type(i) == EMoveType::Wipe)
+            m_result.moves.set_width_height(i, Wipe_Width, Wipe_Height);
     }
 
     // process the time blocks
@@ -1436,15 +1656,13 @@ void GCodeProcessor::finalize(bool post_process)
     auto prepare_time = (it != time_mode.roles_times.end()) ? it->second : 0.0f;
 
     //update times for results
-    for (size_t i = 0; i < m_result.moves.size(); i++) {
-        //field layer_duration contains the layer id for the move in which the layer_duration has to be set.
-        size_t layer_id = size_t(m_result.moves[i].layer_duration);
-        std::vector<float>& layer_times = m_result.print_statistics.modes[static_cast<size_t>(PrintEstimatedStatistics::ETimeMode::Normal)].layers_times;
-        if (layer_times.size() > layer_id - 1 && layer_id > 0)
-            m_result.moves[i].layer_duration = layer_id == 1 ? std::max(0.f,layer_times[layer_id - 1] - prepare_time) : layer_times[layer_id - 1];
-        else
-            m_result.moves[i].layer_duration = 0;
-    }
+    //field layer_duration contains the layer id for the move in which the layer_duration has to be set.
+    const std::vector<float>& layer_times = m_result.print_statistics.modes[static_cast<size_t>(PrintEstimatedStatistics::ETimeMode::Normal)].layers_times;
+    std::vector<float> layer_durations(layer_times);
+    if (!layer_durations.empty())
+        layer_durations.front() = std::max(0.f, layer_durations.front() - prepare_time);
+    m_result.moves.set_layer_durations(std::move(layer_durations));
+    m_result.moves.shrink_to_fit();
 
 #if ENABLE_GCODE_VIEWER_DATA_CHECKING
     std::cout << "\n";
@@ -8,7 +8,10 @@
 #include "libslic3r/CustomGCode.hpp"
 
 #include <cstdint>
+#include <algorithm>
 #include <array>
+#include <cassert>
+#include <iterator>
 #include <vector>
 #include <mutex>
 #include <string>
@@ -126,6 +129,24 @@ namespace Slic3r {
             }
         };
 
+        // Non owning view of the arc interpolation points of a move.
+        // The points of the moves stored into a MoveVertexStore live in its shared pool.
+        struct InterpolationPoints
+        {
+            const Vec3f* points{ nullptr };
+            size_t       count{ 0 };
+
+            InterpolationPoints() = default;
+            InterpolationPoints(const Vec3f* points, size_t count) : points(points), count(count) {}
+            InterpolationPoints(const std::vector<Vec3f>& points) : points(points.data()), count(points.size()) {}
+
+            size_t       size() const { return count; }
+            bool         empty() const { return count == 0; }
+            const Vec3f& operator[](size_t id) const { assert(id < count); return points[id]; }
+            const Vec3f* begin() const { return points; }
+            const Vec3f* end() const { return points + count; }
+        };
+
         struct MoveVertex
         {
             unsigned int gcode_id{ 0 };
@@ -141,14 +162,14 @@ namespace Slic3r {
             float mm3_per_mm{ 0.0f };
             float fan_speed{ 0.0f }; // percentage
             float temperature{ 0.0f }; // Celsius degrees
-            float time{ 0.0f }; // s
+            float time{ 0.0f }; // s (index of the move)
             float layer_duration{ 0.0f }; // s (layer id before finalize)
 
 
             //BBS: arc move related data
             EMovePathType move_path_type{ EMovePathType::Noop_move };
             Vec3f arc_center_position{ Vec3f::Zero() };      // mm
-            std::vector<Vec3f> interpolation_points;     // interpolation points of arc for drawing
+            InterpolationPoints interpolation_points;    // interpolation points of arc for drawing
 
             float volumetric_rate() const { return feedrate * mm3_per_mm; }
             //BBS: new function to support arc move
@@ -160,6 +181,259 @@ namespace Slic3r {
             }
         };
 
+        // Column store of the moves, one array per field.
+        // Fields changing rarely (extruder, color, fan speed, temperature, layer) are stored as runs and the arc data
+        // in side tables. Feedrate, width, height and mm3_per_mm are stored as 16 bit fixed point:
+        //   feedrate   step 0.01 mm/s,      error <= 0.005 mm/s,     up to 655.34 mm/s,
+        //   width      step 0.0001 mm,      error <= 0.00005 mm,     up to 6.5534 mm,
+        //   height     step 0.0001 mm,      error <= 0.00005 mm,     up to 6.5534 mm,
+        //   mm3_per_mm step 0.00001 mm3/mm, error <= 0.000005 mm3/mm, up to 0.65534 mm3/mm,
+        // the values out of range are kept exact in a side table.
+        // A move takes 31 bytes plus the runs and the arcs, against 88 bytes for a MoveVertex (96 bytes and a heap
+        // allocated vector per arc before the arcs were moved to the side table), so about 2.8x (3.1x) smaller.
+        // The moves are returned by value. operator[] looks up every run of the move, loops over the moves should use
+        // the const_iterator, which steps through the runs, or the accessors of the single fields.
+        class MoveVertexStore
+        {
+            // Indices of the runs and of the arc of a move.
+            struct Cursor
+            {
+                size_t   id{ 0 };
+                uint32_t extruder_id{ 0 };
+                uint32_t cp_color_id{ 0 };
+                uint32_t fan_speed{ 0 };
+                uint32_t temperature{ 0 };
+                uint32_t layer_id{ 0 };
+                // First arc with move_id >= id.
+                uint32_t arc{ 0 };
+            };
+
+        public:
+            class const_iterator
+            {
+            public:
+                using iterator_category = std::random_access_iterator_tag;
+                using value_type        = MoveVertex;
+                using difference_type   = std::ptrdiff_t;
+                using pointer           = void;
+                using reference         = MoveVertex;
+
+                const_iterator() = default;
+                const_iterator(const MoveVertexStore* store, size_t id) : m_store(store) { store->seek(m_cursor, id); }
+
+                MoveVertex      operator*() const { return m_store->get(m_cursor); }
+                MoveVertex      operator[](difference_type n) const { return (*m_store)[m_cursor.id + n]; }
+                const_iterator& operator++() { m_store->step(m_cursor, m_cursor.id + 1); return *this; }
+                const_iterator  operator++(int) { const_iterator out = *this; ++(*this); return out; }
+                const_iterator& operator--() { m_store->step(m_cursor, m_cursor.id - 1); return *this; }
+                const_iterator  operator--(int) { const_iterator out = *this; --(*this); return out; }
+                const_iterator& operator+=(difference_type n) { m_store->seek(m_cursor, m_cursor.id + n); return *this; }
+                const_iterator& operator-=(difference_type n) { m_store->seek(m_cursor, m_cursor.id - n); return *this; }
+                const_iterator  operator+(difference_type n) const { return { m_store, m_cursor.id + n }; }
+                const_iterator  operator-(difference_type n) const { return { m_store, m_cursor.id - n }; }
+                difference_type operator-(const const_iterator& rhs) const { return difference_type(m_cursor.id) - difference_type(rhs.m_cursor.id); }
+                bool            operator==(const const_iterator& rhs) const { return m_cursor.id == rhs.m_cursor.id; }
+                bool            operator!=(const const_iterator& rhs) const { return m_cursor.id != rhs.m_cursor.id; }
+                bool            operator<(const const_iterator& rhs) const { return m_cursor.id < rhs.m_cursor.id; }
+                bool            operator>(const const_iterator& rhs) const { return m_cursor.id > rhs.m_cursor.id; }
+                bool            operator<=(const const_iterator& rhs) const { return m_cursor.id <= rhs.m_cursor.id; }
+                bool            operator>=(const const_iterator& rhs) const { return m_cursor.id >= rhs.m_cursor.id; }
+
+            private:
+                const MoveVertexStore* m_store{ nullptr };
+                Cursor                 m_cursor;
+            };
+
+            size_t size() const { return m_gcode_ids.size(); }
+            bool   empty() const { return m_gcode_ids.empty(); }
+            void   reserve(size_t n);
+            void   clear();
+            void   shrink_to_fit();
+            // Memory used by the store, in bytes.
+            size_t memsize() const;
+
+            // The layer_duration of the pushed move is its layer id, see set_layer_durations().
+            void push_back(const MoveVertex& move);
+            void emplace_back(const MoveVertex& move) { this->push_back(move); }
+            void erase(size_t id);
+
+            MoveVertex     operator[](size_t id) const { Cursor cursor; this->seek(cursor, id); return this->get(cursor); }
+            MoveVertex     back() const { assert(!empty()); return (*this)[size() - 1]; }
+            const_iterator begin() const { return { this, 0 }; }
+            const_iterator end() const { return { this, size() }; }
+
+            unsigned int        gcode_id(size_t id) const { return m_gcode_ids[id]; }
+            EMoveType           type(size_t id) const { return m_types[id]; }
+            ExtrusionRole       extrusion_role(size_t id) const { return m_roles[id]; }
+            EMovePathType       move_path_type(size_t id) const { return m_path_types[id]; }
+            const Vec3f&        position(size_t id) const { return m_positions[id]; }
+            float               delta_extruder(size_t id) const { return m_delta_extruders[id]; }
+            float               feedrate(size_t id) const { return m_feedrates.get(id); }
+            float               width(size_t id) const { return m_widths.get(id); }
+            float               height(size_t id) const { return m_heights.get(id); }
+            float               mm3_per_mm(size_t id) const { return m_mm3_per_mms.get(id); }
+            unsigned char       extruder_id(size_t id) const { return m_extruder_ids.at(id); }
+            bool                is_arc_move(size_t id) const { return m_path_types[id] == EMovePathType::Arc_move_ccw || m_path_types[id] == EMovePathType::Arc_move_cw; }
+            // Interpolation points of an arc move, empty for the other moves.
+            InterpolationPoints interpolation_points(size_t id) const;
+
+            void set_gcode_id(size_t id, unsigned int gcode_id) { m_gcode_ids[id] = gcode_id; }
+            void set_width_height(size_t id, float width, float height);
+            // Durations of the layers, indexed by layer id - 1. Replaces the layer ids returned as layer_duration.
+            void set_layer_durations(std::vector<float> layer_durations);
+
+        private:
+            // Values of a rarely changing field, stored once per run of equal values.
+            template<typename T>
+            struct Runs
+            {
+                std::vector<uint32_t> starts;
+                std::vector<T>        values;
+
+                void push(size_t id, const T& value) {
+                    if (values.empty() || !(values.back() == value)) {
+                        starts.push_back(uint32_t(id));
+                        values.push_back(value);
+                    }
+                }
+                // Index of the run containing the move id.
+                uint32_t find(size_t id) const {
+                    return starts.empty() ? 0 : uint32_t(std::upper_bound(starts.begin(), starts.end(), uint32_t(id)) - starts.begin() - 1);
+                }
+                // Moves the index of a run to the run containing the move id, in constant time for the neighbour moves.
+                void step(uint32_t& run, size_t id) const {
+                    while (run + 1 < starts.size() && starts[run + 1] <= id)
+                        ++run;
+                    while (run > 0 && starts[run] > id)
+                        --run;
+                }
+                const T& at(size_t id) const {
+                    assert(!starts.empty());
+                    return values[this->find(id)];
+                }
+                // Removes the move id from a store of size moves.
+                void erase(size_t id, size_t size) {
+                    const uint32_t run     = this->find(id);
+                    const size_t   run_end = run + 1 < starts.size() ? starts[run + 1] : size;
+                    if (run_end - starts[run] == 1) {
+                        starts.erase(starts.begin() + run);
+                        values.erase(values.begin() + run);
+                        // Merge the runs around the removed one.
+                        if (run > 0 && run < starts.size() && values[run - 1] == values[run]) {
+                            starts.erase(starts.begin() + run);
+                            values.erase(values.begin() + run);
+                        }
+                    }
+                    for (size_t i = run; i < starts.size(); ++i)
+                        if (starts[i] > id)
+                            --starts[i];
+                }
+                void truncate(size_t n) {
+                    size_t cnt = std::lower_bound(starts.begin(), starts.end(), uint32_t(n)) - starts.begin();
+                    starts.resize(cnt);
+                    values.resize(cnt);
+                }
+                void clear() { starts.clear(); values.clear(); }
+                void shrink_to_fit() { starts.shrink_to_fit(); values.shrink_to_fit(); }
+                size_t memsize() const { return starts.capacity() * sizeof(uint32_t) + values.capacity() * sizeof(T); }
+            };
+
+            // Values stored as code / Scale with code a 16 bit integer, error <= 0.5 / Scale.
+            // The values out of [0, 65534 / Scale] (or not finite) are kept exact in a side table sorted by move id.
+            template<int Scale>
+            struct Fixed16
+            {
+                static constexpr uint16_t Exact = 0xFFFF;
+
+                std::vector<uint16_t>                  codes;
+                std::vector<std::pair<uint32_t, float>> exact;
+
+                void push(float value) {
+                    const float code = value * float(Scale);
+                    if (code >= 0.f && code < float(Exact) - 0.5f)
+                        codes.push_back(uint16_t(code + 0.5f));
+                    else {
+                        exact.emplace_back(uint32_t(codes.size()), value);
+                        codes.push_back(Exact);
+                    }
+                }
+                float get(size_t id) const {
+                    return codes[id] == Exact ? this->find_exact(id)->second : float(codes[id]) / float(Scale);
+                }
+                void set(size_t id, float value) {
+                    if (codes[id] == Exact)
+                        exact.erase(this->find_exact(id));
+                    const float code = value * float(Scale);
+                    if (code >= 0.f && code < float(Exact) - 0.5f)
+                        codes[id] = uint16_t(code + 0.5f);
+                    else {
+                        exact.insert(this->lower_bound(id), { uint32_t(id), value });
+                        codes[id] = Exact;
+                    }
+                }
+                void erase(size_t id) {
+                    auto it = this->lower_bound(id);
+                    if (codes[id] == Exact)
+                        it = exact.erase(it);
+                    for (; it != exact.end(); ++it)
+                        --it->first;
+                    codes.erase(codes.begin() + id);
+                }
+                void truncate(size_t n) {
+                    exact.erase(this->lower_bound(n), exact.end());
+                    codes.resize(n);
+                }
+                void reserve(size_t n) { codes.reserve(n); }
+                void clear() { codes.clear(); exact.clear(); }
+                void shrink_to_fit() { codes.shrink_to_fit(); exact.shrink_to_fit(); }
+                size_t memsize() const { return codes.capacity() * sizeof(uint16_t) + exact.capacity() * sizeof(std::pair<uint32_t, float>); }
+
+            private:
+                std::vector<std::pair<uint32_t, float>>::iterator lower_bound(size_t id) {
+                    return std::lower_bound(exact.begin(), exact.end(), uint32_t(id), [](const std::pair<uint32_t, float>& e, uint32_t id) { return e.first < id; });
+                }
+                std::vector<std::pair<uint32_t, float>>::const_iterator find_exact(size_t id) const {
+                    auto it = std::lower_bound(exact.begin(), exact.end(), uint32_t(id), [](const std::pair<uint32_t, float>& e, uint32_t id) { return e.first < id; });
+                    assert(it != exact.end() && it->first == id);
+                    return it;
+                }
+            };
+
+            struct Arc
+            {
+                uint32_t move_id;
+                Vec3f    center;
+                uint32_t points_begin;
+                uint32_t points_end;
+            };
+
+            void       seek(Cursor& cursor, size_t id) const;
+            void       step(Cursor& cursor, size_t id) const;
+            MoveVertex get(const Cursor& cursor) const;
+            void       truncate(size_t n);
+
+            std::vector<uint32_t>      m_gcode_ids;
+            std::vector<EMoveType>     m_types;
+            std::vector<ExtrusionRole> m_roles;
+            std::vector<EMovePathType> m_path_types;
+            std::vector<Vec3f>         m_positions;
+            std::vector<float>         m_delta_extruders;
+            Fixed16<100>               m_feedrates;
+            Fixed16<10000>             m_widths;
+            Fixed16<10000>             m_heights;
+            Fixed16<100000>            m_mm3_per_mms;
+            Runs<unsigned char>        m_extruder_ids;
+            Runs<unsigned char>        m_cp_color_ids;
+            Runs<float>                m_fan_speeds;
+            Runs<float>                m_temperatures;
+            Runs<uint32_t>             m_layer_ids;
+            // Arc moves sorted by move id, their interpolation points are stored into m_points.
+            std::vector<Arc>           m_arcs;
+            std::vector<Vec3f>         m_points;
+            std::vector<float>         m_layer_durations;
+            bool                       m_has_layer_durations{ false };
+        };
+
         struct SliceWarning {
             int         level;                  // 0: normal tips, 1: warning; 2: error
             std::string msg;                    // enum string
@@ -169,7 +443,7 @@ namespace Slic3r {
 
         std::string filename;
         unsigned int id;
-        std::vector<MoveVertex> moves;
+        MoveVertexStore moves;
         // Positions of ends of lines of the final G-code this->filename after TimeProcessor::post_process() finalizes the G-code.
         std::vector<size_t> lines_ends;
         Pointfs printable_area;
@@ -454,7 +728,7 @@ namespace Slic3r {
 
             // post process the file with the given filename to add remaining time lines M73
             // and updates moves' gcode ids accordingly
-            void post_process(const std::string& filename, std::vector<GCodeProcessorResult::MoveVertex>& moves, std::vector<size_t>& lines_ends, size_t total_layer_num);
+            void post_process(const std::string& filename, GCodeProcessorResult::MoveVertexStore& moves, std::vector<size_t>& lines_ends, size_t total_layer_num);
         };
 
         struct UsedFilaments  // filaments per ColorChange
@@ -529,10 +803,11 @@ namespace Slic3r {
 
                 const Vec3f position = m_result.moves.back().position;
 
-                GCodeProcessorResult::MoveVertex& move = m_result.moves.emplace_back(m_result.moves[*m_move_id]);
+                GCodeProcessorResult::MoveVertex move = m_result.moves[*m_move_id];
                 move.position = position;
                 move.height = height;
-                m_result.moves.erase(m_result.moves.begin() + *m_move_id);
+                m_result.moves.push_back(move);
+                m_result.moves.erase(*m_move_id);
                 m_result.custom_gcode_per_print_z[*m_custom_gcode_per_print_z_id].print_z = position.z();
                 reset();
             }
@@ -715,7 +990,9 @@ namespace Slic3r {
 
         // Streaming interface, for processing G-codes just generated by PrusaSlicer in a pipelined fashion.
         void initialize(const std::string& filename);
-        void process_buffer(const std::string& buffer);
+        void process_buffer(const std::string& buffer) { this->process_buffer(buffer.c_str(), buffer.c_str() + buffer.size()); }
+        // Process a zero terminated buffer in place, the buffer is not copied. *end must be zero.
+        void process_buffer(const char *begin, const char *end);
         void finalize(bool post_process);
 
         float get_time(PrintEstimatedStatistics::ETimeMode mode) const;
@@ -3,9 +3,12 @@
 #include "tbb/parallel_for.h"
 #include "tbb/blocked_range.h"
 #include "tbb/parallel_reduce.h"
+#include <boost/functional/hash.hpp>
 #include <boost/log/trivial.hpp>
 #include <random>
 #include <algorithm>
+#include <array>
+#include <memory>
 #include <queue>
 
 #include "libslic3r/AABBTreeLines.hpp"
@@ -129,6 +132,9 @@ Vec3f sample_power_cosine_hemisphere(const Vec2f &samples, float power)
     return Vec3f(cos(term1) * term3, sin(term1) * term3, term2);
 }
 
+// Number of rays of a visibility sample traced together through the AABB tree, 8 float lanes fit a single AVX register.
+static constexpr size_t ray_packet_size = 8;
+
 std::vector<float> raycast_visibility(const AABBTreeIndirect::Tree<3, float> &raycasting_tree,
                                       const indexed_triangle_set &            triangles,
                                       const TriangleSetSamples &              samples,
@@ -165,17 +171,29 @@ std::vector<float> raycast_visibility(const AABBTreeIndirect::Tree<3, float> &ra
             Frame f;
             f.set_from_z(normal);
 
+            if (!model_contains_negative_parts) {
+                // Rays of a sample share their origin, they are traced through the AABB tree in packets.
+                Vec3d ray_origin_d = (center + normal * 0.01f).cast<double>(); // start above surface.
+                std::array<Vec3f, SeamPlacer::sqr_rays_per_sample_point * SeamPlacer::sqr_rays_per_sample_point> final_ray_dirs;
+                std::array<Vec3d, SeamPlacer::sqr_rays_per_sample_point * SeamPlacer::sqr_rays_per_sample_point> final_ray_dirs_d;
+                for (size_t dir_idx = 0; dir_idx < final_ray_dirs.size(); ++dir_idx) {
+                    final_ray_dirs[dir_idx]   = f.to_world(precomputed_sample_directions[dir_idx]);
+                    final_ray_dirs_d[dir_idx] = final_ray_dirs[dir_idx].cast<double>();
+                }
+                std::array<igl::Hit, ray_packet_size> hitpoints;
+                for (size_t first = 0; first < final_ray_dirs.size(); first += ray_packet_size) {
+                    size_t   num_rays = std::min(ray_packet_size, final_ray_dirs.size() - first);
+                    uint32_t hit_mask = AABBTreeIndirect::intersect_ray_packet_first_hits<ray_packet_size>(triangles.vertices, triangles.indices, raycasting_tree,
+                                                                                                            ray_origin_d, &final_ray_dirs_d[first], num_rays, hitpoints);
+                    for (size_t i = 0; i < num_rays; ++i)
+                        if ((hit_mask & (uint32_t(1) << i)) && its_face_normal(triangles, hitpoints[i].id).dot(final_ray_dirs[first + i]) <= 0) { result[s_idx] -= decrease_step; }
+                }
+                continue;
+            }
+
             for (const auto &dir : precomputed_sample_directions) {
                 Vec3f final_ray_dir = (f.to_world(dir));
-                if (!model_contains_negative_parts) {
-                    igl::Hit hitpoint;
-                    // FIXME: This AABBTTreeIndirect query will not compile for float ray origin and
-                    // direction.
-                    Vec3d final_ray_dir_d = final_ray_dir.cast<double>();
-                    Vec3d ray_origin_d    = (center + normal * 0.01f).cast<double>(); // start above surface.
-                    bool  hit = AABBTreeIndirect::intersect_ray_first_hit(triangles.vertices, triangles.indices, raycasting_tree, ray_origin_d, final_ray_dir_d, hitpoint);
-                    if (hit && its_face_normal(triangles, hitpoint.id).dot(final_ray_dir) <= 0) { result[s_idx] -= decrease_step; }
-                } else { // TODO improve logic for order based boolean operations - consider order of volumes
+                { // TODO improve logic for order based boolean operations - consider order of volumes
                     bool casting_from_negative_volume = samples.triangle_indices[s_idx] >= negative_volumes_start_index;
 
                     Vec3d ray_origin_d = (center + normal * 0.01f).cast<double>(); // start above surface.
@@ -590,6 +608,23 @@ void compute_global_occlusion(GlobalModelInfo &result, const PrintObject *po, st
 
     BOOST_LOG_TRIVIAL(debug) << "SeamPlacer: gather occlusion meshes: end";
 
+    size_t mesh_hash = size_t(its_hash(triangle_set));
+    boost::hash_combine(mesh_hash, its_hash(negative_volumes_set));
+    for (size_t i = 0; i < 16; ++i)
+        boost::hash_combine(mesh_hash, obj_transform.matrix().data()[i]);
+    auto set_mesh_samples_tree = [&result]() {
+        result.mesh_samples_coordinate_functor = CoordinateFunctor(&result.mesh_samples.positions);
+        result.mesh_samples_tree               = KDTreeIndirect<3, float, CoordinateFunctor>(result.mesh_samples_coordinate_functor, result.mesh_samples.positions.size());
+    };
+    if (std::shared_ptr<const SeamVisibilityCache> cached = po->seam_visibility_cache(); cached && cached->mesh_hash == mesh_hash) {
+        BOOST_LOG_TRIVIAL(debug) << "SeamPlacer: reusing the visibility of " << cached->mesh_samples.positions.size() << " samples of a previous export";
+        result.mesh_samples            = cached->mesh_samples;
+        result.mesh_samples_visibility = cached->mesh_samples_visibility;
+        result.mesh_samples_radius     = cached->mesh_samples_radius;
+        set_mesh_samples_tree();
+        return;
+    }
+
     BOOST_LOG_TRIVIAL(debug) << "SeamPlacer: decimate: start";
     its_short_edge_collpase(triangle_set, 25000);
     its_short_edge_collpase(negative_volumes_set, 25000);
@@ -601,9 +636,8 @@ void compute_global_occlusion(GlobalModelInfo &result, const PrintObject *po, st
 
     BOOST_LOG_TRIVIAL(debug) << "SeamPlacer: Compute visibility sample points: start";
 
-    result.mesh_samples                    = sample_its_uniform_parallel(SeamPlacer::raycasting_visibility_samples_count, triangle_set);
-    result.mesh_samples_coordinate_functor = CoordinateFunctor(&result.mesh_samples.positions);
-    result.mesh_samples_tree               = KDTreeIndirect<3, float, CoordinateFunctor>(result.mesh_samples_coordinate_functor, result.mesh_samples.positions.size());
+    result.mesh_samples = sample_its_uniform_parallel(SeamPlacer::raycasting_visibility_samples_count, triangle_set);
+    set_mesh_samples_tree();
 
     // The following code determines search area for random visibility samples on the mesh when calculating visibility of each perimeter point
     // number of random samples in the given radius (area) is approximately poisson distribution
@@ -631,6 +665,8 @@ void compute_global_occlusion(GlobalModelInfo &result, const PrintObject *po, st
     BOOST_LOG_TRIVIAL(debug) << "SeamPlacer: build AABB tree: end";
     result.mesh_samples_visibility = raycast_visibility(raycasting_tree, triangle_set, result.mesh_samples, negative_volumes_start_index);
     throw_if_canceled();
+    po->set_seam_visibility_cache(std::make_shared<const SeamVisibilityCache>(
+        SeamVisibilityCache{ mesh_hash, result.mesh_samples, result.mesh_samples_visibility, result.mesh_samples_radius }));
 #ifdef DEBUG_FILES
     result.debug_export(triangle_set);
 #endif
@@ -13,6 +13,7 @@
 #include "libslic3r/BoundingBox.hpp"
 #include "libslic3r/AABBTreeIndirect.hpp"
 #include "libslic3r/KDTreeIndirect.hpp"
+#include "libslic3r/TriangleSetSampling.hpp"
 
 namespace Slic3r {
 
@@ -25,6 +26,16 @@ namespace EdgeGrid {
 class Grid;
 }
 
+// Visibility samples of an object raycasted by the seam placer, kept by the PrintObject and keyed by a hash of the object meshes
+// and transformation. If only the print settings change between two G-code exports, the raycasting of the object is skipped.
+struct SeamVisibilityCache
+{
+    uint64_t           mesh_hash;
+    TriangleSetSamples mesh_samples;
+    std::vector<float> mesh_samples_visibility;
+    float              mesh_samples_radius;
+};
+
 namespace SeamPlacerImpl {
 
 // ************  FOR BACKPORT COMPATIBILITY ONLY ***************
@@ -13,6 +13,26 @@
 #include <Shiny/Shiny.h>
 #include <fast_float/fast_float.h>
 
+#include <atomic>
+#include <memory>
+
+#include <tbb/task_arena.h>
+// Intel redesigned some TBB interface considerably when merging TBB with their oneAPI set of libraries, see GH #7332.
+// We are using quite an old TBB 2017 U7. Before we update our build servers, let's use the old API, which is deprecated in up to date TBB.
+#if ! defined(TBB_VERSION_MAJOR)
+    #include <tbb/version.h>
+#endif
+#if ! defined(TBB_VERSION_MAJOR)
+    static_assert(false, "TBB_VERSION_MAJOR not defined");
+#endif
+#if TBB_VERSION_MAJOR >= 2021
+    #include <tbb/parallel_pipeline.h>
+    using slic3r_tbb_filtermode = tbb::filter_mode;
+#else
+    #include <tbb/pipeline.h>
+    using slic3r_tbb_filtermode = tbb::filter;
+#endif
+
 namespace Slic3r {
 
 void GCodeReader::apply_config(const GCodeConfig &config)
@@ -26,6 +46,19 @@ void GCodeReader::apply_config(const DynamicPrintConfig &config)
 }
 
 const char* GCodeReader::parse_line_internal(const char *ptr, const char *end, GCodeLine &gline, std::pair<const char*, const char*> &command)
+{
+    const char *c = tokenize_line(ptr, end, gline, command);
+
+    if (gline.has(E) && m_config.use_relative_e_distances)
+        m_position[E] = 0;
+
+    if (m_verbose)
+        std::cout << gline.m_raw << std::endl;
+
+    return c;
+}
+
+const char* GCodeReader::tokenize_line(const char *ptr, const char *end, GCodeLine &gline, std::pair<const char*, const char*> &command)
 {
     PROFILE_FUNC();
 
@@ -81,9 +114,6 @@ const char* GCodeReader::parse_line_internal(const char *ptr, const char *end, G
                 c = skip_word(c);
         }
     }
-    
-    if (gline.has(E) && m_config.use_relative_e_distances)
-        m_position[E] = 0;
 
     // Skip the rest of the line.
     for (; ! is_end_of_line(*c); ++ c);
@@ -100,9 +130,6 @@ const char* GCodeReader::parse_line_internal(const char *ptr, const char *end, G
 	if (*c == '\n')
 		++ c;
 
-    if (m_verbose)
-        std::cout << gline.m_raw << std::endl;
-
     return c;
 }
 
@@ -184,17 +211,19 @@ bool GCodeReader::parse_file_internal(const std::string &filename, ParseLineCall
     return this->parse_file_raw_internal(filename, 
         [this, &gline, parse_line_callback](const char *begin, const char *end) {
             gline.reset();
-
-            const char* begin_new = begin;
-            begin_new = skip_whitespaces(begin_new);
-            if (std::toupper(*begin_new) == 'N')
-                begin_new = skip_word(begin_new);
-            begin_new = skip_whitespaces(begin_new);
-            this->parse_line(begin_new, end, gline, parse_line_callback);
+            this->parse_line(skip_line_number(begin), end, gline, parse_line_callback);
         }, 
         line_end_callback);
 }
 
+const char* GCodeReader::skip_line_number(const char *c)
+{
+    c = skip_whitespaces(c);
+    if (std::toupper(*c) == 'N')
+        c = skip_word(c);
+    return skip_whitespaces(c);
+}
+
 bool GCodeReader::parse_file(const std::string &file, callback_t callback)
 {
     BOOST_LOG_TRIVIAL(info) << __FUNCTION__ << boost::format(":  before parse_file %1%") % file.c_str();
@@ -214,6 +243,142 @@ bool GCodeReader::parse_file(const std::string &file, callback_t callback, std::
     return ret;
 }
 
+// Piece of a G-code file ending with a line end, tokenized by one thread of GCodeReader::parse_file_parallel().
+struct GCodeChunk
+{
+    std::string                         buffer;
+    // Position of the start of the buffer in the file.
+    size_t                              file_pos { 0 };
+    std::vector<GCodeReader::GCodeLine> lines;
+    std::vector<size_t>                 lines_ends;
+};
+
+bool GCodeReader::parse_file_parallel(const std::string &file, callback_t callback, std::vector<size_t> &lines_ends, const std::string &chunk_marker)
+{
+    // Chunks are cut before the first marker following min_chunk_size bytes, or at the last line end once max_chunk_size is reached.
+    static constexpr const size_t read_block_size = 1 << 20;
+    static constexpr const size_t min_chunk_size  = 1 << 20;
+    static constexpr const size_t max_chunk_size  = 16 << 20;
+
+    lines_ends.clear();
+    BOOST_LOG_TRIVIAL(info) << __FUNCTION__ << boost::format(":  before parse_file %1%") % file.c_str();
+
+    FilePtr in{ boost::nowide::fopen(file.c_str(), "rb") };
+    if (in.f == nullptr)
+        return false;
+
+    const std::string marker   = "\n" + chunk_marker;
+    std::string       pending;
+    size_t            pending_pos = 0;
+    bool              eof         = false;
+    bool              failed      = false;
+    // Set by the sequential stage when the callback quits parsing, read by the input stage.
+    std::atomic<bool> stop { false };
+    m_parsing = true;
+
+    const auto input = tbb::make_filter<void, std::shared_ptr<GCodeChunk>>(slic3r_tbb_filtermode::serial_in_order,
+        [&](tbb::flow_control &fc) -> std::shared_ptr<GCodeChunk> {
+            size_t cut      = std::string::npos;
+            size_t searched = 0;
+            while (cut == std::string::npos && ! stop) {
+                if (pending.size() > min_chunk_size) {
+                    size_t pos = pending.find(marker, std::max(searched, min_chunk_size) - marker.size());
+                    if (pos != std::string::npos) {
+                        cut = pos + 1;
+                        break;
+                    }
+                    searched = pending.size();
+                    if (pending.size() >= max_chunk_size && (pos = pending.rfind('\n')) != std::string::npos) {
+                        cut = pos + 1;
+                        break;
+                    }
+                }
+                if (eof) {
+                    cut = pending.size();
+                    break;
+                }
+                size_t old_size = pending.size();
+                pending.resize(old_size + read_block_size);
+                size_t cnt_read = ::fread(pending.data() + old_size, 1, read_block_size, in.f);
+                pending.resize(old_size + cnt_read);
+                if (::ferror(in.f)) {
+                    failed = true;
+                    break;
+                }
+                eof = cnt_read == 0;
+            }
+            if (cut == std::string::npos || cut == 0) {
+                fc.stop();
+                return {};
+            }
+            auto chunk = std::make_shared<GCodeChunk>();
+            chunk->file_pos = pending_pos;
+            if (cut == pending.size()) {
+                chunk->buffer = std::move(pending);
+                pending.clear();
+            } else {
+                chunk->buffer.assign(pending, 0, cut);
+                pending.erase(0, cut);
+            }
+            pending_pos += cut;
+            return chunk;
+        });
+    // Lines are split the same way as parse_file_raw_internal() does, the buffer of the chunk is zero terminated.
+    const auto tokenize = tbb::make_filter<std::shared_ptr<GCodeChunk>, std::shared_ptr<GCodeChunk>>(slic3r_tbb_filtermode::parallel,
+        [](std::shared_ptr<GCodeChunk> chunk) -> std::shared_ptr<GCodeChunk> {
+            // The numbers are parsed on a worker thread, which may not have the numeric locale set.
+            CNumericLocalesSetter locales_setter;
+            const char *begin = chunk->buffer.c_str();
+            const char *end   = begin + chunk->buffer.size();
+            chunk->lines.reserve(chunk->buffer.size() / 24);
+            for (const char *it = begin; it != end;) {
+                const char *it_end = it;
+                for (; it_end != end && *it_end != '\r' && *it_end != '\n'; ++ it_end);
+                std::pair<const char*, const char*> command;
+                // Only the stateless tokenizer runs here, the reader state (position, configuration) is owned by the sequential stage.
+                tokenize_line(skip_line_number(it), it_end, chunk->lines.emplace_back(), command);
+                it = it_end;
+                if (it != end && *it == '\r')
+                    ++ it;
+                if (it != end && *it == '\n') {
+                    chunk->lines_ends.emplace_back(chunk->file_pos + (it - begin) + 1);
+                    ++ it;
+                }
+            }
+            std::string().swap(chunk->buffer);
+            return chunk;
+        });
+    const auto process = tbb::make_filter<std::shared_ptr<GCodeChunk>, void>(slic3r_tbb_filtermode::serial_in_order,
+        [this, &callback, &lines_ends, &stop](std::shared_ptr<GCodeChunk> chunk) {
+            if (! m_parsing)
+                return;
+            for (size_t i = 0; i < chunk->lines.size(); ++ i) {
+                GCodeLine &gline = chunk->lines[i];
+                if (gline.has(E) && m_config.use_relative_e_distances)
+                    m_position[E] = 0;
+                if (m_verbose)
+                    std::cout << gline.m_raw << std::endl;
+                callback(*this, gline);
+                std::pair<const char*, const char*> command;
+                command.first  = skip_whitespaces(gline.m_raw.c_str());
+                command.second = skip_word(command.first);
+                update_coordinates(gline, command);
+                if (! m_parsing) {
+                    // The callback wishes to exit, the line end of the last processed line is not reported.
+                    lines_ends.insert(lines_ends.end(), chunk->lines_ends.begin(), chunk->lines_ends.begin() + std::min(i, chunk->lines_ends.size()));
+                    stop = true;
+                    return;
+                }
+            }
+            lines_ends.insert(lines_ends.end(), chunk->lines_ends.begin(), chunk->lines_ends.end());
+        });
+
+    tbb::parallel_pipeline(std::max<size_t>(2, 2 * size_t(tbb::this_task_arena::max_concurrency())), input & tokenize & process);
+
+    BOOST_LOG_TRIVIAL(info) << __FUNCTION__ << boost::format(":  finished parse_file %1%") % file.c_str();
+    return ! failed;
+}
+
 bool GCodeReader::parse_file_raw(const std::string &filename, raw_line_callback_t line_callback)
 {
     return this->parse_file_raw_internal(filename,
@@ -95,9 +95,13 @@ public:
 
     template<typename Callback>
     void parse_buffer(const std::string &buffer, Callback callback)
+        { this->parse_buffer(buffer.c_str(), buffer.c_str() + buffer.size(), callback); }
+
+    // Parse a zero terminated buffer in place, without copying it. *end must be zero.
+    template<typename Callback>
+    void parse_buffer(const char *ptr, const char *end, Callback callback)
     {
-        const char *ptr = buffer.c_str();
-        const char *end = ptr + buffer.size();
+        assert(*end == 0);
         GCodeLine gline;
         m_parsing = true;
         while (m_parsing && *ptr != 0) {
@@ -128,6 +132,10 @@ public:
     // Collect positions of line ends in the binary G-code to be used by the G-code viewer when memory mapping and displaying section of G-code
     // as an overlay in the 3D scene.
     bool parse_file(const std::string &file, callback_t callback, std::vector<size_t> &lines_ends);
+    // Same as above, but the file is split into chunks starting with a line beginning with chunk_marker (a layer change tag for example)
+    // and the chunks are tokenized in parallel. The callback is called sequentially (not necessarily on the calling thread) with the lines
+    // in the file order, the callback and the update of the reader state are not sped up.
+    bool parse_file_parallel(const std::string &file, callback_t callback, std::vector<size_t> &lines_ends, const std::string &chunk_marker);
     // Just read the G-code file line by line, calls callback (const char *begin, const char *end). Returns false if reading the file failed.
     bool parse_file_raw(const std::string &file, raw_line_callback_t callback);
 
@@ -157,7 +165,10 @@ private:
     bool        parse_file_internal(const std::string &filename, ParseLineCallback parse_line_callback, LineEndCallback line_end_callback);
 
     const char* parse_line_internal(const char *ptr, const char *end, GCodeLine &gline, std::pair<const char*, const char*> &command);
+    // Split the line into the command and the axis values without touching the reader state, thus safe to call from any thread.
+    static const char* tokenize_line(const char *ptr, const char *end, GCodeLine &gline, std::pair<const char*, const char*> &command);
     void        update_coordinates(GCodeLine &gline, std::pair<const char*, const char*> &command);
+    static const char* skip_line_number(const char *c);
 
     static bool         is_whitespace(char c)           { return c == ' ' || c == '\t'; }
     static bool         is_end_of_line(char c)          { return c == '\r' || c == '\n' || c == 0; }
@@ -6,10 +6,6 @@
 #include <map>
 #include <assert.h>
 
-#ifdef __APPLE__
-    #include <boost/spirit/include/karma.hpp>
-#endif
-
 #define FLAVOR_IS(val) this->config.gcode_flavor == val
 #define FLAVOR_IS_NOT(val) this->config.gcode_flavor != val
 
@@ -319,7 +315,7 @@ std::string GCodeWriter::travel_to_xy(const Vec2d &point, const std::string &com
     Vec2d point_on_plate = { point(0) - m_x_offset, point(1) - m_y_offset };
     
     GCodeG1Formatter w;
-    w.emit_xy(point_on_plate);
+    this->emit_xy(w, point_on_plate);
     w.emit_f(this->config.travel_speed.value * 60.0);
     //BBS
     w.emit_comment(GCodeWriter::full_gcode_comment, comment);
@@ -379,7 +375,7 @@ std::string GCodeWriter::travel_to_xyz(const Vec3d &point, const std::string &co
                 Vec2d temp = delta_no_z.normalized() * delta(2) / tan(GCodeWriter::slope_threshold);
                 Vec3d slope_top_point = Vec3d(temp(0), temp(1), delta(2)) + source;
                 GCodeG1Formatter w0;
-                w0.emit_xyz(slope_top_point);
+                this->emit_xyz(w0, slope_top_point);
                 w0.emit_f(this->config.travel_speed.value * 60.0);
                 //BBS
                 w0.emit_comment(GCodeWriter::full_gcode_comment, "slope lift Z");
@@ -394,13 +390,13 @@ std::string GCodeWriter::travel_to_xyz(const Vec3d &point, const std::string &co
         {
             GCodeG1Formatter w0;
             if (this->is_current_position_clear()) {
-                w0.emit_xyz(target);
+                this->emit_xyz(w0, target);
                 w0.emit_f(this->config.travel_speed.value * 60.0);
                 w0.emit_comment(GCodeWriter::full_gcode_comment, comment);
                 xy_z_move = w0.string();
             }
             else {
-                w0.emit_xy(Vec2d(target.x(), target.y()));
+                this->emit_xy(w0, Vec2d(target.x(), target.y()));
                 w0.emit_f(this->config.travel_speed.value * 60.0);
                 w0.emit_comment(GCodeWriter::full_gcode_comment, comment);
                 xy_z_move = w0.string() + _travel_to_z(target.z(), comment);
@@ -434,13 +430,13 @@ std::string GCodeWriter::travel_to_xyz(const Vec3d &point, const std::string &co
     if (!this->is_current_position_clear())
     {
         //force to move xy first then z after filament change
-        w.emit_xy(Vec2d(point_on_plate.x(), point_on_plate.y()));
+        this->emit_xy(w, Vec2d(point_on_plate.x(), point_on_plate.y()));
         w.emit_f(this->config.travel_speed.value * 60.0);
         w.emit_comment(GCodeWriter::full_gcode_comment, comment);
         out_string = w.string() + _travel_to_z(point_on_plate.z(), comment);
     } else {
         GCodeG1Formatter w;
-        w.emit_xyz(point_on_plate);
+        this->emit_xyz(w, point_on_plate);
         w.emit_f(this->config.travel_speed.value * 60.0);
         w.emit_comment(GCodeWriter::full_gcode_comment, comment);
         out_string = w.string();
@@ -470,6 +466,20 @@ std::string GCodeWriter::travel_to_z(double z, const std::string &comment)
     return this->_travel_to_z(z, comment);
 }
 
+void GCodeWriter::emit_xy(GCodeFormatter &w, const Vec2d &point)
+{
+    if (m_recorded_xy != nullptr)
+        m_recorded_xy->emplace_back(point);
+    w.emit_xy(point);
+}
+
+void GCodeWriter::emit_xyz(GCodeFormatter &w, const Vec3d &point)
+{
+    if (m_recorded_xy != nullptr)
+        m_recorded_xy->emplace_back(point.x(), point.y());
+    w.emit_xyz(point);
+}
+
 std::string GCodeWriter::_travel_to_z(double z, const std::string &comment)
 {
     m_pos(2) = z;
@@ -522,6 +532,13 @@ bool GCodeWriter::will_move_z(double z) const
 }
 
 std::string GCodeWriter::extrude_to_xy(const Vec2d &point, double dE, const std::string &comment, bool force_no_extrusion)
+{
+    std::string out;
+    this->extrude_to_xy(out, point, dE, comment, force_no_extrusion);
+    return out;
+}
+
+void GCodeWriter::extrude_to_xy(std::string &out, const Vec2d &point, double dE, const std::string &comment, bool force_no_extrusion)
 {
     m_pos(0) = point(0);
     m_pos(1) = point(1);
@@ -532,18 +549,25 @@ std::string GCodeWriter::extrude_to_xy(const Vec2d &point, double dE, const std:
     Vec2d point_on_plate = { point(0) - m_x_offset, point(1) - m_y_offset };
 
     GCodeG1Formatter w;
-    w.emit_xy(point_on_plate);
+    this->emit_xy(w, point_on_plate);
     if (!force_no_extrusion)
         w.emit_e(m_extruder->E());
     //BBS
     w.emit_comment(GCodeWriter::full_gcode_comment, comment);
-    return w.string();
+    w.append_to(out);
 }
 
 //BBS: generate G2 or G3 extrude which moves by arc
 //point is end point which means X and Y axis
 //center_offset is I and J axis
 std::string GCodeWriter::extrude_arc_to_xy(const Vec2d& point, const Vec2d& center_offset, double dE, const bool is_ccw, const std::string& comment, bool force_no_extrusion)
+{
+    std::string out;
+    this->extrude_arc_to_xy(out, point, center_offset, dE, is_ccw, comment, force_no_extrusion);
+    return out;
+}
+
+void GCodeWriter::extrude_arc_to_xy(std::string &out, const Vec2d& point, const Vec2d& center_offset, double dE, const bool is_ccw, const std::string& comment, bool force_no_extrusion)
 {
     m_pos(0) = point(0);
     m_pos(1) = point(1);
@@ -553,13 +577,13 @@ std::string GCodeWriter::extrude_arc_to_xy(const Vec2d& point, const Vec2d& cent
     Vec2d point_on_plate = { point(0) - m_x_offset, point(1) - m_y_offset };
 
     GCodeG2G3Formatter w(is_ccw);
-    w.emit_xy(point_on_plate);
+    this->emit_xy(w, point_on_plate);
     w.emit_ij(center_offset);
     if (!force_no_extrusion)
         w.emit_e(m_extruder->E());
     //BBS
     w.emit_comment(GCodeWriter::full_gcode_comment, comment);
-    return w.string();
+    w.append_to(out);
 }
 
 std::string GCodeWriter::extrude_to_xyz(const Vec3d &point, double dE, const std::string &comment, bool force_no_extrusion)
@@ -573,7 +597,7 @@ std::string GCodeWriter::extrude_to_xyz(const Vec3d &point, double dE, const std
     Vec3d point_on_plate = { point(0) - m_x_offset, point(1) - m_y_offset, point(2) };
 
     GCodeG1Formatter w;
-    w.emit_xyz(point_on_plate);
+    this->emit_xyz(w, point_on_plate);
     if (!force_no_extrusion)
         w.emit_e(m_extruder->E());
     //BBS
@@ -679,6 +703,25 @@ std::string GCodeWriter::unlift()
     return gcode;
 }
 
+GCodeWriter::State GCodeWriter::state() const
+{
+    assert(m_extruder != nullptr);
+    return { m_last_acceleration, m_last_jerk, m_lifted, m_to_lift, m_to_lift_type, m_pos, m_is_current_pos_clear, m_extruder->state() };
+}
+
+void GCodeWriter::set_state(const State &state)
+{
+    assert(m_extruder != nullptr);
+    m_last_acceleration    = state.last_acceleration;
+    m_last_jerk            = state.last_jerk;
+    m_lifted               = state.lifted;
+    m_to_lift              = state.to_lift;
+    m_to_lift_type         = state.to_lift_type;
+    m_pos                  = state.pos;
+    m_is_current_pos_clear = state.is_current_pos_clear;
+    m_extruder->set_state(state.extruder);
+}
+
 std::string GCodeWriter::set_fan(const GCodeFlavor gcode_flavor, unsigned int speed)
 {
     std::ostringstream gcode;
@@ -757,48 +800,81 @@ void GCodeWriter::add_object_change_labels(std::string& gcode)
     add_object_start_labels(gcode);
 }
 
+// Two ASCII digits for each number 0..99, so that the digits are emitted in pairs.
+static constexpr const char gcode_digit_pairs[201] =
+    "00010203040506070809" "10111213141516171819" "20212223242526272829" "30313233343536373839" "40414243444546474849"
+    "50515253545556575859" "60616263646566676869" "70717273747576777879" "80818283848586878889" "90919293949596979899";
+
+// Write value to [ptr - num_digits, ptr) backwards, left padded with zeros.
+template<typename T>
+static inline void gcode_write_digits(char *ptr, T value, size_t num_digits)
+{
+    for (; num_digits >= 2; num_digits -= 2) {
+        const char *pair = gcode_digit_pairs + 2 * (value % 100);
+        value /= 100;
+        *-- ptr = pair[1];
+        *-- ptr = pair[0];
+    }
+    if (num_digits == 1)
+        *-- ptr = char('0' + value % 10);
+}
+
+// Round v to a fixed point number with Digits decimal digits and emit it the way G-code is exported:
+// no leading zero before the decimal point, no trailing zeros after it and no decimal point for integers.
+// Digits is a template parameter, so that the divisions by the power of ten are turned into multiplications.
+template<size_t Digits>
+static inline char* gcode_emit_fixed_point(char *ptr, const double v)
+{
+    static constexpr const std::array<uint32_t, 10> pow_10{1, 10, 100, 1000, 10000, 100000, 1000000, 10000000, 100000000, 1000000000};
+    static constexpr const uint32_t scale = pow_10[Digits];
+
+    const auto v_int = int64_t(std::round(v * double(scale)));
+    if (v_int == 0) {
+        *ptr ++ = '0';
+        return ptr;
+    }
+    if (v_int < 0)
+        *ptr ++ = '-';
+    const uint64_t v_abs    = v_int < 0 ? uint64_t(0) - uint64_t(v_int) : uint64_t(v_int);
+    const uint64_t int_part = v_abs / scale;
+    uint32_t       fraction = uint32_t(v_abs % scale);
+    if (int_part > 0) {
+        size_t n = 1;
+        for (uint64_t i = int_part; i >= 10; i /= 10)
+            ++ n;
+        ptr += n;
+        gcode_write_digits(ptr, int_part, n);
+    }
+    if (fraction > 0) {
+        size_t n = Digits;
+        for (; fraction % 10 == 0; fraction /= 10)
+            -- n;
+        *ptr ++ = '.';
+        ptr += n;
+        gcode_write_digits(ptr, fraction, n);
+    }
+    return ptr;
+}
+
 void GCodeFormatter::emit_axis(const char axis, const double v, size_t digits) {
     assert(digits <= 9);
-    static constexpr const std::array<int, 10> pow_10{1, 10, 100, 1000, 10000, 100000, 1000000, 10000000, 100000000, 1000000000};
     *ptr_err.ptr++ = ' '; *ptr_err.ptr++ = axis;
-
-    char *base_ptr = this->ptr_err.ptr;
-    auto  v_int    = int64_t(std::round(v * pow_10[digits]));
-    // Older stdlib on macOS doesn't support std::from_chars at all, so it is used boost::spirit::karma::generate instead of it.
-    // That is a little bit slower than std::to_chars but not much.
-#ifdef __APPLE__
-    boost::spirit::karma::generate(this->ptr_err.ptr, boost::spirit::karma::int_generator<int64_t>(), v_int);
-#else
-    // this->buf_end minus 1 because we need space for adding the extra decimal point.
-    this->ptr_err = std::to_chars(this->ptr_err.ptr, this->buf_end - 1, v_int);
-#endif
-    size_t writen_digits = (this->ptr_err.ptr - base_ptr) - (v_int < 0 ? 1 : 0);
-    if (writen_digits < digits) {
-        // Number is smaller than 10^digits, so that we will pad it with zeros.
-        size_t remaining_digits = digits - writen_digits;
-        // Move all newly inserted chars by remaining_digits to allocate space for padding with zeros.
-        for (char *from_ptr = this->ptr_err.ptr - 1, *to_ptr = from_ptr + remaining_digits; from_ptr >= this->ptr_err.ptr - writen_digits; --to_ptr, --from_ptr)
-            *to_ptr = *from_ptr;
-
-        memset(this->ptr_err.ptr - writen_digits, '0', remaining_digits);
-        this->ptr_err.ptr += remaining_digits;
-    }
-
-    // Move all newly inserted chars by one to allocate space for a decimal point.
-    for (char *to_ptr = this->ptr_err.ptr, *from_ptr = to_ptr - 1; from_ptr >= this->ptr_err.ptr - digits; --to_ptr, --from_ptr)
-        *to_ptr = *from_ptr;
-
-    *(this->ptr_err.ptr - digits) = '.';
-    for (size_t i = 0; i < digits; ++i) {
-        if (*this->ptr_err.ptr != '0')
-            break;
-        this->ptr_err.ptr--;
-    }
-    if (*this->ptr_err.ptr == '.')
-        this->ptr_err.ptr--;
-    if ((this->ptr_err.ptr + 1) == base_ptr || *this->ptr_err.ptr == '-')
-        *(++this->ptr_err.ptr) = '0';
-    this->ptr_err.ptr++;
+    [[maybe_unused]] char *base_ptr = this->ptr_err.ptr;
+    // Integer part of at most 19 digits, decimal point and the fraction.
+    assert(this->ptr_err.ptr + 21 + digits < this->buf_end);
+
+    switch (digits) {
+    case 0: this->ptr_err.ptr = gcode_emit_fixed_point<0>(this->ptr_err.ptr, v); break;
+    case 1: this->ptr_err.ptr = gcode_emit_fixed_point<1>(this->ptr_err.ptr, v); break;
+    case 2: this->ptr_err.ptr = gcode_emit_fixed_point<2>(this->ptr_err.ptr, v); break;
+    case 3: this->ptr_err.ptr = gcode_emit_fixed_point<3>(this->ptr_err.ptr, v); break;
+    case 4: this->ptr_err.ptr = gcode_emit_fixed_point<4>(this->ptr_err.ptr, v); break;
+    case 5: this->ptr_err.ptr = gcode_emit_fixed_point<5>(this->ptr_err.ptr, v); break;
+    case 6: this->ptr_err.ptr = gcode_emit_fixed_point<6>(this->ptr_err.ptr, v); break;
+    case 7: this->ptr_err.ptr = gcode_emit_fixed_point<7>(this->ptr_err.ptr, v); break;
+    case 8: this->ptr_err.ptr = gcode_emit_fixed_point<8>(this->ptr_err.ptr, v); break;
+    default: this->ptr_err.ptr = gcode_emit_fixed_point<9>(this->ptr_err.ptr, v); break;
+    }
 
 #if 0 // #ifndef NDEBUG
     {
@@ -11,6 +11,8 @@
 
 namespace Slic3r {
 
+class GCodeFormatter;
+
 enum class LiftType {
     NormalLift,
     LazyLift,
@@ -70,8 +72,11 @@ public:
     std::string travel_to_z(double z, const std::string &comment = std::string());
     bool        will_move_z(double z) const;
     std::string extrude_to_xy(const Vec2d &point, double dE, const std::string &comment = std::string(), bool force_no_extrusion = false);
+    // Same as above, but the move is appended to out instead of being returned as a new string.
+    void        extrude_to_xy(std::string &out, const Vec2d &point, double dE, const std::string &comment = std::string(), bool force_no_extrusion = false);
     //BBS: generate G2 or G3 extrude which moves by arc
     std::string extrude_arc_to_xy(const Vec2d &point, const Vec2d &center_offset, double dE, const bool is_ccw, const std::string &comment = std::string(), bool force_no_extrusion = false);
+    void        extrude_arc_to_xy(std::string &out, const Vec2d &point, const Vec2d &center_offset, double dE, const bool is_ccw, const std::string &comment = std::string(), bool force_no_extrusion = false);
     std::string extrude_to_xyz(const Vec3d &point, double dE, const std::string &comment = std::string(), bool force_no_extrusion = false);
     std::string retract(bool before_wipe = false);
     std::string retract_for_toolchange(bool before_wipe = false);
@@ -100,6 +105,24 @@ public:
     void add_object_end_labels(std::string& gcode);
     void add_object_change_labels(std::string& gcode);
 
+    //BBS: State changed by the moves, saved and restored when the G-code generated for an object instance is replayed for another instance.
+    struct State
+    {
+        unsigned int    last_acceleration;
+        double          last_jerk;
+        double          lifted;
+        double          to_lift;
+        LiftType        to_lift_type;
+        Vec3d           pos;
+        bool            is_current_pos_clear;
+        Extruder::State extruder;
+    };
+    State state() const;
+    void  set_state(const State &state);
+    // Collect the X and Y values of the moves emitted before they are rounded, so that they could be translated
+    // and rounded again exactly as if the moves were emitted translated. nullptr stops the recording.
+    void  record_xy(std::vector<Vec2d> *xy) { m_recorded_xy = xy; }
+
     //BBS:
     void set_current_position_clear(bool clear) { m_is_current_pos_clear = clear; };
     bool is_current_position_clear() const { return m_is_current_pos_clear; };
@@ -136,10 +159,13 @@ private:
     //BBS: x, y offset for gcode generated
     double          m_x_offset{ 0 };
     double          m_y_offset{ 0 };
+    std::vector<Vec2d> *m_recorded_xy{ nullptr };
 
     std::string m_gcode_label_objects_start;
     std::string m_gcode_label_objects_end;
 
+    void        emit_xy(GCodeFormatter &w, const Vec2d &point);
+    void        emit_xyz(GCodeFormatter &w, const Vec3d &point);
     std::string _travel_to_z(double z, const std::string &comment);
     std::string _spiral_travel_to_z(double z, const Vec2d &ij_offset, const std::string &comment);
     std::string _retract(double length, double restart_extra, const std::string &comment);
@@ -219,6 +245,13 @@ public:
         return std::string(this->buf, ptr_err.ptr - buf);
     }
 
+    // Append the formatted line to out, which is expected to be reserved by the caller,
+    // so that emitting a move does not allocate.
+    void append_to(std::string &out) {
+        *ptr_err.ptr ++ = '\n';
+        out.append(this->buf, ptr_err.ptr - buf);
+    }
+
 protected:
     static constexpr const size_t   buflen = 256;
     char                            buf[buflen];
@@ -156,6 +156,8 @@ public:
     LayerRegion*            get_region(int idx) { return m_regions[idx]; }
     LayerRegion*            add_region(const PrintRegion *print_region);
     const LayerRegionPtrs&  regions() const { return m_regions; }
+    // BBS: backs the extrusion entities generated for this layer, see ExtrusionEntityArena.
+    const ExtrusionEntityArena& extrusion_arena() const { return m_extrusion_arena; }
     // Test whether whether there are any slices assigned to this layer.
     bool                    empty() const;
     void                    make_slices();
@@ -252,6 +254,8 @@ private:
     size_t              m_id;
     PrintObject        *m_object;
     LayerRegionPtrs     m_regions;
+    // Destroyed after ~Layer() deleted the regions and their extrusions.
+    ExtrusionEntityArena m_extrusion_arena;
 };
 
 enum SupportInnerType {
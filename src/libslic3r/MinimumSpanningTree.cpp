@@ -2,7 +2,10 @@
 
 #include <iterator>
 #include <algorithm>
+#include <limits>
+#include <numeric>
 #include "libslic3r.h"
+#include "KDTreeIndirect.hpp"
 
 namespace Slic3r
 {
@@ -19,7 +22,11 @@ inline double vsize2_with_unscale(const Point pt)
     return dot_with_unscale(pt, pt);
 }
 
-MinimumSpanningTree::MinimumSpanningTree(std::vector<Point> vertices) : adjacency_graph(prim(vertices))
+// BBS: Prim's algorithm is kept for the small sets of vertices, for which it is fast enough.
+static constexpr size_t prim_max_vertices = 256;
+
+MinimumSpanningTree::MinimumSpanningTree(std::vector<Point> vertices)
+    : adjacency_graph(vertices.size() > prim_max_vertices ? boruvka(vertices) : prim(vertices))
 {
     //Just copy over the fields.
 }
@@ -98,6 +105,88 @@ auto MinimumSpanningTree::prim(std::vector<Point> vertices) const -> AdjacencyGr
     return result;
 }
 
+auto MinimumSpanningTree::boruvka(const std::vector<Point> &vertices) const -> AdjacencyGraph_t
+{
+    AdjacencyGraph_t result;
+    result.reserve(vertices.size());
+    for (const Point &vertex : vertices)
+        result[vertex];
+    if (vertices.size() < 2)
+        return result;
+
+    auto coordinate = [&vertices](size_t idx, size_t dimension) { return double(vertices[idx](dimension)); };
+    KDTreeIndirect<2, double, decltype(coordinate)> kdtree(coordinate, vertices.size());
+
+    // Union-find of the components of the tree built so far.
+    std::vector<size_t> parent(vertices.size());
+    std::iota(parent.begin(), parent.end(), 0);
+    auto find_root = [&parent](size_t idx) {
+        while (parent[idx] != idx)
+            idx = parent[idx] = parent[parent[idx]];
+        return idx;
+    };
+
+    // The edges are ordered by their length, then by the indices of their vertices, thus all the components agree
+    // on the order of the edges of the same length and no cycle is created.
+    struct ShortestEdge {
+        double dist2 = std::numeric_limits<double>::max();
+        size_t from  = std::numeric_limits<size_t>::max();
+        size_t to    = std::numeric_limits<size_t>::max();
+        bool shorter(double dist2_other, size_t from_other, size_t to_other) const {
+            return dist2_other < this->dist2 || (dist2_other == this->dist2 &&
+                std::make_pair(std::min(from_other, to_other), std::max(from_other, to_other)) < std::make_pair(std::min(this->from, this->to), std::max(this->from, this->to)));
+        }
+    };
+
+    std::vector<size_t>       component(vertices.size());
+    std::vector<ShortestEdge> shortest(vertices.size());
+    for (size_t num_components = vertices.size(); num_components > 1;) {
+        for (size_t idx = 0; idx < vertices.size(); ++ idx)
+            component[idx] = find_root(idx);
+        std::fill(shortest.begin(), shortest.end(), ShortestEdge());
+
+        // Find the shortest edge leaving each component. The search of each vertex is bounded by the shortest edge
+        // of its component found so far, so the vertices inside of the big components are cheap.
+        for (size_t idx = 0; idx < vertices.size(); ++ idx) {
+            const size_t  comp = component[idx];
+            const Point  &pt   = vertices[idx];
+            ShortestEdge &best = shortest[comp];
+            auto visitor = [&](size_t other, size_t dimension) {
+                if (component[other] != comp) {
+                    const double dist2 = (vertices[other] - pt).cast<double>().squaredNorm();
+                    if (best.shorter(dist2, idx, other))
+                        best = { dist2, idx, other };
+                }
+                return kdtree.descent_mask(double(pt(dimension)), best.dist2, other, dimension);
+            };
+            kdtree.visit(visitor);
+        }
+
+        size_t num_merged = 0;
+        for (size_t comp = 0; comp < vertices.size(); ++ comp) {
+            const ShortestEdge &edge = shortest[comp];
+            if (component[comp] != comp || edge.from == std::numeric_limits<size_t>::max())
+                continue;
+            const size_t root_from = find_root(edge.from);
+            const size_t root_to   = find_root(edge.to);
+            if (root_from == root_to)
+                // Both components picked the same edge.
+                continue;
+            parent[root_from] = root_to;
+            const Point &from = vertices[edge.from];
+            const Point &to   = vertices[edge.to];
+            result[from].push_back({ from, to });
+            result[to].push_back({ to, from });
+            -- num_components;
+            ++ num_merged;
+        }
+        if (num_merged == 0)
+            break;
+    }
+
+    return result;
+}
+
 std::vector<Point> MinimumSpanningTree::adjacent_nodes(Point node) const
 {
     std::vector<Point> result;
@@ -71,6 +71,19 @@ private:
      * \return An adjacency graph with for each point one or more edges.
      */
     AdjacencyGraph_t prim(std::vector<Point> vertices) const;
+
+    /*!
+     * \brief Computes the edges of a minimum spanning tree using Boruvka's
+     * algorithm, searching the shortest edge leaving each component in a KD
+     * tree of the vertices.
+     *
+     * Unlike prim(), which is quadratic, this scales to the tens of thousands
+     * of nodes of dense overhangs.
+     *
+     * \param vertices The vertices to span.
+     * \return An adjacency graph with for each point one or more edges.
+     */
+    AdjacencyGraph_t boruvka(const std::vector<Point> &vertices) const;
 };
 
 }
@@ -2970,6 +2970,47 @@ const TriangleMesh& ModelVolume::get_convex_hull() const
     return *m_convex_hull.get();
 }
 
+struct ModelVolume::FacetZIndexCache
+{
+    // Mesh the index was built for. Weak pointer, so that the cache does not keep a replaced mesh alive.
+    std::weak_ptr<const TriangleMesh> mesh;
+    FacetZIndex                       index;
+};
+
+std::shared_ptr<const FacetZIndex> ModelVolume::get_facet_z_index() const
+{
+    // The index may be requested by multiple PrintObjects sharing this volume from parallel threads.
+    // Two threads may build the index at the same time, which is harmless.
+    std::shared_ptr<const FacetZIndexCache> cache = std::atomic_load(&m_facet_z_index);
+    if (! cache || cache->mesh.lock() != m_mesh) {
+        auto new_cache = std::make_shared<FacetZIndexCache>();
+        new_cache->mesh  = m_mesh;
+        new_cache->index = build_facet_z_index(m_mesh->its);
+        cache = std::move(new_cache);
+        std::atomic_store(&m_facet_z_index, cache);
+    }
+    return std::shared_ptr<const FacetZIndex>(cache, &cache->index);
+}
+
+struct ModelVolume::MeshChecksumCache
+{
+    std::weak_ptr<const TriangleMesh> mesh;
+    uint64_t                          checksum;
+};
+
+uint64_t ModelVolume::mesh_checksum() const
+{
+    std::shared_ptr<const MeshChecksumCache> cache = std::atomic_load(&m_mesh_checksum);
+    if (! cache || cache->mesh.lock() != m_mesh) {
+        auto new_cache = std::make_shared<MeshChecksumCache>();
+        new_cache->mesh     = m_mesh;
+        new_cache->checksum = its_hash(m_mesh->its);
+        cache = std::move(new_cache);
+        std::atomic_store(&m_mesh_checksum, cache);
+    }
+    return cache->checksum;
+}
+
 //BBS: refine the model part names
 ModelVolumeType ModelVolume::type_from_string(const std::string &s)
 {
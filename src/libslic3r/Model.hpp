@@ -42,6 +42,7 @@ namespace Slic3r {
 enum class ConversionType;
 
 class BuildVolume;
+struct FacetZIndex;
 class Model;
 class ModelInstance;
 class ModelMaterial;
@@ -944,6 +945,11 @@ public:
     void                calculate_convex_hull();
     const TriangleMesh& get_convex_hull() const;
     const std::shared_ptr<const TriangleMesh>& get_convex_hull_shared_ptr() const { return m_convex_hull; }
+    // Facets of the mesh sorted by Z for slicing. Built on demand, shared by copies of this volume referencing the same mesh.
+    std::shared_ptr<const FacetZIndex> get_facet_z_index() const;
+    // Checksum of the vertices and indices of the mesh (its_hash()), cached until the mesh is replaced.
+    // Used to find the PrintObjects made of identical meshes loaded separately.
+    uint64_t            mesh_checksum() const;
     //BBS: add convex_hell_2d related logic
     const Polygon& get_convex_hull_2d(const Transform3d &trafo_instance) const;
     void invalidate_convex_hull_2d()
@@ -1030,6 +1036,11 @@ private:
     t_model_material_id             	m_material_id;
     // The convex hull of this model's mesh.
     std::shared_ptr<const TriangleMesh> m_convex_hull;
+    // Index of the facets of m_mesh sorted by Z, see get_facet_z_index().
+    struct FacetZIndexCache;
+    mutable std::shared_ptr<const FacetZIndexCache> m_facet_z_index;
+    struct MeshChecksumCache;
+    mutable std::shared_ptr<const MeshChecksumCache> m_mesh_checksum;
     //BBS: add convex hull 2d related logic
     mutable Polygon                     m_convex_hull_2d; //BBS, used for convex_hell_2d acceleration
     mutable Transform3d                 m_cached_trans_matrix; //BBS, used for convex_hell_2d acceleration
@@ -1089,7 +1100,7 @@ private:
     // Copying an existing volume, therefore this volume will get a copy of the ID assigned.
     ModelVolume(ModelObject *object, const ModelVolume &other) :
         ObjectBase(other),
-        name(other.name), source(other.source), m_mesh(other.m_mesh), m_convex_hull(other.m_convex_hull),
+        name(other.name), source(other.source), m_mesh(other.m_mesh), m_convex_hull(other.m_convex_hull), m_facet_z_index(other.m_facet_z_index),
         config(other.config), m_type(other.m_type), object(object), m_transformation(other.m_transformation),
         supported_facets(other.supported_facets), seam_facets(other.seam_facets), mmu_segmentation_facets(other.mmu_segmentation_facets),
         m_text_info(other.m_text_info)
@@ -18,8 +18,15 @@
 #include <float.h>
 
 #include <algorithm>
+#include <atomic>
+#include <exception>
 #include <limits>
+#include <mutex>
+#include <unordered_map>
 #include <unordered_set>
+#include <tbb/task_group.h>
+#include <openssl/sha.h>
+#include <boost/filesystem/operations.hpp>
 #include <boost/filesystem/path.hpp>
 #include <boost/format.hpp>
 #include <boost/log/trivial.hpp>
@@ -1405,9 +1412,19 @@ void  PrintObject::copy_layers_from_shared_object()
 
         firstLayerObjSliceByVolume = m_shared_object->firstLayerObjSlice();
         firstLayerObjSliceByGroups = m_shared_object->firstLayerObjGroups();
+        // The slices of the shared object do not belong to the volumes of this object.
+        m_volume_slices_cache.clear();
     }
 }
 
+void PrintObject::take_volume_slices(PrintObject &rhs)
+{
+    firstLayerObjSliceByVolume = std::move(rhs.firstLayerObjSliceByVolume);
+    m_volume_slices_cache      = std::move(rhs.m_volume_slices_cache);
+    rhs.firstLayerObjSliceByVolume.clear();
+    rhs.m_volume_slices_cache.clear();
+}
+
 void  PrintObject::copy_layers_overhang_from_shared_object()
 {
     if (m_shared_object) {
@@ -1497,8 +1514,15 @@ void Print::process(bool use_cache)
             const ModelVolume &model_volume2 = *model_obj2->volumes[index];
             if (model_volume1.type() != model_volume2.type())
                 return false;
-            if (model_volume1.mesh_ptr() != model_volume2.mesh_ptr())
-                return false;
+            //BBS: the meshes of the copies are shared, identical meshes loaded separately are compared by content
+            if (model_volume1.mesh_ptr() != model_volume2.mesh_ptr()) {
+                if (model_volume1.mesh_checksum() != model_volume2.mesh_checksum())
+                    return false;
+                const indexed_triangle_set &its1 = model_volume1.mesh().its;
+                const indexed_triangle_set &its2 = model_volume2.mesh().its;
+                if (its1.vertices != its2.vertices || its1.indices != its2.indices)
+                    return false;
+            }
             if (!(model_volume1.get_transformation() == model_volume2.get_transformation()))
                 return false;
             has_extruder1 = model_volume1.config.has("extruder");
@@ -1519,23 +1543,57 @@ void Print::process(bool use_cache)
         //    return false;
         if (model_obj1->config.get() != model_obj2->config.get())
             return false;
+        if (model_obj1->layer_height_profile.get() != model_obj2->layer_height_profile.get())
+            return false;
+        if (model_obj1->layer_config_ranges.size() != model_obj2->layer_config_ranges.size())
+            return false;
+        for (auto it1 = model_obj1->layer_config_ranges.begin(), it2 = model_obj2->layer_config_ranges.begin(); it1 != model_obj1->layer_config_ranges.end(); ++ it1, ++ it2)
+            if (it1->first != it2->first || it1->second.get() != it2->second.get())
+                return false;
         return true;
     };
+    //BBS: the objects are bucketed by a hash of the cheap to hash fields compared above, only the objects
+    // of the same bucket are compared, instead of comparing each object with all the objects sliced so far.
+    auto print_object_share_key = [](const PrintObject* object) -> size_t {
+        size_t seed = 0;
+        for (size_t i = 0; i < 16; ++ i)
+            boost::hash_combine(seed, object->trafo().matrix().data()[i]);
+        const ModelObject* model_obj = object->model_object();
+        boost::hash_combine(seed, model_obj->volumes.size());
+        for (const ModelVolume* volume : model_obj->volumes) {
+            boost::hash_combine(seed, int(volume->type()));
+            boost::hash_combine(seed, volume->mesh_checksum());
+            for (size_t i = 0; i < 16; ++ i)
+                boost::hash_combine(seed, volume->get_matrix().data()[i]);
+        }
+        for (coordf_t value : model_obj->layer_height_profile.get())
+            boost::hash_combine(seed, value);
+        boost::hash_combine(seed, model_obj->layer_config_ranges.size());
+        return seed;
+    };
+    std::unordered_map<size_t, std::vector<PrintObject*>> share_index;
+    // Returns the object of the bucket of obj which obj can share the slicing results with, inserts obj otherwise.
+    auto find_or_insert_shared = [&share_index, &is_print_object_the_same](PrintObject* obj, size_t key) -> PrintObject* {
+        std::vector<PrintObject*> &bucket = share_index[key];
+        for (PrintObject *slicing_obj : bucket)
+            if (is_print_object_the_same(obj, slicing_obj))
+                return slicing_obj;
+        bucket.emplace_back(obj);
+        return nullptr;
+    };
     int object_count = m_objects.size();
     std::set<PrintObject*> need_slicing_objects;
     std::set<PrintObject*> re_slicing_objects;
+    std::vector<size_t> share_keys(object_count);
+    for (int index = 0; index < object_count; index++)
+        share_keys[index] = print_object_share_key(m_objects[index]);
     if (!use_cache) {
         for (int index = 0; index < object_count; index++)
         {
             PrintObject *obj =  m_objects[index];
-            for (PrintObject *slicing_obj : need_slicing_objects)
-            {
-                if (is_print_object_the_same(obj, slicing_obj)) {
-                    obj->set_shared_object(slicing_obj);
-                    break;
-                }
-            }
-            if (!obj->get_shared_object())
+            if (PrintObject *slicing_obj = find_or_insert_shared(obj, share_keys[index]))
+                obj->set_shared_object(slicing_obj);
+            else
                 need_slicing_objects.insert(obj);
         }
     }
@@ -1543,23 +1601,19 @@ void Print::process(bool use_cache)
         for (int index = 0; index < object_count; index++)
         {
             PrintObject *obj =  m_objects[index];
-            if (obj->layer_count() > 0)
+            if (obj->layer_count() > 0) {
                 need_slicing_objects.insert(obj);
+                share_index[share_keys[index]].emplace_back(obj);
+            }
         }
         for (int index = 0; index < object_count; index++)
         {
             PrintObject *obj =  m_objects[index];
-            bool found_shared = false;
             if (need_slicing_objects.find(obj) == need_slicing_objects.end()) {
-                for (PrintObject *slicing_obj : need_slicing_objects)
-                {
-                    if (is_print_object_the_same(obj, slicing_obj)) {
-                        obj->set_shared_object(slicing_obj);
-                        found_shared = true;
-                        break;
-                    }
-                }
-                if (!found_shared) {
+                PrintObject *slicing_obj = find_or_insert_shared(obj, share_keys[index]);
+                if (slicing_obj)
+                    obj->set_shared_object(slicing_obj);
+                else {
                     BOOST_LOG_TRIVIAL(warning) << boost::format("Also can not find the shared object, identify_id %1%, maybe shared object is skipped")%obj->model_object()->instances[0]->loaded_id;
                     //throw Slic3r::SlicingError("Can not find the cached data.");
                     //don't report errot, set use_cache to false, and reslice these objects
@@ -1573,77 +1627,25 @@ void Print::process(bool use_cache)
 
     BOOST_LOG_TRIVIAL(info) << __FUNCTION__ << boost::format(": total object counts %1% in current print, need to slice %2%")%m_objects.size()%need_slicing_objects.size();
     BOOST_LOG_TRIVIAL(info) << "Starting the slicing process." << log_memory_info();
-    if (!use_cache) {
-        for (PrintObject *obj : m_objects) {
-            if (need_slicing_objects.count(obj) != 0) {
-                obj->make_perimeters();
-            }
-            else {
-                if (obj->set_started(posSlice))
-                    obj->set_done(posSlice);
-                if (obj->set_started(posPerimeters))
-                    obj->set_done(posPerimeters);
-            }
-        }
-        for (PrintObject *obj : m_objects) {
-            if (need_slicing_objects.count(obj) != 0) {
-                obj->infill();
-            }
-            else {
-                if (obj->set_started(posPrepareInfill))
-                    obj->set_done(posPrepareInfill);
-                if (obj->set_started(posInfill))
-                    obj->set_done(posInfill);
-            }
-        }
-        for (PrintObject *obj : m_objects) {
-            if (need_slicing_objects.count(obj) != 0) {
-                obj->ironing();
-            }
-            else {
-                if (obj->set_started(posIroning))
-                    obj->set_done(posIroning);
-            }
-        }
-
-        tbb::parallel_for(tbb::blocked_range<int>(0, int(m_objects.size())),
-            [this, need_slicing_objects](const tbb::blocked_range<int>& range) {
-                for (int i = range.begin(); i < range.end(); i++) {
-                    PrintObject* obj = m_objects[i];
-                    if (need_slicing_objects.count(obj) != 0) {
-                        obj->generate_support_material();
-                    }
-                    else {
-                        if (obj->set_started(posSupportMaterial))
-                            obj->set_done(posSupportMaterial);
-                    }
-                }
-            }
-        );
-    }
-    else {
+    {
+        //BBS: the steps of an object only depend on the former steps of the same object, thus instead of a barrier
+        // after each step over all the objects, every object runs its steps as an independent chain of tasks.
+        // The layers of the small objects then keep the cores busy while the steps of the big ones finish.
+        // Only the slicing is finished for all the objects first, the tree support generator reads the layer
+        // counts of all the objects.
+        const std::set<PrintObject*> &processed_objects = use_cache ? re_slicing_objects : need_slicing_objects;
+        std::vector<PrintObject*> objects_to_process;
         for (PrintObject *obj : m_objects) {
-            if (re_slicing_objects.count(obj) == 0) {
-                if (obj->set_started(posSlice))
-                    obj->set_done(posSlice);
-                if (obj->set_started(posPerimeters))
-                    obj->set_done(posPerimeters);
-                if (obj->set_started(posPrepareInfill))
-                    obj->set_done(posPrepareInfill);
-                if (obj->set_started(posInfill))
-                    obj->set_done(posInfill);
-                if (obj->set_started(posIroning))
-                    obj->set_done(posIroning);
-                if (obj->set_started(posSupportMaterial))
-                    obj->set_done(posSupportMaterial);
-            }
+            if (processed_objects.count(obj) != 0)
+                objects_to_process.emplace_back(obj);
             else {
-                obj->make_perimeters();
-                obj->infill();
-                obj->ironing();
-                obj->generate_support_material();
+                for (PrintObjectStep step : { posSlice, posPerimeters, posPrepareInfill, posInfill, posIroning, posSupportMaterial })
+                    if (obj->set_started(step))
+                        obj->set_done(step);
             }
         }
+        run_object_steps(objects_to_process, { &PrintObject::slice });
+        run_object_steps(objects_to_process, { &PrintObject::make_perimeters, &PrintObject::infill, &PrintObject::ironing, &PrintObject::generate_support_material });
     }
 
     for (PrintObject *obj : m_objects)
@@ -1805,6 +1807,36 @@ void Print::process(bool use_cache)
     BOOST_LOG_TRIVIAL(info) << "Slicing process finished." << log_memory_info();
 }
 
+//BBS: run the steps of every object as a separate task, the steps of an object one after the other.
+// An exception does not cancel the tasks of the other objects through TBB, which would stop their parallel loops midway
+// and let them mark their steps done with a part of the layers processed. They stop at the next step boundary instead,
+// then the first exception is rethrown.
+void Print::run_object_steps(const std::vector<PrintObject*> &objects, std::initializer_list<void (PrintObject::*)()> steps)
+{
+    std::atomic<bool>  failed { false };
+    std::exception_ptr first_exception;
+    std::mutex         exception_mutex;
+    tbb::task_group    task_group;
+    for (PrintObject *obj : objects)
+        task_group.run([obj, &steps, &failed, &first_exception, &exception_mutex]() {
+            try {
+                for (void (PrintObject::*step)() : steps) {
+                    if (failed)
+                        break;
+                    (obj->*step)();
+                }
+            } catch (...) {
+                std::lock_guard<std::mutex> lock(exception_mutex);
+                if (! first_exception)
+                    first_exception = std::current_exception();
+                failed = true;
+            }
+        });
+    task_group.wait();
+    if (first_exception)
+        std::rethrow_exception(first_exception);
+}
+
 // G-code export process, running at a background thread.
 // The export_gcode may die for various reasons (fails to process filename_format,
 // write error into the G-code, cannot execute post-processing scripts).
@@ -2375,6 +2407,7 @@ std::string PrintStatistics::finalize_output_path(const std::string &path_in) co
 #define JSON_ARC_FITTING            "arc_fitting"
 #define JSON_OBJECT_NAME            "name"
 #define JSON_IDENTIFY_ID          "identify_id"
+#define JSON_CONTENT_KEY            "content_key"
 
 
 #define JSON_LAYERS                  "layers"
@@ -3098,7 +3131,82 @@ static void from_json(const json& j, groupedVolumeSlices& firstlayer_group)
     }
 }
 
-int Print::export_cached_data(const std::string& directory, bool with_space)
+// Digest of everything the slicing data of a PrintObject stored by Print::export_cached_data(keyed_by_content=true) depends on:
+// meshes, transformations, paint-on data, layer heights and configuration.
+// The data is shared by all PrintObjects with the same digest. The digest is stored into the file and verified when loading,
+// the file name carries just its prefix.
+static std::string cached_data_content_key(const PrintObject& obj)
+{
+    SHA256_CTX ctx;
+    SHA256_Init(&ctx);
+    auto update = [&ctx](const void* data, size_t size) { SHA256_Update(&ctx, data, size); };
+    auto update_string = [&update](const std::string& str) {
+        uint64_t size = str.size();
+        update(&size, sizeof(size));
+        update(str.data(), str.size());
+    };
+    auto update_config = [&update_string](const ConfigBase& config) {
+        for (const std::string& key : config.keys()) {
+            update_string(key);
+            update_string(config.option(key)->serialize());
+        }
+        update_string(std::string());
+    };
+    auto update_trafo = [&update](const Transform3d& trafo) { update(trafo.matrix().data(), 16 * sizeof(double)); };
+    auto update_facets = [&update, &update_string](const FacetsAnnotation& facets) {
+        const auto& data = facets.get_data();
+        update(data.first.data(), data.first.size() * sizeof(std::pair<int, int>));
+        std::string bits(data.second.size(), '0');
+        for (size_t i = 0; i < data.second.size(); ++ i)
+            if (data.second[i])
+                bits[i] = '1';
+        update_string(bits);
+    };
+
+    const ModelObject* model_obj = obj.model_object();
+    update_string(SLIC3R_VERSION);
+    update_trafo(obj.trafo());
+    update(obj.center_offset().data(), 2 * sizeof(coord_t));
+    for (const ModelVolume* volume : model_obj->volumes) {
+        int             type = int(volume->type());
+        const indexed_triangle_set& its = volume->mesh().its;
+        uint64_t        counts[2] = { its.vertices.size(), its.indices.size() };
+        update(&type, sizeof(type));
+        update(counts, sizeof(counts));
+        update(its.vertices.data(), its.vertices.size() * sizeof(stl_vertex));
+        update(its.indices.data(), its.indices.size() * sizeof(stl_triangle_vertex_indices));
+        update_trafo(volume->get_matrix());
+        update_config(volume->config.get());
+        update_facets(volume->supported_facets);
+        update_facets(volume->seam_facets);
+        update_facets(volume->mmu_segmentation_facets);
+    }
+    update_config(model_obj->config.get());
+    for (const auto& range : model_obj->layer_config_ranges) {
+        update(&range.first.first, sizeof(coordf_t));
+        update(&range.first.second, sizeof(coordf_t));
+        update_config(range.second.get());
+    }
+    const std::vector<coordf_t>& layer_height_profile = model_obj->layer_height_profile.get();
+    update_string(std::string(reinterpret_cast<const char*>(layer_height_profile.data()), layer_height_profile.size() * sizeof(coordf_t)));
+    update_config(obj.config());
+    for (size_t region_id = 0; region_id < obj.num_printing_regions(); ++ region_id)
+        update_config(obj.printing_region(region_id).config());
+    update_config(obj.print()->config());
+
+    unsigned char digest[SHA256_DIGEST_LENGTH];
+    SHA256_Final(digest, &ctx);
+    char digest_str[SHA256_DIGEST_LENGTH * 2 + 1];
+    for (int j = 0; j < SHA256_DIGEST_LENGTH; j++) { sprintf(&digest_str[j * 2], "%02x", (unsigned int) digest[j]); }
+    return std::string(digest_str);
+}
+
+static std::string cached_data_content_file_name(const std::string& directory, const std::string& content_key)
+{
+    return directory + "/obj_" + content_key.substr(0, 16) + ".json";
+}
+
+int Print::export_cached_data(const std::string& directory, bool with_space, bool keyed_by_content)
 {
     int ret = 0;
     boost::filesystem::path directory_path(directory);
@@ -3137,11 +3245,18 @@ int Print::export_cached_data(const std::string& directory, bool with_space)
         return;
     };
 
+    if (keyed_by_content) {
+        // The directory is shared by many prints, keep the objects stored by the other prints.
+        if (!fs::exists(directory_path) && !fs::create_directories(directory_path)) {
+            BOOST_LOG_TRIVIAL(error) << boost::format("create directory %1% failed")%directory;
+            return CLI_EXPORT_CACHE_DIRECTORY_CREATE_FAILED;
+        }
+    }
     //firstly clear this directory
-    if (fs::exists(directory_path)) {
+    else if (fs::exists(directory_path)) {
         fs::remove_all(directory_path);
     }
-    if (!fs::create_directory(directory_path)) {
+    if (!keyed_by_content && !fs::create_directory(directory_path)) {
         BOOST_LOG_TRIVIAL(error) << boost::format("create directory %1% failed")%directory;
         return CLI_EXPORT_CACHE_DIRECTORY_CREATE_FAILED;
     }
@@ -3159,7 +3274,12 @@ int Print::export_cached_data(const std::string& directory, bool with_space)
         const PrintInstance &print_instance = obj->instances()[0];
         const ModelInstance *model_instance = print_instance.model_instance;
         size_t identify_id = (model_instance->loaded_id > 0)?model_instance->loaded_id: model_instance->id().id;
-        std::string file_name = directory +"/obj_"+std::to_string(identify_id)+".json";
+        std::string content_key = keyed_by_content ? cached_data_content_key(*obj) : std::string();
+        std::string file_name = keyed_by_content ? cached_data_content_file_name(directory, content_key) : directory +"/obj_"+std::to_string(identify_id)+".json";
+        if (keyed_by_content && fs::exists(file_name)) {
+            BOOST_LOG_TRIVIAL(info) << boost::format("object %1% already cached in %2%, skip it")%model_obj->name %file_name;
+            continue;
+        }
 
         BOOST_LOG_TRIVIAL(info) << boost::format("begin to dump object %1%, identify_id %2% to %3%")%model_obj->name %identify_id %file_name;
 
@@ -3168,6 +3288,8 @@ int Print::export_cached_data(const std::string& directory, bool with_space)
 
             root_json[JSON_OBJECT_NAME] = model_obj->name;
             root_json[JSON_IDENTIFY_ID] = identify_id;
+            if (keyed_by_content)
+                root_json[JSON_CONTENT_KEY] = content_key;
 
             //export the layers
             std::vector<json> layers_json_vector(obj->layer_count());
@@ -3324,19 +3446,29 @@ int Print::export_cached_data(const std::string& directory, bool with_space)
     boost::mutex mutex;
     tbb::parallel_for(
         tbb::blocked_range<size_t>(0, filename_vector.size()),
-        [filename_vector, &json_vector, with_space, &ret, &mutex](const tbb::blocked_range<size_t>& output_range) {
+        [filename_vector, &json_vector, with_space, keyed_by_content, &ret, &mutex](const tbb::blocked_range<size_t>& output_range) {
             for (size_t object_index = output_range.begin(); object_index < output_range.end(); ++ object_index) {
+                // The shared directory may be read and written by other processes at the same time, don't let them see a partial file.
+                // The temporary file name is unique, the processes storing the same object don't write into each other's file.
+                std::string file_name = keyed_by_content ?
+                    filename_vector[object_index] + "." + fs::unique_path("%%%%-%%%%-%%%%-%%%%").string() + ".tmp" : filename_vector[object_index];
                 try {
                     boost::nowide::ofstream c;
-                    c.open(filename_vector[object_index], std::ios::out | std::ios::trunc);
+                    c.open(file_name, std::ios::out | std::ios::trunc);
                     if (with_space)
                         c << std::setw(4) << json_vector[object_index] << std::endl;
                     else
                         c << json_vector[object_index].dump(0) << std::endl;
                     c.close();
+                    if (keyed_by_content)
+                        fs::rename(file_name, filename_vector[object_index]);
                 }
                 catch(std::exception &err) {
                     BOOST_LOG_TRIVIAL(error) << __FUNCTION__<< ": save to "<<filename_vector[object_index]<<" got a generic exception, reason = " << err.what();
+                    if (keyed_by_content) {
+                        boost::system::error_code ec;
+                        fs::remove(file_name, ec);
+                    }
                     boost::unique_lock l(mutex);
                     ret = CLI_EXPORT_CACHE_WRITE_FAILED;
                 }
@@ -3349,7 +3481,7 @@ int Print::export_cached_data(const std::string& directory, bool with_space)
 }
 
 
-int Print::load_cached_data(const std::string& directory)
+int Print::load_cached_data(const std::string& directory, bool keyed_by_content)
 {
     int ret = 0;
     boost::filesystem::path directory_path(directory);
@@ -3373,6 +3505,7 @@ int Print::load_cached_data(const std::string& directory)
 
     int count = 0;
     std::vector<std::pair<std::string, PrintObject*>> object_filenames;
+    std::vector<std::string> content_keys;
     for (PrintObject *obj : m_objects) {
         const ModelObject* model_obj = obj->model_object();
         const PrintInstance &print_instance = obj->instances()[0];
@@ -3388,13 +3521,24 @@ int Print::load_cached_data(const std::string& directory)
             BOOST_LOG_TRIVIAL(info) << __FUNCTION__<< boost::format(": object %1%'s loaded_id is 0, need to use the instance_id %2%")%model_obj->name %identify_id;
             //continue;
         }
-        std::string file_name = directory +"/obj_"+std::to_string(identify_id)+".json";
+        std::string content_key = keyed_by_content ? cached_data_content_key(*obj) : std::string();
+        std::string file_name = keyed_by_content ? cached_data_content_file_name(directory, content_key) : directory +"/obj_"+std::to_string(identify_id)+".json";
 
         if (!fs::exists(file_name)) {
             BOOST_LOG_TRIVIAL(info) << __FUNCTION__<<boost::format(": file %1% not exist, maybe a shared object, skip it")%file_name;
             continue;
         }
+        if (keyed_by_content) {
+            // Identical objects share the same file, load it just once.
+            auto it = std::find_if(object_filenames.begin(), object_filenames.end(), [&file_name](const auto& item) { return item.first == file_name; });
+            if (it != object_filenames.end())
+                continue;
+            // Mark the file as recently used for evict_cached_data().
+            boost::system::error_code ec;
+            fs::last_write_time(file_name, std::time(nullptr), ec);
+        }
         object_filenames.push_back({file_name, obj});
+        content_keys.push_back(std::move(content_key));
     }
 
     boost::mutex mutex;
@@ -3433,6 +3577,11 @@ int Print::load_cached_data(const std::string& directory)
 
             std::string name = root_json.at(JSON_OBJECT_NAME);
             int identify_id = root_json.at(JSON_IDENTIFY_ID);
+            if (keyed_by_content && root_json.value(JSON_CONTENT_KEY, std::string()) != content_keys[obj_index]) {
+                // Just the prefix of the key is in the file name, the file belongs to another object. Slice this one.
+                BOOST_LOG_TRIVIAL(warning) << __FUNCTION__<< boost::format(": content key of %1% does not match object %2%, skip it")%object_filenames[obj_index].first %obj->model_object()->name;
+                continue;
+            }
             int layer_count = 0, support_layer_count = 0, firstlayer_group_count = 0;
 
             layer_count = root_json[JSON_LAYERS].size();
@@ -3565,6 +3714,42 @@ int Print::load_cached_data(const std::string& directory)
     return ret;
 }
 
+void Print::evict_cached_data(const std::string& directory, size_t max_size)
+{
+    struct CachedFile {
+        fs::path    path;
+        std::time_t last_used;
+        uintmax_t   size;
+    };
+    std::vector<CachedFile> files;
+    uintmax_t               total_size = 0;
+    try {
+        for (const fs::directory_entry& entry : fs::directory_iterator(directory))
+            if (fs::is_regular_file(entry.status()) && entry.path().extension() == ".json") {
+                files.push_back({ entry.path(), fs::last_write_time(entry.path()), fs::file_size(entry.path()) });
+                total_size += files.back().size;
+            }
+    } catch (const std::exception& err) {
+        BOOST_LOG_TRIVIAL(error) << __FUNCTION__ << ": failed to list " << directory << ", reason = " << err.what();
+        return;
+    }
+    if (total_size <= max_size)
+        return;
+
+    std::sort(files.begin(), files.end(), [](const CachedFile& l, const CachedFile& r) { return l.last_used < r.last_used; });
+    size_t removed = 0;
+    for (const CachedFile& file : files) {
+        if (total_size <= max_size)
+            break;
+        boost::system::error_code ec;
+        if (fs::remove(file.path, ec)) {
+            total_size -= file.size;
+            ++ removed;
+        }
+    }
+    BOOST_LOG_TRIVIAL(info) << __FUNCTION__ << boost::format(": removed %1% of %2% cached objects, cache size %3%")%removed %files.size() %format_memsize_MB(size_t(total_size));
+}
+
 BoundingBoxf3 PrintInstance::get_bounding_box() {
     return print_object->model_object()->instance_bounding_box(*model_instance, false);
 }
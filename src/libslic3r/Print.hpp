@@ -21,6 +21,7 @@
 
 #include <functional>
 #include <set>
+#include <unordered_map>
 #include "Calib.hpp"
 
 namespace Slic3r {
@@ -34,6 +35,8 @@ class SupportLayer;
 // BBS
 class TreeSupportData;
 class TreeSupport;
+struct SupportOverhangCache;
+struct SeamVisibilityCache;
 
 // BBS: move from PrintObjectSlice.cpp
 struct VolumeSlices
@@ -42,6 +45,41 @@ struct VolumeSlices
     std::vector<ExPolygons> slices;
 };
 
+// Inputs of the per volume slices produced by the last run of PrintObject::slice_volumes().
+// The slices themselves are not copied, they are the ones kept by PrintObject::firstLayerObjSlice().
+// If only some volumes of an object change (for example a modifier is moved), only those volumes are sliced again.
+// Only the slicing is incremental: the regions, perimeters and all the later steps are still recomputed for the whole object.
+struct VolumeSlicesCache
+{
+    // Full key of the slices of a volume, compared on lookup.
+    struct Key
+    {
+        ObjectID                       volume_id;
+        uint64_t                       mesh_checksum { 0 };
+        // Object and volume transformation.
+        Transform3d                    trafo { Transform3d::Identity() };
+        MeshSlicingParams::SlicingMode mode { MeshSlicingParams::SlicingMode::Regular };
+        float                          closing_radius { 0 };
+        float                          extra_offset { 0 };
+        double                         resolution { 0 };
+
+        bool operator==(const Key &rhs) const {
+            return volume_id == rhs.volume_id && mesh_checksum == rhs.mesh_checksum && trafo.matrix() == rhs.trafo.matrix() &&
+                   mode == rhs.mode && closing_radius == rhs.closing_radius && extra_offset == rhs.extra_offset && resolution == rhs.resolution;
+        }
+    };
+
+    // Slicing planes of the last run, the per volume slices are indexed by them.
+    std::vector<float> zs;
+    // Keys of the volumes sliced by the last run.
+    std::vector<Key>   keys;
+    // Statistics of the last run.
+    size_t             layers_reused { 0 };
+    size_t             layers_sliced { 0 };
+
+    void clear() { zs.clear(); keys.clear(); layers_reused = 0; layers_sliced = 0; }
+};
+
 struct groupedVolumeSlices
 {
     int                     groupId = -1;
@@ -335,6 +373,7 @@ public:
     std::vector<VolumeSlices>& firstLayerObjSliceMod() { return firstLayerObjSliceByVolume; }
     const std::vector<groupedVolumeSlices>& firstLayerObjGroups() const { return firstLayerObjSliceByGroups; }
     std::vector<groupedVolumeSlices>& firstLayerObjGroupsMod() { return firstLayerObjSliceByGroups; }
+    const VolumeSlicesCache& volume_slices_cache() const { return m_volume_slices_cache; }
 
     bool                         has_brim() const       {
         return ((this->config().brim_type != btNoBrim && this->config().brim_width.value > 0.) || this->config().brim_type == btAutoBrim)
@@ -375,6 +414,12 @@ public:
     SupportLayer* add_tree_support_layer(int id, coordf_t height, coordf_t print_z, coordf_t slice_z);
     std::shared_ptr<TreeSupportData> alloc_tree_support_preview_cache();
     void clear_tree_support_preview_cache() { m_tree_support_preview_cache.reset(); }
+    // Overhangs detected by the last normal support generation, kept over invalidate_support_annotations().
+    std::shared_ptr<SupportOverhangCache> alloc_support_overhang_cache();
+    void clear_support_overhang_cache() { m_support_overhang_cache.reset(); }
+    // Visibility of the object surface raycasted by the seam placer of the last G-code export, released together with the object.
+    std::shared_ptr<const SeamVisibilityCache> seam_visibility_cache() const { return m_seam_visibility_cache; }
+    void set_seam_visibility_cache(std::shared_ptr<const SeamVisibilityCache> cache) const { m_seam_visibility_cache = std::move(cache); }
 
     size_t          support_layer_count() const { return m_support_layers.size(); }
     void            clear_support_layers();
@@ -452,6 +497,10 @@ private:
     bool                    invalidate_step(PrintObjectStep step);
     // Invalidates all PrintObject and Print steps.
     bool                    invalidate_all_steps();
+    // BBS: Invalidates the supports after the support enforcers / blockers changed, keeping the support overhang cache.
+    bool                    invalidate_support_annotations();
+    // BBS: Takes the volume slices of a PrintObject of the same ModelObject replaced by this one, to be reused by slice_volumes().
+    void                    take_volume_slices(PrintObject &rhs);
     // Invalidate steps based on a set of parameters changed.
     // It may be called for both the PrintObjectConfig and PrintRegionConfig.
     bool                    invalidate_state_by_config_options(
@@ -511,10 +560,14 @@ private:
     SupportLayerPtrs                        m_support_layers;
     // BBS
     std::shared_ptr<TreeSupportData>        m_tree_support_preview_cache;
+    std::shared_ptr<SupportOverhangCache>   m_support_overhang_cache;
+    // Written by the G-code export, which only gets a const PrintObject.
+    mutable std::shared_ptr<const SeamVisibilityCache> m_seam_visibility_cache;
 
     // this is set to true when LayerRegion->slices is split in top/internal/bottom
     // so that next call to make_perimeters() performs a union() before computing loops
     bool                    				m_typed_slices = false;
+    VolumeSlicesCache                       m_volume_slices_cache;
     std::vector < VolumeSlices >            firstLayerObjSliceByVolume;
     std::vector<groupedVolumeSlices>        firstLayerObjSliceByGroups;
     // BBS: per object skirt
@@ -703,8 +756,13 @@ public:
     // If preview_data is not null, the preview_data is filled in for the G-code visualization (not used by the command line Slic3r).
     std::string         export_gcode(const std::string& path_template, GCodeProcessorResult* result, ThumbnailsGeneratorCallback thumbnail_cb = nullptr);
     //return 0 means successful
-    int                 export_cached_data(const std::string& dir_path, bool with_space=false);
-    int                 load_cached_data(const std::string& directory);
+    // If keyed_by_content is set, the objects are stored / looked up by a hash of their meshes and configuration
+    // instead of their identify_id, thus a single directory may serve as a slicing cache for any number of projects.
+    int                 export_cached_data(const std::string& dir_path, bool with_space=false, bool keyed_by_content=false) override;
+    int                 load_cached_data(const std::string& directory, bool keyed_by_content=false) override;
+    // Remove the least recently used objects stored by export_cached_data(keyed_by_content=true)
+    // until the size of the directory drops below max_size bytes.
+    static void         evict_cached_data(const std::string& directory, size_t max_size);
 
     // methods for handling state
     bool                is_step_done(PrintStep step) const { return Inherited::is_step_done(step); }
@@ -835,6 +893,8 @@ private:
     void                _make_skirt();
     void                _make_wipe_tower();
     void                finalize_first_layer_convex_hull();
+    //BBS: run the steps of the objects concurrently, the steps of each object in order
+    static void         run_object_steps(const std::vector<PrintObject*> &objects, std::initializer_list<void (PrintObject::*)()> steps);
 
     // Islands of objects and their supports extruded at the 1st layer.
     Polygons            first_layer_islands() const;
@@ -1266,7 +1266,7 @@ Print::ApplyStatus Print::apply(const Model &model, DynamicPrintConfig new_full_
                 }
                 // Invalidate just the supports step.
                 for (const PrintObjectStatus &print_object_status : print_objects_range)
-                    update_apply_status(print_object_status.print_object->invalidate_step(posSupportMaterial));
+                    update_apply_status(print_object_status.print_object->invalidate_support_annotations());
                 if (supports_differ) {
                     // Copy just the support volumes.
                     model_volume_list_update_supports(model_object, model_object_new);
@@ -1336,10 +1336,21 @@ Print::ApplyStatus Print::apply(const Model &model, DynamicPrintConfig new_full_
             ModelObjectStatus &model_object_status = const_cast<ModelObjectStatus&>(model_object_status_db.reuse(*model_object));
             model_object_status.print_instances    = print_objects_from_model_object(*model_object);
             std::vector<const PrintObjectStatus*> old;
+            std::vector<const PrintObjectStatus*> deleted;
             old.reserve(print_object_status_db.count(*model_object));
             for (const PrintObjectStatus &print_object_status : print_object_status_db.get_range(*model_object))
                 if (print_object_status.status != PrintObjectStatus::Deleted)
                     old.emplace_back(&print_object_status);
+                else
+                    deleted.emplace_back(&print_object_status);
+            // BBS: Reuse the volume slices of a deleted PrintObject with the same trafo, for example if just a modifier changed.
+            auto print_object_take_volume_slices = [&deleted](PrintObject *print_object) {
+                auto it = std::find_if(deleted.begin(), deleted.end(), [print_object](const PrintObjectStatus *status) { return transform3d_equal(status->trafo, print_object->trafo()); });
+                if (it != deleted.end()) {
+                    print_object->take_volume_slices(*(*it)->print_object);
+                    deleted.erase(it);
+                }
+            };
             // Generate a list of trafos and XY offsets for instances of a ModelObject
             // Producing the config for PrintObject on demand, caching it at print_object_last.
             const PrintObject *print_object_last = nullptr;
@@ -1354,6 +1365,7 @@ Print::ApplyStatus Print::apply(const Model &model, DynamicPrintConfig new_full_
                 for (PrintObjectTrafoAndInstances &print_instances : model_object_status.print_instances) {
                     PrintObject *print_object = new PrintObject(this, model_object, print_instances.trafo, std::move(print_instances.instances));
                     print_object_apply_config(print_object);
+                    print_object_take_volume_slices(print_object);
                     print_objects_new.emplace_back(print_object);
                     // print_object_status.emplace(PrintObjectStatus(print_object, PrintObjectStatus::New));
                     new_objects = true;
@@ -1371,6 +1383,7 @@ Print::ApplyStatus Print::apply(const Model &model, DynamicPrintConfig new_full_
                     // This is a new instance (or a set of instances with the same trafo). Just add it.
                     PrintObject *print_object = new PrintObject(this, model_object, new_instances.trafo, std::move(new_instances.instances));
                     print_object_apply_config(print_object);
+                    print_object_take_volume_slices(print_object);
                     print_objects_new.emplace_back(print_object);
                     // print_object_status.emplace(PrintObjectStatus(print_object, PrintObjectStatus::New));
                     new_objects = true;
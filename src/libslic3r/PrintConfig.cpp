@@ -4996,6 +4996,18 @@ CLIActionsConfigDef::CLIActionsConfigDef()
     def->tooltip = L("Send progress to pipe.");
     def->cli_params = "pipename";
     def->set_default_value(new ConfigOptionString(""));
+
+    def = this->add("batch", coString);
+    def->label = L("Batch");
+    def->tooltip = L("Run all the jobs listed in a json manifest within this process, and write a json report of their results.");
+    def->cli_params = "manifest.json";
+    def->set_default_value(new ConfigOptionString(""));
+
+    def = this->add("daemon", coString);
+    def->label = L("Daemon");
+    def->tooltip = L("Keep running and serve json slicing requests received on a unix domain socket.");
+    def->cli_params = "socket";
+    def->set_default_value(new ConfigOptionString(""));
 }
 
 //BBS: remove unused command currently
@@ -5183,6 +5195,20 @@ CLIMiscConfigDef::CLIMiscConfigDef()
     def->cli_params = "dir";
     def->set_default_value(new ConfigOptionString());
 
+    def = this->add("slice_cache_dir", coString);
+    def->label = L("Slicing cache directory");
+    def->tooltip = L("Directory to keep the slicing data of objects between runs. Objects with the same geometry and settings "
+                     "are loaded from this directory instead of being sliced again.");
+    def->cli_params = "dir";
+    def->set_default_value(new ConfigOptionString());
+
+    def = this->add("slice_cache_size", coInt);
+    def->label = L("Slicing cache size");
+    def->tooltip = L("Maximum size of the slicing cache directory in MB. The least recently used objects are removed first.");
+    def->min = 0;
+    def->cli_params = "size";
+    def->set_default_value(new ConfigOptionInt(4096));
+
     def = this->add("debug", coInt);
     def->label = L("Debug level");
     def->tooltip = L("Sets debug logging level. 0:fatal, 1:error, 2:warning, 3:info, 4:debug, 5:trace\n");
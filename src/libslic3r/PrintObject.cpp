@@ -127,6 +127,21 @@ std::vector<std::reference_wrapper<const PrintRegion>> PrintObject::all_regions(
 // 1) Merges typed region slices into stInternal type.
 // 2) Increases an "extra perimeters" counter at region slices where needed.
 // 3) Generates perimeters, gap fills and fill regions (fill regions of type stInternal).
+//BBS: report how many extrusion entities the layer arenas served and how many heap allocations backed them
+static void log_extrusion_arena_usage(const LayerPtrs &layers, const char *step)
+{
+    size_t entities = 0;
+    size_t chunks_allocated = 0;
+    size_t chunks = 0;
+    for (const Layer *layer : layers) {
+        entities         += layer->extrusion_arena().entities_allocated();
+        chunks_allocated += layer->extrusion_arena().chunks_allocated();
+        chunks           += layer->extrusion_arena().chunks();
+    }
+    BOOST_LOG_TRIVIAL(debug) << step << ": " << entities << " extrusion entities allocated from " << chunks_allocated
+                             << " arena chunks over " << layers.size() << " layers, " << chunks << " chunks held";
+}
+
 void PrintObject::make_perimeters()
 {
     // prerequisites
@@ -230,6 +245,7 @@ void PrintObject::make_perimeters()
     );
     m_print->throw_if_canceled();
     BOOST_LOG_TRIVIAL(debug) << "Generating perimeters in parallel - end";
+    log_extrusion_arena_usage(m_layers, "Generating perimeters");
 
     this->set_done(posPerimeters);
 }
@@ -382,6 +398,7 @@ void PrintObject::infill()
         );
         m_print->throw_if_canceled();
         BOOST_LOG_TRIVIAL(debug) << "Filling layers in parallel - end";
+        log_extrusion_arena_usage(m_layers, "Filling layers");
         /*  we could free memory now, but this would make this step not idempotent
         ### $_->fill_surfaces->clear for map @{$_->regions}, @{$object->layers};
         */
@@ -455,9 +472,18 @@ void PrintObject::generate_support_material()
 
         if ((this->has_support() && m_layers.size() > 1) || (this->has_raft() && ! m_layers.empty())) {
             m_print->set_status(50, L("Generating support"));
+            typedef std::chrono::high_resolution_clock clock_;
+            typedef std::chrono::duration<double, std::ratio<1> > second_;
+            std::chrono::time_point<clock_> t0{ clock_::now() };
+            // BBS: the overhang cache survives only the edits of the support enforcers / blockers, see invalidate_support_annotations().
+            const bool after_support_annotations_edit = m_support_overhang_cache != nullptr;
 
             this->_generate_support_material();
             m_print->throw_if_canceled();
+
+            double duration{ std::chrono::duration_cast<second_>(clock_::now() - t0).count() };
+            BOOST_LOG_TRIVIAL(info) << std::fixed << std::setprecision(3) << "generate_support_material of " << this->model_object()->name << " takes "
+                << duration << " secs" << (after_support_annotations_edit ? ", after an edit of the support enforcers / blockers." : ".");
         } else if(!m_print->get_no_check_flag()) {
             // BBS: pop a warning if objects have significant amount of overhangs but support material is not enabled
             m_print->set_status(50, L("Checking support necessity"));
@@ -608,6 +634,8 @@ void PrintObject::clear_layers()
             delete l;
         m_layers.clear();
     }
+    // BBS: the cached sharp tails point to the slices of the layers
+    this->clear_support_overhang_cache();
 }
 
 Layer* PrintObject::add_layer(int id, coordf_t height, coordf_t print_z, coordf_t slice_z)
@@ -658,6 +686,14 @@ std::shared_ptr<TreeSupportData> PrintObject::alloc_tree_support_preview_cache()
     return m_tree_support_preview_cache;
 }
 
+std::shared_ptr<SupportOverhangCache> PrintObject::alloc_support_overhang_cache()
+{
+    if (!m_support_overhang_cache)
+        m_support_overhang_cache = std::make_shared<SupportOverhangCache>();
+
+    return m_support_overhang_cache;
+}
+
 SupportLayer* PrintObject::add_tree_support_layer(int id, coordf_t height, coordf_t print_z, coordf_t slice_z)
 {
     m_support_layers.emplace_back(new SupportLayer(id, 0, this, height, print_z, slice_z));
@@ -931,6 +967,11 @@ bool PrintObject::invalidate_step(PrintObjectStep step)
 {
 	bool invalidated = Inherited::invalidate_step(step);
 
+    //BBS: the cached support overhangs are only valid if nothing but the support enforcers / blockers changed.
+    // Besides the slices, the overhang detection reads the perimeters and fill surfaces (bridge_no_support) and the flows of the regions.
+    if (step == posSlice || step == posPerimeters || step == posPrepareInfill || step == posInfill || step == posSupportMaterial)
+        this->clear_support_overhang_cache();
+
     // propagate to dependent steps
     if (step == posPerimeters) {
 		invalidated |= this->invalidate_steps({ posPrepareInfill, posInfill, posIroning, posSimplifyWall, posSimplifyInfill });
@@ -959,10 +1000,20 @@ bool PrintObject::invalidate_step(PrintObjectStep step)
     return invalidated;
 }
 
+//BBS: the overhangs of the layers, whose support blockers did not change, are reused by the support generator.
+bool PrintObject::invalidate_support_annotations()
+{
+    std::shared_ptr<SupportOverhangCache> overhang_cache = std::move(m_support_overhang_cache);
+    bool invalidated = this->invalidate_step(posSupportMaterial);
+    m_support_overhang_cache = std::move(overhang_cache);
+    return invalidated;
+}
+
 bool PrintObject::invalidate_all_steps()
 {
 	// First call the "invalidate" functions, which may cancel background processing.
     bool result = Inherited::invalidate_all_steps() | m_print->invalidate_all_steps();
+    this->clear_support_overhang_cache();
 	// Then reset some of the depending values.
 	m_slicing_params.valid = false;
 	return result;
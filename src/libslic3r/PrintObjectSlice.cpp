@@ -57,6 +57,8 @@ static std::vector<ExPolygons> slice_volume(
         if (its.indices.size() > 0) {
             MeshSlicingParamsEx params2 { params };
             params2.trafo = params2.trafo * volume.get_matrix();
+            // Flipping the triangles below does not reorder the facets, thus the index of the volume mesh stays valid.
+            params2.facet_z_index = [&volume]() { return volume.get_facet_z_index(); };
             if (params2.trafo.rotation().determinant() < 0.)
                 its_flip_triangles(its);
             layers = slice_mesh_ex(its, zs, params2, throw_on_cancel_callback);
@@ -66,6 +68,71 @@ static std::vector<ExPolygons> slice_volume(
     return layers;
 }
 
+// Slices of the volumes produced by the last run of slice_volumes() and the keys of the volumes sliced by the current run.
+// Only the mesh slicing is skipped for the unchanged volumes, posSlice and everything after it still processes the whole object.
+struct VolumeSlicesReuse
+{
+    const VolumeSlicesCache         &previous;
+    const std::vector<VolumeSlices> &previous_slices;
+    VolumeSlicesCache                current;
+
+    // Slices of the layer at z produced by the last run with the same key, nullptr if not available.
+    const ExPolygons* find(const VolumeSlicesCache::Key &key, float z) const {
+        if (std::find(previous.keys.begin(), previous.keys.end(), key) == previous.keys.end())
+            return nullptr;
+        auto it_slices = std::find_if(previous_slices.begin(), previous_slices.end(), [&key](const VolumeSlices &vs) { return vs.volume_id == key.volume_id; });
+        auto it_z      = std::lower_bound(previous.zs.begin(), previous.zs.end(), z);
+        if (it_slices == previous_slices.end() || it_slices->slices.size() != previous.zs.size() || it_z == previous.zs.end() || *it_z != z)
+            return nullptr;
+        return &it_slices->slices[it_z - previous.zs.begin()];
+    }
+};
+
+// Slice single triangle mesh, reuse the layers sliced by the previous slicing run with the same inputs.
+static std::vector<ExPolygons> slice_volume(
+    const ModelVolume             &volume,
+    const std::vector<float>      &zs,
+    const MeshSlicingParamsEx     &params,
+    const std::function<void()>   &throw_on_cancel_callback,
+    VolumeSlicesReuse             &reuse)
+{
+    // In vase mode the bottom layers are sliced differently, thus a layer is not a function of its slicing plane only.
+    if (zs.empty() || volume.mesh().its.indices.empty() || params.slicing_mode_normal_below_layer > 0)
+        return slice_volume(volume, zs, params, throw_on_cancel_callback);
+
+    VolumeSlicesCache::Key key;
+    key.volume_id      = volume.id();
+    key.mesh_checksum  = volume.mesh_checksum();
+    key.trafo          = params.trafo * volume.get_matrix();
+    key.mode           = params.mode;
+    key.closing_radius = params.closing_radius;
+    key.extra_offset   = params.extra_offset;
+    key.resolution     = params.resolution;
+
+    std::vector<ExPolygons> layers(zs.size());
+    std::vector<float>      zs_missing;
+    std::vector<size_t>     layers_missing;
+    for (size_t i = 0; i < zs.size(); ++ i)
+        if (const ExPolygons *slices = reuse.find(key, zs[i]); slices != nullptr)
+            layers[i] = *slices;
+        else {
+            zs_missing.emplace_back(zs[i]);
+            layers_missing.emplace_back(i);
+        }
+    if (! zs_missing.empty()) {
+        std::vector<ExPolygons> sliced = slice_volume(volume, zs_missing, params, throw_on_cancel_callback);
+        assert(sliced.size() == zs_missing.size());
+        for (size_t i = 0; i < layers_missing.size(); ++ i)
+            layers[layers_missing[i]] = std::move(sliced[i]);
+    }
+    BOOST_LOG_TRIVIAL(debug) << "Slicing volume " << volume.name << ": " << zs.size() - zs_missing.size() << " of " << zs.size() << " layers reused";
+
+    reuse.current.keys.emplace_back(std::move(key));
+    reuse.current.layers_reused += zs.size() - zs_missing.size();
+    reuse.current.layers_sliced += zs_missing.size();
+    return layers;
+}
+
 // Slice single triangle mesh.
 // Filter the zs not inside the ranges. The ranges are closed at the bottom and open at the top, they are sorted lexicographically and non overlapping.
 static std::vector<ExPolygons> slice_volume(
@@ -73,13 +140,14 @@ static std::vector<ExPolygons> slice_volume(
     const std::vector<float>                    &z,
     const std::vector<t_layer_height_range>     &ranges,
     const MeshSlicingParamsEx                   &params,
-    const std::function<void()>                 &throw_on_cancel_callback)
+    const std::function<void()>                 &throw_on_cancel_callback,
+    VolumeSlicesReuse                           &reuse)
 {
     std::vector<ExPolygons> out;
     if (! z.empty() && ! ranges.empty()) {
         if (ranges.size() == 1 && z.front() >= ranges.front().first && z.back() < ranges.front().second) {
             // All layers fit into a single range.
-            out = slice_volume(volume, z, params, throw_on_cancel_callback);
+            out = slice_volume(volume, z, params, throw_on_cancel_callback, reuse);
         } else {
             std::vector<float>                     z_filtered;
             std::vector<std::pair<size_t, size_t>> n_filtered;
@@ -95,7 +163,7 @@ static std::vector<ExPolygons> slice_volume(
                     n_filtered.emplace_back(std::make_pair(first, i));
             }
             if (! n_filtered.empty()) {
-                std::vector<ExPolygons> layers = slice_volume(volume, z_filtered, params, throw_on_cancel_callback);
+                std::vector<ExPolygons> layers = slice_volume(volume, z_filtered, params, throw_on_cancel_callback, reuse);
                 out.assign(z.size(), ExPolygons());
                 i = 0;
                 for (const std::pair<size_t, size_t> &span : n_filtered)
@@ -123,7 +191,8 @@ static std::vector<VolumeSlices> slice_volumes_inner(
     ModelVolumePtrs                                           model_volumes,
     const std::vector<PrintObjectRegions::LayerRangeRegions> &layer_ranges,
     const std::vector<float>                                 &zs,
-    const std::function<void()>                              &throw_on_cancel_callback)
+    const std::function<void()>                              &throw_on_cancel_callback,
+    VolumeSlicesReuse                                        &reuse)
 {
     model_volumes_sort_by_id(model_volumes);
 
@@ -177,7 +246,7 @@ static std::vector<VolumeSlices> slice_volumes_inner(
                     }
                     out.push_back({
                         model_volume->id(),
-                        slice_volume(*model_volume, zs, params, throw_on_cancel_callback)
+                        slice_volume(*model_volume, zs, params, throw_on_cancel_callback, reuse)
                     });
                 }
             } else {
@@ -189,7 +258,7 @@ static std::vector<VolumeSlices> slice_volumes_inner(
                 if (! slicing_ranges.empty())
                     out.push_back({
                         model_volume->id(),
-                        slice_volume(*model_volume, zs, slicing_ranges, params, throw_on_cancel_callback)
+                        slice_volume(*model_volume, zs, slicing_ranges, params, throw_on_cancel_callback, reuse)
                     });
             }
             if (! out.empty() && out.back().slices.empty())
@@ -989,10 +1058,11 @@ void PrintObject::slice_volumes()
 
     std::vector<float>                   slice_zs      = zs_from_layers(m_layers);
     std::vector<VolumeSlices> objSliceByVolume;
+    VolumeSlicesReuse         reuse { m_volume_slices_cache, firstLayerObjSliceByVolume };
     if (!slice_zs.empty()) {
         objSliceByVolume = slice_volumes_inner(
             print->config(), this->config(), this->trafo_centered(),
-            this->model_object()->volumes, m_shared_regions->layer_ranges, slice_zs, throw_on_cancel_callback);
+            this->model_object()->volumes, m_shared_regions->layer_ranges, slice_zs, throw_on_cancel_callback, reuse);
     }
 
     //BBS: "model_part" volumes are grouded according to their connections
@@ -1001,6 +1071,9 @@ void PrintObject::slice_volumes()
     //groupingVolumes(objSliceByVolumeParts, firstLayerObjSliceByGroups, scaled_resolution);
     //applyNegtiveVolumes(this->model_object()->volumes, objSliceByVolume, firstLayerObjSliceByGroups, scaled_resolution);
     firstLayerObjSliceByVolume = objSliceByVolume;
+    // The slices kept by firstLayerObjSliceByVolume are reused by the next run.
+    reuse.current.zs     = slice_zs;
+    m_volume_slices_cache = std::move(reuse.current);
 
     std::vector<std::vector<ExPolygons>> region_slices = slices_to_regions(this->model_object()->volumes, *m_shared_regions, slice_zs,
         std::move(objSliceByVolume),
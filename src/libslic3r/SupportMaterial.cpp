@@ -480,7 +480,7 @@ void PrintObjectSupportMaterial::generate(PrintObject &object)
     // should the support material expose to the object in order to guarantee
     // that it will be effective, regardless of how it's built below.
     // If raft is to be generated, the 1st top_contact layer will contain the 1st object layer silhouette without holes.
-    MyLayersPtr top_contacts = this->top_contact_layers(object, buildplate_covered, layer_storage);
+    MyLayersPtr top_contacts = this->top_contact_layers(object, buildplate_covered, *object.alloc_support_overhang_cache(), layer_storage);
     if (top_contacts.empty())
         // Nothing is supported, no supports are generated.
         return;
@@ -2205,7 +2205,7 @@ static OverhangCluster* add_overhang(std::vector<OverhangCluster>& clusters, ExP
 // For a soluble interface material synchronize the layer heights with the object, otherwise leave the layer height undefined.
 // If supports over bed surface only are requested, don't generate contact layers over an object.
 PrintObjectSupportMaterial::MyLayersPtr PrintObjectSupportMaterial::top_contact_layers(
-    const PrintObject &object, const std::vector<Polygons> &buildplate_covered, MyLayerStorage &layer_storage) const
+    const PrintObject &object, const std::vector<Polygons> &buildplate_covered, SupportOverhangCache &overhang_cache, MyLayerStorage &layer_storage) const
 {
 #ifdef SLIC3R_DEBUG
     static int iRun = 0;
@@ -2239,11 +2239,28 @@ PrintObjectSupportMaterial::MyLayersPtr PrintObjectSupportMaterial::top_contact_
 
     std::vector<ExPolygons> overhangs_per_layers(num_layers);
     size_t layer_id_start = this->has_raft() ? 0 : 1;
+    // BBS: detect_overhangs() only reads the support blockers of its own layer. Layers not touched by the support painting
+    // since the last generation take their overhangs (and sharp tails, cantilevers) from the cache.
+    if (overhang_cache.layers.size() != num_layers)
+        overhang_cache.layers.assign(num_layers, SupportOverhangCache::LayerOverhangs());
+    std::vector<char> overhangs_detected(num_layers, false);
+    const Polygons    no_blockers;
      // main part of overhang detection can be parallel
     tbb::parallel_for(tbb::blocked_range<size_t>(layer_id_start, num_layers),
         [&](const tbb::blocked_range<size_t>& range) {
             for (size_t layer_id = range.begin(); layer_id < range.end(); layer_id++) {
                 const Layer& layer = *object.layers()[layer_id];
+                const Polygons &blockers = layer_id < annotations.blockers_layers.size() ? annotations.blockers_layers[layer_id] : no_blockers;
+                SupportOverhangCache::LayerOverhangs &cached = overhang_cache.layers[layer_id];
+                if (cached.valid && cached.blockers == blockers) {
+                    overhangs_per_layers[layer_id] = cached.overhangs;
+                    layer.sharp_tails        = cached.sharp_tails;
+                    layer.sharp_tails_height = cached.sharp_tails_height;
+                    layer.cantilevers        = cached.cantilevers;
+                    continue;
+                }
+
+                cached.valid = false;
                 Polygons            lower_layer_polygons = (layer_id == 0) ? Polygons() : to_polygons(object.layers()[layer_id - 1]->lslices);
 
                 overhangs_per_layers[layer_id] = detect_overhangs(layer, layer_id, lower_layer_polygons, *m_print_config, *m_object_config, annotations, m_support_params.gap_xy
@@ -2251,9 +2268,17 @@ PrintObjectSupportMaterial::MyLayersPtr PrintObjectSupportMaterial::top_contact_
                     , iRun
 #endif // SLIC3R_DEBUG
                 );
+                overhangs_detected[layer_id] = true;
 
                 if (object.print()->canceled())
                     break;
+
+                cached.blockers           = blockers;
+                cached.overhangs          = overhangs_per_layers[layer_id];
+                cached.sharp_tails        = layer.sharp_tails;
+                cached.sharp_tails_height = layer.sharp_tails_height;
+                cached.cantilevers        = layer.cantilevers;
+                cached.valid              = true;
             }
         }
     ); // end tbb::parallel_for
@@ -2261,6 +2286,16 @@ PrintObjectSupportMaterial::MyLayersPtr PrintObjectSupportMaterial::top_contact_
     if (object.print()->canceled())
         return MyLayersPtr();
 
+    {
+        auto first = std::find(overhangs_detected.begin(), overhangs_detected.end(), true);
+        if (first == overhangs_detected.end())
+            BOOST_LOG_TRIVIAL(info) << "PrintObjectSupportMaterial::top_contact_layers() - overhangs of all " << num_layers << " layers reused";
+        else
+            BOOST_LOG_TRIVIAL(info) << "PrintObjectSupportMaterial::top_contact_layers() - overhangs detected on "
+                << std::count(overhangs_detected.begin(), overhangs_detected.end(), true) << " of " << num_layers << " layers, span "
+                << (first - overhangs_detected.begin()) << " - " << (overhangs_detected.rend() - std::find(overhangs_detected.rbegin(), overhangs_detected.rend(), true) - 1);
+    }
+
     // check if the sharp tails should be extended higher
     bool detect_first_sharp_tail_only = false;
     const coordf_t extrusion_width = m_object_config->line_width.value;
@@ -2424,12 +2459,49 @@ PrintObjectSupportMaterial::MyLayersPtr PrintObjectSupportMaterial::top_contact_
     if (object.print()->canceled())
         return MyLayersPtr();
 
+    const ExPolygons no_sharp_tails;
+    if (overhang_cache.contacts.size() != num_layers)
+        overhang_cache.contacts.assign(num_layers, SupportOverhangCache::LayerContacts());
+    size_t num_contacts_reused = 0;
     for (size_t layer_id = layer_id_start; layer_id < num_layers; layer_id++) {
         const Layer& layer = *object.layers()[layer_id];
         Polygons            overhang_polygons = to_polygons(overhangs_per_layers[layer_id]);
         Polygons            lower_layer_polygons = (layer_id == 0) ? Polygons() : to_polygons(object.layers()[layer_id - 1]->lslices);
         SlicesMarginCache   slices_margin;
 
+        // BBS: reuse the top contact layer of the last generation if its inputs did not change.
+        SupportOverhangCache::LayerContacts &cached = overhang_cache.contacts[layer_id];
+        const Polygons   &enforcers         = layer_id < annotations.enforcers_layers.size() ? annotations.enforcers_layers[layer_id] : no_blockers;
+        const ExPolygons &lower_sharp_tails = layer.lower_layer == nullptr ? no_sharp_tails : layer.lower_layer->sharp_tails;
+        if (cached.valid && cached.overhangs == overhang_polygons && cached.enforcers == enforcers && cached.lower_sharp_tails == lower_sharp_tails) {
+            ++ num_contacts_reused;
+            if (! cached.has_contact)
+                continue;
+            auto [new_layer, bridging_layer] = new_contact_layer(*m_print_config, *m_object_config, m_slicing_params, m_support_params.support_layer_height_min, layer, layer_storage, layer_storage_mutex);
+            if (new_layer) {
+                new_layer->polygons          = cached.polygons;
+                new_layer->contact_polygons  = std::make_unique<Polygons>(cached.contact_polygons);
+                new_layer->overhang_polygons = std::make_unique<Polygons>(cached.overhang_polygons);
+                if (cached.has_enforcer_polygons)
+                    new_layer->enforcer_polygons = std::make_unique<Polygons>(cached.enforcer_polygons);
+                contact_out[layer_id * 2] = new_layer;
+                if (bridging_layer != nullptr) {
+                    bridging_layer->polygons = new_layer->polygons;
+                    bridging_layer->contact_polygons = std::make_unique<Polygons>(*new_layer->contact_polygons);
+                    bridging_layer->overhang_polygons = std::make_unique<Polygons>(*new_layer->overhang_polygons);
+                    if (new_layer->enforcer_polygons)
+                        bridging_layer->enforcer_polygons = std::make_unique<Polygons>(*new_layer->enforcer_polygons);
+                    contact_out[layer_id * 2 + 1] = bridging_layer;
+                }
+            }
+            continue;
+        }
+        cached.valid             = true;
+        cached.overhangs         = overhang_polygons;
+        cached.enforcers         = enforcers;
+        cached.lower_sharp_tails = lower_sharp_tails;
+        cached.has_contact       = false;
+
         auto [contact_polygons, enforcer_polygons, no_interface_offset] =
             detect_contacts(layer, layer_id, overhang_polygons, lower_layer_polygons, *m_print_config, *m_object_config, annotations, slices_margin, m_support_params.gap_xy
 #ifdef SLIC3R_DEBUG
@@ -2439,6 +2511,7 @@ PrintObjectSupportMaterial::MyLayersPtr PrintObjectSupportMaterial::top_contact_
 
         // Now apply the contact areas to the layer where they need to be made.
         if (!contact_polygons.empty() || !overhang_polygons.empty()) {
+            cached.has_contact = true;
             // Allocate the two empty layers.
             auto [new_layer, bridging_layer] = new_contact_layer(*m_print_config, *m_object_config, m_slicing_params, m_support_params.support_layer_height_min, layer, layer_storage, layer_storage_mutex);
             if (new_layer) {
@@ -2450,6 +2523,11 @@ PrintObjectSupportMaterial::MyLayersPtr PrintObjectSupportMaterial::top_contact_
                     , iRun, layer
 #endif // SLIC3R_DEBUG
                 );
+                cached.polygons              = new_layer->polygons;
+                cached.contact_polygons      = *new_layer->contact_polygons;
+                cached.overhang_polygons     = *new_layer->overhang_polygons;
+                cached.has_enforcer_polygons = new_layer->enforcer_polygons != nullptr;
+                cached.enforcer_polygons     = cached.has_enforcer_polygons ? *new_layer->enforcer_polygons : Polygons();
                 // Insert new layer even if there is no interface generated: Likely the support angle is not steep enough to require dense interface,
                 // however generating a sparse support will be useful for the object stability.
                 // if (! new_layer->polygons.empty())
@@ -2466,6 +2544,9 @@ PrintObjectSupportMaterial::MyLayersPtr PrintObjectSupportMaterial::top_contact_
         }
     }
 
+    BOOST_LOG_TRIVIAL(info) << "PrintObjectSupportMaterial::top_contact_layers() - top contacts of " << num_contacts_reused << " of "
+        << (num_layers - std::min(num_layers, layer_id_start)) << " layers reused";
+
     // Compress contact_out, remove the nullptr items.
     remove_nulls(contact_out);
 
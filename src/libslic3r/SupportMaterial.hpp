@@ -1,16 +1,58 @@
 #ifndef slic3r_SupportMaterial_hpp_
 #define slic3r_SupportMaterial_hpp_
 
+#include "ExPolygon.hpp"
 #include "Flow.hpp"
 #include "PrintConfig.hpp"
 #include "Slicing.hpp"
 
+#include <map>
+
 namespace Slic3r {
 
 class PrintObject;
 class PrintConfig;
 class PrintObjectConfig;
 
+// BBS: Overhangs and top contacts detected per object layer by the last normal support generation of a PrintObject.
+// Painting support enforcers / blockers invalidates the supports of the whole object, however the overhangs
+// of a layer only depend on the support blockers of that very layer. The layers with unchanged blockers are not
+// detected again, see PrintObjectSupportMaterial::top_contact_layers() and PrintObject::invalidate_support_annotations().
+// The top contacts of a layer depend on its final overhangs (after the sharp tails and the small overhang clusters
+// are resolved over the whole object), its enforcers and the sharp tails of the layer below, they are reused
+// if none of these changed.
+struct SupportOverhangCache
+{
+    struct LayerOverhangs
+    {
+        bool                                valid { false };
+        // Support blockers the overhangs were detected with.
+        Polygons                            blockers;
+        ExPolygons                          overhangs;
+        // Layer::sharp_tails, sharp_tails_height and cantilevers as left by the detection.
+        ExPolygons                          sharp_tails;
+        std::map<const ExPolygon*, float>   sharp_tails_height;
+        ExPolygons                          cantilevers;
+    };
+    struct LayerContacts
+    {
+        bool                                valid { false };
+        // Inputs of the contact detection of the layer.
+        Polygons                            overhangs;
+        Polygons                            enforcers;
+        ExPolygons                          lower_sharp_tails;
+        // Top contact layer filled from the inputs, if any.
+        bool                                has_contact { false };
+        Polygons                            polygons;
+        Polygons                            contact_polygons;
+        Polygons                            overhang_polygons;
+        bool                                has_enforcer_polygons { false };
+        Polygons                            enforcer_polygons;
+    };
+    std::vector<LayerOverhangs> layers;
+    std::vector<LayerContacts>  contacts;
+};
+
 // This class manages raft and supports for a single PrintObject.
 // Instantiated by Slic3r::Print::Object->_support_material()
 // This class is instantiated before the slicing starts as Object.pm will query
@@ -176,7 +218,8 @@ private:
 	// Generate top contact layers supporting overhangs.
 	// For a soluble interface material synchronize the layer heights with the object, otherwise leave the layer height undefined.
 	// If supports over bed surface only are requested, don't generate contact layers over an object.
-	MyLayersPtr top_contact_layers(const PrintObject &object, const std::vector<Polygons> &buildplate_covered, MyLayerStorage &layer_storage) const;
+	// Overhangs of the layers with unchanged support blockers are taken from overhang_cache, which is updated.
+	MyLayersPtr top_contact_layers(const PrintObject &object, const std::vector<Polygons> &buildplate_covered, SupportOverhangCache &overhang_cache, MyLayerStorage &layer_storage) const;
 
 	// Generate bottom contact layers supporting the top contact layers.
 	// For a soluble interface material synchronize the layer heights with the object, 
@@ -10,6 +10,7 @@
 #include "SVG.hpp"
 #include "ShortestPath.hpp"
 #include "I18N.hpp"
+#include "Utils.hpp"
 #include <libnest2d/backends/libslic3r/geometries.hpp>
 
 #define _L(s) Slic3r::I18N::translate(s)
@@ -2584,48 +2585,49 @@ void TreeSupport::drop_nodes(std::vector<std::vector<Node*>>& contact_nodes)
     m_spanning_trees.resize(contact_nodes.size());
     //m_mst_line_x_layer_contour_caches.resize(contact_nodes.size());
 
-    if (0)
-    {// get outlines below and avoidance area using tbb
-     // This part only takes very little time, so we disable it.
+    {
+        // BBS: precompute the avoidance bottom up for the radii the nodes will have, instead of recursing down
+        // the layer stack from the first query of each radius. A node at a layer queries the avoidance of the
+        // radius of its distance to its contact at the support layer below it, the distance grows by the height
+        // of the layer with each layer the node is dropped.
         typedef std::chrono::high_resolution_clock clock_;
         typedef std::chrono::duration<double, std::ratio<1> > second_;
         std::chrono::time_point<clock_> t0{ clock_::now() };
 
-        // get all the possible radiis
-        std::vector<std::set<coordf_t> > all_layer_radius(m_highest_overhang_layer+1);
-        std::vector<std::set<coordf_t>> all_layer_node_dist(m_highest_overhang_layer + 1);
-        for (size_t layer_nr = m_highest_overhang_layer; layer_nr > 0; layer_nr--)
-        {
-            if (layer_heights[layer_nr].height < EPSILON) continue;
-            auto& layer_radius = all_layer_radius[layer_nr];
-            auto& layer_node_dist = all_layer_node_dist[layer_nr];
-            for (Node *p_node : contact_nodes[layer_nr]) {
-                layer_node_dist.emplace(p_node->dist_mm_to_top);
-            }
-            size_t layer_nr_next = layer_heights[layer_nr].next_layer_nr;
-            if (layer_nr_next <= m_highest_overhang_layer && layer_nr_next>0) {
-                for (auto node_dist : layer_node_dist)
-                    all_layer_node_dist[layer_nr_next].emplace(node_dist + layer_heights[layer_nr].height);
-            }
-            for (auto node_dist : layer_node_dist) {
-                layer_radius.emplace(calc_branch_radius(branch_radius, node_dist, diameter_angle_scale_factor));
-            }
-        }
-        // parallel pre-compute avoidance
-        //tbb::parallel_for(tbb::blocked_range<size_t>(1, m_highest_overhang_layer), [&](const tbb::blocked_range<size_t> &range) {
-            //for (size_t layer_nr = range.begin(); layer_nr < range.end(); layer_nr++) {
-            for (size_t layer_nr = 0; layer_nr < all_layer_radius.size(); layer_nr++) {
-                BOOST_LOG_TRIVIAL(debug) << "pre calculate_avoidance layer=" << layer_nr;
-                for (auto node_radius : all_layer_radius[layer_nr]) {
-                    m_ts_data->get_avoidance(0, layer_nr);
-                    m_ts_data->get_avoidance(node_radius, layer_nr);
+        std::map<coordf_t, size_t> radius_top_layers;
+        for (size_t layer_nr = contact_nodes.size() - 1; layer_nr > 0; layer_nr--) {
+            if (contact_nodes[layer_nr].empty())
+                continue;
+            size_t &top_zero = radius_top_layers[0];
+            top_zero = std::max(top_zero, layer_nr);
+            std::set<coordf_t> node_dists;
+            for (const Node *p_node : contact_nodes[layer_nr])
+                node_dists.emplace(p_node->dist_mm_to_top);
+            for (coordf_t node_dist : node_dists) {
+                for (size_t layer_nr_node = layer_nr; layer_nr_node > 0; layer_nr_node = layer_heights[layer_nr_node].next_layer_nr) {
+                    const size_t   layer_nr_next = layer_heights[layer_nr_node].next_layer_nr;
+                    const coordf_t radius        = calc_branch_radius(branch_radius, node_dist, diameter_angle_scale_factor);
+                    size_t        &top           = radius_top_layers[radius];
+                    if (top >= layer_nr_next)
+                        // A node of another contact went down this way with the same radius.
+                        break;
+                    top = layer_nr_next;
+                    node_dist += layer_heights[layer_nr_node].height;
+                    if (layer_nr_next >= layer_nr_node)
+                        break;
                 }
             }
-        //});
+        }
+
+        // One budget for the avoidance caches of all the objects generating their supports at the same time,
+        // leave the most of the available memory to the rest of the slicing.
+        const size_t available    = available_physical_memory();
+        const size_t memory_limit = available == 0 ? (size_t(1) << 30) : std::clamp(available / 4, size_t(256) << 20, size_t(4) << 30);
+        m_ts_data->precompute_avoidance(radius_top_layers, memory_limit);
 
         double duration{ std::chrono::duration_cast<second_>(clock_::now() - t0).count() };
-        BOOST_LOG_TRIVIAL(debug) << "before m_avoidance_cache.size()=" << m_ts_data->m_avoidance_cache.size()
-            << ", takes " << duration << " secs.";
+        BOOST_LOG_TRIVIAL(debug) << "precomputed avoidance of " << radius_top_layers.size() << " radii, takes " << duration << " secs, "
+            << m_ts_data->cache_statistics();
     }
 
     for (size_t layer_nr = contact_nodes.size() - 1; layer_nr > 0; layer_nr--) // Skip layer 0, since we can't drop down the vertices there.
@@ -2633,6 +2635,9 @@ void TreeSupport::drop_nodes(std::vector<std::vector<Node*>>& contact_nodes)
         if (m_object->print()->canceled())
             break;
 
+        // The nodes are dropped from the top down, the avoidance above is not queried anymore.
+        m_ts_data->evict_avoidance_above(layer_nr);
+
         auto& layer_contact_nodes = contact_nodes[layer_nr];
         if (layer_contact_nodes.empty())
             continue;
@@ -3050,19 +3055,21 @@ void TreeSupport::drop_nodes(std::vector<std::vector<Node*>>& contact_nodes)
     #if 1
     // delete nodes with no children (means either it's a single layer nodes, or the branch has been deleted but not completely)
     for (size_t layer_nr = contact_nodes.size() - 1; layer_nr > 0; layer_nr--){
-        auto layer_contact_nodes = contact_nodes[layer_nr];
-        for (Node *p_node : layer_contact_nodes) {
-            if (p_node->child==nullptr) {
-                std::vector<Node *>::iterator to_erase = std::find(contact_nodes[layer_nr].begin(), contact_nodes[layer_nr].end(), p_node);
-                if (to_erase != contact_nodes[layer_nr].end()) {
-                    to_free_node_set.insert(*to_erase);
-                    contact_nodes[layer_nr].erase(to_erase);
-                }
-            }
-        }
+        // BBS: erase in a single pass, erasing the nodes one by one was quadratic in the number of nodes of the layer.
+        std::vector<Node *> &layer_contact_nodes = contact_nodes[layer_nr];
+        layer_contact_nodes.erase(std::remove_if(layer_contact_nodes.begin(), layer_contact_nodes.end(), [&to_free_node_set](Node *p_node) {
+            if (p_node->child != nullptr)
+                return false;
+            to_free_node_set.insert(p_node);
+            return true;
+        }), layer_contact_nodes.end());
     }
     #endif
-    BOOST_LOG_TRIVIAL(debug) << "after m_avoidance_cache.size()=" << m_ts_data->m_avoidance_cache.size();
+    BOOST_LOG_TRIVIAL(info) << "drop_nodes for object " << m_object->model_object()->name << ", " << m_ts_data->cache_statistics();
+    // BBS: m_ts_data is the preview cache kept by the PrintObject, dropping its avoidance is an intended trade-off.
+    // The avoidance of all the radii and layers is the largest part of the cache. Keeping it for the lifetime of the object
+    // would cost more memory than recalculating it if the supports are regenerated. The collision cache and the outlines are kept.
+    m_ts_data->evict_avoidance_above(0);
 
     for (Node *node : to_free_node_set)
     {
@@ -3564,9 +3571,36 @@ void TreeSupport::insert_dropped_node(std::vector<Node*>& nodes_layer, Node* p_n
     conflicting_node->support_roof_layers_below = std::max(conflicting_node->support_roof_layers_below, p_node->support_roof_layers_below);
 }
 
+// Estimated heap memory held by the polygons, for the accounting of the caches.
+static size_t expolygons_memsize(const ExPolygons &expolys)
+{
+    size_t bytes = expolys.capacity() * sizeof(ExPolygon);
+    for (const ExPolygon &expoly : expolys) {
+        bytes += expoly.contour.points.capacity() * sizeof(Point) + expoly.holes.capacity() * sizeof(Polygon);
+        for (const Polygon &hole : expoly.holes)
+            bytes += hole.points.capacity() * sizeof(Point);
+    }
+    return bytes;
+}
+
+// Once the avoidance caches exceed their budget, the avoidance is only kept every avoidance_checkpoint_stride layers.
+static constexpr size_t avoidance_checkpoint_stride = 16;
+
+// Memory of the avoidance caches of all the objects, the objects generate their supports concurrently.
+static std::atomic<size_t> s_avoidance_cache_bytes { 0 };
+
+static void release_avoidance_cache_bytes(std::atomic<size_t> &bytes, size_t released)
+{
+    released = std::min(released, bytes.load());
+    bytes -= released;
+    size_t total = s_avoidance_cache_bytes.load();
+    while (! s_avoidance_cache_bytes.compare_exchange_weak(total, total - std::min(total, released)));
+}
+
 TreeSupportData::TreeSupportData(const PrintObject &object, coordf_t xy_distance, coordf_t max_move, coordf_t radius_sample_resolution)
     : m_xy_distance(xy_distance), m_max_move(max_move), m_radius_sample_resolution(radius_sample_resolution)
 {
+    m_avoidance_cache.resize(object.layers().size());
     for (std::size_t layer_nr  = 0; layer_nr < object.layers().size(); ++layer_nr)
     {
         const Layer* layer = object.get_layer(layer_nr);
@@ -3583,29 +3617,127 @@ TreeSupportData::TreeSupportData(const PrintObject &object, coordf_t xy_distance
     }
 }
 
+TreeSupportData::~TreeSupportData()
+{
+    release_avoidance_cache_bytes(m_avoidance_stats.bytes, m_avoidance_stats.bytes.load());
+}
+
 const ExPolygons& TreeSupportData::get_collision(coordf_t radius, size_t layer_nr) const
 {
     profiler.tic();
     radius = ceil_radius(radius);
     RadiusLayerPair key{radius, layer_nr};
     const auto it = m_collision_cache.find(key);
-    const ExPolygons& collision = it != m_collision_cache.end() ? it->second : calculate_collision(key);
+    const bool hit = it != m_collision_cache.end();
+    ++ (hit ? m_collision_stats.hits : m_collision_stats.misses);
+    const ExPolygons& collision = hit ? it->second : calculate_collision(key);
     profiler.stage_add(STAGE_get_collision, true);
     return collision;
 }
 
-const ExPolygons& TreeSupportData::get_avoidance(coordf_t radius, size_t layer_nr, int recursions) const
+const ExPolygons& TreeSupportData::get_avoidance(coordf_t radius, size_t layer_nr) const
 {
     profiler.tic();
     radius = ceil_radius(radius);
-    RadiusLayerPair key{radius, layer_nr, recursions };
-    const auto it = m_avoidance_cache.find(key);
-    const ExPolygons& avoidance = it != m_avoidance_cache.end() ? it->second : calculate_avoidance(key);
+    assert(layer_nr < m_avoidance_cache.size());
+    const auto &layer_cache = m_avoidance_cache[layer_nr];
+    const auto it = layer_cache.find(radius);
+    const bool hit = it != layer_cache.end();
+    ++ (hit ? m_avoidance_stats.hits : m_avoidance_stats.misses);
+    const ExPolygons& avoidance = hit ? it->second : calculate_avoidance({ radius, layer_nr });
 
     profiler.stage_add(STAGE_GET_AVOIDANCE, true);
     return avoidance;
 }
 
+void TreeSupportData::precompute_avoidance(const std::map<coordf_t, size_t> &radius_top_layers, size_t memory_limit) const
+{
+    if (radius_top_layers.empty() || layer_heights.empty() || m_avoidance_cache.empty())
+        return;
+
+    // Round the radii the same way the queries do.
+    std::map<coordf_t, size_t> radii;
+    for (const auto &[radius, top_layer] : radius_top_layers) {
+        size_t &top = radii[ceil_radius(radius)];
+        top = std::max(top, std::min(top_layer, m_avoidance_cache.size() - 1));
+    }
+    size_t top_layer = 0;
+    for (const auto &radius : radii)
+        top_layer = std::max(top_layer, radius.second);
+    top_layer = std::min(top_layer, layer_heights.size() - 1);
+
+    // The avoidance of a layer depends on the avoidance of the support layer below it only,
+    // collect the chain of the support layers bottom up.
+    while (top_layer > 0 && layer_heights[top_layer].height < EPSILON)
+        -- top_layer;
+    std::vector<size_t> chain;
+    for (size_t layer_nr = top_layer;; layer_nr = layer_heights[layer_nr].next_layer_nr) {
+        chain.emplace_back(layer_nr);
+        if (layer_nr == 0 || layer_heights[layer_nr].next_layer_nr >= layer_nr)
+            break;
+    }
+    std::reverse(chain.begin(), chain.end());
+    m_avoidance_memory_limit = memory_limit;
+    m_avoidance_checkpoints.assign(m_avoidance_cache.size(), false);
+    for (size_t idx = 0; idx < chain.size(); idx += avoidance_checkpoint_stride)
+        m_avoidance_checkpoints[chain[idx]] = true;
+
+    std::vector<std::pair<coordf_t, size_t>> radii_vec(radii.begin(), radii.end());
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, radii_vec.size(), 1), [this, &radii_vec, &chain](const tbb::blocked_range<size_t> &range) {
+        for (size_t radius_idx = range.begin(); radius_idx < range.end(); ++ radius_idx) {
+            const coordf_t radius    = radii_vec[radius_idx].first;
+            const size_t   top_layer = radii_vec[radius_idx].second;
+            // Avoidance of the layer below, either in the cache or in below_storage if it was not cached.
+            const ExPolygons *below = nullptr;
+            ExPolygons        below_storage;
+            for (size_t idx = 0; idx < chain.size() && chain[idx] <= top_layer; ++ idx) {
+                const size_t layer_nr = chain[idx];
+                const auto   it       = m_avoidance_cache[layer_nr].find(radius);
+                if (it != m_avoidance_cache[layer_nr].end()) {
+                    below = &it->second;
+                    continue;
+                }
+                // Same as calculate_avoidance(), without the recursion and without filling the collision cache.
+                ExPolygons avoidance = offset_ex(m_layer_outlines[layer_nr], scale_(radius));
+                if (below != nullptr) {
+                    append(avoidance, offset_ex(*below, scale_(-m_max_move)));
+                    avoidance = union_ex(avoidance);
+                }
+                if (keep_avoidance(layer_nr))
+                    below = &insert_avoidance(radius, layer_nr, std::move(avoidance));
+                else {
+                    below_storage = std::move(avoidance);
+                    below         = &below_storage;
+                }
+            }
+        }
+    });
+}
+
+void TreeSupportData::evict_avoidance_above(size_t layer_nr) const
+{
+    for (size_t idx = layer_nr + 1; idx < m_avoidance_cache.size(); ++ idx) {
+        auto &layer_cache = m_avoidance_cache[idx];
+        if (layer_cache.empty())
+            continue;
+        size_t bytes = 0;
+        for (const auto &entry : layer_cache)
+            bytes += expolygons_memsize(entry.second);
+        release_avoidance_cache_bytes(m_avoidance_stats.bytes, bytes);
+        layer_cache.clear();
+    }
+}
+
+std::string TreeSupportData::cache_statistics() const
+{
+    size_t avoidance_entries = 0;
+    for (const auto &layer_cache : m_avoidance_cache)
+        avoidance_entries += layer_cache.size();
+    return (boost::format("collision cache: %1% hits, %2% misses, %3% entries, %4%; avoidance cache: %5% hits, %6% misses, %7% entries, %8%")
+        % m_collision_stats.hits.load() % m_collision_stats.misses.load() % m_collision_cache.size() % format_memsize_MB(m_collision_stats.bytes.load())
+        % m_avoidance_stats.hits.load() % m_avoidance_stats.misses.load() % avoidance_entries % format_memsize_MB(m_avoidance_stats.bytes.load())).str();
+}
+
 Polygons TreeSupportData::get_contours(size_t layer_nr) const
 {
     Polygons contours;
@@ -3629,13 +3761,14 @@ Polygons TreeSupportData::get_contours_with_holes(size_t layer_nr) const
 coordf_t TreeSupportData::ceil_radius(coordf_t radius) const
 {
 #if 1
+    // BBS: return an exact multiple of the resolution, the rounded radii are the keys of the caches.
     size_t factor = (size_t)(radius / m_radius_sample_resolution);
     coordf_t remains = radius - m_radius_sample_resolution * factor;
     if (remains > EPSILON) {
-        return radius + m_radius_sample_resolution - remains;
+        return m_radius_sample_resolution * (factor + 1);
     }
     else {
-        return radius;
+        return m_radius_sample_resolution * factor;
     }
 #else
     coordf_t resolution = m_radius_sample_resolution;
@@ -3648,50 +3781,79 @@ const ExPolygons& TreeSupportData::calculate_collision(const RadiusLayerPair& ke
     assert(key.layer_nr < m_layer_outlines.size());
 
     ExPolygons collision_areas = std::move(offset_ex(m_layer_outlines[key.layer_nr], scale_(key.radius)));
+    const size_t bytes = expolygons_memsize(collision_areas);
     const auto ret = m_collision_cache.insert({ key, std::move(collision_areas) });
+    if (ret.second)
+        m_collision_stats.bytes += bytes;
     return ret.first->second;
 }
 
+const ExPolygons& TreeSupportData::insert_avoidance(coordf_t radius, size_t layer_nr, ExPolygons &&avoidance) const
+{
+    const size_t bytes = expolygons_memsize(avoidance);
+    const auto ret = m_avoidance_cache[layer_nr].insert({ radius, std::move(avoidance) });
+    if (ret.second) {
+        m_avoidance_stats.bytes += bytes;
+        s_avoidance_cache_bytes += bytes;
+    }
+    return ret.first->second;
+}
+
+bool TreeSupportData::keep_avoidance(size_t layer_nr) const
+{
+    return s_avoidance_cache_bytes.load() < m_avoidance_memory_limit ||
+        (m_avoidance_checkpoints.empty() ? layer_nr % avoidance_checkpoint_stride == 0 : layer_nr < m_avoidance_checkpoints.size() && m_avoidance_checkpoints[layer_nr]);
+}
+
 const ExPolygons& TreeSupportData::calculate_avoidance(const RadiusLayerPair& key) const
 {
     const auto& radius = key.radius;
     const auto& layer_nr = key.layer_nr;
-    BOOST_LOG_TRIVIAL(debug) << "calculate_avoidance on radius=" << radius << ", layer=" << layer_nr<<", recursion="<<key.recursions;
-    constexpr auto max_recursion_depth = 100;
-    if (key.recursions <= max_recursion_depth*2) {
-        if (layer_nr == 0) {
-            m_avoidance_cache[key] = get_collision(radius, 0);
-            return m_avoidance_cache[key];
-        }
-
-        // Avoidance for a given layer depends on all layers beneath it so could have very deep recursion depths if
-        // called at high layer heights. We can limit the reqursion depth to N by checking if the layer N
-        // below the current one exists and if not, forcing the calculation of that layer. This may cause another recursion
-        // if the layer at 2N below the current one but we won't exceed our limit unless there are N*N uncalculated layers
-        // below our current one.
-        size_t         layer_nr_next       = layer_nr;
-        int            layers_below;
-        for (layers_below = 0; layers_below < max_recursion_depth && layer_nr_next > 0; layers_below++) { layer_nr_next = layer_heights[layer_nr_next].next_layer_nr; }
-        // Check if we would exceed the recursion limit by trying to process this layer
-        if (layers_below >= max_recursion_depth && m_avoidance_cache.find({radius, layer_nr_next}) == m_avoidance_cache.end()) {
-            // Force the calculation of the layer `max_recursion_depth` below our current one, ignoring the result.
-            get_avoidance(radius, layer_nr_next, key.recursions + 1);
-        }
-
-        layer_nr_next   = layer_heights[layer_nr].next_layer_nr;
-        ExPolygons        avoidance_areas = std::move(offset_ex(get_avoidance(radius, layer_nr_next, key.recursions+1), scale_(-m_max_move)));
-        const ExPolygons &collision       = get_collision(radius, layer_nr);
-        avoidance_areas.insert(avoidance_areas.end(), collision.begin(), collision.end());
-        avoidance_areas = std::move(union_ex(avoidance_areas));
-        auto ret = m_avoidance_cache.insert({ key, std::move(avoidance_areas) });
-        //assert(ret.second);
-        return ret.first->second;
-    } else {
-        ExPolygons avoidance_areas = std::move(offset_ex(m_layer_outlines_below[layer_nr], scale_(m_xy_distance + radius)));
-        auto ret = m_avoidance_cache.insert({ key, std::move(avoidance_areas) });
-        assert(ret.second);
-        return ret.first->second;
+    BOOST_LOG_TRIVIAL(debug) << "calculate_avoidance on radius=" << radius << ", layer=" << layer_nr;
+
+    // Avoidance for a given layer depends on all the support layers beneath it. Walk down to the first support layer
+    // with a cached avoidance or to the build plate, then calculate the avoidance upwards.
+    std::vector<size_t> layers;
+    const ExPolygons   *below = nullptr;
+    for (size_t layer_nr_below = layer_nr;;) {
+        if (layer_nr_below != layer_nr) {
+            const auto it = m_avoidance_cache[layer_nr_below].find(radius);
+            if (it != m_avoidance_cache[layer_nr_below].end()) {
+                below = &it->second;
+                break;
+            }
+        }
+        layers.emplace_back(layer_nr_below);
+        if (layer_nr_below == 0)
+            break;
+        if (layer_nr_below >= layer_heights.size() || layer_heights[layer_nr_below].next_layer_nr >= layer_nr_below)
+            // The support layers below are not known, avoid everything below.
+            return insert_avoidance(radius, layer_nr, offset_ex(m_layer_outlines_below[layer_nr], scale_(m_xy_distance + radius)));
+        layer_nr_below = layer_heights[layer_nr_below].next_layer_nr;
+    }
+
+    // Like in precompute_avoidance(), only the checkpoints are cached over the memory budget, the others are only
+    // kept until the avoidance of the layer above is calculated. The requested layer is always cached.
+    ExPolygons below_storage;
+    for (auto it = layers.rbegin(); it != layers.rend(); ++ it) {
+        const size_t layer_nr_this = *it;
+        ExPolygons   avoidance_areas;
+        if (below == nullptr)
+            avoidance_areas = get_collision(radius, layer_nr_this);
+        else {
+            avoidance_areas = offset_ex(*below, scale_(-m_max_move));
+            const ExPolygons &collision = get_collision(radius, layer_nr_this);
+            avoidance_areas.insert(avoidance_areas.end(), collision.begin(), collision.end());
+            avoidance_areas = union_ex(avoidance_areas);
+        }
+        if (layer_nr_this == layer_nr || keep_avoidance(layer_nr_this))
+            below = &insert_avoidance(radius, layer_nr_this, std::move(avoidance_areas));
+        else {
+            below_storage = std::move(avoidance_areas);
+            below         = &below_storage;
+        }
     }
+    return *below;
 }
 
 } //namespace Slic3r
@@ -1,7 +1,10 @@
 #ifndef TREESUPPORT_H
 #define TREESUPPORT_H
 
+#include <atomic>
 #include <forward_list>
+#include <limits>
+#include <map>
 #include <unordered_set>
 #include "ExPolygon.hpp"
 #include "Point.hpp"
@@ -63,6 +66,8 @@ public:
 
     TreeSupportData(TreeSupportData&&) = default;
     TreeSupportData& operator=(TreeSupportData&&) = default;
+    // Releases the memory of the avoidance cache from the budget shared by all objects.
+    ~TreeSupportData();
 
     TreeSupportData(const TreeSupportData&) = delete;
     TreeSupportData& operator=(const TreeSupportData&) = delete;
@@ -93,7 +98,36 @@ public:
      * \param layer The layer of interest
      * \return Polygons object
      */
-    const ExPolygons& get_avoidance(coordf_t radius, size_t layer_idx, int recursions=0) const;
+    const ExPolygons& get_avoidance(coordf_t radius, size_t layer_idx) const;
+
+    /*!
+     * \brief Precompute the avoidance areas bottom up before the nodes are dropped.
+     *
+     * Instead of recursing down the layer stack from the first query of each
+     * radius, the avoidance of each radius is calculated layer by layer from
+     * the build plate up to the highest layer the radius is needed at. The
+     * radii are processed in parallel. Once the avoidance caches of all the
+     * objects together exceed \p memory_limit bytes, only every
+     * avoidance_checkpoint_stride-th layer is kept, the layers in between are
+     * recalculated from the checkpoint below them when queried.
+     *
+     * \param radius_top_layers The radii queried by drop_nodes() mapped to the
+     * highest layer they are queried at.
+     * \param memory_limit Budget of the avoidance caches of all the objects
+     * generating their supports at the same time, in bytes.
+     */
+    void precompute_avoidance(const std::map<coordf_t, size_t> &radius_top_layers, size_t memory_limit) const;
+
+    /*!
+     * \brief Release the avoidance areas of the layers above \p layer_nr.
+     *
+     * The nodes are dropped from the top down, the layers above the drop
+     * front are not queried again.
+     */
+    void evict_avoidance_above(size_t layer_nr) const;
+
+    // Hit and miss counts and the memory of the collision and avoidance caches.
+    std::string cache_statistics() const;
 
     Polygons get_contours(size_t layer_nr) const;
     Polygons get_contours_with_holes(size_t layer_nr) const;
@@ -109,8 +143,6 @@ private:
     struct RadiusLayerPair {
         coordf_t radius;
         size_t layer_nr;
-        int recursions;
-        
     };
     struct RadiusLayerPairEquality {
         constexpr bool operator()(const RadiusLayerPair& _Left, const RadiusLayerPair& _Right) const {
@@ -146,6 +178,23 @@ private:
      */
     const ExPolygons& calculate_avoidance(const RadiusLayerPair& key) const;
 
+    // Stores the avoidance of the given radius and layer and accounts for its memory.
+    const ExPolygons& insert_avoidance(coordf_t radius, size_t layer_nr, ExPolygons &&avoidance) const;
+    // Whether the avoidance of a layer is to be cached: always below the memory budget, above it only at the checkpoints.
+    bool keep_avoidance(size_t layer_nr) const;
+
+    struct CacheStats {
+        std::atomic<size_t> hits   { 0 };
+        std::atomic<size_t> misses { 0 };
+        // Estimated size of the cached polygons in bytes.
+        std::atomic<size_t> bytes  { 0 };
+
+        CacheStats() = default;
+        // The bytes move with the cache, the moved from cache releases nothing from the shared budget.
+        CacheStats(CacheStats &&rhs) : hits(rhs.hits.load()), misses(rhs.misses.load()), bytes(rhs.bytes.exchange(0)) {}
+        CacheStats& operator=(CacheStats &&rhs) { hits = rhs.hits.load(); misses = rhs.misses.load(); bytes = rhs.bytes.exchange(0); return *this; }
+    };
+
 
 public:
     bool is_slim = false;
@@ -190,7 +239,14 @@ public:
      * So we change to tbb::concurrent_unordered_map
      */
     mutable tbb::concurrent_unordered_map<RadiusLayerPair, ExPolygons, RadiusLayerPairHash, RadiusLayerPairEquality> m_collision_cache;
-    mutable tbb::concurrent_unordered_map<RadiusLayerPair, ExPolygons, RadiusLayerPairHash, RadiusLayerPairEquality> m_avoidance_cache;
+    // BBS: the avoidance cache is split by layer, so that the layers left behind by the drop front are released at once.
+    // Indexed by layer, keyed by the rounded radius.
+    mutable std::vector<tbb::concurrent_unordered_map<coordf_t, ExPolygons>> m_avoidance_cache;
+    mutable CacheStats m_collision_stats;
+    mutable CacheStats m_avoidance_stats;
+    // Budget of the avoidance caches of all the objects and the checkpoint layers, set by precompute_avoidance().
+    mutable size_t            m_avoidance_memory_limit { std::numeric_limits<size_t>::max() };
+    mutable std::vector<char> m_avoidance_checkpoints;
 
     friend TreeSupport;
 };
@@ -211,7 +211,8 @@ bool TriangleMesh::from_stl(stl_file& stl, bool repair)
 bool TriangleMesh::ReadSTLFile(const char* input_file, bool repair, ImportstlProgressFn stlFn)
 { 
     stl_file stl;
-    if (! stl_open(&stl, input_file, stlFn))
+    std::optional<bool> mapped = stl_open_binary_mapped(&stl, input_file, stlFn);
+    if (mapped ? ! *mapped : ! stl_open(&stl, input_file, stlFn))
         return false;
     return from_stl(stl, repair);
 }
@@ -1274,6 +1275,27 @@ float its_average_edge_length(const indexed_triangle_set &its)
     return float(edge_length / (3 * its.indices.size()));
 }
 
+// 64bit FNV-1a hash over 32bit words of the vertex coordinates and vertex indices.
+uint64_t its_hash(const indexed_triangle_set &its)
+{
+    static_assert(sizeof(stl_vertex) == 3 * sizeof(uint32_t), "stl_vertex is expected to be packed");
+    static_assert(sizeof(stl_triangle_vertex_indices) == 3 * sizeof(uint32_t), "stl_triangle_vertex_indices is expected to be packed");
+    uint64_t hash = 0xcbf29ce484222325ull;
+    auto     hash_words = [&hash](const void *data, size_t num_words) {
+        const uint32_t *words = reinterpret_cast<const uint32_t*>(data);
+        for (size_t i = 0; i < num_words; ++ i) {
+            hash ^= words[i];
+            hash *= 0x100000001b3ull;
+        }
+    };
+    // Hash the number of vertices to separate the vertices from the indices.
+    const uint64_t num_vertices = its.vertices.size();
+    hash_words(&num_vertices, 2);
+    hash_words(its.vertices.data(), its.vertices.size() * 3);
+    hash_words(its.indices.data(), its.indices.size() * 3);
+    return hash;
+}
+
 std::vector<indexed_triangle_set> its_split(const indexed_triangle_set &its)
 {
     return its_split<>(its);
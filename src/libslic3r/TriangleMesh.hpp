@@ -320,6 +320,9 @@ inline stl_normal its_unnormalized_normal(const indexed_triangle_set &its,
 
 float its_volume(const indexed_triangle_set &its);
 float its_average_edge_length(const indexed_triangle_set &its);
+// Hash of the vertices and triangles of the mesh, stable between application runs.
+// Used to key caches of data derived from the mesh.
+uint64_t its_hash(const indexed_triangle_set &its);
 
 void its_merge(indexed_triangle_set &A, const indexed_triangle_set &B);
 void its_merge(indexed_triangle_set &A, const std::vector<Vec3f> &triangles);
@@ -2,12 +2,42 @@
 #define slic3r_TriangleMeshSlicer_hpp_
 
 #include <functional>
+#include <memory>
 #include <vector>
 #include "Polygon.hpp"
 #include "ExPolygon.hpp"
 
 namespace Slic3r {
 
+// Facets of a triangle set bucketed by their Z extent and sorted by their minimum Z inside a bucket, to quickly find
+// the facets crossing a range of slicing planes. The Z extents of the facets of a bucket are within a factor of two,
+// so a few tall facets (a cylinder wall, a vertical side) do not make the queries scan the short facets.
+// Built once per mesh by build_facet_z_index(), the index remains valid as long as the mesh does not change.
+struct FacetZIndex
+{
+    struct Bucket
+    {
+        // Range of this->facets.
+        size_t begin;
+        size_t end;
+        // Maximum Z extent of a facet of the bucket.
+        float  max_height;
+    };
+
+    // Facet indices sorted by their bucket, then by their minimum Z.
+    std::vector<int>    facets;
+    // Minimum Z of the facets, in the order of this->facets.
+    std::vector<float>  min_z;
+    // Buckets of increasing Z extents.
+    std::vector<Bucket> buckets;
+
+    bool empty() const { return this->facets.empty(); }
+    // Facets, which may cross the Z range <z_min, z_max>.
+    std::vector<int> facets_crossing(float z_min, float z_max) const;
+};
+
+FacetZIndex build_facet_z_index(const indexed_triangle_set &its);
+
 struct MeshSlicingParams
 {
     enum class SlicingMode : uint32_t {
@@ -33,6 +63,12 @@ struct MeshSlicingParams
     SlicingMode   mode_below { SlicingMode::Regular };
     // Transforming faces during the slicing.
     Transform3d   trafo { Transform3d::Identity() };
+    // Optional provider of an index of the facets of the sliced mesh. Called by slice_mesh() only when slicing at multiple planes
+    // with trafo not mixing Z with X or Y, thus the index is not built for the meshes sliced without it.
+    std::function<std::shared_ptr<const FacetZIndex>()> facet_z_index;
+    // Slice multiple planes by blocks of facets, see slice_make_lines_blocked(). Otherwise slice facet by facet,
+    // which is kept to compare the two.
+    bool          slice_in_blocks { true };
 };
 
 struct MeshSlicingParamsEx : public MeshSlicingParams
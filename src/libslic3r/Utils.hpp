@@ -72,6 +72,9 @@ extern std::string log_memory_info(bool ignore_loglevel = false);
 extern void disable_multi_threading();
 // Returns the size of physical memory (RAM) in bytes.
 extern size_t total_physical_memory();
+// Returns the size of physical memory (RAM) in bytes, which is available to new allocations without swapping.
+// Returns zero if the value could not be retrieved.
+extern size_t available_physical_memory();
 
 // Set a path with GUI resource files.
 void set_var_dir(const std::string &path);
@@ -1398,6 +1398,33 @@ size_t total_physical_memory()
 #endif
 }
 
+// Returns the size of physical memory (RAM) in bytes, which is available to new allocations without swapping.
+// Returns zero if the value could not be retrieved.
+size_t available_physical_memory()
+{
+#if defined(_WIN32)
+	MEMORYSTATUSEX status;
+	status.dwLength = sizeof(status);
+	if (GlobalMemoryStatusEx(&status))
+		return (size_t)status.ullAvailPhys;
+	return 0L;
+#elif defined(__linux__)
+	// MemAvailable accounts for the reclaimable page cache, MemFree does not.
+	std::ifstream meminfo("/proc/meminfo");
+	std::string   key;
+	size_t        value;
+	std::string   unit;
+	while (meminfo >> key >> value) {
+		std::getline(meminfo, unit);
+		if (key == "MemAvailable:")
+			return value * (size_t)1024L;
+	}
+	return 0L;
+#else
+	return 0L;			// Unknown OS.
+#endif
+}
+
 bool makedir(const std::string path) {
 	// if dir doesn't exist, make it
 #ifdef WIN32
@@ -24,6 +24,8 @@
 #include "libslic3r/Thread.hpp"
 #include "libslic3r/libslic3r.h"
 
+#include <tbb/task_arena.h>
+
 #include <cassert>
 #include <stdexcept>
 #include <cctype>
@@ -105,7 +107,28 @@ std::pair<std::string, std::vector<size_t>> SlicingProcessCompletedEvent::format
     return std::make_pair(std::move(error), std::vector<size_t>{monospace});
 }
 
-BackgroundSlicingProcess::BackgroundSlicingProcess()
+struct BackgroundSlicingProcess::PrefetchState
+{
+	struct Task
+	{
+		Print 								   *print { nullptr };
+		std::mutex 								mutex;
+		std::condition_variable					condition;
+		bool 									done { false };
+		// Slicing warnings reported by the print, replayed once its plate becomes the current one.
+		std::vector<PrintBase::SlicingStatus>	warnings;
+		// Status callback of the plate once the walk reached it, see adopt_prefetch().
+		PrintBase::status_callback_type 		status_cb;
+	};
+	// Low priority, so that the TBB workers serve the current plate first.
+	tbb::task_arena 								arena { tbb::task_arena::automatic, 0, tbb::task_arena::priority::low };
+	// Guards tasks, adopted_tasks are waited for by the background thread.
+	std::mutex 										mutex;
+	std::map<const PrintBase*, std::shared_ptr<Task>> tasks;
+	std::map<const PrintBase*, std::shared_ptr<Task>> adopted_tasks;
+};
+
+BackgroundSlicingProcess::BackgroundSlicingProcess() : m_prefetch(std::make_unique<PrefetchState>())
 {
 	//BBS: move this logic to part plate
 #if 0
@@ -117,6 +140,7 @@ BackgroundSlicingProcess::BackgroundSlicingProcess()
 
 BackgroundSlicingProcess::~BackgroundSlicingProcess()
 {
+	this->cancel_prefetch();
 	this->stop();
 	this->join_background_thread();
 	//BBS: move this logic to part plate
@@ -195,6 +219,8 @@ std::string BackgroundSlicingProcess::output_filepath_for_project(const boost::f
 void BackgroundSlicingProcess::process_fff()
 {
     assert(m_print == m_fff_print);
+    //BBS: the print may still be processed ahead by "slice all", wait here rather than on the UI thread
+    this->wait_for_prefetch();
     PresetBundle &preset_bundle = *wxGetApp().preset_bundle;
     m_fff_print->set_BBL_Printer(preset_bundle.printers.get_edited_preset().is_bbl_vendor_preset(&preset_bundle));
 	//BBS: add the logic to process from an existed gcode file
@@ -561,6 +587,7 @@ bool BackgroundSlicingProcess::stop()
 
 bool BackgroundSlicingProcess::reset()
 {
+	this->cancel_prefetch();
 	bool stopped = this->stop();
 	this->reset_export();
 	//BBS: don't clear print for print is not owned by background slicing process anymore
@@ -570,6 +597,127 @@ bool BackgroundSlicingProcess::reset()
 	return stopped;
 }
 
+// To be called on the UI thread.
+void BackgroundSlicingProcess::prefetch(Print *print)
+{
+	assert(print != nullptr && print != m_print);
+	this->cancel_prefetch(print);
+
+	auto task = std::make_shared<PrefetchState::Task>();
+	task->print = print;
+	// The progress of the other plates is not shown, only their warnings are kept until the walk reaches their plate.
+	print->set_status_callback([task](const PrintBase::SlicingStatus &status) {
+		std::lock_guard<std::mutex> lock(task->mutex);
+		if (task->status_cb)
+			task->status_cb(status);
+		else if (status.flags & (PrintBase::SlicingStatus::UPDATE_PRINT_STEP_WARNINGS | PrintBase::SlicingStatus::UPDATE_PRINT_OBJECT_STEP_WARNINGS))
+			task->warnings.emplace_back(status);
+	});
+	// Print::apply() invalidating a step of the print stops the prefetch first, start() replaces the callback once the walk reaches the plate.
+	print->set_cancel_callback([this, print]() { this->cancel_prefetch(print); });
+	{
+		std::lock_guard<std::mutex> lock(m_prefetch->mutex);
+		m_prefetch->tasks[print] = task;
+	}
+	BOOST_LOG_TRIVIAL(info) << __FUNCTION__ << boost::format(": prefetch print %1%") % print;
+
+	m_prefetch->arena.enqueue([task]() {
+		try {
+			task->print->process();
+		} catch (CanceledException &) {
+			// Canceled, this is all right.
+		} catch (std::exception &ex) {
+			// The failed step is not done, thus the error is reported again once the walk processes this plate.
+			BOOST_LOG_TRIVIAL(warning) << "prefetch of print " << task->print << " failed: " << ex.what();
+		}
+		std::lock_guard<std::mutex> lock(task->mutex);
+		task->done = true;
+		task->condition.notify_all();
+	});
+}
+
+// To be called on the UI thread.
+bool BackgroundSlicingProcess::adopt_prefetch(const PrintBase *print, PrintBase::status_callback_type status_cb)
+{
+	std::shared_ptr<PrefetchState::Task> task;
+	{
+		std::lock_guard<std::mutex> lock(m_prefetch->mutex);
+		auto it = m_prefetch->tasks.find(print);
+		if (it == m_prefetch->tasks.end())
+			return false;
+		task = std::move(it->second);
+		m_prefetch->tasks.erase(it);
+		m_prefetch->adopted_tasks[print] = task;
+	}
+	std::lock_guard<std::mutex> lock(task->mutex);
+	for (const PrintBase::SlicingStatus &warning : task->warnings)
+		status_cb(warning);
+	task->warnings.clear();
+	task->status_cb = std::move(status_cb);
+	BOOST_LOG_TRIVIAL(info) << __FUNCTION__ << boost::format(": print %1% adopted, done %2%") % print % task->done;
+	return true;
+}
+
+// To be called on the background thread. Canceling m_print cancels its prefetch as well, thus the wait ends on stop().
+void BackgroundSlicingProcess::wait_for_prefetch()
+{
+	std::shared_ptr<PrefetchState::Task> task;
+	{
+		std::lock_guard<std::mutex> lock(m_prefetch->mutex);
+		auto it = m_prefetch->adopted_tasks.find(m_print);
+		if (it == m_prefetch->adopted_tasks.end())
+			return;
+		task = std::move(it->second);
+		m_prefetch->adopted_tasks.erase(it);
+	}
+	std::unique_lock<std::mutex> lock(task->mutex);
+	task->condition.wait(lock, [&task]() { return task->done; });
+	BOOST_LOG_TRIVIAL(info) << __FUNCTION__ << boost::format(": prefetch of print %1% finished") % m_print;
+}
+
+// To be called on the UI thread.
+void BackgroundSlicingProcess::cancel_prefetch(const PrintBase *print)
+{
+	std::shared_ptr<PrefetchState::Task> task;
+	{
+		std::lock_guard<std::mutex> lock(m_prefetch->mutex);
+		for (auto *tasks : { &m_prefetch->tasks, &m_prefetch->adopted_tasks }) {
+			auto it = tasks->find(print);
+			if (it != tasks->end()) {
+				task = std::move(it->second);
+				tasks->erase(it);
+				break;
+			}
+		}
+	}
+	if (! task)
+		return;
+	task->print->cancel();
+	std::unique_lock<std::mutex> lock(task->mutex);
+	task->condition.wait(lock, [&task]() { return task->done; });
+	// Allow the canceled print to be processed again.
+	task->print->restart();
+	task->print->set_status_silent();
+	task->print->set_cancel_callback([](){});
+	BOOST_LOG_TRIVIAL(info) << __FUNCTION__ << boost::format(": prefetch of print %1% canceled") % print;
+}
+
+// To be called on the UI thread.
+void BackgroundSlicingProcess::cancel_prefetch()
+{
+	std::vector<const PrintBase*> prints;
+	{
+		std::lock_guard<std::mutex> lock(m_prefetch->mutex);
+		for (auto *tasks : { &m_prefetch->tasks, &m_prefetch->adopted_tasks })
+			for (auto &print_task : *tasks) {
+				print_task.second->print->cancel();
+				prints.emplace_back(print_task.first);
+			}
+	}
+	for (const PrintBase *print : prints)
+		this->cancel_prefetch(print);
+}
+
 // To be called by Print::apply() on the UI thread through the Print::m_cancel_callback to stop the background
 // processing before changing any data of running or finalized milestones.
 // This function shall not trigger any UI update through the wxWidgets event.
@@ -3,7 +3,9 @@
 
 #include <string>
 #include <condition_variable>
+#include <memory>
 #include <mutex>
+#include <vector>
 
 #include <boost/thread.hpp>
 
@@ -187,6 +189,17 @@ public:
     bool    finished() const { return m_print->finished() && !m_gcode_result->moves.empty(); }
     bool    is_internal_cancelled() { return m_internal_cancelled; }
 
+    //BBS: slice the other plates of "slice all" ahead of the plate by plate walk, concurrently with the current plate.
+    // The prints are processed in a low priority task arena, thus the current plate processed by m_thread always wins the cores.
+    // The UI thread shall apply the model and config to the print before, the G-code is still exported by the walk.
+    void    prefetch(Print *print);
+    // Hand the prefetch of the print over to the background thread, which waits for it before processing the print.
+    // Does not block. The warnings reported so far and the further status updates of the prefetch are passed to status_cb.
+    // Returns false if the print is not being prefetched, then the caller installs status_cb itself.
+    bool    adopt_prefetch(const PrintBase *print, PrintBase::status_callback_type status_cb);
+    // Cancel all the prefetches and wait until they stopped, to be called before any print is changed or deleted.
+    void    cancel_prefetch();
+
     //BBS: add Plater to friend class
     //need to call stop_internal in ui thread
     friend class GUI::Plater;
@@ -278,6 +291,14 @@ private:
 	PrinterTechnology m_printer_tech = ptUnknown;
 	bool m_internal_cancelled = false;
 
+	// Prints of the other plates being processed ahead, see prefetch(). Hidden, as tbb must not be included before wx.
+	struct PrefetchState;
+	std::unique_ptr<PrefetchState> m_prefetch;
+	// Cancel the prefetch of a single print and wait until it stopped.
+	void    cancel_prefetch(const PrintBase *print);
+	// Called by the background thread before processing m_print.
+	void    wait_for_prefetch();
+
     PrintState<BackgroundSlicingProcessStep, bspsCount>   	m_step_state;
 	bool                set_step_started(BackgroundSlicingProcessStep step);
 	void                set_step_done(BackgroundSlicingProcessStep step);
@@ -1163,12 +1163,13 @@ void GCodeViewer::refresh(const GCodeProcessorResult& gcode_result, const std::v
 
     // update ranges for coloring / legend
     m_extrusions.reset_ranges();
-    for (size_t i = 0; i < m_moves_count; ++i) {
+    GCodeProcessorResult::MoveVertexStore::const_iterator move_it = gcode_result.moves.begin();
+    for (size_t i = 0; i < m_moves_count; ++i, ++move_it) {
         // skip first vertex
         if (i == 0)
             continue;
 
-        const GCodeProcessorResult::MoveVertex& curr = gcode_result.moves[i];
+        const GCodeProcessorResult::MoveVertex curr = *move_it;
 
         switch (curr.type)
         {
@@ -2370,7 +2371,7 @@ void GCodeViewer::load_toolpaths(const GCodeProcessorResult& gcode_result, const
 
 #if ENABLE_GCODE_VIEWER_STATISTICS
     auto start_time = std::chrono::high_resolution_clock::now();
-    m_statistics.results_size = SLIC3R_STDVEC_MEMSIZE(gcode_result.moves, GCodeProcessorResult::MoveVertex);
+    m_statistics.results_size = gcode_result.moves.memsize();
     m_statistics.results_time = gcode_result.time;
 #endif // ENABLE_GCODE_VIEWER_STATISTICS
 
@@ -2464,9 +2465,8 @@ void GCodeViewer::load_toolpaths(const GCodeProcessorResult& gcode_result, const
 
     m_sequential_view.gcode_ids.clear();
     for (size_t i = 0; i < gcode_result.moves.size(); ++i) {
-        const GCodeProcessorResult::MoveVertex& move = gcode_result.moves[i];
-        if (move.type != EMoveType::Seam)
-            m_sequential_view.gcode_ids.push_back(move.gcode_id);
+        if (gcode_result.moves.type(i) != EMoveType::Seam)
+            m_sequential_view.gcode_ids.push_back(gcode_result.moves.gcode_id(i));
     }
     BOOST_LOG_TRIVIAL(info) << __FUNCTION__<< boost::format(",m_contained_in_bed %1%\n")%m_contained_in_bed;
 
@@ -2481,8 +2481,9 @@ void GCodeViewer::load_toolpaths(const GCodeProcessorResult& gcode_result, const
     std::vector<size_t> biased_seams_ids;
 
     // toolpaths data -> extract vertices from result
-    for (size_t i = 0; i < m_moves_count; ++i) {
-        const GCodeProcessorResult::MoveVertex& curr = gcode_result.moves[i];
+    GCodeProcessorResult::MoveVertexStore::const_iterator move_it = gcode_result.moves.begin();
+    for (size_t i = 0; i < m_moves_count; ++i, ++move_it) {
+        const GCodeProcessorResult::MoveVertex curr = *move_it;
         if (curr.type == EMoveType::Seam) {
             ++seams_count;
             biased_seams_ids.push_back(i - biased_seams_ids.size() - 1);
@@ -2494,7 +2495,7 @@ void GCodeViewer::load_toolpaths(const GCodeProcessorResult& gcode_result, const
         if (i == 0)
             continue;
 
-        const GCodeProcessorResult::MoveVertex& prev = gcode_result.moves[i - 1];
+        const GCodeProcessorResult::MoveVertex prev = *std::prev(move_it);
 
         // update progress dialog
         ++progress_count;
@@ -2612,11 +2613,11 @@ void GCodeViewer::load_toolpaths(const GCodeProcessorResult& gcode_result, const
                 size_t temp_offset = prev_sub_path.last.s_id - curr_s_id;
                 for (size_t i = prev_sub_path.last.s_id; i > curr_s_id; i--) {
                     size_t move_id = m_ssid_to_moveid_map[i];
-                    temp_offset += (gcode_result.moves[move_id].is_arc_move() ? gcode_result.moves[move_id].interpolation_points.size() : 0);
+                    temp_offset += gcode_result.moves.interpolation_points(move_id).size();
                 }
                 if (is_internal_point) {
                     size_t move_id = m_ssid_to_moveid_map[curr_s_id];
-                    temp_offset += (gcode_result.moves[move_id].interpolation_points.size() - interpolation_point_id);
+                    temp_offset += (gcode_result.moves.interpolation_points(move_id).size() - interpolation_point_id);
                 }
                 const size_t next_1st_offset = temp_offset * 6 * vertex_size_floats;
                 // offset into the vertex buffer of the right vertex of the previous segment
@@ -2654,11 +2655,11 @@ void GCodeViewer::load_toolpaths(const GCodeProcessorResult& gcode_result, const
                 size_t temp_offset = prev_sub_path.last.s_id - curr_s_id;
                 for (size_t i = prev_sub_path.last.s_id; i > curr_s_id; i--) {
                     size_t move_id = m_ssid_to_moveid_map[i];
-                    temp_offset += (gcode_result.moves[move_id].is_arc_move() ? gcode_result.moves[move_id].interpolation_points.size() : 0);
+                    temp_offset += gcode_result.moves.interpolation_points(move_id).size();
                 }
                 if (is_internal_point) {
                     size_t move_id = m_ssid_to_moveid_map[curr_s_id];
-                    temp_offset += (gcode_result.moves[move_id].interpolation_points.size() - interpolation_point_id);
+                    temp_offset += (gcode_result.moves.interpolation_points(move_id).size() - interpolation_point_id);
                 }
                 const size_t next_1st_offset = temp_offset * 6 * vertex_size_floats;
                 // offset into the vertex buffer of the left vertex of the previous segment
@@ -2700,14 +2701,15 @@ void GCodeViewer::load_toolpaths(const GCodeProcessorResult& gcode_result, const
             for (size_t j = 1; j < path_vertices_count; ++j) {
                 size_t curr_s_id = path.sub_paths.front().first.s_id + j;
                 size_t move_id = m_ssid_to_moveid_map[curr_s_id];
-                int interpolation_points_num = gcode_result.moves[move_id].is_arc_move_with_interpolation_points()?
-                                                    gcode_result.moves[move_id].interpolation_points.size() : 0;
+                const GCodeProcessorResult::InterpolationPoints curr_points = gcode_result.moves.interpolation_points(move_id);
+                const Vec3f& curr_position = gcode_result.moves.position(move_id);
+                int interpolation_points_num = curr_points.size();
                 int loop_num = interpolation_points_num;
                 //BBS: select the subpaths which contains the previous/next segments
                 if (!path.sub_paths[prev_sub_path_id].contains(curr_s_id))
                     ++prev_sub_path_id;
                 if (j == path_vertices_count - 1) {
-                    if (!gcode_result.moves[move_id].is_arc_move_with_interpolation_points())
+                    if (curr_points.empty())
                         break;   // BBS: the last move has no internal point.
                     loop_num--;  //BBS: don't need to handle the endpoint of the last arc move of path
                     next_sub_path_id = prev_sub_path_id;
@@ -2721,17 +2723,17 @@ void GCodeViewer::load_toolpaths(const GCodeProcessorResult& gcode_result, const
                 // BBS: smooth triangle toolpaths corners including arc move which has internal interpolation point
                 for (int k = 0; k <= loop_num; k++) {
                     const Vec3f& prev = k==0?
-                                        gcode_result.moves[move_id - 1].position :
-                                        gcode_result.moves[move_id].interpolation_points[k-1];
+                                        gcode_result.moves.position(move_id - 1) :
+                                        curr_points[k-1];
                     const Vec3f& curr = k==interpolation_points_num?
-                                        gcode_result.moves[move_id].position :
-                                        gcode_result.moves[move_id].interpolation_points[k];
+                                        curr_position :
+                                        curr_points[k];
                     const Vec3f& next = k < interpolation_points_num - 1?
-                                        gcode_result.moves[move_id].interpolation_points[k+1]:
-                                        (k == interpolation_points_num - 1? gcode_result.moves[move_id].position :
-                                        (gcode_result.moves[move_id + 1].is_arc_move_with_interpolation_points()?
-                                        gcode_result.moves[move_id + 1].interpolation_points[0] :
-                                        gcode_result.moves[move_id + 1].position));
+                                        curr_points[k+1]:
+                                        (k == interpolation_points_num - 1? curr_position :
+                                        (!gcode_result.moves.interpolation_points(move_id + 1).empty()?
+                                        gcode_result.moves.interpolation_points(move_id + 1)[0] :
+                                        gcode_result.moves.position(move_id + 1)));
 
                     const Vec3f prev_dir = (curr - prev).normalized();
                     const Vec3f prev_right = Vec3f(prev_dir.y(), -prev_dir.x(), 0.0f).normalized();
@@ -2882,8 +2884,9 @@ void GCodeViewer::load_toolpaths(const GCodeProcessorResult& gcode_result, const
 
     seams_count = 0;
 
-    for (size_t i = 0; i < m_moves_count; ++i) {
-        const GCodeProcessorResult::MoveVertex& curr = gcode_result.moves[i];
+    move_it = gcode_result.moves.begin();
+    for (size_t i = 0; i < m_moves_count; ++i, ++move_it) {
+        const GCodeProcessorResult::MoveVertex curr = *move_it;
         if (curr.type == EMoveType::Seam)
             ++seams_count;
 
@@ -2893,10 +2896,13 @@ void GCodeViewer::load_toolpaths(const GCodeProcessorResult& gcode_result, const
         if (i == 0)
             continue;
 
-        const GCodeProcessorResult::MoveVertex& prev = gcode_result.moves[i - 1];
+        const GCodeProcessorResult::MoveVertex prev = *std::prev(move_it);
+        GCodeProcessorResult::MoveVertex next_move;
         const GCodeProcessorResult::MoveVertex* next = nullptr;
-        if (i < m_moves_count - 1)
-            next = &gcode_result.moves[i + 1];
+        if (i < m_moves_count - 1) {
+            next_move = *std::next(move_it);
+            next = &next_move;
+        }
 
         ++progress_count;
         if (progress_dialog != nullptr && progress_count % progress_threshold == 0) {
@@ -3052,8 +3058,9 @@ void GCodeViewer::load_toolpaths(const GCodeProcessorResult& gcode_result, const
     // layers zs / roles / extruder ids -> extract from result
     size_t last_travel_s_id = 0;
     seams_count = 0;
-    for (size_t i = 0; i < m_moves_count; ++i) {
-        const GCodeProcessorResult::MoveVertex& move = gcode_result.moves[i];
+    move_it = gcode_result.moves.begin();
+    for (size_t i = 0; i < m_moves_count; ++i, ++move_it) {
+        const GCodeProcessorResult::MoveVertex move = *move_it;
         if (move.type == EMoveType::Seam)
             ++seams_count;
 
@@ -3450,10 +3457,7 @@ void GCodeViewer::refresh_render_paths(bool keep_sequential_current_first, bool
                             if (buffer.render_primitive_type == TBuffer::ERenderPrimitiveType::Line) {
                                 for (size_t i = sub_path.first.s_id + 1; i < m_sequential_view.current.last + 1; i++) {
                                     size_t move_id = m_ssid_to_moveid_map[i];
-                                    const GCodeProcessorResult::MoveVertex& curr = m_gcode_result->moves[move_id];
-                                    if (curr.is_arc_move()) {
-                                        offset += curr.interpolation_points.size();
-                                    }
+                                    offset += m_gcode_result->moves.interpolation_points(move_id).size();
                                 }
                                 offset = 2 * offset - 1;
                             }
@@ -3462,10 +3466,7 @@ void GCodeViewer::refresh_render_paths(bool keep_sequential_current_first, bool
                                 // BBS: modify to support moves which has internal point
                                 for (size_t i = sub_path.first.s_id + 1; i < m_sequential_view.current.last + 1; i++) {
                                     size_t move_id = m_ssid_to_moveid_map[i];
-                                    const GCodeProcessorResult::MoveVertex& curr = m_gcode_result->moves[move_id];
-                                    if (curr.is_arc_move()) {
-                                        offset += curr.interpolation_points.size();
-                                    }
+                                    offset += m_gcode_result->moves.interpolation_points(move_id).size();
                                 }
                                 offset = indices_count * (offset - 1) + (indices_count - 2);
                                 if (sub_path_id == 0)
@@ -3564,10 +3565,7 @@ void GCodeViewer::refresh_render_paths(bool keep_sequential_current_first, bool
             unsigned int segments_count = max_s_id - min_s_id;
             for (size_t i = min_s_id + 1; i < max_s_id + 1; i++) {
                 size_t move_id = m_ssid_to_moveid_map[i];
-                const GCodeProcessorResult::MoveVertex& curr = m_gcode_result->moves[move_id];
-                if (curr.is_arc_move()) {
-                    segments_count += curr.interpolation_points.size();
-                }
+                segments_count += m_gcode_result->moves.interpolation_points(move_id).size();
             }
             size_in_indices = buffer.indices_per_segment() * segments_count;
             break;
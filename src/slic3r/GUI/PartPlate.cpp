@@ -1582,6 +1582,9 @@ void PartPlate::set_index(int index)
 {
 	BOOST_LOG_TRIVIAL(debug) << __FUNCTION__ << boost::format(": plate_id update from %1% to %2%") % m_plate_index % index;
 
+	//BBS: the print may be sliced ahead by "slice all"
+	if (m_print != nullptr && index != m_plate_index && m_partplate_list)
+		m_partplate_list->release_prints();
 	m_plate_index = index;
 	if (m_print != nullptr)
 		m_print->set_plate_index(index);
@@ -1660,8 +1663,12 @@ void PartPlate::set_pos_and_size(Vec3d& origin, int width, int depth, int height
 		clear();
 	}
 
-    if (m_print)
+    if (m_print) {
+        //BBS: the print may be sliced ahead by "slice all"
+        if (pos_changed && m_partplate_list)
+            m_partplate_list->release_prints();
         m_print->set_plate_origin(origin);
+    }
 
 	m_origin = origin;
 	m_width = width;
@@ -2508,7 +2515,9 @@ void PartPlate::update_slice_context(BackgroundSlicingProcess & process)
 	process.set_gcode_result(m_gcode_result);
 	process.select_technology(this->printer_technology);
 	process.set_current_plate(this);
-	m_print->set_status_callback(statuscb);
+	//BBS: the print may still be sliced ahead by "slice all", the background thread waits for it and its status is forwarded
+	if (!process.adopt_prefetch(m_print, statuscb))
+		m_print->set_status_callback(statuscb);
 	process.switch_print_preprocess();
 
 	return;
@@ -3051,6 +3060,7 @@ void PartPlateList::clear(bool delete_plates, bool release_print_list, bool exce
 
 	if (release_print_list)
 	{
+		release_prints();
 		for (std::map<int, PrintBase*>::iterator it = m_print_list.begin(); it != m_print_list.end(); ++it)
 		{
 			PrintBase* print = it->second;
@@ -3190,6 +3200,8 @@ int PartPlateList::destroy_print(int print_index)
 {
 	int result = 0;
 
+	release_prints();
+
 	if (print_index >= 0)
 	{
 		std::map<int, PrintBase*>::iterator it = m_print_list.find(print_index);
@@ -4516,6 +4528,8 @@ int PartPlateList::rebuild_plates_after_deserialize(std::vector<bool>& previous_
 {
 	int ret = 0;
 
+	release_prints();
+
 	BOOST_LOG_TRIVIAL(debug) << __FUNCTION__ << boost::format(": plates count %1%") % m_plate_list.size();
 	update_plate_cols();
 	set_shapes(m_shape, m_exclude_areas, m_logo_texture_filename, m_height_to_lid, m_height_to_rod);
@@ -4765,6 +4779,8 @@ int PartPlateList::load_from_3mf_structure(PlateDataPtrs& plate_data_list)
 			m_plate_list[index]->obj_to_instance_set.insert(std::pair(it->first, it->second));*/
 		if (!plate_data_list[i]->gcode_file.empty()) {
 			m_plate_list[index]->m_gcode_path_from_3mf = plate_data_list[i]->gcode_file;
+			m_plate_list[index]->m_gcode_path_in_3mf = plate_data_list[i]->gcode_file_in_3mf;
+			m_plate_list[index]->m_source_3mf = plate_data_list[i]->source_3mf;
 		}
 		GCodeResult* gcode_result = nullptr;
 		PrintBase* fff_print = nullptr;
@@ -4841,6 +4857,13 @@ int PartPlateList::load_gcode_files()
 			//print_volume.min(2) = -1e10;
 			m_model->update_print_volume_state({m_plate_list[i]->get_shape(), (double)this->m_plate_height });
 
+			//the gcode was left in the 3mf by the lazy loading, extract it now
+			if (!m_plate_list[i]->m_gcode_path_in_3mf.empty() && !boost::filesystem::exists(m_plate_list[i]->m_gcode_path_from_3mf)) {
+				if (!extract_file_from_3mf(m_plate_list[i]->m_source_3mf, m_plate_list[i]->m_gcode_path_in_3mf, m_plate_list[i]->m_gcode_path_from_3mf))
+					BOOST_LOG_TRIVIAL(warning) << __FUNCTION__ << boost::format(": failed to extract %1% from %2%") % m_plate_list[i]->m_gcode_path_in_3mf % m_plate_list[i]->m_source_3mf;
+				m_plate_list[i]->m_gcode_path_in_3mf.clear();
+			}
+
 			if (!m_plate_list[i]->load_gcode_from_file(m_plate_list[i]->m_gcode_path_from_3mf))
 				ret ++;
 		}
@@ -6,6 +6,7 @@
 #include <array>
 #include <thread>
 #include <mutex>
+#include <functional>
 
 #include "libslic3r/ObjectID.hpp"
 #include "libslic3r/GCode/GCodeProcessor.hpp"
@@ -103,6 +104,8 @@ private:
     std::string m_tmp_gcode_path;       //use a temp path to store the gcode
     std::string m_temp_config_3mf_path; //use a temp path to store the config 3mf
     std::string m_gcode_path_from_3mf;  //use a path to store the gcode loaded from 3mf
+    std::string m_gcode_path_in_3mf;    //the archive entry of m_gcode_path_from_3mf while it is not extracted yet
+    std::string m_source_3mf;           //the 3mf to extract m_gcode_path_in_3mf from
 
     friend class PartPlateList;
 
@@ -488,6 +491,9 @@ class PartPlateList : public ObjectBase
     std::map<int, PrintBase*> m_print_list;
     std::map<int, GCodeResult*> m_gcode_result_list;
     std::mutex m_plates_mutex;
+    // Called before the prints are changed or deleted outside of the current plate, to stop the background processing of the other plates.
+    std::function<void()> m_release_prints_cb;
+    void release_prints() { if (m_release_prints_cb) m_release_prints_cb(); }
     int m_plate_count;
     int m_plate_cols;
     int m_current_plate;
@@ -751,6 +757,7 @@ public:
     /*slice related functions*/
     //update current slice context into backgroud slicing process
     void update_slice_context_to_current_plate(BackgroundSlicingProcess& process);
+    void set_release_prints_callback(std::function<void()> cb) { m_release_prints_cb = std::move(cb); }
     //return the current fff print object
     Print& get_current_fff_print() const;
     //return the slice result
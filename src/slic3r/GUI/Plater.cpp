@@ -2173,6 +2173,7 @@ struct Plater::priv
     void on_action_open_project(SimpleEvent&);
     void on_action_slice_plate(SimpleEvent&);
     void on_action_slice_all(SimpleEvent&);
+    void prefetch_slice_all_plates();
     void on_action_publish(wxCommandEvent &evt);
     void on_action_print_plate(SimpleEvent&);
     void on_action_print_all(SimpleEvent&);
@@ -2361,6 +2362,9 @@ Plater::priv::priv(Plater *q, MainFrame *main_frame)
     fff_print.set_status_callback(statuscb);
     sla_print.set_status_callback(statuscb); */
 
+    //BBS: the prints of the other plates may be sliced ahead by "slice all", stop them before they are released
+    partplate_list.set_release_prints_callback([this]() { background_process.cancel_prefetch(); });
+
     // BBS: to be checked. Not follow patch.
     background_process.set_thumbnail_cb([this](const ThumbnailsParams& params) { return this->generate_thumbnails(params, Camera::EType::Ortho); });
     background_process.set_slicing_completed_event(EVT_SLICING_COMPLETED);
@@ -2743,6 +2747,9 @@ Plater::priv::priv(Plater *q, MainFrame *main_frame)
 
 Plater::priv::~priv()
 {
+    //BBS: background_process is destroyed before partplate_list, which still owns the prefetched prints
+    background_process.cancel_prefetch();
+    partplate_list.set_release_prints_callback(nullptr);
     if (config != nullptr)
         delete config;
     // Saves the database of visited (already shown) hints into hints.ini.
@@ -3131,6 +3138,9 @@ std::vector<size_t> Plater::priv::load_files(const std::vector<fs::path>& input_
             strategy = strategy | LoadStrategy::LoadAuxiliary;
         }
         if (load_config) strategy = strategy | LoadStrategy::CheckVersion;
+        // the plate G-code is only needed by G-code only projects, extract it when the plates are loaded
+        if (load_model && load_config && type_3mf && !(strategy & LoadStrategy::Restore))
+            strategy = strategy | LoadStrategy::LazyPlateData;
         bool is_project_file = false;
         BOOST_LOG_TRIVIAL(info) << __FUNCTION__ << boost::format(": is_project_file %1%, type_3mf %2%") % is_project_file % type_3mf;
         try {
@@ -6053,6 +6063,9 @@ void Plater::priv::on_process_completed(SlicingProcessCompletedEvent &evt)
         this->notification_manager->set_slicing_progress_canceled(_u8L("Slicing Canceled"));
         is_finished = true;
     }
+    //BBS: the walk of slice all stops here, drop the plates sliced ahead
+    if (has_error || evt.cancelled())
+        this->background_process.cancel_prefetch();
 
     //BBS: set the current plater's slice result to valid
     if (!this->background_process.empty())
@@ -6244,6 +6257,7 @@ void Plater::priv::on_action_slice_plate(SimpleEvent&)
         Plater::setExtruderParams(Slic3r::Model::extruderParamsMap);
         Plater::setPrintSpeedTable(Slic3r::Model::printSpeedMap);
         m_slice_all = false;
+        background_process.cancel_prefetch();
         q->reslice();
         q->select_view_3D("Preview");
     }
@@ -6263,6 +6277,8 @@ void Plater::priv::on_action_slice_all(SimpleEvent&)
         //select plate
         q->select_plate(m_cur_slice_plate);
         q->reslice();
+        //BBS: slice the other plates concurrently, the walk picks up their results plate by plate
+        prefetch_slice_all_plates();
         if (!m_is_publishing)
             q->select_view_3D("Preview");
         //BBS: wish to select all plates stats item
@@ -6270,6 +6286,48 @@ void Plater::priv::on_action_slice_all(SimpleEvent&)
     }
 }
 
+//BBS: apply the model and config to the prints of the not yet sliced plates and let the background process slice them
+// in its low priority arena. Only Print::process() runs ahead, the G-code export still happens when the walk of
+// on_process_completed() reaches the plate, as the thumbnails are rendered by the UI thread.
+void Plater::priv::prefetch_slice_all_plates()
+{
+    int plate_count = partplate_list.get_plate_count();
+    if (printer_technology != ptFFF || plate_count < 2 || !background_process.running())
+        return;
+
+    PresetBundle &preset_bundle = *wxGetApp().preset_bundle;
+    const DynamicPrintConfig full_config = preset_bundle.full_config();
+    bool is_bbl_printer = preset_bundle.printers.get_edited_preset().is_bbl_vendor_preset(&preset_bundle);
+    int curr_plate_index = partplate_list.get_curr_plate_index();
+    for (int index = 0; index < plate_count; index++) {
+        PartPlate *plate = partplate_list.get_plate(index);
+        if (index == curr_plate_index || plate->is_slice_result_valid() || !plate->has_printable_instances())
+            continue;
+
+        Print *print = nullptr;
+        plate->get_print((PrintBase **) &print, nullptr, nullptr);
+        if (print == nullptr)
+            continue;
+
+        // The printable state of the instances is evaluated against the plate the print belongs to.
+        model.curr_plate_index = index;
+        model.update_print_volume_state(BuildVolume(plate->get_shape(), this->bed.build_volume().printable_height()));
+        DynamicPrintConfig config = full_config;
+        config.apply(*plate->config());
+        print->set_status_silent();
+        print->apply(model, config);
+        print->set_BBL_Printer(is_bbl_printer);
+        if (print->empty() || !print->validate().string.empty()) {
+            // Left to the walk, which reports the error.
+            BOOST_LOG_TRIVIAL(info) << __FUNCTION__ << boost::format(": plate %1% not prefetched") % index;
+            continue;
+        }
+        background_process.prefetch(print);
+    }
+    model.curr_plate_index = curr_plate_index;
+    this->update_print_volume_state();
+}
+
 void Plater::priv::on_action_publish(wxCommandEvent &event)
 {
     if (q != nullptr) {
@@ -10342,6 +10400,8 @@ int Plater::export_3mf(const boost::filesystem::path& output_path, SaveStrategy
     store_params.id_bboxes = plate_bboxes;//BBS
     store_params.project = &p->project;
     store_params.strategy = strategy | SaveStrategy::Zip64;
+    if (wxGetApp().app_config->get("fast_save_3mf") == "true")
+        store_params.strategy = store_params.strategy | SaveStrategy::FastSave;
 
 
     // get type and color for platedata
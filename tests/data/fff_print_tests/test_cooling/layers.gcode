@@ -0,0 +1,1782 @@
+@@LAYER 0 1
+G1 Z0.200 F720
+;_SET_FAN_SPEED_CHANGING_LAYER
+G1 F3000
+G1 X10.000 Y10.000 F9000
+G1 F1800 ;_EXTRUDE_SET_SPEED
+G1 X7.491 Y5.519 E0.03221
+G1 X11.175 Y4.326 E0.02129
+G1 X13.487 Y3.408 E0.03723
+G1 X12.381 Y6.027 E0.01531
+G1 X11.830 Y2.349 E0.19450
+G2 X13.830 Y2.349 I1 J0 E.05
+G1 X10.488 Y-0.986 E0.06342
+G1 X14.249 Y0.271 E0.03715
+;_EXTRUDE_END
+G1 E-.8 F2100
+G1 X14.249 Y0.271 F12000
+T9
+G1 X14.249 Y0.271 F9000
+G1 F6000 ;_EXTRUDE_SET_SPEED;_EXTERNAL_PERIMETER
+G1 X15.111 Y1.231 E0.14183
+G3 X17.111 Y1.231 I1 J0 E.05
+G1 X16.918 Y-0.611 E0.09676
+G1 X12.488 Y4.140 E0.00555
+G1 X15.937 Y-0.679 E0.15776
+;_EXTRUDE_END
+G4 P500
+G1 E-.8 F2100
+G1 X15.937 Y-0.679 F12000
+@@LAYER 1 0
+G1 Z0.400 F720
+;_SET_FAN_SPEED_CHANGING_LAYER
+G1 X15.937 Y-0.679 F9000
+;_OVERHANG_FAN_START
+G1 F7200 ;_EXTRUDE_SET_SPEED;_EXTERNAL_PERIMETER
+G1 X19.864 Y-3.170 E0.09311
+G1 X22.674 Y-4.497 E0.05988
+G1 X27.457 Y-7.412 E0.10306
+G1 X23.939 Y-9.656 E0.14082
+G3 X25.939 Y-9.656 I1 J0 E.05
+G1 X28.927 Y-8.388 E0.14451
+;_OVERHANG_FAN_END
+;_EXTRUDE_END
+G1 E-.8 F2100
+G1 X28.927 Y-8.388 F12000
+@@LAYER 2 1
+G1 Z0.600 F720
+;_SET_FAN_SPEED_CHANGING_LAYER
+G1 X28.927 Y-8.388 F9000
+G1 F6000 ;_EXTRUDE_SET_SPEED
+G1 X25.383 Y-3.597 E0.12803
+G1 X23.725 Y-6.527 E0.19628
+G1 X20.053 Y-2.562 E0.08335
+G1 X18.783 Y-6.974 E0.08471
+G2 X20.783 Y-6.974 I1 J0 E.05
+G1 X20.318 Y-7.092 E0.14617
+G1 X18.229 Y-8.054 E0.03015
+G1 X23.112 Y-3.456 E0.12577
+;_EXTRUDE_END
+G1 E-.8 F2100
+G1 X23.112 Y-3.456 F12000
+@@LAYER 3 1
+G1 Z0.800 F720
+;_SET_FAN_SPEED_CHANGING_LAYER
+G1 X23.112 Y-3.456 F9000
+;_OVERHANG_FAN_START
+G1 F6000 ;_EXTRUDE_SET_SPEED
+G1 X18.456 Y-5.399 E0.11230
+G1 X21.808 Y-7.751 E0.19621
+G1 X26.377 Y-9.350 E0.03655
+G1 X26.120 Y-6.613 E0.06586
+G1 X24.008 Y-6.609 E0.13505
+G1 X21.747 Y-8.153 E0.18757
+G1 X25.970 Y-11.429 E0.17353
+G1 X24.613 Y-13.085 E0.02923
+G1 X21.600 Y-14.465 E0.17092
+G1 X17.388 Y-12.756 E0.08391
+G1 X21.750 Y-12.592 E0.18735
+G1 X22.282 Y-8.921 E0.05487
+;_OVERHANG_FAN_END
+;_EXTRUDE_END
+G1 E-.8 F2100
+G1 X22.282 Y-8.921 F12000
+G1 X22.282 Y-8.921 F9000
+;_OVERHANG_FAN_START
+G1 F7200 ;_EXTRUDE_SET_SPEED
+G1 X26.200 Y-12.812 E0.19363
+G1 X26.684 Y-13.657 E0.07087
+G1 X22.403 Y-16.614 E0.14389
+G1 X20.908 Y-12.093 E0.17132
+;_OVERHANG_FAN_END
+;_EXTRUDE_END
+G1 E-.8 F2100
+G1 X20.908 Y-12.093 F12000
+G1 X20.908 Y-12.093 F9000
+G1 F6000 ;_EXTRUDE_SET_SPEED
+G1 X20.099 Y-8.963 E0.12882
+G1 X16.521 Y-8.003 E0.11321
+G1 X21.201 Y-6.917 E0.07087
+G1 X16.210 Y-10.838 E0.11360
+G1 X12.617 Y-9.544 E0.17837
+G1 X11.934 Y-12.280 E0.05901
+;_EXTRUDE_END
+G1 E-.8 F2100
+G1 X11.934 Y-12.280 F12000
+@@LAYER 4 0
+G1 Z1.000 F720
+;_SET_FAN_SPEED_CHANGING_LAYER
+G1 X11.934 Y-12.280 F9000
+G1 F6000 ;_EXTRUDE_SET_SPEED
+G1 X9.798 Y-12.511 E0.02526
+G1 X9.233 Y-14.580 E0.15656
+G1 X4.365 Y-14.254 E0.05548
+G1 X7.184 Y-16.798 E0.05427
+G1 X12.072 Y-18.866 E0.12200
+;_EXTRUDE_END
+G1 E-.8 F2100
+G1 X12.072 Y-18.866 F12000
+G1 X12.072 Y-18.866 F9000
+G1 F6000 ;_EXTRUDE_SET_SPEED
+G1 X12.371 Y-19.222 E0.07285
+G1 X13.279 Y-23.858 E0.05123
+G1 X17.444 Y-19.979 E0.10957
+G3 X19.444 Y-19.979 I1 J0 E.05
+G1 X21.335 Y-15.446 E0.13012
+G1 X24.747 Y-15.689 E0.13678
+G1 X28.736 Y-16.038 E0.15188
+G1 X23.768 Y-13.248 E0.11684
+G1 X23.492 Y-15.138 E0.03392
+G1 X27.379 Y-10.409 E0.10805
+;_EXTRUDE_END
+G4 P500
+G1 E-.8 F2100
+G1 X27.379 Y-10.409 F12000
+@@LAYER 5 1
+G1 Z1.200 F720
+;_SET_FAN_SPEED_CHANGING_LAYER
+T1
+;_FORCE_RESUME_FAN_SPEED
+G1 X27.379 Y-10.409 F9000
+G1 F7200 ;_EXTRUDE_SET_SPEED;_EXTERNAL_PERIMETER
+G1 X29.392 Y-14.920 E0.16857
+G1 X30.849 Y-10.398 E0.14278
+;_EXTRUDE_END
+G1 X31.849 Y-9.398 F3000 ;_WIPE
+G1 E-.8 F2100
+G1 X31.849 Y-9.398 F12000
+T0
+;_FORCE_RESUME_FAN_SPEED
+G1 X31.849 Y-9.398 F9000
+;_OVERHANG_FAN_START
+G1 F1800 ;_EXTRUDE_SET_SPEED
+G3 X33.849 Y-9.398 I1 J0 E.05
+G1 X31.648 Y-8.687 E0.02455
+G1 X32.885 Y-13.587 E0.01920
+G1 X32.779 Y-15.053 E0.13157
+G1 X29.162 Y-17.106 E0.11416
+G1 X27.064 Y-12.686 E0.11043
+G1 X22.696 Y-15.330 E0.16669
+G1 X27.447 Y-12.249 E0.17284
+G1 X26.336 Y-15.938 E0.00472
+;_OVERHANG_FAN_END
+;_EXTRUDE_END
+G4 P500
+G1 E-.8 F2100
+G1 X26.336 Y-15.938 F12000
+G1 X26.336 Y-15.938 F9000
+G1 F6000 ;_EXTRUDE_SET_SPEED
+G1 X21.631 Y-13.688 E0.01168
+G1 X26.151 Y-11.876 E0.04539
+;_EXTRUDE_END
+G1 X27.151 Y-10.876 F3000 ;_WIPE
+G1 E-.8 F2100
+G1 X27.151 Y-10.876 F12000
+G1 X27.151 Y-10.876 F9000
+G1 F6000 ;_EXTRUDE_SET_SPEED;_EXTERNAL_PERIMETER
+G1 X30.111 Y-12.095 E0.14482
+G1 X28.071 Y-10.782 E0.19229
+G1 X23.434 Y-5.851 E0.04376
+G1 X19.067 Y-10.480 E0.03808
+G1 X18.967 Y-6.109 E0.13259
+G1 X18.237 Y-8.103 E0.18699
+G1 X16.470 Y-8.484 E0.03913
+G1 X12.182 Y-4.794 E0.17391
+G1 X12.702 Y-8.691 E0.16387
+G1 X14.422 Y-13.360 E0.17938
+;_EXTRUDE_END
+G1 E-.8 F2100
+G1 X14.422 Y-13.360 F12000
+T1
+;_FORCE_RESUME_FAN_SPEED
+T9
+G1 X14.422 Y-13.360 F9000
+G1 F6000 ;_EXTRUDE_SET_SPEED;_EXTERNAL_PERIMETER
+G1 X11.822 Y-8.424 E0.00767
+G1 X12.569 Y-6.859 E0.12390
+G1 X14.636 Y-5.054 E0.03771
+G1 X10.305 Y-0.118 E0.09414
+G1 X7.061 Y-3.030 E0.00974
+;_EXTRUDE_END
+G1 E-.8 F2100
+G1 X7.061 Y-3.030 F12000
+G1 X7.061 Y-3.030 F9000
+;_OVERHANG_FAN_START
+G1 F6000 ;_EXTRUDE_SET_SPEED;_EXTERNAL_PERIMETER
+G1 X4.431 Y0.002 E0.01930
+G1 X6.259 Y1.444 E0.09999
+;_OVERHANG_FAN_END
+;_EXTRUDE_END
+G4 S1
+G1 E-.8 F2100
+G1 X6.259 Y1.444 F12000
+@@LAYER 6 1
+G1 Z1.400 F720
+;_SET_FAN_SPEED_CHANGING_LAYER
+G1 X6.259 Y1.444 F9000
+G92 E0
+G1 F7200 ;_EXTRUDE_SET_SPEED;_EXTERNAL_PERIMETER
+G1 X2.103 Y-0.417 E0.02249
+G1 X6.316 Y0.566 E0.17150
+G1 X1.490 Y0.963 E0.09782
+G1 X0.256 Y2.214 E0.14540
+;_EXTRUDE_END
+G1 E-.8 F2100
+G1 X0.256 Y2.214 F12000
+G1 X0.256 Y2.214 F9000
+G92 E0
+G1 F6000 ;_EXTRUDE_SET_SPEED;_EXTERNAL_PERIMETER
+G1 X-3.446 Y-1.967 E0.04973
+G3 X-1.446 Y-1.967 I1 J0 E.05
+G1 X0.217 Y-4.208 E0.09904
+G1 X2.253 Y-1.246 E0.17665
+G1 X-2.028 Y1.448 E0.07659
+G1 X-7.027 Y-0.693 E0.18812
+G2 X-5.027 Y-0.693 I1 J0 E.05
+;_EXTRUDE_END
+G1 E-.8 F2100
+G1 X-5.027 Y-0.693 F12000
+G1 X-5.027 Y-0.693 F9000
+G1 F7200 ;_EXTRUDE_SET_SPEED
+G2 X-3.027 Y-0.693 I1 J0 E.05
+G1 X-6.654 Y-0.716 E0.06532
+G2 X-4.654 Y-0.716 I1 J0 E.05
+G2 X-2.654 Y-0.716 I1 J0 E.05
+G1 X0.611 Y-1.356 E0.05238
+G1 X-4.223 Y-1.082 E0.02594
+G1 X-5.641 Y-4.449 E0.12422
+G1 X-0.811 Y-6.767 E0.12158
+G1 X-4.371 Y-4.120 E0.08748
+;_EXTRUDE_END
+G1 E-.8 F2100
+G1 X-4.371 Y-4.120 F12000
+T0
+;_FORCE_RESUME_FAN_SPEED
+G1 X-4.371 Y-4.120 F9000
+G92 E0
+;_OVERHANG_FAN_START
+G1 F3000 ;_EXTRUDE_SET_SPEED
+G1 X-4.457 Y-9.104 E0.02625
+G1 X-2.602 Y-12.029 E0.00122
+G1 X-5.244 Y-9.978 E0.07150
+G1 X-8.230 Y-6.761 E0.06134
+G1 X-5.585 Y-3.909 E0.07396
+G1 X-2.442 Y-2.277 E0.18178
+G3 X-0.442 Y-2.277 I1 J0 E.05
+G1 X-4.012 Y1.040 E0.09853
+G2 X-2.012 Y1.040 I1 J0 E.05
+;_OVERHANG_FAN_END
+;_EXTRUDE_END
+G1 E-.8 F2100
+G1 X-2.012 Y1.040 F12000
+G1 X-2.012 Y1.040 F9000
+G1 F1800 ;_EXTRUDE_SET_SPEED
+G1 X-6.911 Y1.157 E0.11775
+G1 X-8.020 Y-0.670 E0.00638
+G1 X-9.192 Y-0.909 E0.14097
+G1 X-4.368 Y2.246 E0.18485
+;_EXTRUDE_END
+G1 E-.8 F2100
+G1 X-4.368 Y2.246 F12000
+G1 X-4.368 Y2.246 F9000
+G1 F6000 ;_EXTRUDE_SET_SPEED
+G2 X-2.368 Y2.246 I1 J0 E.05
+G1 X-1.261 Y5.875 E0.18825
+G1 X3.425 Y1.020 E0.18591
+G1 X-1.197 Y-3.097 E0.19241
+G1 X-2.683 Y-0.085 E0.18651
+;_EXTRUDE_END
+G1 E-.8 F2100
+G1 X-2.683 Y-0.085 F12000
+T1
+;_FORCE_RESUME_FAN_SPEED
+G1 X-2.683 Y-0.085 F9000
+G1 F1800 ;_EXTRUDE_SET_SPEED
+G1 X-5.901 Y1.446 E0.18001
+G1 X-4.766 Y0.312 E0.02267
+G1 X-4.232 Y2.465 E0.07543
+G1 X-7.105 Y0.521 E0.05426
+G1 X-3.132 Y-2.805 E0.12693
+G1 X-5.886 Y-7.178 E0.11361
+G1 X-2.100 Y-4.898 E0.08395
+G1 X-1.812 Y-0.850 E0.06116
+G1 X-0.758 Y3.815 E0.03826
+G2 X1.242 Y3.815 I1 J0 E.05
+G1 X1.792 Y4.449 E0.08733
+;_EXTRUDE_END
+G1 E-.8 F2100
+G1 X1.792 Y4.449 F12000
+G1 X1.792 Y4.449 F9000
+;_OVERHANG_FAN_START
+G1 F1800 ;_EXTRUDE_SET_SPEED
+G1 X1.472 Y3.290 E0.18048
+G1 X2.624 Y6.269 E0.16814
+G2 X4.624 Y6.269 I1 J0 E.05
+G3 X6.624 Y6.269 I1 J0 E.05
+G1 X7.782 Y2.318 E0.15186
+G1 X10.945 Y5.355 E0.14291
+;_OVERHANG_FAN_END
+;_EXTRUDE_END
+G1 E-.8 F2100
+G1 X10.945 Y5.355 F12000
+@@LAYER 7 0
+G1 Z1.600 F720
+;_SET_FAN_SPEED_CHANGING_LAYER
+G1 X10.945 Y5.355 F9000
+G92 E0
+G1 F1800 ;_EXTRUDE_SET_SPEED;_EXTERNAL_PERIMETER
+G1 X11.380 Y4.107 E0.02439
+G1 X10.124 Y5.944 E0.09961
+G1 X14.575 Y1.666 E0.15220
+G1 X12.534 Y-2.166 E0.09632
+;_EXTRUDE_END
+G1 E-.8 F2100
+G1 X12.534 Y-2.166 F12000
+@@LAYER 8 1
+G1 Z1.800 F720
+;_SET_FAN_SPEED_CHANGING_LAYER
+T0
+;_FORCE_RESUME_FAN_SPEED
+G1 X12.534 Y-2.166 F9000
+G1 F1800 ;_EXTRUDE_SET_SPEED;_EXTERNAL_PERIMETER
+G1 X16.965 Y-6.533 E0.08705
+G1 X21.824 Y-8.823 E0.14429
+G2 X23.824 Y-8.823 I1 J0 E.05
+G1 X23.149 Y-12.024 E0.16892
+G1 X20.599 Y-12.499 E0.02667
+;_EXTRUDE_END
+G1 X21.599 Y-11.499 F3000 ;_WIPE
+G1 E-.8 F2100
+G1 X21.599 Y-11.499 F12000
+T9
+G1 X21.599 Y-11.499 F9000
+G1 F1800 ;_EXTRUDE_SET_SPEED
+G1 X18.537 Y-8.464 E0.00343
+;_EXTRUDE_END
+G1 E-.8 F2100
+G1 X18.537 Y-8.464 F12000
+@@LAYER 9 1
+G1 Z2.000 F720
+;_SET_FAN_SPEED_CHANGING_LAYER
+G1 X18.537 Y-8.464 F9000
+G1 F1800 ;_EXTRUDE_SET_SPEED
+G3 X20.537 Y-8.464 I1 J0 E.05
+G1 X23.774 Y-9.141 E0.17973
+G2 X25.774 Y-9.141 I1 J0 E.05
+G1 X22.256 Y-6.332 E0.08500
+;_EXTRUDE_END
+G1 E-.8 F2100
+G1 X22.256 Y-6.332 F12000
+G1 X22.256 Y-6.332 F9000
+G1 F1800 ;_EXTRUDE_SET_SPEED
+G1 X18.025 Y-4.457 E0.00815
+G1 X14.521 Y-2.976 E0.14972
+G1 X12.697 Y-3.394 E0.09416
+;_EXTRUDE_END
+G1 X13.697 Y-2.394 F3000 ;_WIPE
+G1 E-.8 F2100
+G1 X13.697 Y-2.394 F12000
+T1
+;_FORCE_RESUME_FAN_SPEED
+G1 X13.697 Y-2.394 F9000
+G92 E0
+;_OVERHANG_FAN_START
+G1 F6000 ;_EXTRUDE_SET_SPEED
+G1 X13.881 Y2.355 E0.14070
+G2 X15.881 Y2.355 I1 J0 E.05
+G3 X17.881 Y2.355 I1 J0 E.05
+G1 X16.568 Y2.132 E0.11676
+;_OVERHANG_FAN_END
+;_EXTRUDE_END
+G1 E-.8 F2100
+G1 X16.568 Y2.132 F12000
+G1 X16.568 Y2.132 F9000
+;_OVERHANG_FAN_START
+G1 F1800 ;_EXTRUDE_SET_SPEED
+G2 X18.568 Y2.132 I1 J0 E.05
+;_OVERHANG_FAN_END
+;_EXTRUDE_END
+G1 E-.8 F2100
+G1 X18.568 Y2.132 F12000
+@@LAYER 10 0
+G1 Z2.200 F720
+;_SET_FAN_SPEED_CHANGING_LAYER
+T0
+;_FORCE_RESUME_FAN_SPEED
+G1 X18.568 Y2.132 F9000
+G92 E0
+G1 F1800 ;_EXTRUDE_SET_SPEED
+G1 X18.068 Y3.681 E0.18503
+G1 X18.369 Y5.813 E0.18752
+G1 X23.249 Y3.830 E0.03416
+G1 X19.023 Y3.318 E0.14751
+G1 X17.910 Y7.563 E0.06054
+G1 X21.207 Y3.943 E0.07084
+G1 X21.866 Y1.017 E0.09133
+G2 X23.866 Y1.017 I1 J0 E.05
+G2 X25.866 Y1.017 I1 J0 E.05
+;_EXTRUDE_END
+G1 E-.8 F2100
+G1 X25.866 Y1.017 F12000
+G1 X25.866 Y1.017 F9000
+G92 E0
+G1 F6000 ;_EXTRUDE_SET_SPEED;_EXTERNAL_PERIMETER
+G1 X28.758 Y3.037 E0.11881
+G1 X32.910 Y6.400 E0.11918
+G1 X36.926 Y4.951 E0.02557
+G1 X38.864 Y6.061 E0.13513
+G1 X34.124 Y5.175 E0.08311
+G1 X33.551 Y5.945 E0.10775
+G1 X35.609 Y8.138 E0.11875
+;_EXTRUDE_END
+G1 X36.609 Y9.138 F3000 ;_WIPE
+G1 E-.8 F2100
+G1 X36.609 Y9.138 F12000
+G1 X36.609 Y9.138 F9000
+G1 F6000 ;_EXTRUDE_SET_SPEED
+G1 X34.662 Y8.672 E0.06051
+G1 X32.890 Y10.248 E0.10011
+;_EXTRUDE_END
+G1 E-.8 F2100
+G1 X32.890 Y10.248 F12000
+@@LAYER 11 1
+G1 Z2.400 F720
+;_SET_FAN_SPEED_CHANGING_LAYER
+G1 X32.890 Y10.248 F9000
+G92 E0
+G1 F7200 ;_EXTRUDE_SET_SPEED;_EXTERNAL_PERIMETER
+G1 X34.396 Y6.996 E0.02862
+G1 X36.268 Y6.467 E0.11508
+G1 X32.718 Y4.146 E0.09926
+G1 X36.720 Y4.699 E0.13281
+G1 X39.563 Y8.058 E0.05943
+G3 X41.563 Y8.058 I1 J0 E.05
+G1 X45.023 Y8.221 E0.09785
+G1 X40.886 Y11.355 E0.13825
+;_EXTRUDE_END
+G1 X41.886 Y12.355 F3000 ;_WIPE
+G1 E-.8 F2100
+G1 X41.886 Y12.355 F12000
+G1 X41.886 Y12.355 F9000
+G92 E0
+G1 F3000 ;_EXTRUDE_SET_SPEED
+G1 X44.544 Y8.353 E0.17170
+G1 X42.664 Y6.280 E0.06809
+G1 X41.749 Y1.942 E0.01471
+G2 X43.749 Y1.942 I1 J0 E.05
+G1 X47.713 Y2.005 E0.02173
+G1 X44.975 Y-2.726 E0.11343
+G1 X41.053 Y-2.610 E0.18670
+G1 X40.714 Y-6.583 E0.15397
+G2 X42.714 Y-6.583 I1 J0 E.05
+G3 X44.714 Y-6.583 I1 J0 E.05
+G1 X42.436 Y-6.073 E0.19462
+;_EXTRUDE_END
+G1 E-.8 F2100
+G1 X42.436 Y-6.073 F12000
+G1 X42.436 Y-6.073 F9000
+G1 F1800 ;_EXTRUDE_SET_SPEED
+G1 X45.996 Y-4.661 E0.06198
+G1 X48.975 Y-3.306 E0.05190
+G1 X50.261 Y-3.739 E0.08139
+;_EXTRUDE_END
+G1 E-.8 F2100
+G1 X50.261 Y-3.739 F12000
+@@LAYER 12 1
+G1 Z2.600 F720
+;_SET_FAN_SPEED_CHANGING_LAYER
+G1 X50.261 Y-3.739 F9000
+G92 E0
+G1 F3000 ;_EXTRUDE_SET_SPEED;_EXTERNAL_PERIMETER
+G3 X52.261 Y-3.739 I1 J0 E.05
+G1 X51.901 Y-1.971 E0.16058
+G1 X49.880 Y1.880 E0.12592
+G1 X50.305 Y2.434 E0.04212
+G3 X52.305 Y2.434 I1 J0 E.05
+G1 X52.192 Y6.171 E0.18397
+G1 X50.530 Y9.941 E0.02743
+G1 X49.677 Y14.705 E0.02652
+G1 X52.247 Y16.987 E0.00121
+G1 X50.371 Y20.518 E0.13261
+G1 X53.748 Y22.276 E0.06863
+;_EXTRUDE_END
+G1 E-.8 F2100
+G1 X53.748 Y22.276 F12000
+G1 X53.748 Y22.276 F9000
+G92 E0
+G1 F7200 ;_EXTRUDE_SET_SPEED;_EXTERNAL_PERIMETER
+G1 X49.180 Y22.628 E0.09624
+G2 X51.180 Y22.628 I1 J0 E.05
+G1 X47.889 Y22.701 E0.13352
+G1 X43.911 Y21.878 E0.17282
+G1 X48.112 Y18.928 E0.04794
+G3 X50.112 Y18.928 I1 J0 E.05
+G1 X48.176 Y21.281 E0.07519
+G1 X50.752 Y20.726 E0.13754
+;_EXTRUDE_END
+G1 X51.752 Y21.726 F3000 ;_WIPE
+G1 E-.8 F2100
+G1 X51.752 Y21.726 F12000
+T1
+;_FORCE_RESUME_FAN_SPEED
+G1 X51.752 Y21.726 F9000
+G92 E0
+G1 F7200 ;_EXTRUDE_SET_SPEED;_EXTERNAL_PERIMETER
+G1 X51.446 Y19.617 E0.01584
+G1 X53.437 Y20.743 E0.09359
+G1 X54.480 Y24.826 E0.17046
+G1 X55.994 Y24.266 E0.10098
+G1 X57.958 Y21.275 E0.10728
+G1 X54.680 Y20.231 E0.00767
+G2 X56.680 Y20.231 I1 J0 E.05
+G1 X55.567 Y16.892 E0.19073
+;_EXTRUDE_END
+G1 E-.8 F2100
+G1 X55.567 Y16.892 F12000
+G1 X55.567 Y16.892 F9000
+;_OVERHANG_FAN_START
+G1 F3000 ;_EXTRUDE_SET_SPEED
+G1 X58.952 Y14.559 E0.01932
+G1 X58.178 Y17.684 E0.16497
+G1 X58.785 Y20.940 E0.14728
+G1 X55.811 Y21.760 E0.14350
+G1 X51.273 Y24.972 E0.19401
+G1 X52.605 Y27.058 E0.08717
+G1 X53.878 Y23.879 E0.10929
+G1 X58.360 Y26.307 E0.14049
+G1 X61.646 Y30.291 E0.14556
+G1 X61.524 Y28.966 E0.19765
+G1 X60.220 Y32.822 E0.05368
+G1 X64.081 Y31.114 E0.19388
+;_OVERHANG_FAN_END
+;_EXTRUDE_END
+G1 E-.8 F2100
+G1 X64.081 Y31.114 F12000
+@@LAYER 13 0
+G1 Z2.800 F720
+;_SET_FAN_SPEED_CHANGING_LAYER
+T0
+;_FORCE_RESUME_FAN_SPEED
+G1 X64.081 Y31.114 F9000
+;_OVERHANG_FAN_START
+G1 F3000 ;_EXTRUDE_SET_SPEED
+G1 X65.025 Y27.057 E0.14632
+G1 X63.232 Y30.623 E0.15597
+;_OVERHANG_FAN_END
+;_EXTRUDE_END
+G1 E-.8 F2100
+G1 X63.232 Y30.623 F12000
+@@LAYER 14 1
+G1 Z3.000 F720
+;_SET_FAN_SPEED_CHANGING_LAYER
+G1 X63.232 Y30.623 F9000
+;_OVERHANG_FAN_START
+G1 F7200 ;_EXTRUDE_SET_SPEED
+G1 X59.744 Y28.405 E0.09045
+G2 X61.744 Y28.405 I1 J0 E.05
+G1 X65.058 Y29.305 E0.01549
+G1 X64.195 Y25.902 E0.12556
+;_OVERHANG_FAN_END
+;_EXTRUDE_END
+G1 E-.8 F2100
+G1 X64.195 Y25.902 F12000
+@@LAYER 15 1
+G1 Z3.200 F720
+;_SET_FAN_SPEED_CHANGING_LAYER
+G1 X64.195 Y25.902 F9000
+G92 E0
+G1 F7200 ;_EXTRUDE_SET_SPEED
+G1 X59.777 Y23.183 E0.05784
+G1 X62.997 Y23.207 E0.07000
+G1 X66.455 Y23.904 E0.09084
+G1 X67.606 Y22.959 E0.08584
+G3 X69.606 Y22.959 I1 J0 E.05
+G1 X64.985 Y25.822 E0.08479
+G1 X61.067 Y20.915 E0.02949
+G1 X61.745 Y21.812 E0.14026
+G2 X63.745 Y21.812 I1 J0 E.05
+G1 X61.667 Y21.132 E0.04716
+G1 X59.632 Y23.079 E0.10608
+G1 X60.272 Y22.032 E0.09378
+;_EXTRUDE_END
+G4 S1
+G1 E-.8 F2100
+G1 X60.272 Y22.032 F12000
+G1 X60.272 Y22.032 F9000
+G92 E0
+G1 F6000 ;_EXTRUDE_SET_SPEED;_EXTERNAL_PERIMETER
+G1 X59.174 Y25.601 E0.19940
+G3 X61.174 Y25.601 I1 J0 E.05
+G1 X57.985 Y30.440 E0.00289
+G1 X56.139 Y27.388 E0.03196
+G1 X56.299 Y23.572 E0.07625
+G1 X53.234 Y22.630 E0.13856
+G1 X54.912 Y17.893 E0.02355
+G1 X50.905 Y16.261 E0.07018
+G1 X46.031 Y13.223 E0.00758
+G1 X43.080 Y17.435 E0.19852
+G1 X41.224 Y16.116 E0.00437
+;_EXTRUDE_END
+G1 E-.8 F2100
+G1 X41.224 Y16.116 F12000
+@@LAYER 16 0
+G1 Z3.400 F720
+;_SET_FAN_SPEED_CHANGING_LAYER
+T1
+;_FORCE_RESUME_FAN_SPEED
+G1 X41.224 Y16.116 F9000
+G1 F6000 ;_EXTRUDE_SET_SPEED
+G1 X37.915 Y13.816 E0.01402
+G1 X40.114 Y13.726 E0.00309
+G1 X43.610 Y17.236 E0.14617
+G1 X47.727 Y17.807 E0.07728
+G1 X45.552 Y13.172 E0.05273
+G1 X41.753 Y8.978 E0.05021
+;_EXTRUDE_END
+G1 E-.8 F2100
+G1 X41.753 Y8.978 F12000
+G1 X41.753 Y8.978 F9000
+G1 F6000 ;_EXTRUDE_SET_SPEED
+G1 X45.304 Y11.884 E0.05976
+G2 X47.304 Y11.884 I1 J0 E.05
+G1 X44.290 Y15.985 E0.11327
+G2 X46.290 Y15.985 I1 J0 E.05
+G1 X47.934 Y16.828 E0.05706
+;_EXTRUDE_END
+G1 E-.8 F2100
+G1 X47.934 Y16.828 F12000
+T0
+;_FORCE_RESUME_FAN_SPEED
+G1 X47.934 Y16.828 F9000
+G1 F7200 ;_EXTRUDE_SET_SPEED
+G1 X45.475 Y17.796 E0.11837
+G1 X46.975 Y19.559 E0.12833
+G1 X51.424 Y24.475 E0.00386
+G2 X53.424 Y24.475 I1 J0 E.05
+G1 X54.978 Y22.597 E0.05654
+G1 X55.989 Y24.043 E0.02762
+G1 X56.591 Y20.991 E0.02133
+G1 X51.799 Y20.977 E0.05964
+G3 X53.799 Y20.977 I1 J0 E.05
+G1 X51.571 Y24.245 E0.05483
+G1 X49.688 Y20.372 E0.04940
+;_EXTRUDE_END
+G1 E-.8 F2100
+G1 X49.688 Y20.372 F12000
+@@LAYER 17 1
+G1 Z3.600 F720
+;_SET_FAN_SPEED_CHANGING_LAYER
+G1 X49.688 Y20.372 F9000
+G1 F7200 ;_EXTRUDE_SET_SPEED;_EXTERNAL_PERIMETER
+G3 X51.688 Y20.372 I1 J0 E.05
+G1 X47.131 Y20.423 E0.13279
+G1 X48.974 Y19.101 E0.12367
+G1 X50.674 Y23.356 E0.14185
+G1 X52.716 Y20.662 E0.12321
+G1 X48.326 Y23.205 E0.04613
+G1 X48.563 Y25.427 E0.15329
+G1 X52.959 Y24.857 E0.11372
+G1 X51.197 Y26.997 E0.19131
+;_EXTRUDE_END
+G1 X52.197 Y27.997 F3000 ;_WIPE
+G1 E-.8 F2100
+G1 X52.197 Y27.997 F12000
+G1 X52.197 Y27.997 F9000
+;_OVERHANG_FAN_START
+G1 F3000 ;_EXTRUDE_SET_SPEED
+G1 X55.481 Y23.643 E0.08584
+G1 X59.942 Y26.204 E0.06739
+;_OVERHANG_FAN_END
+;_EXTRUDE_END
+G1 E-.8 F2100
+G1 X59.942 Y26.204 F12000
+G1 X59.942 Y26.204 F9000
+G1 F7200 ;_EXTRUDE_SET_SPEED
+G1 X58.174 Y28.902 E0.11791
+G2 X60.174 Y28.902 I1 J0 E.05
+G1 X60.658 Y26.436 E0.19442
+G1 X62.352 Y25.870 E0.01425
+G1 X66.558 Y23.203 E0.08345
+G1 X65.921 Y21.349 E0.15846
+G1 X63.790 Y18.698 E0.18296
+G1 X68.720 Y14.741 E0.11222
+G1 X69.035 Y16.041 E0.00965
+G1 X72.682 Y12.052 E0.06082
+G2 X74.682 Y12.052 I1 J0 E.05
+;_EXTRUDE_END
+G4 P500
+G1 E-.8 F2100
+G1 X74.682 Y12.052 F12000
+G1 X74.682 Y12.052 F9000
+G92 E0
+G1 F7200 ;_EXTRUDE_SET_SPEED
+G2 X76.682 Y12.052 I1 J0 E.05
+G3 X78.682 Y12.052 I1 J0 E.05
+G1 X75.069 Y14.251 E0.12596
+G1 X79.704 Y17.910 E0.05633
+G1 X84.339 Y12.984 E0.09651
+G1 X89.253 Y8.972 E0.10458
+G3 X91.253 Y8.972 I1 J0 E.05
+G2 X93.253 Y8.972 I1 J0 E.05
+G1 X93.328 Y7.867 E0.03922
+G1 X93.066 Y8.077 E0.04118
+G1 X88.305 Y9.253 E0.08326
+G1 X87.989 Y9.862 E0.17959
+;_EXTRUDE_END
+G1 E-.8 F2100
+G1 X87.989 Y9.862 F12000
+@@LAYER 18 1
+G1 Z3.800 F720
+;_SET_FAN_SPEED_CHANGING_LAYER
+G1 X87.989 Y9.862 F9000
+G92 E0
+G1 F6000 ;_EXTRUDE_SET_SPEED
+G1 X89.704 Y9.544 E0.01164
+G1 X87.030 Y9.718 E0.17426
+G1 X85.544 Y11.579 E0.15523
+G1 X82.773 Y16.032 E0.19373
+G1 X83.507 Y19.670 E0.08950
+G1 X82.135 Y15.819 E0.09424
+G3 X84.135 Y15.819 I1 J0 E.05
+G1 X88.379 Y19.190 E0.18697
+G1 X84.112 Y16.986 E0.13148
+G1 X85.921 Y12.376 E0.07018
+G1 X82.633 Y9.627 E0.10372
+G1 X80.303 Y8.747 E0.18950
+;_EXTRUDE_END
+G1 E-.8 F2100
+G1 X80.303 Y8.747 F12000
+T1
+;_FORCE_RESUME_FAN_SPEED
+G1 X80.303 Y8.747 F9000
+G92 E0
+;_OVERHANG_FAN_START
+G1 F7200 ;_EXTRUDE_SET_SPEED
+G1 X79.583 Y5.691 E0.04467
+G2 X81.583 Y5.691 I1 J0 E.05
+G1 X79.730 Y2.964 E0.03223
+G1 X83.119 Y1.072 E0.06615
+G1 X87.063 Y5.007 E0.15176
+G1 X82.934 Y4.979 E0.19320
+G2 X84.934 Y4.979 I1 J0 E.05
+G1 X84.966 Y4.857 E0.13644
+G1 X89.434 Y4.244 E0.15855
+G1 X90.652 Y5.138 E0.15816
+G1 X87.586 Y4.305 E0.03222
+;_OVERHANG_FAN_END
+;_EXTRUDE_END
+G1 X88.586 Y5.305 F3000 ;_WIPE
+G1 E-.8 F2100
+G1 X88.586 Y5.305 F12000
+T9
+G1 X88.586 Y5.305 F9000
+G92 E0
+G1 F7200 ;_EXTRUDE_SET_SPEED
+G1 X92.662 Y7.315 E0.04463
+G1 X89.498 Y8.123 E0.12916
+G1 X93.388 Y9.223 E0.14229
+G3 X95.388 Y9.223 I1 J0 E.05
+G1 X96.569 Y11.592 E0.06512
+G1 X94.873 Y16.375 E0.13185
+G1 X95.493 Y17.932 E0.05316
+G2 X97.493 Y17.932 I1 J0 E.05
+G2 X99.493 Y17.932 I1 J0 E.05
+G1 X104.272 Y19.141 E0.17075
+G1 X104.237 Y18.358 E0.09477
+;_EXTRUDE_END
+G1 E-.8 F2100
+G1 X104.237 Y18.358 F12000
+T0
+;_FORCE_RESUME_FAN_SPEED
+G1 X104.237 Y18.358 F9000
+G1 F1800 ;_EXTRUDE_SET_SPEED
+G2 X106.237 Y18.358 I1 J0 E.05
+G1 X102.525 Y21.513 E0.14984
+G1 X101.396 Y17.830 E0.15215
+G1 X103.077 Y19.794 E0.05539
+G2 X105.077 Y19.794 I1 J0 E.05
+G1 X109.921 Y17.079 E0.14649
+G1 X110.724 Y15.101 E0.04685
+G1 X111.798 Y19.197 E0.12119
+;_EXTRUDE_END
+G1 E-.8 F2100
+G1 X111.798 Y19.197 F12000
+@@LAYER 19 0
+G1 Z4.000 F720
+;_SET_FAN_SPEED_CHANGING_LAYER
+G1 X111.798 Y19.197 F9000
+G92 E0
+G1 F6000 ;_EXTRUDE_SET_SPEED
+G1 X113.360 Y19.099 E0.16346
+G1 X111.871 Y21.611 E0.13618
+G1 X115.765 Y16.874 E0.10774
+G1 X119.555 Y13.805 E0.16165
+G1 X123.907 Y12.087 E0.13322
+G1 X128.812 Y10.479 E0.07854
+G2 X130.812 Y10.479 I1 J0 E.05
+G2 X132.812 Y10.479 I1 J0 E.05
+G3 X134.812 Y10.479 I1 J0 E.05
+G1 X138.172 Y9.301 E0.12016
+;_EXTRUDE_END
+G1 X139.172 Y10.301 F3000 ;_WIPE
+G1 E-.8 F2100
+G1 X139.172 Y10.301 F12000
+G1 X139.172 Y10.301 F9000
+;_OVERHANG_FAN_START
+G1 F7200 ;_EXTRUDE_SET_SPEED
+G1 X137.382 Y6.570 E0.12091
+G3 X139.382 Y6.570 I1 J0 E.05
+G1 X134.861 Y1.583 E0.07544
+G1 X134.796 Y-2.683 E0.11237
+;_OVERHANG_FAN_END
+;_EXTRUDE_END
+G1 E-.8 F2100
+G1 X134.796 Y-2.683 F12000
+G1 X134.796 Y-2.683 F9000
+G1 F1800 ;_EXTRUDE_SET_SPEED
+G1 X138.772 Y0.802 E0.10789
+G1 X138.388 Y-3.941 E0.04811
+;_EXTRUDE_END
+G4 S1
+G1 E-.8 F2100
+G1 X138.388 Y-3.941 F12000
+T1
+;_FORCE_RESUME_FAN_SPEED
+G1 X138.388 Y-3.941 F9000
+G92 E0
+G1 F3000 ;_EXTRUDE_SET_SPEED
+G1 X143.171 Y-7.173 E0.04018
+G1 X142.040 Y-7.433 E0.13711
+G1 X142.984 Y-10.392 E0.04505
+G1 X142.261 Y-6.447 E0.02949
+;_EXTRUDE_END
+G1 E-.8 F2100
+G1 X142.261 Y-6.447 F12000
+@@LAYER 20 1
+G1 Z4.200 F720
+;_SET_FAN_SPEED_CHANGING_LAYER
+G1 X142.261 Y-6.447 F9000
+G92 E0
+G1 F6000 ;_EXTRUDE_SET_SPEED
+G1 X144.506 Y-6.547 E0.16141
+G3 X146.506 Y-6.547 I1 J0 E.05
+G1 X149.506 Y-1.818 E0.18172
+;_EXTRUDE_END
+G1 E-.8 F2100
+G1 X149.506 Y-1.818 F12000
+G1 X149.506 Y-1.818 F9000
+G92 E0
+G1 F3000 ;_EXTRUDE_SET_SPEED
+G1 X149.224 Y2.028 E0.09336
+G1 X146.812 Y4.603 E0.07419
+G1 X148.886 Y3.892 E0.00719
+G1 X148.059 Y2.595 E0.11695
+G3 X150.059 Y2.595 I1 J0 E.05
+G1 X150.831 Y0.830 E0.10220
+G1 X147.070 Y-0.754 E0.15731
+G1 X145.954 Y1.941 E0.01682
+G1 X149.275 Y2.791 E0.16519
+G1 X148.539 Y0.334 E0.16639
+G1 X147.164 Y-0.381 E0.07442
+;_EXTRUDE_END
+G1 E-.8 F2100
+G1 X147.164 Y-0.381 F12000
+@@LAYER 21 1
+G1 Z4.400 F720
+;_SET_FAN_SPEED_CHANGING_LAYER
+G1 X147.164 Y-0.381 F9000
+G92 E0
+;_OVERHANG_FAN_START
+G1 F1800 ;_EXTRUDE_SET_SPEED
+G1 X147.734 Y0.668 E0.05277
+G1 X151.010 Y1.997 E0.02449
+G1 X155.891 Y1.423 E0.04974
+;_OVERHANG_FAN_END
+;_EXTRUDE_END
+G1 E-.8 F2100
+G1 X155.891 Y1.423 F12000
+@@LAYER 22 0
+G1 Z4.600 F720
+;_SET_FAN_SPEED_CHANGING_LAYER
+G1 X155.891 Y1.423 F9000
+G1 F6000 ;_EXTRUDE_SET_SPEED;_EXTERNAL_PERIMETER
+G1 X154.736 Y-2.226 E0.13902
+G3 X156.736 Y-2.226 I1 J0 E.05
+G1 X155.656 Y-6.577 E0.13163
+G1 X159.644 Y-5.605 E0.07755
+G1 X160.199 Y-8.840 E0.10853
+G1 X157.173 Y-9.412 E0.16739
+G1 X155.463 Y-12.026 E0.12643
+;_EXTRUDE_END
+G1 E-.8 F2100
+G1 X155.463 Y-12.026 F12000
+G1 X155.463 Y-12.026 F9000
+G1 F6000 ;_EXTRUDE_SET_SPEED
+G1 X152.284 Y-7.953 E0.14075
+G1 X151.504 Y-6.567 E0.14356
+G1 X150.643 Y-6.298 E0.17341
+G1 X153.524 Y-5.393 E0.00126
+;_EXTRUDE_END
+G1 X154.524 Y-4.393 F3000 ;_WIPE
+G1 E-.8 F2100
+G1 X154.524 Y-4.393 F12000
+G1 X154.524 Y-4.393 F9000
+G1 F1800 ;_EXTRUDE_SET_SPEED
+G1 X152.070 Y-0.967 E0.18027
+G1 X151.620 Y-2.633 E0.03265
+G1 X154.549 Y-5.455 E0.16967
+;_EXTRUDE_END
+G1 E-.8 F2100
+G1 X154.549 Y-5.455 F12000
+@@LAYER 23 1
+G1 Z4.800 F720
+;_SET_FAN_SPEED_CHANGING_LAYER
+G1 X154.549 Y-5.455 F9000
+G92 E0
+G1 F3000 ;_EXTRUDE_SET_SPEED
+G3 X156.549 Y-5.455 I1 J0 E.05
+G1 X156.178 Y-8.128 E0.15288
+;_EXTRUDE_END
+G1 E-.8 F2100
+G1 X156.178 Y-8.128 F12000
+G1 X156.178 Y-8.128 F9000
+G1 F3000 ;_EXTRUDE_SET_SPEED
+G1 X159.375 Y-9.680 E0.17791
+;_EXTRUDE_END
+G1 E-.8 F2100
+G1 X159.375 Y-9.680 F12000
+G1 X159.375 Y-9.680 F9000
+G1 F7200 ;_EXTRUDE_SET_SPEED
+G1 X158.729 Y-12.540 E0.07082
+G1 X162.281 Y-8.346 E0.04096
+G1 X158.031 Y-3.876 E0.12830
+G1 X161.429 Y-7.468 E0.05382
+;_EXTRUDE_END
+G1 E-.8 F2100
+G1 X161.429 Y-7.468 F12000
+@@LAYER 24 1
+G1 Z5.000 F720
+;_SET_FAN_SPEED_CHANGING_LAYER
+G1 X161.429 Y-7.468 F9000
+G92 E0
+;_OVERHANG_FAN_START
+G1 F6000 ;_EXTRUDE_SET_SPEED
+G3 X163.429 Y-7.468 I1 J0 E.05
+G3 X165.429 Y-7.468 I1 J0 E.05
+G1 X162.830 Y-3.649 E0.17039
+;_OVERHANG_FAN_END
+;_EXTRUDE_END
+G1 X163.830 Y-2.649 F3000 ;_WIPE
+G1 E-.8 F2100
+G1 X163.830 Y-2.649 F12000
+T0
+;_FORCE_RESUME_FAN_SPEED
+G1 X163.830 Y-2.649 F9000
+;_OVERHANG_FAN_START
+G1 F6000 ;_EXTRUDE_SET_SPEED;_EXTERNAL_PERIMETER
+G1 X168.444 Y-0.948 E0.05570
+G1 X166.832 Y2.751 E0.08532
+G1 X169.340 Y4.777 E0.15077
+G1 X165.858 Y3.462 E0.19176
+G3 X167.858 Y3.462 I1 J0 E.05
+G1 X171.692 Y-0.723 E0.00582
+G1 X167.509 Y-5.305 E0.11979
+;_OVERHANG_FAN_END
+;_EXTRUDE_END
+G1 E-.8 F2100
+G1 X167.509 Y-5.305 F12000
+G1 X167.509 Y-5.305 F9000
+G1 F1800 ;_EXTRUDE_SET_SPEED;_EXTERNAL_PERIMETER
+G1 X170.340 Y-5.229 E0.15000
+G1 X166.795 Y-2.004 E0.04104
+G3 X168.795 Y-2.004 I1 J0 E.05
+;_EXTRUDE_END
+G1 E-.8 F2100
+G1 X168.795 Y-2.004 F12000
+T1
+;_FORCE_RESUME_FAN_SPEED
+G1 X168.795 Y-2.004 F9000
+G92 E0
+G1 F6000 ;_EXTRUDE_SET_SPEED;_EXTERNAL_PERIMETER
+G1 X171.081 Y0.043 E0.04915
+G1 X172.044 Y0.812 E0.15818
+G1 X173.989 Y-1.986 E0.18530
+G1 X177.103 Y-5.570 E0.14542
+;_EXTRUDE_END
+G1 E-.8 F2100
+G1 X177.103 Y-5.570 F12000
+G1 X177.103 Y-5.570 F9000
+G1 F3000 ;_EXTRUDE_SET_SPEED;_EXTERNAL_PERIMETER
+G1 X177.025 Y-6.010 E0.12651
+G1 X176.908 Y-1.976 E0.17747
+G1 X179.163 Y0.212 E0.04028
+G1 X176.829 Y-2.740 E0.19005
+G1 X179.979 Y0.599 E0.08154
+G2 X181.979 Y0.599 I1 J0 E.05
+G2 X183.979 Y0.599 I1 J0 E.05
+G1 X182.528 Y1.594 E0.03343
+G1 X185.345 Y4.420 E0.11302
+G1 X180.366 Y2.084 E0.08189
+;_EXTRUDE_END
+G1 X181.366 Y3.084 F3000 ;_WIPE
+G1 E-.8 F2100
+G1 X181.366 Y3.084 F12000
+@@LAYER 25 0
+G1 Z5.200 F720
+;_SET_FAN_SPEED_CHANGING_LAYER
+G1 X181.366 Y3.084 F9000
+;_OVERHANG_FAN_START
+G1 F3000 ;_EXTRUDE_SET_SPEED
+G1 X184.160 Y2.716 E0.03695
+G1 X185.213 Y-2.185 E0.05665
+G1 X183.288 Y-2.835 E0.02009
+G1 X186.009 Y-2.365 E0.07088
+G1 X181.942 Y-5.906 E0.19126
+G1 X186.161 Y-8.751 E0.00999
+G1 X186.200 Y-4.879 E0.15172
+;_OVERHANG_FAN_END
+;_EXTRUDE_END
+G1 X187.200 Y-3.879 F3000 ;_WIPE
+G1 E-.8 F2100
+G1 X187.200 Y-3.879 F12000
+G1 X187.200 Y-3.879 F9000
+G92 E0
+;_OVERHANG_FAN_START
+G1 F6000 ;_EXTRUDE_SET_SPEED
+G1 X188.680 Y-8.589 E0.07507
+;_OVERHANG_FAN_END
+;_EXTRUDE_END
+G1 E-.8 F2100
+G1 X188.680 Y-8.589 F12000
+G1 X188.680 Y-8.589 F9000
+G1 F6000 ;_EXTRUDE_SET_SPEED
+G1 X193.058 Y-7.373 E0.04031
+G1 X191.313 Y-7.580 E0.12341
+G1 X193.200 Y-7.494 E0.16239
+;_EXTRUDE_END
+G1 E-.8 F2100
+G1 X193.200 Y-7.494 F12000
+G1 X193.200 Y-7.494 F9000
+G1 F6000 ;_EXTRUDE_SET_SPEED;_EXTERNAL_PERIMETER
+G1 X191.880 Y-7.926 E0.13997
+G1 X190.929 Y-7.120 E0.05582
+G1 X190.169 Y-5.066 E0.07028
+G1 X187.131 Y-5.214 E0.09897
+G2 X189.131 Y-5.214 I1 J0 E.05
+G1 X190.496 Y-0.338 E0.08084
+G3 X192.496 Y-0.338 I1 J0 E.05
+G1 X189.007 Y-3.951 E0.15873
+G1 X187.174 Y-7.567 E0.18186
+G1 X184.529 Y-6.623 E0.14092
+;_EXTRUDE_END
+G1 X185.529 Y-5.623 F3000 ;_WIPE
+G1 E-.8 F2100
+G1 X185.529 Y-5.623 F12000
+G1 X185.529 Y-5.623 F9000
+G1 F6000 ;_EXTRUDE_SET_SPEED
+G1 X189.880 Y-8.669 E0.18738
+;_EXTRUDE_END
+G1 X190.880 Y-7.669 F3000 ;_WIPE
+G1 E-.8 F2100
+G1 X190.880 Y-7.669 F12000
+G1 X190.880 Y-7.669 F9000
+G1 F1800 ;_EXTRUDE_SET_SPEED
+G1 X191.191 Y-10.693 E0.16640
+G1 X193.613 Y-7.272 E0.10430
+G1 X193.247 Y-9.895 E0.16002
+G1 X188.594 Y-14.565 E0.09450
+G3 X190.594 Y-14.565 I1 J0 E.05
+G2 X192.594 Y-14.565 I1 J0 E.05
+G1 X189.488 Y-17.030 E0.03647
+G1 X194.445 Y-16.576 E0.18813
+G1 X194.033 Y-14.005 E0.04373
+;_EXTRUDE_END
+G1 E-.8 F2100
+G1 X194.033 Y-14.005 F12000
+@@LAYER 26 1
+G1 Z5.400 F720
+;_SET_FAN_SPEED_CHANGING_LAYER
+G1 X194.033 Y-14.005 F9000
+G1 F3000 ;_EXTRUDE_SET_SPEED
+G1 X191.958 Y-16.357 E0.05092
+G1 X193.422 Y-11.987 E0.11831
+G1 X197.266 Y-15.601 E0.11822
+G1 X195.597 Y-19.079 E0.02364
+G2 X197.597 Y-19.079 I1 J0 E.05
+G1 X200.802 Y-15.726 E0.00617
+G1 X198.441 Y-18.087 E0.00673
+G1 X196.839 Y-18.562 E0.10668
+;_EXTRUDE_END
+G1 E-.8 F2100
+G1 X196.839 Y-18.562 F12000
+G1 X196.839 Y-18.562 F9000
+G1 F3000 ;_EXTRUDE_SET_SPEED
+G1 X201.189 Y-21.750 E0.05634
+G1 X203.997 Y-19.148 E0.10902
+G1 X200.809 Y-23.460 E0.14024
+G1 X196.204 Y-19.797 E0.17840
+G3 X198.204 Y-19.797 I1 J0 E.05
+G2 X200.204 Y-19.797 I1 J0 E.05
+G1 X195.734 Y-21.346 E0.17731
+G1 X194.806 Y-25.044 E0.05836
+G1 X198.956 Y-23.420 E0.19373
+G1 X194.646 Y-25.010 E0.07391
+;_EXTRUDE_END
+G1 X195.646 Y-24.010 F3000 ;_WIPE
+G1 E-.8 F2100
+G1 X195.646 Y-24.010 F12000
+G1 X195.646 Y-24.010 F9000
+G92 E0
+G1 F6000 ;_EXTRUDE_SET_SPEED;_EXTERNAL_PERIMETER
+G1 X192.730 Y-28.698 E0.09292
+G1 X188.442 Y-28.784 E0.02731
+G1 X192.485 Y-25.035 E0.10719
+G2 X194.485 Y-25.035 I1 J0 E.05
+G1 X191.203 Y-20.798 E0.15114
+G1 X188.274 Y-18.864 E0.03723
+G1 X185.880 Y-15.894 E0.07766
+G1 X186.165 Y-12.272 E0.14635
+;_EXTRUDE_END
+G1 X187.165 Y-11.272 F3000 ;_WIPE
+G4 S1
+G1 E-.8 F2100
+G1 X187.165 Y-11.272 F12000
+G1 X187.165 Y-11.272 F9000
+;_OVERHANG_FAN_START
+G1 F3000 ;_EXTRUDE_SET_SPEED;_EXTERNAL_PERIMETER
+G2 X189.165 Y-11.272 I1 J0 E.05
+G1 X186.324 Y-12.281 E0.16841
+G1 X190.350 Y-11.824 E0.06761
+G1 X185.935 Y-10.000 E0.16794
+G1 X189.239 Y-8.529 E0.16102
+G1 X189.860 Y-11.898 E0.18733
+G1 X186.623 Y-7.056 E0.12443
+G1 X190.080 Y-5.794 E0.12486
+G1 X188.239 Y-8.017 E0.11448
+G1 X190.227 Y-8.247 E0.04086
+;_OVERHANG_FAN_END
+;_EXTRUDE_END
+G1 X191.227 Y-7.247 F3000 ;_WIPE
+G1 E-.8 F2100
+G1 X191.227 Y-7.247 F12000
+G1 X191.227 Y-7.247 F9000
+G1 F6000 ;_EXTRUDE_SET_SPEED
+G1 X195.262 Y-9.661 E0.12505
+G1 X190.784 Y-8.999 E0.15963
+G1 X189.970 Y-5.013 E0.00856
+;_EXTRUDE_END
+G1 E-.8 F2100
+G1 X189.970 Y-5.013 F12000
+G1 X189.970 Y-5.013 F9000
+G1 F3000 ;_EXTRUDE_SET_SPEED;_EXTERNAL_PERIMETER
+G1 X192.730 Y-5.276 E0.16798
+G2 X194.730 Y-5.276 I1 J0 E.05
+G1 X193.852 Y-8.811 E0.19244
+G2 X195.852 Y-8.811 I1 J0 E.05
+;_EXTRUDE_END
+G1 E-.8 F2100
+G1 X195.852 Y-8.811 F12000
+@@LAYER 27 1
+G1 Z5.600 F720
+;_SET_FAN_SPEED_CHANGING_LAYER
+G1 X195.852 Y-8.811 F9000
+G92 E0
+;_OVERHANG_FAN_START
+G1 F6000 ;_EXTRUDE_SET_SPEED
+G1 X192.624 Y-8.443 E0.07220
+;_OVERHANG_FAN_END
+;_EXTRUDE_END
+G1 E-.8 F2100
+G1 X192.624 Y-8.443 F12000
+G1 X192.624 Y-8.443 F9000
+G1 F7200 ;_EXTRUDE_SET_SPEED;_EXTERNAL_PERIMETER
+G1 X194.488 Y-4.045 E0.13128
+G1 X191.216 Y-6.114 E0.11785
+G1 X191.795 Y-3.328 E0.07808
+G1 X195.232 Y-2.845 E0.04674
+;_EXTRUDE_END
+G1 E-.8 F2100
+G1 X195.232 Y-2.845 F12000
+T0
+;_FORCE_RESUME_FAN_SPEED
+G1 X195.232 Y-2.845 F9000
+;_OVERHANG_FAN_START
+G1 F1800 ;_EXTRUDE_SET_SPEED
+G1 X198.846 Y1.926 E0.09376
+G1 X202.105 Y-2.310 E0.01675
+G1 X204.413 Y-7.035 E0.08964
+G1 X200.423 Y-3.757 E0.17663
+G1 X197.649 Y-6.578 E0.14823
+G3 X199.649 Y-6.578 I1 J0 E.05
+G1 X204.445 Y-1.645 E0.16113
+G1 X208.376 Y2.100 E0.10137
+G2 X210.376 Y2.100 I1 J0 E.05
+G1 X205.483 Y4.846 E0.15079
+;_OVERHANG_FAN_END
+;_EXTRUDE_END
+G1 E-.8 F2100
+G1 X205.483 Y4.846 F12000
+@@LAYER 28 0
+G1 Z5.800 F720
+;_SET_FAN_SPEED_CHANGING_LAYER
+G1 X205.483 Y4.846 F9000
+G1 F3000 ;_EXTRUDE_SET_SPEED
+G1 X206.656 Y9.229 E0.00505
+G2 X208.656 Y9.229 I1 J0 E.05
+G1 X207.854 Y12.161 E0.08933
+G3 X209.854 Y12.161 I1 J0 E.05
+G1 X214.238 Y8.926 E0.17875
+G1 X209.741 Y9.513 E0.13928
+G3 X211.741 Y9.513 I1 J0 E.05
+;_EXTRUDE_END
+G1 E-.8 F2100
+G1 X211.741 Y9.513 F12000
+G1 X211.741 Y9.513 F9000
+G1 F6000 ;_EXTRUDE_SET_SPEED
+G1 X207.810 Y5.464 E0.12626
+G2 X209.810 Y5.464 I1 J0 E.05
+G2 X211.810 Y5.464 I1 J0 E.05
+G1 X211.631 Y6.627 E0.04016
+G1 X216.360 Y3.122 E0.04448
+G1 X212.427 Y-1.756 E0.19178
+G1 X207.818 Y1.577 E0.11622
+G1 X211.644 Y-2.261 E0.12840
+G1 X213.631 Y-4.893 E0.03073
+G1 X211.569 Y-3.839 E0.14816
+G3 X213.569 Y-3.839 I1 J0 E.05
+G1 X212.601 Y-3.091 E0.06658
+;_EXTRUDE_END
+G1 E-.8 F2100
+G1 X212.601 Y-3.091 F12000
+@@LAYER 29 1
+G1 Z6.000 F720
+;_SET_FAN_SPEED_CHANGING_LAYER
+G1 X212.601 Y-3.091 F9000
+;_OVERHANG_FAN_START
+G1 F7200 ;_EXTRUDE_SET_SPEED
+G1 X207.986 Y1.120 E0.16705
+G1 X207.519 Y-3.490 E0.15875
+G1 X208.482 Y1.294 E0.09498
+G1 X211.918 Y5.551 E0.09245
+G1 X207.267 Y10.064 E0.01852
+G1 X208.294 Y6.806 E0.07073
+G1 X203.386 Y5.806 E0.07694
+G1 X205.381 Y10.285 E0.17432
+G1 X206.491 Y12.213 E0.15798
+G3 X208.491 Y12.213 I1 J0 E.05
+G1 X206.843 Y11.873 E0.14792
+;_OVERHANG_FAN_END
+;_EXTRUDE_END
+G1 E-.8 F2100
+G1 X206.843 Y11.873 F12000
+G1 X206.843 Y11.873 F9000
+G1 F6000 ;_EXTRUDE_SET_SPEED
+G3 X208.843 Y11.873 I1 J0 E.05
+G1 X213.726 Y7.179 E0.16773
+;_EXTRUDE_END
+G1 E-.8 F2100
+G1 X213.726 Y7.179 F12000
+G1 X213.726 Y7.179 F9000
+G92 E0
+G1 F3000 ;_EXTRUDE_SET_SPEED
+G1 X212.464 Y4.532 E0.07099
+G1 X208.529 Y0.447 E0.14042
+G1 X211.800 Y-1.915 E0.07018
+G1 X209.895 Y-4.924 E0.18045
+G1 X211.552 Y-0.393 E0.18948
+G2 X213.552 Y-0.393 I1 J0 E.05
+G1 X213.062 Y3.066 E0.07786
+G1 X216.102 Y6.385 E0.04770
+G1 X215.772 Y7.256 E0.01818
+G1 X213.228 Y10.098 E0.15686
+;_EXTRUDE_END
+G1 E-.8 F2100
+G1 X213.228 Y10.098 F12000
+@@LAYER 30 1
+G1 Z6.200 F720
+;_SET_FAN_SPEED_CHANGING_LAYER
+G1 X213.228 Y10.098 F9000
+G1 F7200 ;_EXTRUDE_SET_SPEED;_EXTERNAL_PERIMETER
+G1 X214.259 Y11.141 E0.18130
+G1 X217.865 Y8.741 E0.01610
+G1 X218.014 Y11.765 E0.11646
+G1 X214.906 Y10.557 E0.11519
+G1 X216.867 Y10.619 E0.02104
+G1 X219.811 Y6.332 E0.16281
+G2 X221.811 Y6.332 I1 J0 E.05
+G1 X219.784 Y2.228 E0.05227
+;_EXTRUDE_END
+G1 E-.8 F2100
+G1 X219.784 Y2.228 F12000
+T1
+;_FORCE_RESUME_FAN_SPEED
+G1 X219.784 Y2.228 F9000
+;_OVERHANG_FAN_START
+G1 F1800 ;_EXTRUDE_SET_SPEED;_EXTERNAL_PERIMETER
+G1 X215.161 Y6.986 E0.07260
+;_OVERHANG_FAN_END
+;_EXTRUDE_END
+G1 E-.8 F2100
+G1 X215.161 Y6.986 F12000
+G1 X215.161 Y6.986 F9000
+G92 E0
+G1 F7200 ;_EXTRUDE_SET_SPEED
+G1 X218.901 Y9.408 E0.11401
+G1 X221.940 Y10.481 E0.00599
+;_EXTRUDE_END
+G1 E-.8 F2100
+G1 X221.940 Y10.481 F12000
+@@LAYER 31 0
+G1 Z6.400 F720
+;_SET_FAN_SPEED_CHANGING_LAYER
+G1 X221.940 Y10.481 F9000
+G92 E0
+G1 F7200 ;_EXTRUDE_SET_SPEED;_EXTERNAL_PERIMETER
+G3 X223.940 Y10.481 I1 J0 E.05
+G1 X222.562 Y7.883 E0.02201
+G3 X224.562 Y7.883 I1 J0 E.05
+G1 X228.028 Y5.722 E0.06716
+G1 X225.064 Y6.890 E0.07971
+;_EXTRUDE_END
+G1 X226.064 Y7.890 F3000 ;_WIPE
+G1 E-.8 F2100
+G1 X226.064 Y7.890 F12000
+T0
+;_FORCE_RESUME_FAN_SPEED
+G1 X226.064 Y7.890 F9000
+G1 F6000 ;_EXTRUDE_SET_SPEED
+G1 X224.374 Y12.145 E0.05430
+G1 X221.739 Y10.543 E0.14876
+G1 X218.884 Y6.815 E0.17530
+G1 X218.985 Y10.188 E0.09767
+;_EXTRUDE_END
+G1 E-.8 F2100
+G1 X218.985 Y10.188 F12000
+@@LAYER 32 1
+G1 Z6.600 F720
+;_SET_FAN_SPEED_CHANGING_LAYER
+G1 X218.985 Y10.188 F9000
+G1 F6000 ;_EXTRUDE_SET_SPEED
+G1 X222.623 Y10.328 E0.13227
+G1 X224.124 Y15.088 E0.05130
+G1 X226.633 Y15.794 E0.11891
+G1 X221.801 Y11.106 E0.17830
+G1 X222.818 Y10.531 E0.17586
+G1 X221.559 Y11.918 E0.04364
+G1 X218.160 Y16.035 E0.10769
+G3 X220.160 Y16.035 I1 J0 E.05
+G1 X221.944 Y13.633 E0.02764
+;_EXTRUDE_END
+G1 E-.8 F2100
+G1 X221.944 Y13.633 F12000
+G1 X221.944 Y13.633 F9000
+G92 E0
+G1 F1800 ;_EXTRUDE_SET_SPEED
+G1 X226.406 Y8.894 E0.14235
+G2 X228.406 Y8.894 I1 J0 E.05
+G1 X224.534 Y7.578 E0.13433
+G1 X223.690 Y3.739 E0.12558
+G1 X223.526 Y8.438 E0.07390
+G1 X218.826 Y4.767 E0.03965
+;_EXTRUDE_END
+G1 X219.826 Y5.767 F3000 ;_WIPE
+G1 E-.8 F2100
+G1 X219.826 Y5.767 F12000
+G1 X219.826 Y5.767 F9000
+G1 F1800 ;_EXTRUDE_SET_SPEED;_EXTERNAL_PERIMETER
+G1 X217.841 Y1.789 E0.19650
+G1 X215.397 Y0.239 E0.03394
+G1 X214.904 Y2.697 E0.08340
+G1 X217.337 Y-0.840 E0.16932
+G1 X217.987 Y-3.765 E0.03136
+G1 X219.730 Y-3.768 E0.10760
+G1 X215.788 Y-5.145 E0.09967
+G2 X217.788 Y-5.145 I1 J0 E.05
+G1 X221.021 Y-7.337 E0.11748
+G1 X218.350 Y-6.928 E0.05338
+G1 X215.701 Y-4.112 E0.03849
+G3 X217.701 Y-4.112 I1 J0 E.05
+;_EXTRUDE_END
+G1 E-.8 F2100
+G1 X217.701 Y-4.112 F12000
+T1
+;_FORCE_RESUME_FAN_SPEED
+G1 X217.701 Y-4.112 F9000
+G1 F1800 ;_EXTRUDE_SET_SPEED
+G3 X219.701 Y-4.112 I1 J0 E.05
+G1 X222.057 Y-4.097 E0.12305
+G1 X222.401 Y-3.993 E0.14522
+G1 X220.651 Y-7.257 E0.04220
+G1 X221.746 Y-12.007 E0.03159
+G1 X217.896 Y-10.438 E0.18172
+G1 X220.763 Y-9.779 E0.04302
+G1 X218.493 Y-5.308 E0.19133
+G1 X219.204 Y-8.517 E0.07644
+G1 X215.002 Y-12.323 E0.15080
+G1 X210.114 Y-7.596 E0.17023
+;_EXTRUDE_END
+G1 X211.114 Y-6.596 F3000 ;_WIPE
+G1 E-.8 F2100
+G1 X211.114 Y-6.596 F12000
+G1 X211.114 Y-6.596 F9000
+G1 F7200 ;_EXTRUDE_SET_SPEED
+G3 X213.114 Y-6.596 I1 J0 E.05
+G1 X212.513 Y-6.893 E0.10400
+G2 X214.513 Y-6.893 I1 J0 E.05
+G1 X215.357 Y-2.808 E0.12476
+G1 X219.190 Y-0.468 E0.09211
+G1 X223.653 Y-4.667 E0.19999
+G1 X227.447 Y-3.245 E0.15641
+;_EXTRUDE_END
+G1 E-.8 F2100
+G1 X227.447 Y-3.245 F12000
+@@LAYER 33 1
+G1 Z6.800 F720
+;_SET_FAN_SPEED_CHANGING_LAYER
+T0
+;_FORCE_RESUME_FAN_SPEED
+G1 X227.447 Y-3.245 F9000
+G1 F6000 ;_EXTRUDE_SET_SPEED;_EXTERNAL_PERIMETER
+G1 X224.214 Y0.720 E0.02347
+G1 X227.662 Y-3.034 E0.05434
+G1 X223.636 Y0.620 E0.14978
+G1 X226.411 Y-2.985 E0.16957
+G1 X225.247 Y0.156 E0.09197
+G2 X227.247 Y0.156 I1 J0 E.05
+G2 X229.247 Y0.156 I1 J0 E.05
+;_EXTRUDE_END
+G1 X230.247 Y1.156 F3000 ;_WIPE
+G1 E-.8 F2100
+G1 X230.247 Y1.156 F12000
+@@LAYER 34 0
+G1 Z7.000 F720
+;_SET_FAN_SPEED_CHANGING_LAYER
+G1 X230.247 Y1.156 F9000
+;_OVERHANG_FAN_START
+G1 F3000 ;_EXTRUDE_SET_SPEED
+G1 X225.675 Y3.685 E0.12295
+;_OVERHANG_FAN_END
+;_EXTRUDE_END
+G1 E-.8 F2100
+G1 X225.675 Y3.685 F12000
+T9
+G1 X225.675 Y3.685 F9000
+G92 E0
+G1 F6000 ;_EXTRUDE_SET_SPEED
+G1 X224.404 Y5.844 E0.17861
+G3 X226.404 Y5.844 I1 J0 E.05
+G1 X228.240 Y1.840 E0.11523
+G1 X225.194 Y0.556 E0.10469
+G1 X221.018 Y-1.587 E0.08338
+G1 X225.876 Y1.873 E0.17866
+G1 X225.996 Y3.061 E0.00675
+G1 X229.357 Y1.517 E0.12233
+G3 X231.357 Y1.517 I1 J0 E.05
+G1 X234.709 Y5.471 E0.06401
+;_EXTRUDE_END
+G4 P500
+G1 E-.8 F2100
+G1 X234.709 Y5.471 F12000
+G1 X234.709 Y5.471 F9000
+G1 F3000 ;_EXTRUDE_SET_SPEED
+G3 X236.709 Y5.471 I1 J0 E.05
+G1 X233.790 Y7.686 E0.16237
+G2 X235.790 Y7.686 I1 J0 E.05
+G2 X237.790 Y7.686 I1 J0 E.05
+G3 X239.790 Y7.686 I1 J0 E.05
+G1 X235.167 Y11.068 E0.15374
+G1 X232.596 Y15.301 E0.04488
+G1 X233.108 Y19.390 E0.10952
+;_EXTRUDE_END
+G1 E-.8 F2100
+G1 X233.108 Y19.390 F12000
+G1 X233.108 Y19.390 F9000
+;_OVERHANG_FAN_START
+G1 F3000 ;_EXTRUDE_SET_SPEED
+G3 X235.108 Y19.390 I1 J0 E.05
+G3 X237.108 Y19.390 I1 J0 E.05
+G2 X239.108 Y19.390 I1 J0 E.05
+G3 X241.108 Y19.390 I1 J0 E.05
+;_OVERHANG_FAN_END
+;_EXTRUDE_END
+G1 X242.108 Y20.390 F3000 ;_WIPE
+G1 E-.8 F2100
+G1 X242.108 Y20.390 F12000
+T1
+;_FORCE_RESUME_FAN_SPEED
+G1 X242.108 Y20.390 F9000
+G1 F1800 ;_EXTRUDE_SET_SPEED
+G1 X242.247 Y17.140 E0.14797
+G1 X246.649 Y13.382 E0.12003
+G1 X249.264 Y15.789 E0.07222
+G3 X251.264 Y15.789 I1 J0 E.05
+G1 X253.719 Y13.286 E0.15518
+G1 X249.877 Y8.433 E0.18244
+G1 X253.586 Y12.901 E0.08450
+G1 X249.315 Y8.670 E0.17027
+G1 X246.906 Y5.588 E0.01621
+G1 X244.627 Y1.127 E0.16486
+G1 X241.319 Y1.783 E0.07403
+G1 X240.903 Y2.193 E0.05410
+;_EXTRUDE_END
+G1 E-.8 F2100
+G1 X240.903 Y2.193 F12000
+G1 X240.903 Y2.193 F9000
+G1 F6000 ;_EXTRUDE_SET_SPEED
+G1 X245.682 Y6.956 E0.06388
+G1 X247.097 Y11.924 E0.13650
+G1 X247.424 Y16.603 E0.05062
+;_EXTRUDE_END
+G1 E-.8 F2100
+G1 X247.424 Y16.603 F12000
+@@LAYER 35 1
+G1 Z7.200 F720
+;_SET_FAN_SPEED_CHANGING_LAYER
+G1 X247.424 Y16.603 F9000
+G1 F6000 ;_EXTRUDE_SET_SPEED
+G1 X248.518 Y16.619 E0.12666
+G1 X245.920 Y20.764 E0.04318
+G1 X246.835 Y20.728 E0.01936
+G1 X249.498 Y17.103 E0.09684
+G2 X251.498 Y17.103 I1 J0 E.05
+G1 X248.444 Y21.795 E0.04826
+G3 X250.444 Y21.795 I1 J0 E.05
+G1 X254.747 Y26.176 E0.08043
+G1 X251.955 Y29.518 E0.02853
+G1 X248.873 Y31.909 E0.17372
+G1 X247.179 Y36.076 E0.02073
+G1 X245.359 Y40.155 E0.05207
+;_EXTRUDE_END
+G1 E-.8 F2100
+G1 X245.359 Y40.155 F12000
+T0
+;_FORCE_RESUME_FAN_SPEED
+G1 X245.359 Y40.155 F9000
+G92 E0
+G1 F7200 ;_EXTRUDE_SET_SPEED
+G1 X246.891 Y42.203 E0.06590
+G3 X248.891 Y42.203 I1 J0 E.05
+;_EXTRUDE_END
+G1 E-.8 F2100
+G1 X248.891 Y42.203 F12000
+@@LAYER 36 1
+G1 Z7.400 F720
+;_SET_FAN_SPEED_CHANGING_LAYER
+T1
+;_FORCE_RESUME_FAN_SPEED
+G1 X248.891 Y42.203 F9000
+G1 F6000 ;_EXTRUDE_SET_SPEED
+G1 X248.332 Y40.595 E0.00517
+G1 X252.221 Y39.660 E0.09071
+G1 X256.770 Y44.266 E0.14950
+G1 X255.391 Y42.662 E0.16055
+G1 X258.576 Y39.198 E0.04610
+G1 X256.978 Y40.141 E0.08605
+G1 X252.028 Y43.215 E0.18194
+;_EXTRUDE_END
+G1 E-.8 F2100
+G1 X252.028 Y43.215 F12000
+T0
+;_FORCE_RESUME_FAN_SPEED
+G1 X252.028 Y43.215 F9000
+G1 F6000 ;_EXTRUDE_SET_SPEED
+G1 X254.624 Y47.322 E0.14274
+G2 X256.624 Y47.322 I1 J0 E.05
+G1 X252.556 Y47.526 E0.16266
+G1 X253.258 Y46.525 E0.06936
+;_EXTRUDE_END
+G1 E-.8 F2100
+G1 X253.258 Y46.525 F12000
+G1 X253.258 Y46.525 F9000
+G1 F7200 ;_EXTRUDE_SET_SPEED;_EXTERNAL_PERIMETER
+G1 X256.291 Y48.603 E0.17681
+G1 X256.503 Y43.751 E0.08960
+G1 X255.942 Y45.066 E0.11615
+G1 X253.149 Y49.558 E0.06644
+;_EXTRUDE_END
+G1 X254.149 Y50.558 F3000 ;_WIPE
+G1 E-.8 F2100
+G1 X254.149 Y50.558 F12000
+@@LAYER 37 0
+G1 Z7.600 F720
+;_SET_FAN_SPEED_CHANGING_LAYER
+G1 X254.149 Y50.558 F9000
+G1 F7200 ;_EXTRUDE_SET_SPEED
+G2 X256.149 Y50.558 I1 J0 E.05
+G1 X251.792 Y49.753 E0.15879
+;_EXTRUDE_END
+G1 E-.8 F2100
+G1 X251.792 Y49.753 F12000
+G1 X251.792 Y49.753 F9000
+G92 E0
+G1 F6000 ;_EXTRUDE_SET_SPEED;_EXTERNAL_PERIMETER
+G3 X253.792 Y49.753 I1 J0 E.05
+G1 X256.210 Y54.732 E0.08343
+G1 X251.268 Y51.436 E0.15484
+G3 X253.268 Y51.436 I1 J0 E.05
+G1 X248.404 Y51.949 E0.16682
+G2 X250.404 Y51.949 I1 J0 E.05
+;_EXTRUDE_END
+G1 E-.8 F2100
+G1 X250.404 Y51.949 F12000
+G1 X250.404 Y51.949 F9000
+G1 F3000 ;_EXTRUDE_SET_SPEED
+G1 X254.339 Y49.810 E0.18871
+G1 X257.532 Y54.410 E0.13663
+G1 X253.649 Y56.667 E0.01834
+G1 X256.704 Y60.426 E0.14824
+G1 X257.724 Y60.317 E0.17544
+G1 X256.825 Y62.494 E0.15608
+G1 X255.530 Y64.155 E0.11453
+G3 X257.530 Y64.155 I1 J0 E.05
+G1 X255.492 Y60.068 E0.16133
+G1 X256.643 Y60.072 E0.02605
+G1 X254.404 Y57.570 E0.05871
+G1 X258.615 Y61.820 E0.12203
+;_EXTRUDE_END
+G1 X259.615 Y62.820 F3000 ;_WIPE
+G1 E-.8 F2100
+G1 X259.615 Y62.820 F12000
+G1 X259.615 Y62.820 F9000
+G1 F3000 ;_EXTRUDE_SET_SPEED
+G1 X263.338 Y61.523 E0.14932
+G1 X265.772 Y61.085 E0.19743
+G1 X265.263 Y60.986 E0.14530
+G1 X263.173 Y61.448 E0.17635
+G1 X264.180 Y61.145 E0.00121
+G3 X266.180 Y61.145 I1 J0 E.05
+G1 X267.164 Y58.657 E0.12250
+G1 X263.500 Y60.801 E0.08465
+G2 X265.500 Y60.801 I1 J0 E.05
+G1 X265.406 Y63.806 E0.03584
+;_EXTRUDE_END
+G1 E-.8 F2100
+G1 X265.406 Y63.806 F12000
+@@LAYER 38 1
+G1 Z7.800 F720
+;_SET_FAN_SPEED_CHANGING_LAYER
+G1 X265.406 Y63.806 F9000
+G92 E0
+G1 F1800 ;_EXTRUDE_SET_SPEED
+G1 X267.380 Y61.292 E0.18028
+G1 X264.755 Y56.339 E0.17929
+G1 X267.719 Y60.233 E0.16437
+G3 X269.719 Y60.233 I1 J0 E.05
+G1 X264.978 Y56.781 E0.16813
+G3 X266.978 Y56.781 I1 J0 E.05
+G1 X266.877 Y53.821 E0.16817
+;_EXTRUDE_END
+G1 X267.877 Y54.821 F3000 ;_WIPE
+G4 S1
+G1 E-.8 F2100
+G1 X267.877 Y54.821 F12000
+G1 X267.877 Y54.821 F9000
+;_OVERHANG_FAN_START
+G1 F7200 ;_EXTRUDE_SET_SPEED
+G1 X266.648 Y53.888 E0.17113
+G1 X264.150 Y54.337 E0.00990
+G1 X259.280 Y55.645 E0.07823
+G1 X259.342 Y52.311 E0.15161
+G1 X259.901 Y54.578 E0.08085
+G1 X255.395 Y52.667 E0.01546
+G1 X255.217 Y49.782 E0.07285
+G3 X257.217 Y49.782 I1 J0 E.05
+G1 X262.012 Y49.334 E0.14088
+G1 X258.463 Y45.472 E0.06595
+;_OVERHANG_FAN_END
+;_EXTRUDE_END
+G1 X259.463 Y46.472 F3000 ;_WIPE
+G4 S1
+G1 E-.8 F2100
+G1 X259.463 Y46.472 F12000
+T1
+;_FORCE_RESUME_FAN_SPEED
+G1 X259.463 Y46.472 F9000
+G1 F3000 ;_EXTRUDE_SET_SPEED;_EXTERNAL_PERIMETER
+G1 X261.395 Y49.776 E0.01059
+;_EXTRUDE_END
+G4 P500
+G1 E-.8 F2100
+G1 X261.395 Y49.776 F12000
+G1 X261.395 Y49.776 F9000
+G92 E0
+;_OVERHANG_FAN_START
+G1 F3000 ;_EXTRUDE_SET_SPEED;_EXTERNAL_PERIMETER
+G1 X261.484 Y45.579 E0.18890
+;_OVERHANG_FAN_END
+;_EXTRUDE_END
+G1 E-.8 F2100
+G1 X261.484 Y45.579 F12000
+@@LAYER 39 1
+G1 Z8.000 F720
+;_SET_FAN_SPEED_CHANGING_LAYER
+G1 X261.484 Y45.579 F9000
+G92 E0
+G1 F1800 ;_EXTRUDE_SET_SPEED
+G3 X263.484 Y45.579 I1 J0 E.05
+G1 X264.544 Y43.707 E0.03153
+G1 X267.064 Y41.511 E0.16577
+G1 X265.368 Y39.353 E0.03996
+G2 X267.368 Y39.353 I1 J0 E.05
+G2 X269.368 Y39.353 I1 J0 E.05
+G1 X274.115 Y34.873 E0.10987
+G1 X271.753 Y30.102 E0.18645
+;_EXTRUDE_END
+G1 E-.8 F2100
+G1 X271.753 Y30.102 F12000
+G1 X271.753 Y30.102 F9000
+G1 F1800 ;_EXTRUDE_SET_SPEED;_EXTERNAL_PERIMETER
+G1 X270.962 Y28.700 E0.18008
+G1 X269.060 Y30.151 E0.02845
+G1 X267.228 Y27.716 E0.02456
+G1 X267.241 Y25.009 E0.04904
+G2 X269.241 Y25.009 I1 J0 E.05
+G2 X271.241 Y25.009 I1 J0 E.05
+;_EXTRUDE_END
+G1 E-.8 F2100
+G1 X271.241 Y25.009 F12000
+G1 X271.241 Y25.009 F9000
+;_OVERHANG_FAN_START
+G1 F7200 ;_EXTRUDE_SET_SPEED;_EXTERNAL_PERIMETER
+G1 X273.244 Y28.977 E0.14949
+G2 X275.244 Y28.977 I1 J0 E.05
+G1 X276.221 Y24.388 E0.01706
+G2 X278.221 Y24.388 I1 J0 E.05
+G1 X274.235 Y27.737 E0.08232
+G3 X276.235 Y27.737 I1 J0 E.05
+G1 X273.381 Y24.846 E0.15780
+G2 X275.381 Y24.846 I1 J0 E.05
+G1 X274.790 Y25.387 E0.07473
+;_OVERHANG_FAN_END
+;_EXTRUDE_END
+G1 E-.8 F2100
+G1 X274.790 Y25.387 F12000
+G1 X274.790 Y25.387 F9000
+;_OVERHANG_FAN_START
+G1 F3000 ;_EXTRUDE_SET_SPEED
+G1 X274.188 Y24.761 E0.19265
+;_OVERHANG_FAN_END
+;_EXTRUDE_END
+G1 E-.8 F2100
+G1 X274.188 Y24.761 F12000
+G1 X274.188 Y24.761 F9000
+G1 F3000 ;_EXTRUDE_SET_SPEED;_EXTERNAL_PERIMETER
+G1 X278.452 Y21.370 E0.19875
+G1 X281.049 Y21.046 E0.09495
+G1 X276.381 Y21.253 E0.05146
+G1 X277.697 Y19.067 E0.16759
+G1 X279.049 Y21.437 E0.14627
+G1 X282.730 Y23.860 E0.15205
+G1 X280.072 Y28.670 E0.14568
+G1 X277.916 Y26.739 E0.17631
+G1 X279.901 Y23.226 E0.05836
+G1 X274.990 Y21.602 E0.11372
+G1 X276.887 Y25.524 E0.04203
+G1 X274.073 Y23.042 E0.13191
+;_EXTRUDE_END
+G1 X275.073 Y24.042 F3000 ;_WIPE
+G4 S1
+G1 E-.8 F2100
+G1 X275.073 Y24.042 F12000
+@@LAYER 40 1
+G1 X1 Y1 F3000
@@ -0,0 +1,99 @@
+#include <catch2/catch.hpp>
+
+#include <iterator>
+#include <tuple>
+
+#include "libslic3r/GCode.hpp"
+#include "libslic3r/GCode/CoolingBuffer.hpp"
+
+#include <boost/nowide/fstream.hpp>
+
+using namespace Slic3r;
+
+static std::string read_file(const std::string &path)
+{
+    boost::nowide::ifstream ifs(path, std::ios::binary);
+    return std::string((std::istreambuf_iterator<char>(ifs)), std::istreambuf_iterator<char>());
+}
+
+// Layers of G-code, each one starting with a "@@LAYER <layer_id> <flush>" line.
+static std::vector<std::tuple<size_t, bool, std::string>> read_layers(const std::string &path)
+{
+    std::vector<std::tuple<size_t, bool, std::string>> layers;
+    boost::nowide::ifstream ifs(path);
+    std::string line;
+    while (std::getline(ifs, line)) {
+        size_t layer_id = 0;
+        int    flush    = 0;
+        if (sscanf(line.c_str(), "@@LAYER %zu %d", &layer_id, &flush) == 2)
+            layers.emplace_back(layer_id, flush != 0, std::string());
+        else
+            std::get<2>(layers.back()) += line + "\n";
+    }
+    return layers;
+}
+
+SCENARIO("Cooling buffer stages produce the G-code of the single stage cooling buffer", "[CoolingBuffer]") {
+    GIVEN("Two extruders with different cooling, tool changes inside the layers and support layers collected until a flush") {
+        DynamicPrintConfig config = DynamicPrintConfig::full_print_config();
+        config.set_deserialize_strict({
+            { "gcode_flavor",                   "marlin" },
+            { "travel_speed",                   150 },
+            { "use_relative_e_distances",       1 },
+            { "slow_down_for_layer_cooling",    "1,1" },
+            { "slow_down_layer_time",           "8,12" },
+            { "slow_down_min_speed",            "10,20" },
+            { "fan_min_speed",                  "30,40" },
+            { "fan_max_speed",                  "100,90" },
+            { "fan_cooling_layer_time",         "60,30" },
+            { "reduce_fan_stop_start_freq",     "1,0" },
+            { "additional_cooling_fan_speed",   "50,70" },
+            { "close_fan_the_first_x_layers",   "1,1" },
+            { "full_fan_speed_layer",           "4,0" },
+            { "overhang_fan_speed",             "100,100" },
+            });
+        PrintConfig print_config;
+        print_config.apply(config, true);
+        GCode gcodegen;
+        gcodegen.apply_print_config(print_config);
+        gcodegen.writer().set_extruders({ 0, 1 });
+
+        // The input covers slow down of the external perimeters and of the other extrusions, overhang fan, forced fan resume,
+        // wipes, arcs, dwells and an unknown tool. The expected output was produced by the cooling buffer before it was split
+        // into the stages of the G-code export pipeline.
+        const std::string dir      = std::string(TEST_DATA_DIR) + "/fff_print_tests/test_cooling/";
+        auto              layers   = read_layers(dir + "layers.gcode");
+        const std::string expected = read_file(dir + "layers_cooled.gcode");
+        REQUIRE(layers.size() == 41);
+
+        WHEN("the layers are processed one by one") {
+            CoolingBuffer cooling_buffer(gcodegen);
+            cooling_buffer.set_current_extruder(0);
+            std::string out;
+            for (auto &[layer_id, flush, gcode] : layers)
+                out += cooling_buffer.process_layer(std::move(gcode), layer_id, flush);
+            THEN("the G-code is the same") {
+                REQUIRE(out == expected);
+            }
+        }
+        WHEN("the parallel stages process the batches out of order") {
+            CoolingBuffer cooling_buffer(gcodegen);
+            cooling_buffer.set_current_extruder(0);
+            std::vector<CoolingBuffer::Batch> batches;
+            for (auto &[layer_id, flush, gcode] : layers)
+                batches.emplace_back(cooling_buffer.collect_layer(std::move(gcode), layer_id, flush));
+            for (auto it = batches.rbegin(); it != batches.rend(); ++ it)
+                cooling_buffer.parse_batch(*it);
+            for (CoolingBuffer::Batch &batch : batches)
+                cooling_buffer.carry_over(batch);
+            for (auto it = batches.rbegin(); it != batches.rend(); ++ it)
+                cooling_buffer.slow_down_batch(*it);
+            std::string out;
+            for (CoolingBuffer::Batch &batch : batches)
+                out += cooling_buffer.apply_fan_speeds(std::move(batch));
+            THEN("the G-code is the same") {
+                REQUIRE(out == expected);
+            }
+        }
+    }
+}
@@ -4,6 +4,7 @@
 
 #include "libslic3r/ExtrusionEntityCollection.hpp"
 #include "libslic3r/ExtrusionEntity.hpp"
+#include "libslic3r/ExtrusionTable.hpp"
 #include "libslic3r/Point.hpp"
 #include "libslic3r/libslic3r.h"
 
@@ -83,3 +84,96 @@ SCENARIO("ExtrusionEntityCollection: Polygon flattening", "[ExtrusionEntity]") {
         }
     }
 }
+
+SCENARIO("ExtrusionEntityArena: entities of a layer", "[ExtrusionEntity]") {
+    srand(0xDEADBEEF);
+
+    GIVEN("An arena") {
+        ExtrusionEntityArena arena;
+        WHEN("A collection is filled inside the arena scope") {
+            ExtrusionEntityCollection collection;
+            {
+                ExtrusionEntityArena::Scope scope(arena);
+                collection.append(random_paths(1000));
+            }
+            THEN("The entities are allocated from the arena chunks") {
+                REQUIRE(arena.entities_allocated() == 1000);
+                REQUIRE(arena.chunks_allocated() > 0);
+                REQUIRE(arena.chunks_allocated() < 1000);
+            }
+            AND_WHEN("The collection is copied outside of the scope") {
+                ExtrusionEntityCollection copy = collection;
+                THEN("The copies are allocated on the heap") {
+                    REQUIRE(arena.entities_allocated() == 1000);
+                    REQUIRE(copy.entities.size() == 1000);
+                    REQUIRE(copy.entities.front()->first_point() == collection.entities.front()->first_point());
+                }
+            }
+            AND_WHEN("The collection is cleared") {
+                collection.clear();
+                THEN("Only the chunk being filled is kept") {
+                    REQUIRE(arena.chunks() == 1);
+                }
+            }
+        }
+    }
+    GIVEN("An arena destroyed before its entities") {
+        ExtrusionEntityCollection collection;
+        ExtrusionPaths            paths = random_paths(1000);
+        {
+            ExtrusionEntityArena        arena;
+            ExtrusionEntityArena::Scope scope(arena);
+            collection.append(paths);
+        }
+        THEN("The entities stay valid") {
+            REQUIRE(collection.entities.size() == 1000);
+            REQUIRE(collection.entities.front()->first_point() == paths.front().first_point());
+            REQUIRE(collection.entities.back()->last_point() == paths.back().last_point());
+        }
+        WHEN("The collection is cleared") {
+            collection.clear();
+            THEN("The entities are deleted") {
+                REQUIRE(collection.entities.empty());
+            }
+        }
+    }
+}
+
+SCENARIO("ExtrusionTable: flattening of nested collections", "[ExtrusionEntity]") {
+    srand(0xDEADBEEF);
+
+    GIVEN("A collection of paths, a loop and a nested collection") {
+        ExtrusionPaths paths = random_paths(5, 20);
+        ExtrusionLoop  loop(random_paths(2, 10));
+        ExtrusionEntityCollection nested;
+        nested.append(random_paths(3, 4));
+
+        ExtrusionEntityCollection collection;
+        collection.append(paths);
+        collection.append(loop);
+        collection.append(nested);
+
+        WHEN("The collection is appended to a table") {
+            ExtrusionTable table;
+            table.append(collection);
+            THEN("Every path is a row with its own point range") {
+                REQUIRE(table.size() == 10);
+                REQUIRE(table.point_offsets.size() == 11);
+                REQUIRE(table.points.size() == 5 * 20 + 2 * 10 + 3 * 4);
+                REQUIRE(table.num_points(0) == 20);
+                REQUIRE(*table.points_begin(0) == paths.front().first_point());
+                REQUIRE(*(table.points_end(4) - 1) == paths.back().last_point());
+                REQUIRE(table.num_points(9) == 4);
+                REQUIRE(table.roles[9] == erPerimeter);
+            }
+            AND_WHEN("The table is cleared") {
+                table.clear();
+                THEN("The table is empty") {
+                    REQUIRE(table.empty());
+                    REQUIRE(table.points.empty());
+                    REQUIRE(table.point_offsets.size() == 1);
+                }
+            }
+        }
+    }
+}
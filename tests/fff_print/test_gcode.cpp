@@ -1,8 +1,23 @@
 #include <catch2/catch.hpp>
 
 #include <memory>
+#include <chrono>
+#include <atomic>
 
 #include "libslic3r/GCode.hpp"
+#include "libslic3r/GCode/ConflictChecker.hpp"
+#include "libslic3r/GCode/GCodeProcessor.hpp"
+#include "libslic3r/GCodeReader.hpp"
+#include "libslic3r/Model.hpp"
+#include "libslic3r/Print.hpp"
+
+#include "test_data.hpp"
+
+#include <boost/filesystem/operations.hpp>
+#include <boost/nowide/cstdio.hpp>
+#include <boost/nowide/fstream.hpp>
+
+#include <tbb/parallel_for.h>
 
 using namespace Slic3r;
 
@@ -20,3 +35,332 @@ SCENARIO("Origin manipulation", "[GCode]") {
     	}
     }
 }
+
+SCENARIO("Columnar store of the G-code moves", "[GCode]") {
+    using MoveVertex = GCodeProcessorResult::MoveVertex;
+    GCodeProcessorResult::MoveVertexStore moves;
+    std::vector<Vec3f> arc_points { Vec3f(1.f, 0.f, 0.2f), Vec3f(1.5f, 0.5f, 0.2f), Vec3f(2.f, 1.f, 0.2f) };
+    std::vector<Vec3f> arc_points2 { Vec3f(4.f, 0.f, 0.2f), Vec3f(4.5f, 0.5f, 0.2f) };
+    for (unsigned int i = 0; i < 5; ++i) {
+        MoveVertex move;
+        move.gcode_id       = 10 + i;
+        move.type           = EMoveType::Extrude;
+        move.extrusion_role = erPerimeter;
+        move.extruder_id    = i == 2 ? 1 : 0;
+        move.position       = Vec3f(float(i), float(i), 0.2f);
+        move.feedrate       = 60.f + float(i) * 0.01f;
+        move.width          = 0.4537f;
+        move.height         = 0.2f;
+        move.mm3_per_mm     = 0.0812345f;
+        move.fan_speed      = 100.f;
+        move.temperature    = 220.f + float(i / 2);
+        move.layer_duration = 1.f;
+        if (i == 2 || i == 4) {
+            move.move_path_type       = EMovePathType::Arc_move_ccw;
+            move.interpolation_points = i == 2 ? arc_points : arc_points2;
+        }
+        moves.push_back(move);
+    }
+    THEN("the moves read back with their fields within the fixed point steps") {
+        REQUIRE(moves.size() == 5);
+        REQUIRE(moves[1].gcode_id == 11);
+        REQUIRE(moves[2].extruder_id == 1);
+        REQUIRE(moves[3].extruder_id == 0);
+        REQUIRE(moves[3].position == Vec3f(3.f, 3.f, 0.2f));
+        REQUIRE(moves[3].feedrate == 60.03f);
+        REQUIRE(moves[0].width == 0.4537f);
+        REQUIRE(moves[0].mm3_per_mm == Approx(0.0812345f).margin(0.000005f));
+        REQUIRE(moves[4].temperature == 222.f);
+        REQUIRE(moves[2].interpolation_points.size() == 3);
+        REQUIRE(moves[2].interpolation_points[1] == arc_points[1]);
+        REQUIRE(moves.interpolation_points(4).size() == 2);
+        REQUIRE(moves.interpolation_points(3).empty());
+        REQUIRE(moves.end() - moves.begin() == 5);
+    }
+    THEN("the iterator walks the moves in both directions") {
+        auto check = [&moves](const MoveVertex &move, size_t id) {
+            REQUIRE(move.gcode_id == moves.gcode_id(id));
+            REQUIRE(move.extruder_id == moves.extruder_id(id));
+            REQUIRE(move.temperature == moves[id].temperature);
+            REQUIRE(move.interpolation_points.size() == moves.interpolation_points(id).size());
+        };
+        size_t id = 0;
+        for (auto it = moves.begin(); it != moves.end(); ++it, ++id)
+            check(*it, id);
+        for (auto it = moves.end(); it != moves.begin();)
+            check(*--it, --id);
+        REQUIRE(id == 0);
+    }
+    WHEN("a move before the arc is erased") {
+        moves.erase(1);
+        THEN("the following moves and the arc points are kept") {
+            REQUIRE(moves.size() == 4);
+            REQUIRE(moves[1].gcode_id == 12);
+            REQUIRE(moves[1].extruder_id == 1);
+            REQUIRE(moves[1].interpolation_points.size() == 3);
+            REQUIRE(moves[1].interpolation_points[2] == arc_points[2]);
+            REQUIRE(moves[3].interpolation_points[1] == arc_points2[1]);
+            REQUIRE(moves[2].extruder_id == 0);
+        }
+    }
+    WHEN("the arc move of a single move run is erased") {
+        moves.erase(2);
+        THEN("the runs around it are merged and the next arc keeps its points") {
+            REQUIRE(moves.size() == 4);
+            REQUIRE(moves[2].gcode_id == 13);
+            REQUIRE(! moves[2].is_arc_move());
+            REQUIRE(moves[3].interpolation_points.size() == 2);
+            REQUIRE(moves[3].interpolation_points[0] == arc_points2[0]);
+            for (size_t i = 0; i < moves.size(); ++i)
+                REQUIRE(moves[i].extruder_id == 0);
+            REQUIRE(moves.memsize() > 0);
+        }
+    }
+    WHEN("moves out of the fixed point range are pushed and the moves before them erased") {
+        MoveVertex move = moves[0];
+        move.feedrate   = 1000.f;
+        move.width      = 10.f;
+        move.mm3_per_mm = 1.234567f;
+        moves.push_back(move);
+        moves.push_back(moves[0]);
+        moves.set_width_height(6, 7.5f, 0.12345f);
+        moves.erase(0);
+        moves.erase(1);
+        THEN("their values are kept exact") {
+            REQUIRE(moves.size() == 5);
+            REQUIRE(moves[3].feedrate == 1000.f);
+            REQUIRE(moves[3].width == 10.f);
+            REQUIRE(moves[3].mm3_per_mm == 1.234567f);
+            REQUIRE(moves[4].feedrate == 60.f);
+            REQUIRE(moves[4].width == 7.5f);
+            REQUIRE(moves[4].height == Approx(0.12345f).margin(0.00005f));
+        }
+    }
+    WHEN("many moves are pushed") {
+        MoveVertex move = moves[0];
+        moves.clear();
+        for (size_t i = 0; i < 100000; ++ i) {
+            move.position.x() = float(i % 100);
+            move.feedrate     = 50.f + float(i % 200);
+            moves.push_back(move);
+        }
+        moves.shrink_to_fit();
+        THEN("a move takes 31 bytes, about 2.8x less than a MoveVertex") {
+            REQUIRE(moves.memsize() / moves.size() <= 32);
+            REQUIRE(moves.memsize() * 2.75 < moves.size() * sizeof(MoveVertex));
+        }
+    }
+    WHEN("the layer durations are set") {
+        moves.set_layer_durations({ 12.5f });
+        THEN("the moves return the duration of their layer") {
+            REQUIRE(moves[0].layer_duration == 12.5f);
+        }
+    }
+}
+
+SCENARIO("Parallel G-code file parsing", "[GCode]") {
+    GIVEN("A G-code file of several chunks with layer changes, line numbers and CRLF line ends") {
+        std::string gcode = "G21\nM83\n";
+        for (int layer = 0; layer < 60; ++ layer) {
+            gcode += "; CHANGE_LAYER\nG1 Z" + std::to_string(0.2 * (layer + 1)) + "\n";
+            for (int i = 0; i < 2000; ++ i)
+                gcode += (i % 7 == 0 ? "N" + std::to_string(i) + " " : std::string()) + "G1 X" + std::to_string(i % 100) + ".125 Y" +
+                    std::to_string(layer) + ".5 E0.0" + std::to_string(i % 9) + (i % 5 == 0 ? " ; comment\r\n" : "\n");
+            gcode += "\n";
+        }
+        gcode += "M107";
+        boost::filesystem::path temp = boost::filesystem::unique_path();
+        {
+            boost::nowide::ofstream file(temp.string(), std::ios::binary);
+            file << gcode;
+        }
+        WHEN("the file is parsed sequentially and in parallel") {
+            auto parse = [&temp](bool parallel, std::vector<size_t> &lines_ends) {
+                std::vector<std::string> lines;
+                std::vector<float>       positions;
+                auto callback = [&lines, &positions](GCodeReader &reader, const GCodeReader::GCodeLine &line) {
+                    lines.emplace_back(line.raw());
+                    positions.emplace_back(line.has_x() ? line.x() : -1.f);
+                    positions.emplace_back(reader.e());
+                };
+                GCodeReader reader;
+                if (parallel)
+                    reader.parse_file_parallel(temp.string(), callback, lines_ends, "; CHANGE_LAYER");
+                else
+                    reader.parse_file(temp.string(), callback, lines_ends);
+                return std::make_pair(lines, positions);
+            };
+            std::vector<size_t> lines_ends, lines_ends_parallel;
+            auto sequential = parse(false, lines_ends);
+            auto parallel   = parse(true, lines_ends_parallel);
+            THEN("the lines, the positions and the line ends are the same") {
+                REQUIRE(sequential.first.size() > 100000);
+                REQUIRE(sequential.first == parallel.first);
+                REQUIRE(sequential.second == parallel.second);
+                REQUIRE(lines_ends == lines_ends_parallel);
+            }
+        }
+        boost::nowide::remove(temp.string().c_str());
+    }
+}
+
+// Benchmark of the parallel G-code parsing: only the tokenizing runs in parallel, the GCodeProcessor callback
+// (decoding, time estimation) and the update of the reader state run in the sequential stage.
+// Hidden from the default run, run with "[benchmark]".
+TEST_CASE("Parallel G-code file parsing of a large file", "[GCode][benchmark][.]") {
+    std::string gcode = "G21\nG90\nM83\n";
+    for (int layer = 0; layer < 500; ++ layer) {
+        gcode += ";" + GCodeProcessor::reserved_tag(GCodeProcessor::ETags::Layer_Change) + "\nG1 Z" + std::to_string(0.2 * (layer + 1)) + " F600\n";
+        gcode += ";" + GCodeProcessor::reserved_tag(GCodeProcessor::ETags::Role) + "Sparse infill\n";
+        for (int i = 0; i < 4000; ++ i)
+            gcode += "G1 X" + std::to_string(10 + (i * 37) % 200) + ".125 Y" + std::to_string(10 + (i * 53) % 200) + ".5 E0." + std::to_string(100 + i % 900) +
+                (i % 50 == 0 ? " F" + std::to_string(3000 + i % 7 * 600) : std::string()) + "\n";
+    }
+    boost::filesystem::path temp = boost::filesystem::unique_path();
+    {
+        boost::nowide::ofstream file(temp.string(), std::ios::binary);
+        file << gcode;
+    }
+    auto seconds = [](auto t0, auto t1) { return std::chrono::duration<double>(t1 - t0).count(); };
+    size_t              num_lines = 0;
+    std::vector<size_t> lines_ends;
+    GCodeReader         reader;
+    auto t0 = std::chrono::steady_clock::now();
+    reader.parse_file(temp.string(), [&num_lines](GCodeReader &, const GCodeReader::GCodeLine &) { ++ num_lines; }, lines_ends);
+    auto t1 = std::chrono::steady_clock::now();
+    reader.parse_file_parallel(temp.string(), [&num_lines](GCodeReader &, const GCodeReader::GCodeLine &) { ++ num_lines; }, lines_ends,
+        ";" + GCodeProcessor::reserved_tag(GCodeProcessor::ETags::Layer_Change));
+    auto t2 = std::chrono::steady_clock::now();
+    GCodeProcessor processor;
+    processor.process_file(temp.string());
+    auto t3 = std::chrono::steady_clock::now();
+    boost::nowide::remove(temp.string().c_str());
+
+    WARN("G-code of " << num_lines / 2 << " lines, " << gcode.size() / 1000000 << " MB read sequentially in " << seconds(t0, t1) <<
+        " s, in parallel in " << seconds(t1, t2) << " s, processed by GCodeProcessor in " << seconds(t2, t3) << " s");
+    REQUIRE(processor.get_result().moves.size() > 1000000);
+}
+
+// Lines of a layer of a synthetic plate: a square perimeter and a zig-zag infill per instance, laid out on a grid.
+static LineWithIDs conflict_plate_layer_lines(const std::vector<int> &instances, int columns, double spacing, int layer)
+{
+    LineWithIDs lines;
+    for (size_t i = 0; i < instances.size(); ++ i) {
+        double  x0 = spacing * double(i % columns);
+        double  y0 = spacing * double(i / columns);
+        Polygon square({ Point::new_scale(x0, y0), Point::new_scale(x0 + 10., y0), Point::new_scale(x0 + 10., y0 + 10.), Point::new_scale(x0, y0 + 10.) });
+        for (const Line &line : square.lines())
+            lines.emplace_back(line, &instances[i], erExternalPerimeter);
+        for (double x = 0.5 * (1 + layer % 2); x < 10.; x += 0.5)
+            lines.emplace_back(Line(Point::new_scale(x0 + x, y0), Point::new_scale(x0 + x - 0.5, y0 + 10.)), &instances[i], erSolidInfill);
+    }
+    return lines;
+}
+
+SCENARIO("Replay of the G-code generated for an instance of an object", "[GCode]") {
+    // The nearest seams and the infill printed first are chosen from the position the instance is entered from.
+    for (const std::string seam_position : { "aligned", "nearest" }) {
+        for (const std::string wall_infill_order : { "inner wall/outer wall/infill", "infill/inner wall/outer wall" }) {
+            GIVEN("Two objects of three instances each, shifted off the G-code resolution, " + seam_position + " seams, " + wall_infill_order) {
+                DynamicPrintConfig config = DynamicPrintConfig::full_print_config();
+                config.set_deserialize_strict({
+                    { "use_relative_e_distances", "1" },
+                    { "wall_loops",               "2" },
+                    { "sparse_infill_density",    "20%" },
+                    { "z_hop_types",              "Auto Lift" },
+                    { "enable_arc_fitting",       "1" },
+                    { "seam_position",            seam_position },
+                    { "wall_infill_order",        wall_infill_order },
+                    });
+                Slic3r::Model model;
+                int object_idx = 0;
+                for (Slic3r::Test::TestMesh test_mesh : { Slic3r::Test::TestMesh::cube_20x20x20, Slic3r::Test::TestMesh::overhang }) {
+                    ModelObject *object = model.add_object();
+                    object->name = "object" + std::to_string(object_idx) + ".stl";
+                    object->add_volume(Slic3r::Test::mesh(test_mesh));
+                    // The regions of the objects differ, so that a replay after the other object would travel with the wrong region config.
+                    object->config.set_key_value("wall_loops", new ConfigOptionInt(2 + object_idx));
+                    for (int i = 0; i < 3; ++ i)
+                        object->add_instance()->set_offset(Vec3d(30.1234567 + 35. * i, 30.7654321 + 45. * object_idx, 0.));
+                    object->ensure_on_bed();
+                    ++ object_idx;
+                }
+                Slic3r::Print print;
+                for (ModelObject *object : model.objects)
+                    print.auto_assign_extruders(object);
+                print.apply(model, config);
+                print.validate();
+                print.set_status_silent();
+                print.process();
+
+                auto export_gcode = [&print](bool replay) {
+                    boost::filesystem::path temp = boost::filesystem::unique_path();
+                    GCode                   gcodegen;
+                    GCodeProcessorResult    result;
+                    gcodegen.set_replay_instance_templates(replay);
+                    gcodegen.do_export(&print, temp.string().c_str(), &result);
+                    boost::nowide::ifstream ifs(temp.string());
+                    std::string gcode((std::istreambuf_iterator<char>(ifs)), std::istreambuf_iterator<char>());
+                    ifs.close();
+                    boost::nowide::remove(temp.string().c_str());
+                    return gcode;
+                };
+                WHEN("the G-code is generated with the instances replayed and with the replay switched off") {
+                    std::string replayed  = export_gcode(true);
+                    std::string generated = export_gcode(false);
+                    THEN("the G-code is the same") {
+                        REQUIRE(! generated.empty());
+                        REQUIRE(replayed == generated);
+                    }
+                }
+            }
+        }
+    }
+}
+
+SCENARIO("Conflict checking of overlapping objects", "[GCode]") {
+    std::vector<int> instances(40);
+    GIVEN("A plate of instances on a grid with a gap between them") {
+        LineWithIDs lines = conflict_plate_layer_lines(instances, 8, 12., 0);
+        THEN("no conflict is found") {
+            REQUIRE(! ConflictChecker::find_inter_of_lines(lines).has_value());
+            REQUIRE(! ConflictChecker::find_inter_of_lines_in_overlapping_objs(lines).has_value());
+        }
+    }
+    GIVEN("A plate of instances on a grid overlapping their neighbours") {
+        LineWithIDs lines = conflict_plate_layer_lines(instances, 8, 9., 0);
+        THEN("a conflict of two different instances is found") {
+            REQUIRE(ConflictChecker::find_inter_of_lines(lines).has_value());
+            ConflictComputeOpt conflict = ConflictChecker::find_inter_of_lines_in_overlapping_objs(lines);
+            REQUIRE(conflict.has_value());
+            REQUIRE(conflict->_obj1 != conflict->_obj2);
+        }
+    }
+}
+
+// Benchmark of the conflict checking of all the lines of a layer against the checking of the overlapping objects only.
+// Hidden from the default run, run with "[benchmark]".
+TEST_CASE("Conflict checking of a 200 instance plate", "[GCode][benchmark][.]") {
+    std::vector<int>         instances(200);
+    std::vector<LineWithIDs> layers;
+    for (int layer = 0; layer < 100; ++ layer)
+        layers.emplace_back(conflict_plate_layer_lines(instances, 20, 12., layer));
+
+    auto t_start = std::chrono::high_resolution_clock::now();
+    bool found   = false;
+    for (const LineWithIDs &lines : layers)
+        found |= ConflictChecker::find_inter_of_lines(lines).has_value();
+    auto t_mid   = std::chrono::high_resolution_clock::now();
+    std::atomic<bool> found_overlapping(false);
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, layers.size()), [&layers, &found_overlapping](const tbb::blocked_range<size_t> &range) {
+        for (size_t i = range.begin(); i < range.end(); ++ i)
+            if (ConflictChecker::find_inter_of_lines_in_overlapping_objs(layers[i]).has_value())
+                found_overlapping = true;
+    });
+    auto t_end   = std::chrono::high_resolution_clock::now();
+    WARN("Conflict check of " << instances.size() << " instances and " << layers.size() << " layers: all lines " <<
+        std::chrono::duration_cast<std::chrono::milliseconds>(t_mid - t_start).count() << " ms, overlapping objects in parallel " <<
+        std::chrono::duration_cast<std::chrono::milliseconds>(t_end - t_mid).count() << " ms");
+    REQUIRE(! found);
+    REQUIRE(! found_overlapping);
+}
@@ -1,6 +1,8 @@
 #include <catch2/catch.hpp>
 
 #include <memory>
+#include <chrono>
+#include <cstdio>
 
 #include "libslic3r/GCodeWriter.hpp"
 
@@ -94,3 +96,116 @@ SCENARIO("set_speed emits values with fixed-point output.", "[GCodeWriter]") {
         }
     }
 }
+
+SCENARIO("Axis values are emitted in the shortest fixed-point form.", "[GCodeWriter]") {
+    GIVEN("GCodeWriter instance") {
+        GCodeWriter writer;
+        WHEN("set_speed is called with values smaller than one") {
+            THEN("The leading zero is omitted") {
+                REQUIRE_THAT(writer.set_speed(0.5), Catch::Equals("G1 F.5\n"));
+                REQUIRE_THAT(writer.set_speed(0.0306), Catch::Equals("G1 F.031\n"));
+            }
+        }
+        WHEN("set_speed is called with a value rounding to an integer") {
+            THEN("No decimal point is emitted") {
+                REQUIRE_THAT(writer.set_speed(1200.0004), Catch::Equals("G1 F1200\n"));
+                REQUIRE_THAT(writer.set_speed(1199.9996), Catch::Equals("G1 F1200\n"));
+            }
+        }
+        WHEN("set_speed is called with a value with inner zeros") {
+            THEN("Only the trailing zeros are removed") {
+                REQUIRE_THAT(writer.set_speed(1002.05), Catch::Equals("G1 F1002.05\n"));
+                REQUIRE_THAT(writer.set_speed(10.001), Catch::Equals("G1 F10.001\n"));
+            }
+        }
+    }
+}
+
+// The formatter is expected to produce the same numbers as "%.*f" with trailing zeros,
+// the trailing decimal point and the leading zero removed.
+static std::string format_axis_printf(double v, int digits)
+{
+    char buf[64];
+    sprintf(buf, "%.*f", digits, v);
+    std::string out = buf;
+    if (out.find('.') != std::string::npos) {
+        while (out.back() == '0')
+            out.pop_back();
+        if (out.back() == '.')
+            out.pop_back();
+    }
+    if (out == "-0" || out.empty())
+        out = "0";
+    else if (out.rfind("0.", 0) == 0)
+        out.erase(0, 1);
+    else if (out.rfind("-0.", 0) == 0)
+        out.erase(1, 1);
+    return out;
+}
+
+TEST_CASE("G-code formatter matches printf", "[GCodeWriter]") {
+    // Values exactly representable at the export precision, so that printf and the formatter cannot round differently.
+    for (int i = -200000; i <= 200000; i += 7) {
+        for (double scale : { 1., 137., 10000. }) {
+            double v = double(i) * scale / 1000.;
+            GCodeG1Formatter w;
+            w.emit_f(v);
+            REQUIRE_THAT(w.string(), Catch::Equals("G1 F" + format_axis_printf(v, GCodeFormatter::XYZF_EXPORT_DIGITS) + "\n"));
+        }
+        double e = double(i) / 100000.;
+        GCodeG1Formatter w;
+        w.emit_e(e);
+        REQUIRE_THAT(w.string(), Catch::Equals("G1 E" + format_axis_printf(e, GCodeFormatter::E_EXPORT_DIGITS) + "\n"));
+    }
+}
+
+TEST_CASE("Appending extrusions produces the same G-code as returning them", "[GCodeWriter]") {
+    GCodeWriter writer_string;
+    GCodeWriter writer_append;
+    std::vector<unsigned int> extruder_ids {0};
+    for (GCodeWriter *writer : { &writer_string, &writer_append }) {
+        writer->set_extruders(extruder_ids);
+        writer->set_extruder(0);
+    }
+
+    std::string gcode_string;
+    std::string gcode_append;
+    for (int i = 0; i < 1000; ++ i) {
+        Vec2d  pt(100. + 0.37 * i, 50. - 0.011 * i * i);
+        double dE = 0.001 * (i % 13);
+        gcode_string += writer_string.extrude_to_xy(pt, dE);
+        writer_append.extrude_to_xy(gcode_append, pt, dE);
+        gcode_string += writer_string.extrude_arc_to_xy(pt, Vec2d(1.5, -0.25), dE, i % 2 == 0);
+        writer_append.extrude_arc_to_xy(gcode_append, pt, Vec2d(1.5, -0.25), dE, i % 2 == 0);
+    }
+    REQUIRE(gcode_string == gcode_append);
+}
+
+// Benchmark of the G-code formatting into returned strings against the formatting appended to a reserved buffer.
+// Hidden from the default run, run with "[benchmark]".
+TEST_CASE("G-code formatter performance", "[GCodeWriter][benchmark][.]") {
+    GCodeWriter writer_string;
+    GCodeWriter writer_append;
+    std::vector<unsigned int> extruder_ids {0};
+    for (GCodeWriter *writer : { &writer_string, &writer_append }) {
+        writer->set_extruders(extruder_ids);
+        writer->set_extruder(0);
+    }
+    const size_t num_moves = 5000000;
+
+    auto t_start = std::chrono::high_resolution_clock::now();
+    std::string gcode_string;
+    for (size_t i = 0; i < num_moves; ++ i)
+        gcode_string += writer_string.extrude_to_xy(Vec2d(100. + 1e-4 * i, 50. - 2e-4 * i), 0.0123);
+    auto t_mid = std::chrono::high_resolution_clock::now();
+    std::string gcode_append;
+    gcode_append.reserve(gcode_string.size());
+    for (size_t i = 0; i < num_moves; ++ i)
+        writer_append.extrude_to_xy(gcode_append, Vec2d(100. + 1e-4 * i, 50. - 2e-4 * i), 0.0123);
+    auto t_end = std::chrono::high_resolution_clock::now();
+
+    WARN("Formatting " << num_moves << " extrusions: returned strings " <<
+        std::chrono::duration_cast<std::chrono::milliseconds>(t_mid - t_start).count() << " ms, appended to a reserved buffer " <<
+        std::chrono::duration_cast<std::chrono::milliseconds>(t_end - t_mid).count() << " ms");
+    REQUIRE(gcode_string == gcode_append);
+}
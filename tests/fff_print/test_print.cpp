@@ -4,6 +4,10 @@
 #include "libslic3r/Print.hpp"
 #include "libslic3r/Layer.hpp"
 
+#include <boost/filesystem.hpp>
+#include <boost/nowide/fstream.hpp>
+#include "nlohmann/json.hpp"
+
 #include "test_data.hpp"
 
 using namespace Slic3r;
@@ -126,3 +130,59 @@ SCENARIO("Print: Brim generation", "[Print]") {
         }
     }
 }
+
+SCENARIO("Print: Slicing cache keyed by content", "[Print]") {
+    GIVEN("20mm cube sliced and exported into a slicing cache directory") {
+        DynamicPrintConfig config = DynamicPrintConfig::full_print_config();
+        boost::filesystem::path directory = boost::filesystem::temp_directory_path() / boost::filesystem::unique_path();
+        Slic3r::Print exported;
+        Slic3r::Test::init_and_process_print({TestMesh::cube_20x20x20}, exported, config);
+        REQUIRE(exported.export_cached_data(directory.string(), false, true) == 0);
+        std::vector<boost::filesystem::path> files;
+        for (const boost::filesystem::directory_entry &entry : boost::filesystem::directory_iterator(directory))
+            files.emplace_back(entry.path());
+        REQUIRE(files.size() == 1);
+
+        auto load = [&config, &directory](Slic3r::Print &print) {
+            Slic3r::Model model;
+            Slic3r::Test::init_print({TestMesh::cube_20x20x20}, print, model, config);
+            return print.load_cached_data(directory.string(), true);
+        };
+        WHEN("the same object is loaded from the cache") {
+            Slic3r::Print loaded;
+            int ret = load(loaded);
+            THEN("the loaded layers match the exported ones") {
+                REQUIRE(ret == 0);
+                const PrintObject &expected = *exported.objects().front();
+                const PrintObject &object   = *loaded.objects().front();
+                REQUIRE(object.layer_count() == expected.layer_count());
+                for (size_t i = 0; i < object.layer_count(); ++ i) {
+                    REQUIRE(object.get_layer(i)->print_z == Approx(expected.get_layer(i)->print_z));
+                    REQUIRE(object.get_layer(i)->lslices == expected.get_layer(i)->lslices);
+                }
+            }
+        }
+        WHEN("the content key stored in the cache file does not match the object") {
+            nlohmann::json root_json;
+            {
+                boost::nowide::ifstream ifs(files.front().string());
+                ifs >> root_json;
+            }
+            REQUIRE(root_json.contains("content_key"));
+            std::string content_key = root_json["content_key"];
+            // Keep the prefix used as the file name, as if two objects collided in it.
+            root_json["content_key"] = content_key.substr(0, 16) + std::string(content_key.size() - 16, '0');
+            {
+                boost::nowide::ofstream ofs(files.front().string());
+                ofs << root_json.dump(0);
+            }
+            Slic3r::Print loaded;
+            int ret = load(loaded);
+            THEN("the object is not loaded and will be sliced") {
+                REQUIRE(ret == 0);
+                REQUIRE(loaded.objects().front()->layer_count() == 0);
+            }
+        }
+        boost::filesystem::remove_all(directory);
+    }
+}
@@ -87,3 +87,89 @@ SCENARIO("PrintObject: object layer heights", "[PrintObject]") {
 #endif
     }
 }
+
+// Slices of all the layers and regions of an object.
+static std::vector<ExPolygons> object_region_slices(const PrintObject &object)
+{
+    std::vector<ExPolygons> out;
+    for (const Layer *layer : object.layers()) {
+        out.emplace_back(layer->lslices);
+        for (const LayerRegion *region : layer->regions())
+            out.emplace_back(to_expolygons(region->slices.surfaces));
+    }
+    return out;
+}
+
+SCENARIO("PrintObject: reuse of the volume slices between slicing runs", "[PrintObject]") {
+    GIVEN("20mm cube with a 5mm modifier inside, sliced once") {
+        DynamicPrintConfig config = DynamicPrintConfig::full_print_config();
+        config.set_deserialize_strict({ { "layer_height", 0.2 }, { "initial_layer_print_height", 0.2 } });
+        Model model;
+        Print print;
+        Slic3r::Test::init_print({ TestMesh::cube_20x20x20 }, print, model, config);
+        ModelObject *object   = model.objects.front();
+        TriangleMesh cube     = make_cube(5., 5., 5.);
+        cube.translate(5.f, 5.f, 5.f);
+        ModelVolume *modifier = object->add_volume(std::move(cube), ModelVolumeType::PARAMETER_MODIFIER);
+        modifier->config.set("wall_loops", 5);
+        print.apply(model, config);
+        print.process();
+        const size_t num_layers = print.objects().front()->layers().size();
+        REQUIRE(print.objects().front()->volume_slices_cache().layers_sliced == 2 * num_layers);
+
+        auto check_from_scratch = [&model, &config, &print]() {
+            Print print_from_scratch;
+            print_from_scratch.apply(model, config);
+            print_from_scratch.validate();
+            print_from_scratch.set_status_silent();
+            print_from_scratch.process();
+            REQUIRE(object_region_slices(*print.objects().front()) == object_region_slices(*print_from_scratch.objects().front()));
+        };
+
+        WHEN("the modifier is moved") {
+            modifier->set_offset(modifier->get_offset() + Vec3d(3., 0., 2.));
+            print.apply(model, config);
+            print.process();
+            THEN("only the modifier is sliced again and the slices are the same as the ones sliced from scratch") {
+                const VolumeSlicesCache &cache = print.objects().front()->volume_slices_cache();
+                REQUIRE(cache.layers_reused == num_layers);
+                REQUIRE(cache.layers_sliced == num_layers);
+                check_from_scratch();
+            }
+        }
+        WHEN("the XY compensation changes") {
+            config.set_deserialize_strict({ { "xy_contour_compensation", 0.05 } });
+            print.apply(model, config);
+            print.process();
+            THEN("all the layers are reused and the slices are the same as the ones sliced from scratch") {
+                const VolumeSlicesCache &cache = print.objects().front()->volume_slices_cache();
+                REQUIRE(cache.layers_reused == 2 * num_layers);
+                REQUIRE(cache.layers_sliced == 0);
+                check_from_scratch();
+            }
+        }
+        WHEN("the mesh of the modifier is replaced and the XY compensation changes") {
+            modifier->set_mesh(make_cube(5., 5., 4.));
+            config.set_deserialize_strict({ { "xy_contour_compensation", 0.05 } });
+            print.apply(model, config);
+            print.process();
+            THEN("only the modifier is sliced again and the slices are the same as the ones sliced from scratch") {
+                const VolumeSlicesCache &cache = print.objects().front()->volume_slices_cache();
+                REQUIRE(cache.layers_reused == num_layers);
+                REQUIRE(cache.layers_sliced == num_layers);
+                check_from_scratch();
+            }
+        }
+        WHEN("the slicing parameters change") {
+            config.set_deserialize_strict({ { "slice_closing_radius", 0.1 } });
+            print.apply(model, config);
+            print.process();
+            THEN("all volumes are sliced again") {
+                const VolumeSlicesCache &cache = print.objects().front()->volume_slices_cache();
+                REQUIRE(cache.layers_reused == 0);
+                REQUIRE(cache.layers_sliced == 2 * num_layers);
+                check_from_scratch();
+            }
+        }
+    }
+}
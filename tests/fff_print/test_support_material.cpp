@@ -1,7 +1,15 @@
 #include <catch2/catch.hpp>
 
+#include "libslic3r/ClipperUtils.hpp"
 #include "libslic3r/GCodeReader.hpp"
 #include "libslic3r/Layer.hpp"
+#include "libslic3r/MinimumSpanningTree.hpp"
+#include "libslic3r/TreeSupport.hpp"
+
+#include <chrono>
+#include <random>
+#include <regex>
+#include <set>
 
 #include "test_data.hpp" // get access to init_print, etc
 
@@ -236,3 +244,267 @@ SCENARIO("SupportMaterial: Checking bridge speed", "[SupportMaterial]")
 }
 
 #endif
+
+// Length of the minimum spanning tree of the complete graph of the points, by Prim's algorithm over a distance matrix.
+static double reference_spanning_tree_length(const std::vector<Point> &points)
+{
+    std::vector<double> dist2(points.size(), std::numeric_limits<double>::max());
+    std::vector<bool>   in_tree(points.size(), false);
+    dist2.front() = 0;
+    double length = 0;
+    for (size_t iter = 0; iter < points.size(); ++ iter) {
+        size_t closest = points.size();
+        for (size_t i = 0; i < points.size(); ++ i)
+            if (! in_tree[i] && (closest == points.size() || dist2[i] < dist2[closest]))
+                closest = i;
+        in_tree[closest] = true;
+        length += std::sqrt(dist2[closest]);
+        for (size_t i = 0; i < points.size(); ++ i)
+            if (! in_tree[i])
+                dist2[i] = std::min(dist2[i], (points[i] - points[closest]).cast<double>().squaredNorm());
+    }
+    return length;
+}
+
+static double spanning_tree_length(const MinimumSpanningTree &mst, size_t &num_edges)
+{
+    double length = 0;
+    num_edges = 0;
+    for (const Point &vertex : mst.vertices())
+        for (const Point &neighbour : mst.adjacent_nodes(vertex)) {
+            length += (neighbour - vertex).cast<double>().norm();
+            ++ num_edges;
+        }
+    num_edges /= 2;
+    return length / 2;
+}
+
+SCENARIO("SupportMaterial: minimum spanning tree of the tree support nodes", "[SupportMaterial]")
+{
+    GIVEN("Nodes scattered randomly") {
+        std::mt19937                   rng(1);
+        std::uniform_int_distribution<coord_t> coordinate(0, scaled<coord_t>(50.));
+        for (size_t num_points : { 100, 2000 }) {
+            std::vector<Point> points;
+            std::set<std::pair<coord_t, coord_t>> unique;
+            while (points.size() < num_points) {
+                Point pt(coordinate(rng), coordinate(rng));
+                if (unique.insert({ pt.x(), pt.y() }).second)
+                    points.emplace_back(pt);
+            }
+            WHEN("the tree of " + std::to_string(num_points) + " nodes is built") {
+                MinimumSpanningTree mst(points);
+                size_t num_edges;
+                double length = spanning_tree_length(mst, num_edges);
+                THEN("it spans all the nodes") {
+                    REQUIRE(mst.vertices().size() == num_points);
+                    REQUIRE(num_edges == num_points - 1);
+                }
+                THEN("it is as short as the tree of Prim's algorithm") {
+                    REQUIRE(length == Approx(reference_spanning_tree_length(points)));
+                }
+            }
+        }
+    }
+    GIVEN("Nodes of a large flat ceiling") {
+        // 150x150 nodes 2mm apart, the grid of the contact points of tree support under a 300x300mm ceiling.
+        std::vector<Point> points;
+        for (int i = 0; i < 150; ++ i)
+            for (int j = 0; j < 150; ++ j)
+                points.emplace_back(scaled<coord_t>(2. * i), scaled<coord_t>(2. * j));
+        WHEN("the tree is built") {
+            MinimumSpanningTree mst(points);
+            size_t num_edges;
+            double length = spanning_tree_length(mst, num_edges);
+            THEN("the nodes are connected to their direct neighbours") {
+                REQUIRE(num_edges == points.size() - 1);
+                REQUIRE(length == Approx(double(points.size() - 1) * scaled<double>(2.)));
+            }
+        }
+    }
+}
+
+// Benchmark of the tree support of a table with a single leg, most of the time is spent dropping the nodes of its top.
+// Hidden from the default run, run with "[benchmark]".
+TEST_CASE("SupportMaterial: tree support under a large flat overhang", "[SupportMaterial][benchmark][.]")
+{
+    TriangleMesh table = make_cube(120., 120., 2.);
+    table.translate(0.f, 0.f, 20.f);
+    TriangleMesh leg = make_cube(10., 10., 20.);
+    leg.translate(55.f, 55.f, 0.f);
+    table.merge(leg);
+
+    Slic3r::Print print;
+    auto t0 = std::chrono::steady_clock::now();
+    Slic3r::Test::init_and_process_print({ table }, print, {
+        { "enable_support", 1 },
+        { "support_type",   "tree(auto)" },
+        });
+    auto t1 = std::chrono::steady_clock::now();
+    WARN("Tree support of a 120x120mm overhang processed in " << std::chrono::duration<double>(t1 - t0).count() << " s");
+    REQUIRE(! print.objects().front()->support_layers().empty());
+}
+
+// Print z and the extrusion polylines of each support layer.
+static std::vector<std::pair<coordf_t, Polylines>> support_polylines(const PrintObject &object)
+{
+    std::vector<std::pair<coordf_t, Polylines>> out;
+    for (const SupportLayer *layer : object.support_layers()) {
+        Polylines polylines;
+        layer->support_fills.collect_polylines(polylines);
+        out.emplace_back(layer->print_z, std::move(polylines));
+    }
+    return out;
+}
+
+SCENARIO("SupportMaterial: regeneration after changing the support blockers", "[SupportMaterial]")
+{
+    GIVEN("A table supported by normal supports, its perimeters changed after the first generation") {
+        TriangleMesh table = make_cube(40., 40., 2.);
+        table.translate(0.f, 0.f, 10.f);
+        table.merge(make_cube(10., 10., 10.));
+
+        DynamicPrintConfig config = DynamicPrintConfig::full_print_config();
+        config.set_deserialize_strict({
+            { "enable_support",    1 },
+            { "support_type",      "normal(auto)" },
+            { "bridge_no_support", 1 },
+            });
+        Model model;
+        Print print;
+        Slic3r::Test::init_print({ table }, print, model, config);
+        print.process();
+        config.set_deserialize_strict({ { "wall_loops", 3 } });
+        print.apply(model, config);
+        print.process();
+
+        WHEN("a support blocker is added over a corner of the table top and the supports are regenerated") {
+            ModelObject  *object = model.objects.front();
+            BoundingBoxf3 bbox   = object->volumes.front()->mesh().transformed_bounding_box(object->volumes.front()->get_matrix());
+            TriangleMesh  blocker = make_cube(15., 15., 4.);
+            blocker.translate(float(bbox.max.x() - 15.), float(bbox.max.y() - 15.), float(bbox.min.z() + 8.));
+            object->add_volume(std::move(blocker), ModelVolumeType::SUPPORT_BLOCKER);
+            print.apply(model, config);
+            print.process();
+
+            Print print_from_scratch;
+            print_from_scratch.apply(model, config);
+            print_from_scratch.validate();
+            print_from_scratch.set_status_silent();
+            print_from_scratch.process();
+
+            THEN("the supports are the same as the ones generated from scratch") {
+                auto regenerated   = support_polylines(*print.objects().front());
+                auto from_scratch  = support_polylines(*print_from_scratch.objects().front());
+                REQUIRE(! from_scratch.empty());
+                REQUIRE(regenerated == from_scratch);
+            }
+        }
+    }
+}
+
+SCENARIO("SupportMaterial: precomputed tree support avoidance", "[SupportMaterial]")
+{
+    GIVEN("An object with an overhang") {
+        Slic3r::Print print;
+        Slic3r::Test::init_and_process_print({ TestMesh::overhang }, print, { { "layer_height", 0.1 } });
+        const PrintObject &object = *print.objects().front();
+        // More layers than two strides of the avoidance checkpoints.
+        REQUIRE(object.layer_count() > 2 * 16);
+        auto make_data = [&object]() {
+            auto data = std::make_unique<TreeSupportData>(object, 0.5, 0.2, 0.05);
+            for (size_t layer_nr = 0; layer_nr < object.layer_count(); ++ layer_nr) {
+                const Layer *layer = object.get_layer(int(layer_nr));
+                data->layer_heights.emplace_back(layer->print_z, layer->height, layer_nr == 0 ? 0 : layer_nr - 1);
+            }
+            return data;
+        };
+        // Radii queried up to a layer, the last one is rounded up to the radius resolution.
+        const size_t               top_layer = object.layer_count() - 1;
+        std::map<coordf_t, size_t> radius_top_layers { { 1., top_layer }, { 2., top_layer / 2 }, { 3.03, top_layer } };
+        auto reference = make_data();
+        for (size_t memory_limit : { std::numeric_limits<size_t>::max(), size_t(1) }) {
+            const std::string description = memory_limit == 1 ? "the avoidance is precomputed over the memory limit, keeping checkpoints only" : "the avoidance is precomputed";
+            WHEN(description) {
+                auto data = make_data();
+                data->precompute_avoidance(radius_top_layers, memory_limit);
+                THEN("it is the same as the avoidance calculated on demand") {
+                    for (const auto &[radius, top] : radius_top_layers)
+                        for (size_t layer_nr = 0; layer_nr <= top; ++ layer_nr) {
+                            const ExPolygons &precomputed = data->get_avoidance(radius, layer_nr);
+                            const ExPolygons &calculated  = reference->get_avoidance(radius, layer_nr);
+                            REQUIRE(! calculated.empty());
+                            REQUIRE(area(precomputed) == Approx(area(calculated)));
+                            REQUIRE(area(diff_ex(precomputed, calculated)) == Approx(0.).margin(1e-6 * area(calculated)));
+                            REQUIRE(area(diff_ex(calculated, precomputed)) == Approx(0.).margin(1e-6 * area(calculated)));
+                        }
+                }
+            }
+        }
+        WHEN("a layer between the checkpoints is queried over the memory limit") {
+            auto avoidance_entries = [](const TreeSupportData &data) {
+                const std::string stats = data.cache_statistics();
+                std::smatch       match;
+                REQUIRE(std::regex_search(stats, match, std::regex("avoidance cache: [0-9]+ hits, [0-9]+ misses, ([0-9]+) entries")));
+                return std::stoul(match[1].str());
+            };
+            auto data = make_data();
+            data->precompute_avoidance({ { 1., top_layer } }, 1);
+            const size_t entries = avoidance_entries(*data);
+            data->get_avoidance(1., 2 * 16 - 1);
+            THEN("only the queried layer is added to the cache, not the layers down to the checkpoint") {
+                REQUIRE(avoidance_entries(*data) == entries + 1);
+            }
+        }
+    }
+}
+
+// Benchmark of the normal support regeneration after painting a support blocker, against a regeneration from scratch.
+// Hidden from the default run, run with "[benchmark]".
+TEST_CASE("SupportMaterial: regeneration after a support blocker edit on a large part", "[SupportMaterial][benchmark][.]")
+{
+    TriangleMesh table = make_cube(200., 200., 2.);
+    table.translate(0.f, 0.f, 60.f);
+    for (float x : { 0.f, 190.f })
+        for (float y : { 0.f, 190.f }) {
+            TriangleMesh leg = make_cylinder(5., 60.);
+            leg.translate(x + 5.f, y + 5.f, 0.f);
+            table.merge(leg);
+        }
+    TriangleMesh shelf = make_cube(150., 150., 2.);
+    shelf.translate(25.f, 25.f, 30.f);
+    table.merge(shelf);
+
+    DynamicPrintConfig config = DynamicPrintConfig::full_print_config();
+    config.set_deserialize_strict({
+        { "enable_support", 1 },
+        { "support_type",   "normal(auto)" },
+        { "layer_height",   0.1 },
+        });
+    Model model;
+    Print print;
+    Slic3r::Test::init_print({ table }, print, model, config);
+    print.process();
+
+    // Regenerate the supports from scratch.
+    config.set_deserialize_strict({ { "support_base_pattern_spacing", 3 } });
+    print.apply(model, config);
+    auto t0 = std::chrono::steady_clock::now();
+    print.process();
+    auto t1 = std::chrono::steady_clock::now();
+
+    // Paint a support blocker under a corner of the table top.
+    ModelObject  *object  = model.objects.front();
+    BoundingBoxf3 bbox    = object->volumes.front()->mesh().transformed_bounding_box(object->volumes.front()->get_matrix());
+    TriangleMesh  blocker = make_cube(20., 20., 4.);
+    blocker.translate(float(bbox.max.x() - 40.), float(bbox.max.y() - 40.), float(bbox.min.z() + 58.));
+    object->add_volume(std::move(blocker), ModelVolumeType::SUPPORT_BLOCKER);
+    print.apply(model, config);
+    auto t2 = std::chrono::steady_clock::now();
+    print.process();
+    auto t3 = std::chrono::steady_clock::now();
+
+    WARN("Supports of a 200x200mm table regenerated from scratch in " << std::chrono::duration<double>(t1 - t0).count() <<
+        " s, after a support blocker edit in " << std::chrono::duration<double>(t3 - t2).count() << " s");
+    REQUIRE(! print.objects().front()->support_layers().empty());
+}
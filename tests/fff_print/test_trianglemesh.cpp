@@ -301,6 +301,127 @@ SCENARIO( "TriangleMeshSlicer: Cut behavior.") {
         }
     }
 }
+
+static std::vector<float> slicing_zs(const indexed_triangle_set &its, float layer_height)
+{
+    BoundingBoxf3 bbox = bounding_box(its);
+    std::vector<float> zs;
+    for (float z = float(bbox.min.z()) + 0.5f * layer_height; z < bbox.max.z(); z += layer_height)
+        zs.emplace_back(z);
+    return zs;
+}
+
+// Polygons rotated to start at their lowest point and sorted, to compare slices independently of the order the intersection lines were chained in.
+static std::vector<Polygons> normalized(std::vector<Polygons> layers)
+{
+    auto point_less = [](const Point &l, const Point &r) { return l.x() < r.x() || (l.x() == r.x() && l.y() < r.y()); };
+    for (Polygons &polygons : layers) {
+        for (Polygon &polygon : polygons)
+            std::rotate(polygon.points.begin(), std::min_element(polygon.points.begin(), polygon.points.end(), point_less), polygon.points.end());
+        std::sort(polygons.begin(), polygons.end(), [&point_less](const Polygon &l, const Polygon &r) {
+            return std::lexicographical_compare(l.points.begin(), l.points.end(), r.points.begin(), r.points.end(), point_less);
+        });
+    }
+    return layers;
+}
+
+SCENARIO( "TriangleMeshSlicer: Slicing at multiple planes matches slicing at a single plane.") {
+    GIVEN( "A sphere of 10mm radius") {
+        indexed_triangle_set sphere = its_make_sphere(10., 2 * PI / 90);
+        std::vector<float>   zs     = slicing_zs(sphere, 0.2f);
+        WHEN( "The sphere is sliced at all planes at once and at each plane separately") {
+            std::vector<Polygons> layers = slice_mesh(sphere, zs, MeshSlicingParams{});
+            THEN( "The slices are the same.") {
+                REQUIRE(layers.size() == zs.size());
+                for (size_t i = 0; i < zs.size(); ++ i) {
+                    Polygons layer = slice_mesh(sphere, zs[i], MeshSlicingParams{});
+                    REQUIRE(layers[i].size() == layer.size());
+                    REQUIRE(area(layers[i]) == Approx(area(layer)));
+                }
+            }
+        }
+        WHEN( "The sphere is sliced in blocks of facets and facet by facet") {
+            MeshSlicingParams params;
+            std::vector<Polygons> layers = slice_mesh(sphere, zs, params);
+            params.slice_in_blocks = false;
+            std::vector<Polygons> layers_by_facets = slice_mesh(sphere, zs, params);
+            THEN( "The slices are the same.") {
+                REQUIRE(normalized(layers) == normalized(layers_by_facets));
+            }
+        }
+        WHEN( "The sphere is sliced with a facet Z index") {
+            auto              index    = std::make_shared<const FacetZIndex>(build_facet_z_index(sphere));
+            size_t            requests = 0;
+            MeshSlicingParams params;
+            params.trafo.translate(Vec3d(0., 0., 5.));
+            std::vector<float> zs_shifted = zs;
+            for (float &z : zs_shifted)
+                z += 5.f;
+            std::vector<Polygons> layers = slice_mesh(sphere, zs_shifted, params);
+            params.facet_z_index = [index, &requests]() { ++ requests; return index; };
+            std::vector<Polygons> layers_indexed = slice_mesh(sphere, zs_shifted, params);
+            THEN( "The facets of each bucket are sorted by their minimum Z.") {
+                REQUIRE(index->facets.size() == sphere.indices.size());
+                REQUIRE(! index->buckets.empty());
+                REQUIRE(index->buckets.back().end == index->facets.size());
+                for (const FacetZIndex::Bucket &bucket : index->buckets)
+                    REQUIRE(std::is_sorted(index->min_z.begin() + bucket.begin, index->min_z.begin() + bucket.end));
+            }
+            THEN( "The index is requested only when slicing at multiple planes.") {
+                REQUIRE(requests == 1);
+                slice_mesh(sphere, zs_shifted.front(), params);
+                REQUIRE(requests == 1);
+            }
+            THEN( "The slices are the same as without the index.") {
+                REQUIRE(layers_indexed.size() == layers.size());
+                for (size_t i = 0; i < layers.size(); ++ i) {
+                    REQUIRE(layers_indexed[i].size() == layers[i].size());
+                    REQUIRE(area(layers_indexed[i]) == Approx(area(layers[i])));
+                }
+            }
+        }
+        WHEN( "A tall box is added next to the sphere") {
+            indexed_triangle_set mesh = sphere;
+            its_merge(mesh, its_make_cube(5., 5., 100.));
+            FacetZIndex index = build_facet_z_index(mesh);
+            THEN( "A thin Z range does not visit the short facets far from it") {
+                std::vector<int> facets = index.facets_crossing(-0.1f, 0.1f);
+                REQUIRE(facets.size() < mesh.indices.size() / 4);
+                size_t crossing = 0;
+                for (size_t i = 0; i < mesh.indices.size(); ++ i) {
+                    float z0 = mesh.vertices[mesh.indices[i](0)].z(), z1 = mesh.vertices[mesh.indices[i](1)].z(), z2 = mesh.vertices[mesh.indices[i](2)].z();
+                    if (std::min(z0, std::min(z1, z2)) <= 0.1f && std::max(z0, std::max(z1, z2)) >= -0.1f) {
+                        ++ crossing;
+                        REQUIRE(std::find(facets.begin(), facets.end(), int(i)) != facets.end());
+                    }
+                }
+                REQUIRE(crossing > 0);
+            }
+        }
+    }
+}
+
+// Benchmark of slicing facet by facet against slicing in blocks of facets.
+// Hidden from the default run, run with "[benchmark]".
+TEST_CASE("Slicing a dense mesh at many planes", "[benchmark][.]") {
+    indexed_triangle_set sphere = its_make_sphere(50., 2 * PI / 2000);
+    std::vector<float>   zs     = slicing_zs(sphere, 0.1f);
+    auto slice = [&sphere, &zs](bool slice_in_blocks, const char *name) {
+        MeshSlicingParams params;
+        params.slice_in_blocks = slice_in_blocks;
+        auto t_start = std::chrono::high_resolution_clock::now();
+        std::vector<Polygons> layers = slice_mesh(sphere, zs, params);
+        auto t_end   = std::chrono::high_resolution_clock::now();
+        WARN("Sliced " << sphere.indices.size() << " facets at " << zs.size() << " planes " << name << " in " <<
+            std::chrono::duration_cast<std::chrono::milliseconds>(t_end - t_start).count() << " ms");
+        return layers;
+    };
+    std::vector<Polygons> layers_by_facets = slice(false, "facet by facet");
+    std::vector<Polygons> layers           = slice(true,  "in blocks of facets");
+    REQUIRE(layers.size() == zs.size());
+    REQUIRE(normalized(layers) == normalized(layers_by_facets));
+}
+
 #ifdef TEST_PERFORMANCE
 TEST_CASE("Regression test for issue #4486 - files take forever to slice") {
     TriangleMesh mesh;
@@ -2,8 +2,11 @@
 
 #include "libslic3r/Model.hpp"
 #include "libslic3r/Format/3mf.hpp"
+#include "libslic3r/Format/bbs_3mf.hpp"
 #include "libslic3r/Format/STL.hpp"
+#include "libslic3r/miniz_extension.hpp"
 
+#include <boost/algorithm/string/predicate.hpp>
 #include <boost/filesystem/operations.hpp>
 
 using namespace Slic3r;
@@ -131,3 +134,61 @@ SCENARIO("2D convex hull of sinking object", "[3mf]") {
     }
 }
 
+// Size of the data deflated at the given level the way the zip writer deflates the archive entries.
+static size_t deflated_size(const void *data, size_t size, int level)
+{
+    size_t out_size = 0;
+    void  *out      = tdefl_compress_mem_to_heap(data, size, &out_size, tdefl_create_comp_flags_from_zip_params(level, -15, MZ_DEFAULT_STRATEGY));
+    mz_free(out);
+    return out_size;
+}
+
+SCENARIO("Compression level of the 3mf model entries", "[3mf]") {
+    GIVEN("a model split into per object model files") {
+        Model model;
+        std::string src_file = std::string(TEST_DATA_DIR) + "/test_3mf/Prusa.stl";
+        load_stl(src_file.c_str(), &model);
+        model.add_default_instances();
+
+        for (bool fast_save : { false, true }) {
+            WHEN(std::string("the model is saved ") + (fast_save ? "with" : "without") + " fast save") {
+                std::string test_file = std::string(TEST_DATA_DIR) + "/test_3mf/prusa_level.3mf";
+                StoreParams store_params;
+                store_params.path     = test_file.c_str();
+                store_params.model    = &model;
+                store_params.config   = nullptr;
+                store_params.strategy = SaveStrategy::Zip64 | SaveStrategy::Silence | SaveStrategy::SkipStatic | SaveStrategy::SplitModel;
+                if (fast_save)
+                    store_params.strategy = store_params.strategy | SaveStrategy::FastSave;
+                REQUIRE(store_bbs_3mf(store_params));
+
+                mz_zip_archive archive;
+                mz_zip_zero_struct(&archive);
+                REQUIRE(open_zip_reader(&archive, test_file));
+                const int level = fast_save ? MZ_BEST_SPEED : MZ_DEFAULT_LEVEL;
+                std::vector<std::string> models;
+                std::vector<std::string> models_at_level;
+                for (mz_uint i = 0; i < mz_zip_reader_get_num_files(&archive); ++ i) {
+                    mz_zip_archive_file_stat stat;
+                    REQUIRE(mz_zip_reader_file_stat(&archive, i, &stat));
+                    std::string name(stat.m_filename);
+                    if (! boost::algorithm::ends_with(name, ".model"))
+                        continue;
+                    models.emplace_back(name);
+                    size_t size = 0;
+                    void  *data = mz_zip_reader_extract_to_heap(&archive, i, &size, 0);
+                    REQUIRE(data != nullptr);
+                    if (stat.m_method == MZ_DEFLATED && stat.m_comp_size == deflated_size(data, size, level))
+                        models_at_level.emplace_back(name);
+                    mz_free(data);
+                }
+                close_zip_reader(&archive);
+                boost::filesystem::remove(test_file);
+                THEN("the main model file and the object model file are deflated at the selected level") {
+                    REQUIRE(models.size() == 2);
+                    REQUIRE(models_at_level == models);
+                }
+            }
+        }
+    }
+}
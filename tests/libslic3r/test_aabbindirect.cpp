@@ -58,3 +58,57 @@ TEST_CASE("Building a tree over a box, ray caster and closest query", "[AABBIndi
     REQUIRE(closest_point.y() == Approx(0.5));
     REQUIRE(closest_point.z() == Approx(1.));
 }
+
+TEST_CASE("Ray packet casting matches single ray casting", "[AABBIndirect]")
+{
+    TriangleMesh tmesh = make_sphere(1., 0.3);
+    tmesh.merge(make_cube(0.5, 0.5, 0.5));
+    auto tree = AABBTreeIndirect::build_aabb_tree_over_indexed_triangle_set(tmesh.its.vertices, tmesh.its.indices);
+
+    const Vec3d        origin(0.1, -0.2, 0.05);
+    std::vector<Vec3d> dirs;
+    for (int i = 0; i < 13; ++ i)
+        dirs.emplace_back(Vec3d(std::cos(0.5 * i), std::sin(0.5 * i), 0.3 * (i - 6)).normalized());
+    // The last packet is partially filled.
+    for (size_t first = 0; first < dirs.size(); first += 8) {
+        size_t                  num_rays = std::min<size_t>(8, dirs.size() - first);
+        std::array<igl::Hit, 8> hits;
+        uint32_t                mask     = AABBTreeIndirect::intersect_ray_packet_first_hits<8>(
+            tmesh.its.vertices, tmesh.its.indices, tree, origin, &dirs[first], num_rays, hits);
+        REQUIRE((mask >> num_rays) == 0);
+        for (size_t i = 0; i < num_rays; ++ i) {
+            igl::Hit hit;
+            bool     intersected = AABBTreeIndirect::intersect_ray_first_hit(tmesh.its.vertices, tmesh.its.indices, tree, origin, dirs[first + i], hit);
+            REQUIRE(intersected == bool(mask & (1 << i)));
+            if (intersected) {
+                REQUIRE(hits[i].id == hit.id);
+                REQUIRE(hits[i].t == Approx(hit.t));
+            }
+        }
+    }
+}
+
+TEST_CASE("Ray packet casting of rays parallel to the box sides", "[AABBIndirect]")
+{
+    TriangleMesh tmesh = make_cube(1., 1., 1.);
+    tmesh.translate(4.f, -0.5f, 1.f);
+    auto tree = AABBTreeIndirect::build_aabb_tree_over_indexed_triangle_set(tmesh.its.vertices, tmesh.its.indices);
+
+    // The origin rounds to the bottom of the box in single precision, the rays with zero z direction touch the bottom slab.
+    const Vec3d        origin(0., 0., 1. + 1e-9);
+    std::vector<Vec3d> dirs { Vec3d(1., 0., 0.), Vec3d(1., 0.1, 0.).normalized(), Vec3d(1., 0., 0.1).normalized(),
+                              Vec3d(0., 0., 1.), Vec3d(1., 0., -0.1).normalized(), Vec3d(-1., 0., 0.) };
+    std::array<igl::Hit, 8> hits;
+    uint32_t                mask = AABBTreeIndirect::intersect_ray_packet_first_hits<8>(
+        tmesh.its.vertices, tmesh.its.indices, tree, origin, dirs.data(), dirs.size(), hits);
+    REQUIRE(mask == 0b111);
+    for (size_t i = 0; i < dirs.size(); ++ i) {
+        igl::Hit hit;
+        bool     intersected = AABBTreeIndirect::intersect_ray_first_hit(tmesh.its.vertices, tmesh.its.indices, tree, origin, dirs[i], hit);
+        REQUIRE(intersected == bool(mask & (1 << i)));
+        if (intersected) {
+            REQUIRE(hits[i].id == hit.id);
+            REQUIRE(hits[i].t == Approx(hit.t));
+        }
+    }
+}
@@ -102,6 +102,19 @@ TEST_CASE("Split two watertight meshes", "[its_split][its]") {
     debug_write_obj(res, "parts_watertight");
 }
 
+TEST_CASE("Mesh hash depends on the mesh content only", "[its_hash][its]") {
+    using namespace Slic3r;
+
+    auto cube1 = its_make_cube(10., 10., 10.), cube2 = cube1;
+    REQUIRE(its_hash(cube1) == its_hash(cube2));
+
+    its_transform(cube2, identity3f().translate(Vec3f{0.f, 0.f, 1.f}));
+    REQUIRE(its_hash(cube1) != its_hash(cube2));
+
+    its_flip_triangles(cube1);
+    REQUIRE(its_hash(cube1) != its_hash(its_make_cube(10., 10., 10.)));
+}
+
 #include <libslic3r/QuadricEdgeCollapse.hpp>
 static float triangle_area(const Vec3f &v0, const Vec3f &v1, const Vec3f &v2)
 {
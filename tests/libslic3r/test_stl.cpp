@@ -20,6 +20,31 @@ SCENARIO("Reading an STL file", "[stl]") {
             }
         }
     }
+	GIVEN("a binary STL file") {
+		WHEN("STL file is read through a memory mapping") {
+			stl_file stl_mapped, stl_read;
+			std::optional<bool> mapped = stl_open_binary_mapped(&stl_mapped, stl_path("Geräte/20mmbox-čřšřěá.stl").c_str());
+			THEN("the facets and statistics match the sequential reader") {
+				REQUIRE(mapped);
+				REQUIRE(*mapped);
+				REQUIRE(stl_open(&stl_read, stl_path("Geräte/20mmbox-čřšřěá.stl").c_str()));
+				REQUIRE(stl_mapped.stats.number_of_facets == stl_read.stats.number_of_facets);
+				REQUIRE(stl_mapped.stats.min == stl_read.stats.min);
+				REQUIRE(stl_mapped.stats.max == stl_read.stats.max);
+				REQUIRE(stl_mapped.stats.shortest_edge == stl_read.stats.shortest_edge);
+				for (size_t i = 0; i < stl_read.facet_start.size(); ++ i)
+					REQUIRE(memcmp(&stl_mapped.facet_start[i], &stl_read.facet_start[i], SIZEOF_STL_FACET) == 0);
+			}
+		}
+	}
+	GIVEN("an ASCII STL file") {
+		WHEN("STL file is read through a memory mapping") {
+			stl_file stl;
+			THEN("the caller is asked to fall back to the sequential reader") {
+				REQUIRE(! stl_open_binary_mapped(&stl, stl_path("ASCII/20mmbox-LF.stl").c_str()));
+			}
+		}
+	}
 	GIVEN("in ASCII format") {
 		WHEN("line endings LF") {
 			Slic3r::Model model;